@@ -122,6 +122,7 @@ private:
 	thread_local static Error last_file_open_error;
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
+	bool memory_mapping_enabled = false;
 	static CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
 	template <typename T>
 	static Ref<FileAccess> _create_builtin() {
@@ -159,6 +160,9 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const { return nullptr; } ///< get a read-only view of the next p_length bytes and advance past them, or nullptr if the file is not memory-backed. The view is valid while the file stays open.
+	void set_memory_mapping_enabled(bool p_enabled) { memory_mapping_enabled = p_enabled; } ///< let get_mapped_buffer() map a plain file opened for reading. Only for files that are never truncated while open, touching a mapping past the new end of the file crashes the process.
+	bool is_memory_mapping_enabled() const { return memory_mapping_enabled; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -33,17 +33,26 @@
 #include "resource_format_binary.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
 #define print_bl(m_what) (void)(m_what)
 
+// Below these, decoding the internal resources on worker threads costs more than it saves.
+static const int PARALLEL_DECODE_MIN_RESOURCES = 4;
+static const uint64_t PARALLEL_DECODE_MIN_SIZE = 64 * 1024;
+// Smaller packed arrays are not worth a compression frame.
+static const uint64_t PACKED_ARRAY_COMPRESS_MIN_SIZE = 4096;
+
 enum {
 	//numbering must be different from variant, in case new variant types are added (variant must be always contiguous for jumptable optimization)
 	VARIANT_NIL = 1,
@@ -88,6 +97,7 @@ enum {
 	VARIANT_VECTOR4I = 51,
 	VARIANT_PROJECTION = 52,
 	VARIANT_PACKED_VECTOR4_ARRAY = 53,
+	VARIANT_COMPRESSED_PACKED_ARRAY = 54,
 	OBJECT_EMPTY = 0,
 	OBJECT_EXTERNAL_RESOURCE = 1,
 	OBJECT_INTERNAL_RESOURCE = 2,
@@ -97,9 +107,12 @@ enum {
 	// Version 4: New string ID for ext/subresources, breaks forward compat.
 	// Version 5: Ability to store script class in the header.
 	// Version 6: Added PackedVector4Array Variant type.
-	FORMAT_VERSION = 6,
+	// Version 7: Packed arrays can be stored zstd-compressed.
+	FORMAT_VERSION = 7,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_PACKED_VECTOR4_ARRAY = 6,
+	FORMAT_VERSION_COMPRESSED_PACKED_ARRAYS = 7,
 };
 
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
@@ -155,6 +168,43 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	return OK;
 }
 
+template <typename T>
+static Error decompress_packed_array(Vector<T> &r_array, uint64_t p_count, uint64_t p_size, const uint8_t *p_src, uint32_t p_src_size) {
+	ERR_FAIL_COND_V(p_count == 0 || p_count * sizeof(T) != p_size, ERR_FILE_CORRUPT);
+	ERR_FAIL_COND_V(r_array.resize(p_count) != OK, ERR_OUT_OF_MEMORY);
+	int decompressed = Compression::decompress((uint8_t *)r_array.ptrw(), p_size, p_src, p_src_size, Compression::MODE_ZSTD);
+	ERR_FAIL_COND_V_MSG(decompressed != (int)p_size, ERR_FILE_CORRUPT, "Error decompressing packed array.");
+	return OK;
+}
+
+// Arrays of real_t based types, stored with the precision the file was saved with.
+template <typename T>
+static Error decompress_packed_real_array(Vector<T> &r_array, bool p_real_is_double, uint64_t p_count, uint64_t p_size, const uint8_t *p_src, uint32_t p_src_size) {
+	static_assert(sizeof(T) % sizeof(real_t) == 0);
+	constexpr uint64_t components = sizeof(T) / sizeof(real_t);
+	if (p_real_is_double == (sizeof(real_t) == 8)) {
+		return decompress_packed_array(r_array, p_count, p_size, p_src, p_src_size);
+	}
+
+	// Precision differs from the engine's, convert after decompressing.
+	Error err = OK;
+	Vector<float> floats;
+	Vector<double> doubles;
+	if (p_real_is_double) {
+		err = decompress_packed_array(doubles, p_count * components, p_size, p_src, p_src_size);
+	} else {
+		err = decompress_packed_array(floats, p_count * components, p_size, p_src, p_src_size);
+	}
+	ERR_FAIL_COND_V(err != OK, err);
+
+	ERR_FAIL_COND_V(r_array.resize(p_count) != OK, ERR_OUT_OF_MEMORY);
+	real_t *w = reinterpret_cast<real_t *>(r_array.ptrw());
+	for (uint64_t i = 0; i < p_count * components; i++) {
+		w[i] = p_real_is_double ? (real_t)doubles[i] : (real_t)floats[i];
+	}
+	return OK;
+}
+
 StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
@@ -412,11 +462,14 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					// Every resource is created upfront, but only earlier ones are visible, like when loading them one by one.
+					const HashMap<String, Ref<Resource>> &index_cache = decode_owner ? decode_owner->internal_index_cache : internal_index_cache;
+					HashMap<String, Ref<Resource>>::ConstIterator E = index_cache.find(path);
+					if (!E || (using_named_scene_ids && decode_index >= 0 && (int)index >= decode_index)) {
 						WARN_PRINT(vformat("Couldn't load resource (no cache): %s.", path));
 						r_v = Variant();
 					} else {
-						r_v = internal_index_cache[path];
+						r_v = E->value;
 					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
@@ -425,6 +478,12 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					String exttype = get_unicode_string();
 					String path = get_unicode_string();
 
+					if (decode_owner) {
+						// Waiting for other loads is left to the loading thread.
+						decode_deferred = true;
+						break;
+					}
+
 					if (!path.contains("://") && path.is_relative_path()) {
 						// path is relative to file being loaded, so convert to a resource path
 						path = ProjectSettings::get_singleton()->localize_path(res_path.get_base_dir().path_join(path));
@@ -446,6 +505,11 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					//new file format, just refers to an index in the external list
 					int erindex = f->get_32();
 
+					if (decode_owner) {
+						decode_deferred = true;
+						break;
+					}
+
 					if (erindex < 0 || erindex >= external_resources.size()) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
@@ -669,6 +733,84 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 
 			r_v = array;
 
+		} break;
+		case VARIANT_COMPRESSED_PACKED_ARRAY: {
+			uint32_t array_type = f->get_32();
+			uint32_t len = f->get_32();
+			uint64_t size = f->get_64();
+			uint32_t compressed_size = f->get_32();
+
+			ERR_FAIL_COND_V(size > INT_MAX - 12 || compressed_size > INT_MAX, ERR_FILE_CORRUPT);
+#ifdef BIG_ENDIAN_ENABLED
+			// Only little endian hosts compress arrays, the data would need swapping here.
+			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Compressed packed arrays are not supported on big endian platforms.");
+#else
+			ERR_FAIL_COND_V(f->is_big_endian(), ERR_FILE_CORRUPT);
+
+			Vector<uint8_t> compressed;
+			const uint8_t *src = f->get_mapped_buffer(compressed_size);
+			if (!src) {
+				compressed.resize(compressed_size);
+				ERR_FAIL_COND_V(f->get_buffer(compressed.ptrw(), compressed_size) != compressed_size, ERR_FILE_CORRUPT);
+				src = compressed.ptr();
+			}
+			_advance_padding(compressed_size);
+
+			// Decompress straight into the array, the stored data matches its memory layout.
+			Error err = OK;
+			switch (array_type) {
+				case VARIANT_PACKED_BYTE_ARRAY: {
+					Vector<uint8_t> array;
+					err = decompress_packed_array(array, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_INT32_ARRAY: {
+					Vector<int32_t> array;
+					err = decompress_packed_array(array, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_INT64_ARRAY: {
+					Vector<int64_t> array;
+					err = decompress_packed_array(array, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_FLOAT32_ARRAY: {
+					Vector<float> array;
+					err = decompress_packed_array(array, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_FLOAT64_ARRAY: {
+					Vector<double> array;
+					err = decompress_packed_array(array, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_VECTOR2_ARRAY: {
+					Vector<Vector2> array;
+					err = decompress_packed_real_array(array, f->real_is_double, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_VECTOR3_ARRAY: {
+					Vector<Vector3> array;
+					err = decompress_packed_real_array(array, f->real_is_double, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_COLOR_ARRAY: {
+					// Colors always use `float` even with double-precision support enabled.
+					Vector<Color> array;
+					err = decompress_packed_array(array, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				case VARIANT_PACKED_VECTOR4_ARRAY: {
+					Vector<Vector4> array;
+					err = decompress_packed_real_array(array, f->real_is_double, len, size, src, compressed_size);
+					r_v = array;
+				} break;
+				default: {
+					ERR_FAIL_V(ERR_FILE_CORRUPT);
+				} break;
+			}
+			ERR_FAIL_COND_V(err != OK, err);
+#endif
 		} break;
 		default: {
 			ERR_FAIL_V(ERR_FILE_CORRUPT);
@@ -711,9 +853,20 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
+	// Create every internal resource first, so their properties can be decoded in any order.
+	Vector<Ref<Resource>> resources;
+	Vector<MissingResource *> missing_resources;
+	Vector<bool> skip;
+	resources.resize(internal_resources.size());
+	missing_resources.resize(internal_resources.size());
+	skip.resize(internal_resources.size());
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
+		missing_resources.write[i] = nullptr;
+		skip.write[i] = false;
+
 		//maybe it is loaded already
 		String path;
 		String id;
@@ -735,6 +888,7 @@ Error ResourceLoaderBinary::load() {
 					//already loaded, don't do anything
 					error = OK;
 					internal_index_cache[path] = cached;
+					skip.write[i] = true;
 					continue;
 				}
 			}
@@ -813,25 +967,58 @@ Error ResourceLoaderBinary::load() {
 			internal_index_cache[path] = res;
 		}
 
-		int pc = f->get_32();
+		resources.write[i] = res;
+		missing_resources.write[i] = missing_resource;
+	}
+
+	Vector<DecodedResource> decoded;
+	_decode_internal_resources(skip, decoded);
+
+	// Set the properties in file order, the main resource last.
+	for (int i = 0; i < internal_resources.size(); i++) {
+		if (skip[i]) {
+			continue;
+		}
+
+		bool main = i == (internal_resources.size() - 1);
+		Ref<Resource> res = resources[i];
+		MissingResource *missing_resource = missing_resources[i];
+		const DecodedResource *dr = i < decoded.size() && decoded[i].decoded ? &decoded[i] : nullptr;
+
+		decode_index = i;
+
+		int pc;
+		if (dr) {
+			pc = dr->names.size();
+		} else {
+			f->seek(internal_resources[i].offset);
+			get_unicode_string(); // Type, the resource is already created.
+			pc = f->get_32();
+		}
 
 		//set properties
 
 		Dictionary missing_resource_properties;
 
 		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+			StringName name;
+			Variant value;
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+			if (dr) {
+				name = dr->names[j];
+				value = dr->values[j];
+			} else {
+				name = _get_string();
 
-			Variant value;
+				if (name == StringName()) {
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V(ERR_FILE_CORRUPT);
+				}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
+				error = parse_variant(value);
+				if (error) {
+					return error;
+				}
 			}
 
 			bool set_valid = true;
@@ -907,6 +1094,91 @@ Error ResourceLoaderBinary::load() {
 	return ERR_FILE_EOF;
 }
 
+void ResourceLoaderBinary::_decode_properties(DecodedResource &r_decoded) {
+	f->seek(internal_resources[decode_index].offset);
+	get_unicode_string(); // Type, the resource is already created.
+
+	int pc = f->get_32();
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+		if (name == StringName()) {
+			return;
+		}
+
+		Variant value;
+		Error err = parse_variant(value);
+		if (err || decode_deferred) {
+			// Decoded again by the loading thread, which reports the errors.
+			return;
+		}
+
+		r_decoded.names.push_back(name);
+		r_decoded.values.push_back(value);
+	}
+
+	r_decoded.decoded = true;
+}
+
+void ResourceLoaderBinary::_decode_internal_resource(void *p_userdata, uint32_t p_index) {
+	ParallelDecode *pd = (ParallelDecode *)p_userdata;
+	const ResourceLoaderBinary *owner = pd->owner;
+	int index = pd->indices[p_index];
+
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	fm->open_custom(pd->data, pd->length);
+	fm->set_big_endian(pd->big_endian);
+	fm->real_is_double = pd->real_is_double;
+
+	ResourceLoaderBinary decoder;
+	decoder.f = fm;
+	decoder.local_path = owner->local_path;
+	decoder.res_path = owner->res_path;
+	decoder.ver_format = owner->ver_format;
+	decoder.using_named_scene_ids = owner->using_named_scene_ids;
+	decoder.string_map = owner->string_map;
+	decoder.internal_resources = owner->internal_resources;
+	decoder.decode_owner = owner;
+	decoder.decode_index = index;
+	decoder._decode_properties(pd->results[index]);
+}
+
+void ResourceLoaderBinary::_decode_internal_resources(const Vector<bool> &p_skip, Vector<DecodedResource> &r_decoded) {
+	// Resources from the old format refer to each other by position, keep decoding those one by one.
+	if (!using_named_scene_ids) {
+		return;
+	}
+
+	ParallelDecode pd;
+	pd.owner = this;
+	for (int i = 0; i < internal_resources.size(); i++) {
+		if (!p_skip[i]) {
+			pd.indices.push_back(i);
+		}
+	}
+
+	pd.length = f->get_length();
+	if (pd.indices.size() < PARALLEL_DECODE_MIN_RESOURCES || pd.length < PARALLEL_DECODE_MIN_SIZE) {
+		return; // Not worth dispatching.
+	}
+
+	// Workers read from their own cursor over the mapped file. Files that can't be mapped are decoded
+	// one by one rather than copied whole into memory, which large scenes can't afford.
+	f->seek(0);
+	pd.data = f->get_mapped_buffer(pd.length);
+	if (!pd.data) {
+		return;
+	}
+	pd.big_endian = f->is_big_endian();
+	pd.real_is_double = f->real_is_double;
+
+	r_decoded.resize(internal_resources.size());
+	pd.results = r_decoded.ptrw();
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&ResourceLoaderBinary::_decode_internal_resource, &pd, pd.indices.size(), -1, true, String("ResourceLoaderBinaryDecode"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
 	translation_remapped = p_remapped;
 }
@@ -1596,7 +1868,43 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
-void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
+bool ResourceFormatSaverBinaryInstance::_store_packed_array(Ref<FileAccess> f, uint32_t p_type, uint32_t p_len, const uint8_t *p_data, uint64_t p_size, bool p_compress, bool *r_compressed) {
+#ifdef BIG_ENDIAN_ENABLED
+	return false;
+#else
+	if (f->is_big_endian()) {
+		return false; // Needs swapping element by element.
+	}
+
+	if (p_compress && p_size >= PACKED_ARRAY_COMPRESS_MIN_SIZE && p_size <= INT_MAX - 12) {
+		Vector<uint8_t> compressed;
+		compressed.resize(Compression::get_max_compressed_buffer_size(p_size, Compression::MODE_ZSTD));
+		int compressed_size = Compression::compress(compressed.ptrw(), p_data, p_size, Compression::MODE_ZSTD);
+		if (compressed_size > 0 && (uint64_t)compressed_size < p_size) {
+			f->store_32(VARIANT_COMPRESSED_PACKED_ARRAY);
+			f->store_32(p_type);
+			f->store_32(p_len);
+			f->store_64(p_size);
+			f->store_32(compressed_size);
+			f->store_buffer(compressed.ptr(), compressed_size);
+			_pad_buffer(f, compressed_size);
+			if (r_compressed) {
+				*r_compressed = true;
+			}
+			return true;
+		}
+	}
+
+	// The file layout matches the memory layout, store the whole array at once.
+	f->store_32(p_type);
+	f->store_32(p_len);
+	f->store_buffer(p_data, p_size);
+	_pad_buffer(f, p_size);
+	return true;
+#endif
+}
+
+void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint, bool p_compress_packed_arrays, bool *r_compressed_packed_arrays) {
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
 			f->store_32(VARIANT_NIL);
@@ -1884,8 +2192,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			d.get_key_list(&keys);
 
 			for (const Variant &E : keys) {
-				write_variant(f, E, resource_map, external_resources, string_map);
-				write_variant(f, d[E], resource_map, external_resources, string_map);
+				write_variant(f, E, resource_map, external_resources, string_map, PropertyInfo(), p_compress_packed_arrays, r_compressed_packed_arrays);
+				write_variant(f, d[E], resource_map, external_resources, string_map, PropertyInfo(), p_compress_packed_arrays, r_compressed_packed_arrays);
 			}
 
 		} break;
@@ -1894,14 +2202,17 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Array a = p_property;
 			f->store_32(uint32_t(a.size()));
 			for (const Variant &var : a) {
-				write_variant(f, var, resource_map, external_resources, string_map);
+				write_variant(f, var, resource_map, external_resources, string_map, PropertyInfo(), p_compress_packed_arrays, r_compressed_packed_arrays);
 			}
 
 		} break;
 		case Variant::PACKED_BYTE_ARRAY: {
-			f->store_32(VARIANT_PACKED_BYTE_ARRAY);
 			Vector<uint8_t> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_BYTE_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len, p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_BYTE_ARRAY);
 			f->store_32(len);
 			const uint8_t *r = arr.ptr();
 			f->store_buffer(r, len);
@@ -1909,9 +2220,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 
 		} break;
 		case Variant::PACKED_INT32_ARRAY: {
-			f->store_32(VARIANT_PACKED_INT32_ARRAY);
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_INT32_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(int32_t), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_INT32_ARRAY);
 			f->store_32(len);
 			const int32_t *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -1920,9 +2234,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
-			f->store_32(VARIANT_PACKED_INT64_ARRAY);
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_INT64_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(int64_t), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_INT64_ARRAY);
 			f->store_32(len);
 			const int64_t *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -1931,9 +2248,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
-			f->store_32(VARIANT_PACKED_FLOAT32_ARRAY);
 			Vector<float> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_FLOAT32_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(float), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_FLOAT32_ARRAY);
 			f->store_32(len);
 			const float *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -1942,9 +2262,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
-			f->store_32(VARIANT_PACKED_FLOAT64_ARRAY);
 			Vector<double> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_FLOAT64_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(double), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_FLOAT64_ARRAY);
 			f->store_32(len);
 			const double *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -1964,9 +2287,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 		} break;
 
 		case Variant::PACKED_VECTOR2_ARRAY: {
-			f->store_32(VARIANT_PACKED_VECTOR2_ARRAY);
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_VECTOR2_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(Vector2), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_VECTOR2_ARRAY);
 			f->store_32(len);
 			const Vector2 *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -1976,9 +2302,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 		} break;
 
 		case Variant::PACKED_VECTOR3_ARRAY: {
-			f->store_32(VARIANT_PACKED_VECTOR3_ARRAY);
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_VECTOR3_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(Vector3), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_VECTOR3_ARRAY);
 			f->store_32(len);
 			const Vector3 *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -1989,9 +2318,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 		} break;
 
 		case Variant::PACKED_COLOR_ARRAY: {
-			f->store_32(VARIANT_PACKED_COLOR_ARRAY);
 			Vector<Color> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_COLOR_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(Color), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_COLOR_ARRAY);
 			f->store_32(len);
 			const Color *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -2003,9 +2335,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 
 		} break;
 		case Variant::PACKED_VECTOR4_ARRAY: {
-			f->store_32(VARIANT_PACKED_VECTOR4_ARRAY);
 			Vector<Vector4> arr = p_property;
 			int len = arr.size();
+			if (_store_packed_array(f, VARIANT_PACKED_VECTOR4_ARRAY, len, (const uint8_t *)arr.ptr(), (uint64_t)len * sizeof(Vector4), p_compress_packed_arrays, r_compressed_packed_arrays)) {
+				break;
+			}
+			f->store_32(VARIANT_PACKED_VECTOR4_ARRAY);
 			f->store_32(len);
 			const Vector4 *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
@@ -2166,6 +2501,8 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	bundle_resources = p_flags & ResourceSaver::FLAG_BUNDLE_RESOURCES;
 	big_endian = p_flags & ResourceSaver::FLAG_SAVE_BIG_ENDIAN;
 	takeover_paths = p_flags & ResourceSaver::FLAG_REPLACE_SUBRESOURCE_PATHS;
+	// Compressing the arrays again is pointless when the whole file is compressed.
+	compress_packed_arrays = !(p_flags & ResourceSaver::FLAG_COMPRESS) && bool(GLOBAL_GET("compression/binary_resources/compress_packed_arrays"));
 
 	if (!p_path.begins_with("res://")) {
 		takeover_paths = false;
@@ -2192,7 +2529,10 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	f->store_32(0); //64 bits file, false for now
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
-	f->store_32(FORMAT_VERSION);
+	// Files without compressed packed arrays stay readable by older versions,
+	// the version is raised once one is actually written.
+	const uint64_t format_version_pos = f->get_position();
+	f->store_32(FORMAT_VERSION_PACKED_VECTOR4_ARRAY);
 
 	if (f->get_error() != OK && f->get_error() != ERR_FILE_EOF) {
 		return ERR_CANT_CREATE;
@@ -2359,6 +2699,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	}
 
 	Vector<uint64_t> ofs_table;
+	bool packed_arrays_compressed = false;
 
 	//now actually save the resources
 	for (const ResourceData &rd : resources) {
@@ -2368,7 +2709,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 		for (const Property &p : rd.properties) {
 			f->store_32(p.name_idx);
-			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi);
+			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi, compress_packed_arrays, &packed_arrays_compressed);
 		}
 	}
 
@@ -2377,6 +2718,11 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 		f->store_64(ofs_table[i]);
 	}
 
+	if (packed_arrays_compressed) {
+		f->seek(format_version_pos);
+		f->store_32(FORMAT_VERSION_COMPRESSED_PACKED_ARRAYS);
+	}
+
 	f->seek_end();
 
 	f->store_buffer((const uint8_t *)"RSRC", 4); //magic at end
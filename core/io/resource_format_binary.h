@@ -95,6 +95,32 @@ class ResourceLoaderBinary {
 
 	HashMap<String, Ref<Resource>> dependency_cache;
 
+	// Properties of an internal resource decoded ahead of time on a worker thread.
+	// Left undecoded when it failed or referenced external resources, the loading thread then decodes it itself.
+	struct DecodedResource {
+		Vector<StringName> names;
+		Vector<Variant> values;
+		bool decoded = false;
+	};
+
+	struct ParallelDecode {
+		const ResourceLoaderBinary *owner = nullptr;
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+		bool big_endian = false;
+		bool real_is_double = false;
+		Vector<int> indices;
+		DecodedResource *results = nullptr;
+	};
+
+	const ResourceLoaderBinary *decode_owner = nullptr; // Set on the helper loaders used by worker threads.
+	int decode_index = -1; // Internal resource being decoded, only earlier ones can be referenced.
+	bool decode_deferred = false;
+
+	void _decode_properties(DecodedResource &r_decoded);
+	static void _decode_internal_resource(void *p_userdata, uint32_t p_index);
+	void _decode_internal_resources(const Vector<bool> &p_skip, Vector<DecodedResource> &r_decoded);
+
 public:
 	Ref<Resource> get_resource();
 	Error load();
@@ -134,6 +160,7 @@ class ResourceFormatSaverBinaryInstance {
 	bool skip_editor;
 	bool big_endian;
 	bool takeover_paths;
+	bool compress_packed_arrays;
 	String magic;
 	HashSet<Ref<Resource>> resource_set;
 
@@ -162,6 +189,7 @@ class ResourceFormatSaverBinaryInstance {
 	};
 
 	static void _pad_buffer(Ref<FileAccess> f, int p_bytes);
+	static bool _store_packed_array(Ref<FileAccess> f, uint32_t p_type, uint32_t p_len, const uint8_t *p_data, uint64_t p_size, bool p_compress, bool *r_compressed = nullptr);
 	void _find_resources(const Variant &p_variant, bool p_main = false);
 	static void save_unicode_string(Ref<FileAccess> f, const String &p_string, bool p_bit_on_len = false);
 	int get_string_index(const String &p_string);
@@ -178,7 +206,7 @@ public:
 	};
 	Error save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags = 0);
 	Error set_uid(const String &p_path, ResourceUID::ID p_uid);
-	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo());
+	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo(), bool p_compress_packed_arrays = false, bool *r_compressed_packed_arrays = nullptr);
 };
 
 class ResourceFormatSaverBinary : public ResourceFormatSaver {
@@ -85,30 +85,230 @@ Error CallQueue::push_set(Object *p_object, const StringName &p_prop, const Vari
 	return push_set(p_object->get_instance_id(), p_prop, p_value);
 }
 
-Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
-	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+Error CallQueue::push_call(Object *p_object, const StringName &p_method) {
+	return push_callablep(Callable(p_object->get_instance_id(), p_method), nullptr, 0);
+}
 
-	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
+CallQueue::ThreadStagingCache::~ThreadStagingCache() {
+	// The queue frees the staging of exited threads once it has spliced all its messages.
+	if (staging && generation == live_staging_generation.get()) {
+		staging->thread_exited.set();
+	}
+}
+
+CallQueue::ThreadStaging *CallQueue::_get_thread_staging() {
+	ThreadStagingCache &cache = thread_staging_cache;
+	if (likely(cache.generation == staging_generation)) {
+		return cache.staging;
+	}
+
+	MutexLock lock(mutex);
+	const Thread::ID thread_id = Thread::get_caller_id();
+	ThreadStaging *staging = nullptr;
+	for (ThreadStaging *E : thread_stagings) {
+		if (E->thread_id == thread_id) {
+			staging = E;
+			break;
+		}
+	}
+	if (!staging) {
+		staging = memnew(ThreadStaging);
+		staging->thread_id = thread_id;
+		thread_stagings.push_back(staging);
+	}
+
+	cache.generation = staging_generation;
+	cache.staging = staging;
+	return staging;
+}
+
+// Must be called with the mutex locked.
+// Moves the messages of every thread staging to the end of the queue, in the order they were pushed.
+bool CallQueue::_splice_thread_stagings() {
+	// All the stagings are locked at once, so no thread can take a sequence number meanwhile:
+	// everything spliced was pushed before anything that will be spliced later.
+	splice_sources.clear();
+	for (ThreadStaging *staging : thread_stagings) {
+		staging->lock.lock();
+		if (staging->pages_used > 0) {
+			splice_sources.push_back(staging);
+		}
+	}
+
+	const bool spliced = !splice_sources.is_empty();
+	if (splice_sources.size() == 1) {
+		// Only one thread pushed, so its pages are already in order and can be moved as they are.
+		_move_staged_pages(splice_sources[0]);
+	} else if (spliced) {
+		_merge_staged_messages();
+	}
+
+	for (uint32_t i = 0; i < thread_stagings.size(); i++) {
+		ThreadStaging *staging = thread_stagings[i];
+		const bool remove = staging->pages_used == 0 && staging->thread_exited.is_set();
+		staging->lock.unlock();
+
+		if (remove) {
+			_free_thread_staging(staging);
+			thread_stagings.remove_at_unordered(i);
+			i--;
+		}
+	}
+	return spliced;
+}
+
+// Must be called with the mutex and the staging locked.
+// Swaps the staged pages into the queue, giving back free pages in exchange.
+void CallQueue::_move_staged_pages(ThreadStaging *p_staging) {
+	_ensure_first_page();
+	for (uint32_t i = 0; i < p_staging->pages_used; i++) {
+		uint32_t slot;
+		if (page_bytes[pages_used - 1] == 0) {
+			slot = pages_used - 1;
+			used_pages.decrement(); // The page was already counted by the queue.
+		} else {
+			if (pages_used == pages.size()) {
+				pages.push_back(allocator->alloc());
+				page_bytes.push_back(0);
+			}
+			slot = pages_used++;
+		}
+
+		SWAP(pages[slot], p_staging->pages[i]);
+		page_bytes[slot] = p_staging->page_bytes[i];
+		p_staging->page_bytes[i] = 0;
+	}
+	p_staging->pages_used = 0;
+}
+
+// Must be called with the mutex and every staging in splice_sources locked.
+// Copies the staged messages to the end of the queue, interleaved by sequence number.
+void CallQueue::_merge_staged_messages() {
+	struct Cursor {
+		ThreadStaging *staging = nullptr;
+		uint32_t page = 0;
+		uint32_t offset = 0;
+	};
+	Cursor *cursors = (Cursor *)alloca(sizeof(Cursor) * splice_sources.size());
+	for (uint32_t i = 0; i < splice_sources.size(); i++) {
+		memnew_placement(&cursors[i], Cursor);
+		cursors[i].staging = splice_sources[i];
+	}
+
+	_ensure_first_page();
+	while (true) {
+		Cursor *next = nullptr;
+		const Message *next_message = nullptr;
+		for (uint32_t i = 0; i < splice_sources.size(); i++) {
+			Cursor &cursor = cursors[i];
+			if (cursor.page == cursor.staging->pages_used) {
+				continue;
+			}
+			const Message *message = (const Message *)&cursor.staging->pages[cursor.page]->data[cursor.offset];
+			// Sequence numbers wrap around, so compare their difference.
+			if (!next_message || int32_t(message->sequence - next_message->sequence) < 0) {
+				next = &cursor;
+				next_message = message;
+			}
+		}
+		if (!next) {
+			break;
+		}
+
+		const uint32_t size = _get_message_size(next_message);
+		if (page_bytes[pages_used - 1] + size > uint32_t(PAGE_SIZE_BYTES)) {
+			// Staged pages are released below, so this only exceeds the limit by the slack left at the end of pages.
+			used_pages.increment();
+			_add_page();
+		}
+		// Messages are relocated bitwise, the same way CowData moves Variants when reallocating.
+		memcpy(&pages[pages_used - 1]->data[page_bytes[pages_used - 1]], (const void *)next_message, size);
+		page_bytes[pages_used - 1] += size;
+
+		next->offset += size;
+		if (next->offset == next->staging->page_bytes[next->page]) {
+			next->page++;
+			next->offset = 0;
+		}
+	}
+
+	for (ThreadStaging *staging : splice_sources) {
+		for (uint32_t i = 0; i < staging->pages_used; i++) {
+			staging->page_bytes[i] = 0;
+		}
+		used_pages.sub(staging->pages_used);
+		staging->pages_used = 0;
+	}
+}
+
+void CallQueue::_free_thread_staging(ThreadStaging *p_staging) {
+	for (uint32_t i = 0; i < p_staging->pages_used; i++) {
+		_clear_messages(p_staging->pages[i], p_staging->page_bytes[i]);
+	}
+	used_pages.sub(p_staging->pages_used);
+	for (Page *page : p_staging->pages) {
+		allocator->free(page);
+	}
+	memdelete(p_staging);
+}
+
+uint8_t *CallQueue::_begin_message(uint32_t p_room_needed, ThreadStaging *&r_staging) {
+	// Threads overriding the queue write directly into the shared pages.
+	if (thread_staging && this != MessageQueue::thread_singleton) {
+		ThreadStaging *staging = _get_thread_staging();
+		staging->lock.lock();
+
+		if (staging->pages_used == 0 || (staging->page_bytes[staging->pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+			if (!_reserve_page()) {
+				staging->lock.unlock();
+				return nullptr;
+			}
+			if (staging->pages_used == staging->pages.size()) {
+				staging->pages.push_back(allocator->alloc());
+				staging->page_bytes.push_back(0);
+			}
+			staging->page_bytes[staging->pages_used] = 0;
+			staging->pages_used++;
+		}
+
+		r_staging = staging;
+		return &staging->pages[staging->pages_used - 1]->data[staging->page_bytes[staging->pages_used - 1]];
+	}
+
+	r_staging = nullptr;
 
 	LOCK_MUTEX;
 
 	_ensure_first_page();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
+	if ((page_bytes[pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (!_reserve_page()) {
 			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+			return nullptr;
 		}
 		_add_page();
 	}
 
-	Page *page = pages[pages_used - 1];
+	return &pages[pages_used - 1]->data[page_bytes[pages_used - 1]];
+}
 
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
+void CallQueue::_end_message(uint32_t p_room_needed, ThreadStaging *p_staging) {
+	if (p_staging) {
+		// Taken with the staging locked, so splicing sees either this message or none with a later number.
+		Message *message = (Message *)&p_staging->pages[p_staging->pages_used - 1]->data[p_staging->page_bytes[p_staging->pages_used - 1]];
+		message->sequence = push_sequence.increment();
+		p_staging->page_bytes[p_staging->pages_used - 1] += p_room_needed;
+		p_staging->lock.unlock();
+		return;
+	}
 
-	Message *msg = memnew_placement(buffer_end, Message);
+	page_bytes[pages_used - 1] += p_room_needed;
+
+	UNLOCK_MUTEX;
+}
+
+void CallQueue::_write_call_message(uint8_t *p_buffer, const Callable &p_callable, int p_argcount, bool p_show_error) {
+	Message *msg = memnew_placement(p_buffer, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -119,46 +319,54 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
 		msg->type |= FLAG_NULL_IS_OK;
 	}
+}
+
+void CallQueue::_print_call_out_of_memory(const Callable &p_callable) {
+	fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+	statistics();
+}
+
+Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+
+	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
+
+	ThreadStaging *staging = nullptr;
+	uint8_t *buffer_end = _begin_message(room_needed, staging);
+	if (unlikely(!buffer_end)) {
+		_print_call_out_of_memory(p_callable);
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	_write_call_message(buffer_end, p_callable, p_argcount, p_show_error);
 
 	buffer_end += sizeof(Message);
 
 	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(buffer_end, Variant);
+		memnew_placement(buffer_end, Variant(*p_args[i]));
 		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_end_message(room_needed, staging);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	ThreadStaging *staging = nullptr;
+	uint8_t *buffer_end = _begin_message(room_needed, staging);
+	if (unlikely(!buffer_end)) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -166,35 +374,25 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 	buffer_end += sizeof(Message);
 
-	Variant *v = memnew_placement(buffer_end, Variant);
-	*v = p_value;
+	memnew_placement(buffer_end, Variant(p_value));
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_end_message(room_needed, staging);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	ThreadStaging *staging = nullptr;
+	uint8_t *buffer_end = _begin_message(room_needed, staging);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -202,15 +400,17 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_end_message(room_needed, staging);
 
 	return OK;
 }
 
 void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error) {
 	const Variant **argptrs = nullptr;
-	if (p_argcount) {
+	const Variant *single_argptr = p_args;
+	if (p_argcount == 1) {
+		argptrs = &single_argptr;
+	} else if (p_argcount) {
 		argptrs = (const Variant **)alloca(sizeof(Variant *) * p_argcount);
 		for (int i = 0; i < p_argcount; i++) {
 			argptrs[i] = &p_args[i];
@@ -228,6 +428,10 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
+	if (thread_staging && !flushing) {
+		_splice_thread_stagings();
+	}
+
 	if (pages.size() == 0) {
 		// Never allocated
 		UNLOCK_MUTEX;
@@ -244,7 +448,15 @@ Error CallQueue::flush() {
 	uint32_t i = 0;
 	uint32_t offset = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
+	while (true) {
+		if (i >= pages_used || offset >= page_bytes[i]) {
+			// Messages pushed by other threads, or by the calls themselves, while flushing.
+			if (thread_staging && _splice_thread_stagings() && i < pages_used && offset < page_bytes[i]) {
+				continue;
+			}
+			break;
+		}
+
 		Page *page = pages[i];
 
 		//lock on each iteration, so a call can re-add itself to the message queue
@@ -299,6 +511,7 @@ Error CallQueue::flush() {
 		}
 	}
 
+	used_pages.sub(pages_used - 1);
 	page_bytes[0] = 0;
 	pages_used = 1;
 
@@ -310,42 +523,56 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
-	if (pages.size() == 0) {
+	if (pages.size() == 0 && thread_stagings.is_empty()) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
 	}
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+	_ensure_first_page();
 
-			//lock on each iteration, so a call can re-add itself to the message queue
+	for (uint32_t i = 0; i < pages_used; i++) {
+		_clear_messages(pages[i], page_bytes[i]);
+	}
 
-			Message *message = (Message *)&page->data[offset];
+	used_pages.sub(pages_used - 1);
+	pages_used = 1;
+	page_bytes[0] = 0;
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+	for (ThreadStaging *staging : thread_stagings) {
+		staging->lock.lock();
+		for (uint32_t i = 0; i < staging->pages_used; i++) {
+			_clear_messages(staging->pages[i], staging->page_bytes[i]);
+			staging->page_bytes[i] = 0;
+		}
+		used_pages.sub(staging->pages_used);
+		staging->pages_used = 0;
+		staging->lock.unlock();
+	}
 
-			offset += advance;
+	UNLOCK_MUTEX;
+}
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
+void CallQueue::_clear_messages(Page *p_page, uint32_t p_bytes) {
+	uint32_t offset = 0;
+	while (offset < p_bytes) {
+		Message *message = (Message *)&p_page->data[offset];
 
-			message->~Message();
+		uint32_t advance = sizeof(Message);
+		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			advance += sizeof(Variant) * message->args;
 		}
-	}
 
-	pages_used = 1;
-	page_bytes[0] = 0;
+		offset += advance;
 
-	UNLOCK_MUTEX;
+		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			Variant *args = (Variant *)(message + 1);
+			for (int k = 0; k < message->args; k++) {
+				args[k].~Variant();
+			}
+		}
+
+		message->~Message();
+	}
 }
 
 void CallQueue::statistics() {
@@ -448,6 +675,18 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
+	if (thread_staging) {
+		MutexLock lock(mutex);
+		for (const ThreadStaging *staging : thread_stagings) {
+			staging->lock.lock();
+			const bool staged = staging->pages_used > 1 || (staging->pages_used == 1 && staging->page_bytes[0] > 0);
+			staging->lock.unlock();
+			if (staged) {
+				return true;
+			}
+		}
+	}
+
 	if (pages_used == 0) {
 		return false;
 	}
@@ -458,6 +697,28 @@ bool CallQueue::has_messages() const {
 	return true;
 }
 
+void CallQueue::set_thread_staging_enabled(bool p_enabled) {
+	MutexLock lock(mutex);
+	if (thread_staging == p_enabled) {
+		return;
+	}
+
+	if (p_enabled) {
+		ERR_FAIL_COND_MSG(live_staging_generation.get() != 0, "Only one call queue can use thread staging at a time.");
+		staging_generation = last_staging_generation.increment();
+		live_staging_generation.set(staging_generation);
+	} else {
+		_splice_thread_stagings();
+		for (ThreadStaging *staging : thread_stagings) {
+			_free_thread_staging(staging);
+		}
+		thread_stagings.clear();
+		live_staging_generation.set(0);
+		staging_generation = 0;
+	}
+	thread_staging = p_enabled;
+}
+
 int CallQueue::get_max_buffer_usage() const {
 	return pages.size() * PAGE_SIZE_BYTES;
 }
@@ -476,6 +737,7 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 
 CallQueue::~CallQueue() {
 	clear();
+	set_thread_staging_enabled(false);
 	// Let go of pages.
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
@@ -488,6 +750,8 @@ CallQueue::~CallQueue() {
 
 //////////////////////
 
+thread_local CallQueue::ThreadStagingCache CallQueue::thread_staging_cache;
+
 CallQueue *MessageQueue::main_singleton = nullptr;
 thread_local CallQueue *MessageQueue::thread_singleton = nullptr;
 
@@ -511,6 +775,7 @@ MessageQueue::MessageQueue() :
 				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
+	set_thread_staging_enabled(true);
 }
 
 MessageQueue::~MessageQueue() {
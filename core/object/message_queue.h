@@ -34,6 +34,8 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object/object_id.h"
+#include "core/os/spin_lock.h"
+#include "core/os/thread.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
@@ -77,6 +79,7 @@ private:
 	LocalVector<uint32_t> page_bytes;
 	uint32_t max_pages = 0;
 	uint32_t pages_used = 0;
+	SafeNumeric<uint32_t> used_pages; // Pages holding messages, in the queue and in every thread staging.
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
@@ -90,18 +93,96 @@ private:
 			int16_t notification;
 			int16_t args;
 		};
+		uint32_t sequence = 0; // Push order, only used with thread staging. Fits in the padding.
 	};
 
+	// With thread staging, each thread, the main one included, pushes to pages of its own, locked
+	// only by itself and by the flushing thread when it splices them at the end of the queue. This
+	// keeps pushing threads from contending on the queue mutex. Every staged message is stamped with
+	// a sequence number, so splicing restores the order in which messages were pushed across threads.
+	struct ThreadStaging {
+		SpinLock lock;
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t pages_used = 0;
+		SafeFlag thread_exited;
+	};
+
+	struct ThreadStagingCache {
+		uint64_t generation = 0;
+		ThreadStaging *staging = nullptr;
+		~ThreadStagingCache();
+	};
+
+	static thread_local ThreadStagingCache thread_staging_cache;
+	static inline SafeNumeric<uint64_t> last_staging_generation{ 0 };
+	static inline SafeNumeric<uint64_t> live_staging_generation{ 0 }; // Only one queue can use thread staging at a time.
+
+	bool thread_staging = false;
+	uint64_t staging_generation = 0;
+	LocalVector<ThreadStaging *> thread_stagings; // Protected by the mutex.
+	LocalVector<ThreadStaging *> splice_sources; // Scratch space for splicing, protected by the mutex.
+	SafeNumeric<uint32_t> push_sequence;
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
 			page_bytes.push_back(0);
 			pages_used = 1;
+			used_pages.increment();
+		}
+	}
+
+	// Counts one more page as used, unless the queue and the thread stagings already use up the limit.
+	_FORCE_INLINE_ bool _reserve_page() {
+		if (unlikely(used_pages.increment() > max_pages)) {
+			used_pages.decrement();
+			return false;
+		}
+		return true;
+	}
+
+	_FORCE_INLINE_ static uint32_t _get_message_size(const Message *p_message) {
+		uint32_t size = sizeof(Message);
+		if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+			size += sizeof(Variant) * p_message->args;
 		}
+		return size;
 	}
 
 	void _add_page();
 
+	ThreadStaging *_get_thread_staging();
+	bool _splice_thread_stagings();
+	void _move_staged_pages(ThreadStaging *p_staging);
+	void _merge_staged_messages();
+	void _free_thread_staging(ThreadStaging *p_staging);
+	void _clear_messages(Page *p_page, uint32_t p_bytes);
+
+	// Returns where to write a message of the given size, or nullptr if out of memory.
+	// Must be followed by _end_message() if not null.
+	uint8_t *_begin_message(uint32_t p_room_needed, ThreadStaging *&r_staging);
+	void _end_message(uint32_t p_room_needed, ThreadStaging *p_staging);
+	void _write_call_message(uint8_t *p_buffer, const Callable &p_callable, int p_argcount, bool p_show_error);
+
+	template <typename T>
+	Error _push_callable_typed(const Callable &p_callable, const T &p_arg) {
+		// Builds the argument in place instead of boxing it into a temporary Variant to copy.
+		const uint32_t room_needed = sizeof(Message) + sizeof(Variant);
+		ThreadStaging *staging = nullptr;
+		uint8_t *buffer = _begin_message(room_needed, staging);
+		if (unlikely(!buffer)) {
+			_print_call_out_of_memory(p_callable);
+			return ERR_OUT_OF_MEMORY;
+		}
+		_write_call_message(buffer, p_callable, 1, false);
+		memnew_placement(buffer + sizeof(Message), Variant(p_arg));
+		_end_message(room_needed, staging);
+		return OK;
+	}
+
+	void _print_call_out_of_memory(const Callable &p_callable);
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
 	String error_text;
@@ -118,6 +199,15 @@ public:
 		return push_callp(p_id, p_method, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
 	}
 
+	// Fast paths for zero and one arguments, which don't need to build a temporary array of Variants.
+	Error push_call(ObjectID p_id, const StringName &p_method) {
+		return push_callablep(Callable(p_id, p_method), nullptr, 0);
+	}
+	template <typename T>
+	Error push_call(ObjectID p_id, const StringName &p_method, const T &p_arg) {
+		return _push_callable_typed(Callable(p_id, p_method), p_arg);
+	}
+
 	Error push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error = false);
 	Error push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value);
 	Error push_notification(ObjectID p_id, int p_notification);
@@ -131,6 +221,13 @@ public:
 		}
 		return push_callablep(p_callable, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
 	}
+	Error push_callable(const Callable &p_callable) {
+		return push_callablep(p_callable, nullptr, 0);
+	}
+	template <typename T>
+	Error push_callable(const Callable &p_callable, const T &p_arg) {
+		return _push_callable_typed(p_callable, p_arg);
+	}
 
 	Error push_callp(Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error = false);
 	template <typename... VarArgs>
@@ -142,6 +239,11 @@ public:
 		}
 		return push_callp(p_object, p_method, sizeof...(p_args) == 0 ? nullptr : (const Variant **)argptrs, sizeof...(p_args));
 	}
+	Error push_call(Object *p_object, const StringName &p_method);
+	template <typename T>
+	Error push_call(Object *p_object, const StringName &p_method, const T &p_arg) {
+		return _push_callable_typed(Callable(p_object, p_method), p_arg);
+	}
 
 	Error push_notification(Object *p_object, int p_notification);
 	Error push_set(Object *p_object, const StringName &p_prop, const Variant &p_value);
@@ -155,6 +257,9 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	// Must be enabled before any message is pushed.
+	void set_thread_staging_enabled(bool p_enabled);
+
 	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
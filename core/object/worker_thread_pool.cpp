@@ -117,22 +117,21 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
 		}
 
+		task_mutex.lock();
+
 		if (do_post) {
-			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
+			_complete_group(p_task->group);
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
 
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
-			MutexLock task_lock(task_mutex);
 			group_allocator.free(p_task->group);
 		}
 
 		// For groups, tasks get rid of themselves.
 
-		task_mutex.lock();
 		task_allocator.free(p_task);
 	} else {
 		if (p_task->native_func) {
@@ -147,6 +146,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		task_mutex.lock();
 		p_task->completed = true;
 		p_task->pool_thread_index = -1;
+		if (unlikely(!p_task->dependents.is_empty())) {
+			_release_dependents(p_task->dependents);
+		}
 		if (p_task->waiting_user) {
 			p_task->done_semaphore.post(p_task->waiting_user);
 		}
@@ -184,8 +186,8 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		Task *task_to_process = singleton->_pop_queued_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 
 			bool exit = singleton->_handle_runlevel(thread_data, lock);
@@ -199,7 +201,15 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
+				// Tasks pushed lock-free are followed by a notification under the mutex
+				// whenever a thread has announced it's going to wait, so checking again now can't miss any.
+				singleton->num_waiting_threads.increment();
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				task_to_process = singleton->_pop_queued_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+				}
+				singleton->num_waiting_threads.decrement();
 			}
 		}
 
@@ -209,6 +219,7 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	}
 }
 
+// Leaves p_lock unlocked.
 void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
@@ -219,7 +230,6 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 		for (uint32_t i = 0; i < p_count; i++) {
 			_process_task(p_tasks[i]);
 		}
-		p_lock.temp_relock();
 		return;
 	}
 
@@ -227,15 +237,50 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 		control_cond_var.wait(p_lock);
 	}
 
+	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
+
+	if (!caller_pool_thread || !p_high_priority) {
+		// Low priority bookkeeping and the injection queue, which has many producers, need the mutex.
+		_enqueue_tasks(p_tasks, p_count, p_high_priority, caller_pool_thread);
+		p_lock.temp_unlock();
+		return;
+	}
+
+	// The caller owns its work queue, so it can push without holding the mutex.
+	p_lock.temp_unlock();
+
+	uint32_t overflow_from = p_count;
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_tasks[i]->low_priority = false;
+		if (unlikely(!caller_pool_thread->work_queue.push(p_tasks[i]))) {
+			overflow_from = i;
+			break;
+		}
+	}
+
+	// Pairs with the fence in the waiting paths: either the waiter sees the pushed tasks
+	// when checking again, or this thread sees the waiter and notifies it under the mutex.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (overflow_from == p_count && num_waiting_threads.get() == 0) {
+		return;
+	}
+
+	p_lock.temp_relock();
+	for (uint32_t i = overflow_from; i < p_count; i++) {
+		task_queue.add_last(&p_tasks[i]->task_elem);
+	}
+	_notify_threads(caller_pool_thread, p_count, 0);
+	p_lock.temp_unlock();
+}
+
+void WorkerThreadPool::_enqueue_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, ThreadData *p_caller_pool_thread) {
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
-	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			_queue_task(p_caller_pool_thread, p_tasks[i]);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -247,7 +292,7 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 		}
 	}
 
-	_notify_threads(caller_pool_thread, to_process, to_promote);
+	_notify_threads(p_caller_pool_thread, to_process, to_promote);
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -314,6 +359,43 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+void WorkerThreadPool::_queue_task(ThreadData *p_caller_pool_thread, Task *p_task) {
+	bool queued = p_caller_pool_thread ? p_caller_pool_thread->work_queue.push(p_task) : injection_queue.push(p_task);
+	if (unlikely(!queued)) {
+		task_queue.add_last(&p_task->task_elem);
+	}
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_queued_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->work_queue.pop(task)) {
+		return task;
+	}
+	if (injection_queue.steal(task)) {
+		return task;
+	}
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (victim.work_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_queued_tasks() const {
+	if (task_queue.first() || !injection_queue.is_empty()) {
+		return true;
+	}
+	for (const ThreadData &th : threads) {
+		if (!th.work_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -330,7 +412,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	// Get a free task
@@ -344,6 +426,15 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->template_userdata = p_template_userdata;
 	tasks.insert(id, task);
 
+	if (!p_dependencies.is_empty()) {
+		task->pending_dependencies = _add_dependencies(id, p_dependencies, task, nullptr);
+		if (task->pending_dependencies) {
+			// Will be posted by the last dependency to complete.
+			task->low_priority = !p_high_priority;
+			return id;
+		}
+	}
+
 	_post_tasks(&task, 1, p_high_priority, lock);
 
 	return id;
@@ -353,6 +444,108 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_dependent_native_task(void (*p_func)(void *), void *p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_dependent_task(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+// Registers the task or group as a dependent of every dependency not completed yet, and returns how many those are.
+uint32_t WorkerThreadPool::_add_dependencies(TaskID p_id, const Vector<TaskID> &p_dependencies, Task *p_task, Group *p_group) {
+	uint32_t pending = 0;
+	for (TaskID dependency_id : p_dependencies) {
+		ERR_CONTINUE_MSG(dependency_id == p_id, "A task can't depend on itself.");
+
+		DependentList *dependents = nullptr;
+		if (Task **taskp = tasks.getptr(dependency_id)) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else if (Group **groupp = groups.getptr(dependency_id)) {
+			if (!(*groupp)->completed.is_set()) {
+				dependents = &(*groupp)->dependents;
+			}
+		} else {
+			// IDs that were valid once belong to tasks or groups already completed and waited for.
+			ERR_CONTINUE_MSG(dependency_id <= 0 || dependency_id >= (TaskID)last_task, vformat("Invalid task or group ID as dependency: %d.", dependency_id));
+		}
+
+		if (dependents) {
+			if (p_task) {
+				dependents->tasks.push_back(p_task);
+			} else {
+				dependents->groups.push_back(p_group);
+			}
+			pending++;
+		}
+	}
+	return pending;
+}
+
+// Must be called with task_mutex locked.
+void WorkerThreadPool::_release_dependents(DependentList &p_dependents) {
+	ThreadData *caller_pool_thread = nullptr;
+	if (const int *thread_index = thread_ids.getptr(Thread::get_caller_id())) {
+		caller_pool_thread = &threads[*thread_index];
+	}
+
+	// Same fallback as in _post_tasks(): without worker threads, released tasks run on the calling thread.
+	bool process_on_calling_thread = threads.size() == 0;
+	LocalVector<Task *> to_process;
+
+	for (Task *task : p_dependents.tasks) {
+		task->pending_dependencies--;
+		if (task->pending_dependencies == 0) {
+			if (process_on_calling_thread) {
+				to_process.push_back(task);
+			} else {
+				_enqueue_tasks(&task, 1, !task->low_priority, caller_pool_thread);
+			}
+		}
+	}
+
+	for (Group *group : p_dependents.groups) {
+		group->pending_dependencies--;
+		if (group->pending_dependencies == 0) {
+			if (group->held_tasks.is_empty()) {
+				// Group with no elements, done as soon as it's released.
+				_complete_group(group);
+			} else {
+				if (process_on_calling_thread) {
+					for (Task *task : group->held_tasks) {
+						to_process.push_back(task);
+					}
+				} else {
+					_enqueue_tasks(group->held_tasks.ptr(), group->held_tasks.size(), !group->held_tasks[0]->low_priority, caller_pool_thread);
+				}
+				group->held_tasks.clear();
+			}
+		}
+	}
+
+	p_dependents.tasks.clear();
+	p_dependents.groups.clear();
+
+	if (!to_process.is_empty()) {
+		task_mutex.unlock();
+		for (Task *task : to_process) {
+			_process_task(task);
+		}
+		task_mutex.lock();
+	}
+}
+
+// Must be called with task_mutex locked.
+void WorkerThreadPool::_complete_group(Group *p_group) {
+	p_group->completed.set_to(true);
+	if (unlikely(!p_group->dependents.is_empty())) {
+		_release_dependents(p_group->dependents);
+	}
+	p_group->done_semaphore.post();
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	MutexLock task_lock(task_mutex);
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -481,7 +674,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = _has_queued_tasks() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -499,20 +692,25 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (singleton->task_queue.first()) {
+			if (task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
-			}
+			} else {
+				num_waiting_threads.increment();
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				task_to_process = _pop_queued_task(p_caller_pool_thread);
 
-			if (!task_to_process) {
-				p_caller_pool_thread->awaited_task = p_task;
+				if (!task_to_process) {
+					p_caller_pool_thread->awaited_task = p_task;
 
-				_unlock_unlockable_mutexes();
-				relock_unlockables = true;
+					_unlock_unlockable_mutexes();
+					relock_unlockables = true;
 
-				p_caller_pool_thread->cond_var.wait(lock);
+					p_caller_pool_thread->cond_var.wait(lock);
 
-				p_caller_pool_thread->awaited_task = nullptr;
+					p_caller_pool_thread->awaited_task = nullptr;
+				}
+				num_waiting_threads.decrement();
 			}
 		}
 
@@ -545,7 +743,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!_has_queued_tasks() && !low_priority_task_queue.first()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -608,7 +806,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	td.cond_var.notify_one();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -621,11 +819,16 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	group->max = p_elements;
 	group->self = id;
 
+	if (!p_dependencies.is_empty()) {
+		group->pending_dependencies = _add_dependencies(id, p_dependencies, nullptr, group);
+	}
+
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
 		// Should really not call it with zero Elements, but at least it should work.
-		group->completed.set_to(true);
-		group->done_semaphore.post();
+		if (group->pending_dependencies == 0) {
+			_complete_group(group);
+		}
 		group->tasks_used = 0;
 		p_tasks = 0;
 		if (p_template_userdata) {
@@ -650,6 +853,15 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (group->pending_dependencies) {
+		// Will be posted by the last dependency to complete.
+		for (int i = 0; i < p_tasks; i++) {
+			tasks_posted[i]->low_priority = !p_high_priority;
+			group->held_tasks.push_back(tasks_posted[i]);
+		}
+		return id;
+	}
+
 	_post_tasks(tasks_posted, p_tasks, p_high_priority, lock);
 
 	return id;
@@ -663,6 +875,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_dependent_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_dependent_group_task(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	MutexLock task_lock(task_mutex);
 	const Group *const *groupp = groups.getptr(p_group);
@@ -696,6 +916,12 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 		group->done_semaphore.wait();
 		_lock_unlockable_mutexes();
 
+		{
+			// Unregister before the group may be freed, so it can't be found anymore when adding dependencies.
+			MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
+			groups.erase(p_group);
+		}
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -705,9 +931,6 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			group_allocator.free(group);
 		}
 	}
-
-	MutexLock task_lock(task_mutex); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
 #endif
 }
 
@@ -828,7 +1051,10 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
 
+	ClassDB::bind_method(D_METHOD("add_dependent_task", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_dependent_task, DEFVAL(false), DEFVAL(String()));
+
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("add_dependent_group_task", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_dependent_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
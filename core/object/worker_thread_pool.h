@@ -42,6 +42,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -55,6 +56,15 @@ public:
 
 private:
 	struct Task;
+	struct Group;
+
+	// Tasks and groups waiting for a task or group to complete before being posted.
+	struct DependentList {
+		LocalVector<Task *> tasks;
+		LocalVector<Group *> groups;
+
+		_FORCE_INLINE_ bool is_empty() const { return tasks.is_empty() && groups.is_empty(); }
+	};
 
 	struct BaseTemplateUserdata {
 		virtual void callback() {}
@@ -71,6 +81,9 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		uint32_t pending_dependencies = 0;
+		LocalVector<Task *> held_tasks; // Tasks to post once there are no pending dependencies.
+		DependentList dependents;
 	};
 
 	struct Task {
@@ -90,6 +103,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0;
+		DependentList dependents;
 
 		void free_template_userdata();
 		Task() :
@@ -100,12 +115,26 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t WORK_QUEUE_SIZE = 1024;
+	static const uint32_t INJECTION_QUEUE_SIZE = 4096;
+
+	typedef WorkStealingDeque<Task *, WORK_QUEUE_SIZE> WorkQueue;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
+	SelfList<Task>::List task_queue; // Promoted low priority tasks and overflow of the lock-free queues.
+
+	// Tasks posted from outside the pool go to the injection queue, where all the
+	// pool threads take them from in FIFO order. Tasks posted from a pool thread go to
+	// its own work queue, which the owner takes from in LIFO order and other threads
+	// steal from in FIFO order. Tasks are taken lock-free. High priority tasks posted
+	// by a pool thread are also pushed lock-free; everything else is queued with task_mutex held.
+	WorkStealingDeque<Task *, INJECTION_QUEUE_SIZE> injection_queue;
+	// Threads about to wait on their condition variable. A lock-free push only takes
+	// task_mutex to notify if there are any.
+	SafeNumeric<uint32_t> num_waiting_threads;
 
 	BinaryMutex task_mutex;
 
@@ -121,6 +150,7 @@ private:
 		Task *current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
+		WorkQueue work_queue;
 
 		ThreadData() :
 				signaled(false),
@@ -172,7 +202,12 @@ private:
 
 	void _process_task(Task *task);
 
+	void _queue_task(ThreadData *p_caller_pool_thread, Task *p_task);
+	Task *_pop_queued_task(ThreadData *p_thread_data);
+	bool _has_queued_tasks() const;
+
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
+	void _enqueue_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, ThreadData *p_caller_pool_thread);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
@@ -188,8 +223,12 @@ private:
 	static thread_local UnlockableLocks unlockable_locks[MAX_UNLOCKABLE_LOCKS];
 #endif
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	uint32_t _add_dependencies(TaskID p_id, const Vector<TaskID> &p_dependencies, Task *p_task, Group *p_group);
+	void _release_dependents(DependentList &p_dependents);
+	void _complete_group(Group *p_group);
+
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies = Vector<TaskID>());
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -239,6 +278,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// Dependent tasks are posted automatically once all the tasks and groups whose IDs are
+	// given as dependencies are completed. This allows building a graph of tasks upfront.
+	template <typename C, typename M, typename U>
+	TaskID add_dependent_template_task(C *p_instance, M p_method, U p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies);
+	}
+	TaskID add_dependent_native_task(void (*p_func)(void *), void *p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+	TaskID add_dependent_task(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -256,6 +309,8 @@ public:
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_dependent_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	GroupID add_dependent_group_task(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
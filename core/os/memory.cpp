@@ -33,8 +33,13 @@
 #include "memory.h"
 
 #include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
 #include "core/templates/safe_refcount.h"
 
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+#include "core/os/thread_cache_allocator.h"
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -62,11 +67,118 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #endif
 
 #ifdef DEBUG_ENABLED
-SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
 #endif
 
-SafeNumeric<uint64_t> Memory::alloc_count;
+// Allocation statistics are kept per thread and only summed when queried, so
+// allocating never writes to a cache line shared with other threads.
+struct MemoryThreadStats {
+	// Only written by the owning thread; may go negative when the thread frees
+	// memory allocated by another one.
+	std::atomic<int64_t> usage;
+	std::atomic<int64_t> count;
+	// Usage when the global peak was last sampled from this thread.
+	int64_t sampled_usage;
+	MemoryThreadStats *prev;
+	MemoryThreadStats *next;
+	bool registered;
+	bool retired;
+};
+
+// Trivially constructible and destructible, so it is usable at any point of the
+// thread lifetime, including from the destructors of other thread locals.
+static thread_local MemoryThreadStats thread_stats;
+
+static SpinLock thread_stats_lock;
+static MemoryThreadStats *thread_stats_list = nullptr;
+// Totals of exited threads, plus whatever they allocate or free while exiting.
+static SafeNumeric<int64_t> retired_usage;
+static SafeNumeric<int64_t> retired_count;
+
+struct MemoryThreadStatsReleaser {
+	~MemoryThreadStatsReleaser() {
+		thread_stats_lock.lock();
+		if (thread_stats.prev) {
+			thread_stats.prev->next = thread_stats.next;
+		} else {
+			thread_stats_list = thread_stats.next;
+		}
+		if (thread_stats.next) {
+			thread_stats.next->prev = thread_stats.prev;
+		}
+		retired_usage.add(thread_stats.usage.load(std::memory_order_relaxed));
+		retired_count.add(thread_stats.count.load(std::memory_order_relaxed));
+		thread_stats.retired = true;
+		thread_stats_lock.unlock();
+	}
+};
+
+static thread_local MemoryThreadStatsReleaser thread_stats_releaser;
+
+static void _register_thread_stats() {
+	thread_stats.registered = true;
+	// First use of the releaser in this thread registers its destructor.
+	(void)&thread_stats_releaser;
+
+	thread_stats_lock.lock();
+	thread_stats.prev = nullptr;
+	thread_stats.next = thread_stats_list;
+	if (thread_stats_list) {
+		thread_stats_list->prev = &thread_stats;
+	}
+	thread_stats_list = &thread_stats;
+	thread_stats_lock.unlock();
+}
+
+static void _sum_thread_stats(int64_t &r_usage, int64_t &r_count) {
+	thread_stats_lock.lock();
+	r_usage = retired_usage.get();
+	r_count = retired_count.get();
+	for (const MemoryThreadStats *stats = thread_stats_list; stats; stats = stats->next) {
+		r_usage += stats->usage.load(std::memory_order_relaxed);
+		r_count += stats->count.load(std::memory_order_relaxed);
+	}
+	thread_stats_lock.unlock();
+}
+
+#ifdef DEBUG_ENABLED
+// A thread samples the global peak each time its own usage grows by this much,
+// which bounds the peak error to this step times the number of threads.
+static constexpr int64_t PEAK_SAMPLE_STEP = 256 * 1024;
+#endif
+
+static _FORCE_INLINE_ void _record_allocation(int64_t p_bytes, int64_t p_count) {
+	MemoryThreadStats &stats = thread_stats;
+	if (unlikely(!stats.registered)) {
+		_register_thread_stats();
+	}
+	if (unlikely(stats.retired)) {
+		retired_usage.add(p_bytes);
+		retired_count.add(p_count);
+		return;
+	}
+	int64_t usage = stats.usage.load(std::memory_order_relaxed) + p_bytes;
+	stats.usage.store(usage, std::memory_order_relaxed);
+	stats.count.store(stats.count.load(std::memory_order_relaxed) + p_count, std::memory_order_relaxed);
+
+#ifdef DEBUG_ENABLED
+	if (usage < stats.sampled_usage) {
+		stats.sampled_usage = usage;
+	} else if (unlikely(usage - stats.sampled_usage > PEAK_SAMPLE_STEP)) {
+		stats.sampled_usage = usage;
+		Memory::get_mem_usage(); // Updates the peak.
+	}
+#endif
+}
+
+// In the allocation header, the top byte of the stored size holds the size class
+// of blocks coming from the thread cache allocator, or 0 for malloc() blocks.
+static constexpr uint64_t SIZE_CLASS_SHIFT = 56;
+static constexpr uint64_t SIZE_MASK = (uint64_t(1) << SIZE_CLASS_SHIFT) - 1;
+
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+static std::atomic<bool> thread_cache_allocator_enabled{ true };
+#endif
 
 inline bool is_power_of_2(size_t x) { return x && ((x & (x - 1U)) == 0U); }
 
@@ -101,30 +213,40 @@ void Memory::free_aligned_static(void *p_memory) {
 }
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(THREAD_CACHE_ALLOCATOR_ENABLED)
+	// The thread cache allocator needs the header to know where blocks go back to.
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+	uint32_t size_class = thread_cache_allocator_enabled.load(std::memory_order_relaxed) ? ThreadCacheAllocator::get_size_class(p_bytes + DATA_OFFSET) : 0;
+	void *mem = size_class ? ThreadCacheAllocator::alloc(size_class) : malloc(p_bytes + DATA_OFFSET);
+#else
 	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
+#endif
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
-	alloc_count.increment();
-
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+		*s = p_bytes | ((uint64_t)size_class << SIZE_CLASS_SHIFT);
+#else
 		*s = p_bytes;
+#endif
 
 #ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = mem_usage.add(p_bytes);
-		max_usage.exchange_if_greater(new_mem_usage);
+		_record_allocation(p_bytes, 1);
+#else
+		_record_allocation(0, 1);
 #endif
 		return s8 + DATA_OFFSET;
 	} else {
+		_record_allocation(0, 1);
 		return mem;
 	}
 }
@@ -136,7 +258,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(THREAD_CACHE_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -145,13 +267,39 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+		uint64_t prev_bytes = *s & SIZE_MASK;
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
-			max_usage.exchange_if_greater(new_mem_usage);
-		} else {
-			mem_usage.sub(*s - p_bytes);
+		_record_allocation((int64_t)p_bytes - (int64_t)prev_bytes, p_bytes == 0 ? -1 : 0);
+#else
+		if (p_bytes == 0) {
+			_record_allocation(0, -1);
+		}
+#endif
+
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+		uint32_t size_class = *s >> SIZE_CLASS_SHIFT;
+		if (size_class != 0) {
+			if (p_bytes == 0) {
+				ThreadCacheAllocator::free(mem, size_class);
+				return nullptr;
+			}
+
+			uint32_t new_size_class = thread_cache_allocator_enabled.load(std::memory_order_relaxed) ? ThreadCacheAllocator::get_size_class(p_bytes + DATA_OFFSET) : 0;
+			if (new_size_class == size_class) {
+				*s = p_bytes | ((uint64_t)size_class << SIZE_CLASS_SHIFT);
+				return mem + DATA_OFFSET;
+			}
+
+			uint8_t *new_mem = (uint8_t *)(new_size_class ? ThreadCacheAllocator::alloc(new_size_class) : malloc(p_bytes + DATA_OFFSET));
+			ERR_FAIL_NULL_V(new_mem, nullptr);
+
+			// Copy the whole header too, callers may keep data in the element count.
+			memcpy(new_mem, mem, DATA_OFFSET + MIN(prev_bytes, (uint64_t)p_bytes));
+			*(uint64_t *)(new_mem + SIZE_OFFSET) = p_bytes | ((uint64_t)new_size_class << SIZE_CLASS_SHIFT);
+
+			ThreadCacheAllocator::free(mem, size_class);
+			return new_mem + DATA_OFFSET;
 		}
 #endif
 
@@ -184,24 +332,33 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(THREAD_CACHE_ALLOCATOR_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
 
-	alloc_count.decrement();
-
 	if (prepad) {
 		mem -= DATA_OFFSET;
+		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
 #ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		mem_usage.sub(*s);
+		_record_allocation(-(int64_t)(*s & SIZE_MASK), -1);
+#else
+		_record_allocation(0, -1);
+#endif
+
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+		uint32_t size_class = *s >> SIZE_CLASS_SHIFT;
+		if (size_class != 0) {
+			ThreadCacheAllocator::free(mem, size_class);
+			return;
+		}
 #endif
 
 		free(mem);
 	} else {
+		_record_allocation(0, -1);
 		free(mem);
 	}
 }
@@ -212,7 +369,11 @@ uint64_t Memory::get_mem_available() {
 
 uint64_t Memory::get_mem_usage() {
 #ifdef DEBUG_ENABLED
-	return mem_usage.get();
+	int64_t usage;
+	int64_t count;
+	_sum_thread_stats(usage, count);
+	max_usage.exchange_if_greater(usage);
+	return usage;
 #else
 	return 0;
 #endif
@@ -220,12 +381,27 @@ uint64_t Memory::get_mem_usage() {
 
 uint64_t Memory::get_mem_max_usage() {
 #ifdef DEBUG_ENABLED
+	get_mem_usage();
 	return max_usage.get();
 #else
 	return 0;
 #endif
 }
 
+void Memory::set_thread_cache_allocator_enabled(bool p_enabled) {
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+	thread_cache_allocator_enabled.store(p_enabled, std::memory_order_relaxed);
+#endif
+}
+
+bool Memory::is_thread_cache_allocator_enabled() {
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+	return thread_cache_allocator_enabled.load(std::memory_order_relaxed);
+#else
+	return false;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -42,12 +42,11 @@
 
 class Memory {
 #ifdef DEBUG_ENABLED
-	static SafeNumeric<uint64_t> mem_usage;
+	// Current usage is tracked per thread and only summed on demand, so the peak
+	// is sampled whenever the usage is queried.
 	static SafeNumeric<uint64_t> max_usage;
 #endif
 
-	static SafeNumeric<uint64_t> alloc_count;
-
 public:
 	// Alignment:  ↓ max_align_t        ↓ uint64_t          ↓ max_align_t
 	//             ┌─────────────────┬──┬────────────────┬──┬───────────...
@@ -91,6 +90,11 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+	// Only has an effect in builds with `thread_cache_allocator=yes`. Can be toggled
+	// at any time; blocks are always released to the allocator they came from.
+	static void set_thread_cache_allocator_enabled(bool p_enabled);
+	static bool is_thread_cache_allocator_enabled();
 };
 
 class DefaultAllocator {
@@ -0,0 +1,230 @@
+/**************************************************************************/
+/*  thread_cache_allocator.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "thread_cache_allocator.h"
+
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+
+#include "core/error/error_macros.h"
+#include "core/os/spin_lock.h"
+
+#include <stdlib.h>
+
+namespace {
+
+struct FreeBlock {
+	FreeBlock *next; // Next block in the same thread list or batch.
+	FreeBlock *next_batch; // Only used by the first block of a batch in a central list.
+};
+
+static_assert(sizeof(FreeBlock) <= 16, "The smallest size class must be able to hold a FreeBlock.");
+
+constexpr size_t class_sizes[ThreadCacheAllocator::SIZE_CLASS_COUNT + 1] = {
+	0,
+	16, 32, 48, 64, 80, 96, 112, 128,
+	160, 192, 224, 256,
+	320, 384, 448, 512,
+	640, 768, 896, 1024
+};
+
+struct CentralList {
+	SpinLock lock;
+	FreeBlock *batches = nullptr;
+};
+
+CentralList central_lists[ThreadCacheAllocator::SIZE_CLASS_COUNT + 1];
+
+// Trivially constructible and destructible, so it is usable at any point of the
+// thread lifetime, including from the destructors of other thread locals.
+struct ThreadCache {
+	FreeBlock *lists[ThreadCacheAllocator::SIZE_CLASS_COUNT + 1];
+	uint32_t counts[ThreadCacheAllocator::SIZE_CLASS_COUNT + 1];
+	bool releaser_armed;
+	bool exited;
+};
+
+thread_local ThreadCache thread_cache;
+
+struct ThreadCacheReleaser {
+	~ThreadCacheReleaser() {
+		ThreadCacheAllocator::flush_thread_cache();
+		// Blocks freed after this point go straight to the central lists.
+		thread_cache.exited = true;
+	}
+};
+
+thread_local ThreadCacheReleaser thread_cache_releaser;
+
+void push_batch(uint32_t p_class, FreeBlock *p_first) {
+	CentralList &central = central_lists[p_class];
+	central.lock.lock();
+	p_first->next_batch = central.batches;
+	central.batches = p_first;
+	central.lock.unlock();
+}
+
+FreeBlock *pop_batch(uint32_t p_class) {
+	CentralList &central = central_lists[p_class];
+	central.lock.lock();
+	FreeBlock *first = central.batches;
+	if (first) {
+		central.batches = first->next_batch;
+	}
+	central.lock.unlock();
+	return first;
+}
+
+FreeBlock *carve_span(uint32_t p_class) {
+	const size_t block_size = class_sizes[p_class];
+	uint8_t *span = (uint8_t *)malloc(ThreadCacheAllocator::SPAN_SIZE);
+	if (!span) {
+		return nullptr;
+	}
+
+	const size_t block_count = ThreadCacheAllocator::SPAN_SIZE / block_size;
+	for (size_t i = 0; i < block_count; i++) {
+		FreeBlock *block = (FreeBlock *)(span + i * block_size);
+		block->next = (i + 1 < block_count) ? (FreeBlock *)(span + (i + 1) * block_size) : nullptr;
+	}
+	return (FreeBlock *)span;
+}
+
+void arm_releaser(ThreadCache &p_cache) {
+	// First use of the releaser in this thread registers its destructor.
+	(void)&thread_cache_releaser;
+	p_cache.releaser_armed = true;
+}
+
+FreeBlock *refill(ThreadCache &p_cache, uint32_t p_class) {
+	if (unlikely(!p_cache.releaser_armed)) {
+		arm_releaser(p_cache);
+	}
+
+	FreeBlock *first = pop_batch(p_class);
+	if (!first) {
+		first = carve_span(p_class);
+		if (!first) {
+			return nullptr;
+		}
+	}
+
+	if (unlikely(p_cache.exited)) {
+		// Don't leave blocks in the cache of a thread that is going away.
+		if (first->next) {
+			push_batch(p_class, first->next);
+		}
+		first->next = nullptr;
+		p_cache.lists[p_class] = first;
+		p_cache.counts[p_class] = 1;
+		return first;
+	}
+
+	uint32_t count = 0;
+	for (FreeBlock *block = first; block; block = block->next) {
+		count++;
+	}
+	p_cache.lists[p_class] = first;
+	p_cache.counts[p_class] = count;
+	return first;
+}
+
+void release_batch(ThreadCache &p_cache, uint32_t p_class) {
+	FreeBlock *first = p_cache.lists[p_class];
+	FreeBlock *last = first;
+	for (uint32_t i = 1; i < ThreadCacheAllocator::TRANSFER_BATCH; i++) {
+		last = last->next;
+	}
+	p_cache.lists[p_class] = last->next;
+	p_cache.counts[p_class] -= ThreadCacheAllocator::TRANSFER_BATCH;
+	last->next = nullptr;
+	push_batch(p_class, first);
+}
+
+} // namespace
+
+size_t ThreadCacheAllocator::get_class_size(uint32_t p_class) {
+	DEV_ASSERT(p_class <= SIZE_CLASS_COUNT);
+	return class_sizes[p_class];
+}
+
+void *ThreadCacheAllocator::alloc(uint32_t p_class) {
+	DEV_ASSERT(p_class > 0 && p_class <= SIZE_CLASS_COUNT);
+
+	ThreadCache &cache = thread_cache;
+	FreeBlock *block = cache.lists[p_class];
+	if (unlikely(!block)) {
+		block = refill(cache, p_class);
+		if (!block) {
+			return nullptr;
+		}
+	}
+
+	cache.lists[p_class] = block->next;
+	cache.counts[p_class]--;
+	return block;
+}
+
+void ThreadCacheAllocator::free(void *p_block, uint32_t p_class) {
+	DEV_ASSERT(p_class > 0 && p_class <= SIZE_CLASS_COUNT);
+
+	ThreadCache &cache = thread_cache;
+	FreeBlock *block = (FreeBlock *)p_block;
+
+	if (unlikely(cache.exited)) {
+		block->next = nullptr;
+		push_batch(p_class, block);
+		return;
+	}
+
+	if (unlikely(!cache.releaser_armed)) {
+		arm_releaser(cache);
+	}
+
+	block->next = cache.lists[p_class];
+	cache.lists[p_class] = block;
+	if (unlikely(++cache.counts[p_class] > CACHE_HIGH_WATER)) {
+		release_batch(cache, p_class);
+	}
+}
+
+void ThreadCacheAllocator::flush_thread_cache() {
+	ThreadCache &cache = thread_cache;
+	for (uint32_t i = 1; i <= SIZE_CLASS_COUNT; i++) {
+		if (cache.lists[i]) {
+			push_batch(i, cache.lists[i]);
+			cache.lists[i] = nullptr;
+			cache.counts[i] = 0;
+		}
+	}
+}
+
+#endif // THREAD_CACHE_ALLOCATOR_ENABLED
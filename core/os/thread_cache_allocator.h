@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  thread_cache_allocator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef THREAD_CACHE_ALLOCATOR_H
+#define THREAD_CACHE_ALLOCATOR_H
+
+#include "core/typedefs.h"
+
+// Small-block allocator used by Memory::alloc_static() when the engine is built
+// with `thread_cache_allocator=yes`.
+//
+// Blocks are grouped in size classes. Each thread keeps a free list per class,
+// so the common alloc/free path touches no shared state at all. Free lists that
+// grow past a high-water mark, and the caches of exiting threads, are handed back
+// in batches to a central list per class, protected by a spin lock.
+//
+// Block memory is carved from spans obtained with malloc(). Spans are never
+// returned to the system; freed blocks are only recycled within their class.
+//
+// Size classes are numbered from 1. Class 0 means "too big, use malloc()".
+
+class ThreadCacheAllocator {
+public:
+	static constexpr uint32_t SIZE_CLASS_COUNT = 20;
+	static constexpr size_t MAX_BLOCK_SIZE = 1024;
+	static constexpr size_t SPAN_SIZE = 64 * 1024;
+
+	// Number of blocks moved between a thread cache and the central list at once.
+	static constexpr uint32_t TRANSFER_BATCH = 32;
+	// A thread cache holding more blocks than this for a class returns a batch.
+	static constexpr uint32_t CACHE_HIGH_WATER = TRANSFER_BATCH * 2;
+
+	_FORCE_INLINE_ static uint32_t get_size_class(size_t p_bytes) {
+		if (p_bytes == 0 || p_bytes > MAX_BLOCK_SIZE) {
+			return 0;
+		}
+		if (p_bytes <= 128) {
+			return (p_bytes + 15) >> 4; // 16-byte steps: classes 1-8.
+		}
+		if (p_bytes <= 256) {
+			return 8 + ((p_bytes - 128 + 31) >> 5); // 32-byte steps: classes 9-12.
+		}
+		if (p_bytes <= 512) {
+			return 12 + ((p_bytes - 256 + 63) >> 6); // 64-byte steps: classes 13-16.
+		}
+		return 16 + ((p_bytes - 512 + 127) >> 7); // 128-byte steps: classes 17-20.
+	}
+
+	static size_t get_class_size(uint32_t p_class);
+
+	// Returns a block of get_class_size(p_class) bytes, or nullptr if out of memory.
+	static void *alloc(uint32_t p_class);
+	// p_block must have been returned by alloc() with the same class, on any thread.
+	static void free(void *p_block, uint32_t p_class);
+
+	// Returns all blocks cached by the calling thread to the central lists.
+	// Done automatically when a thread exits.
+	static void flush_thread_cache();
+};
+
+#endif // THREAD_CACHE_ALLOCATOR_H
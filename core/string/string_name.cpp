@@ -72,11 +72,113 @@ StringName _scs_create(const char *p_chr, bool p_static) {
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+		_table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	configured = true;
 }
 
+namespace {
+// Releases the reader slot of a thread when it exits, so a later thread can reuse it.
+struct StringNameReaderSlotHolder {
+	std::atomic<bool> *in_use = nullptr;
+	~StringNameReaderSlotHolder() {
+		if (in_use) {
+			in_use->store(false, std::memory_order_release);
+		}
+	}
+};
+thread_local StringNameReaderSlotHolder reader_slot_holder;
+} // namespace
+
+StringName::ReaderSlot *StringName::_get_reader_slot() {
+	if (likely(thread_reader_slot)) {
+		return thread_reader_slot;
+	}
+	for (uint32_t i = 0; i < MAX_READER_SLOTS; i++) {
+		bool expected = false;
+		if (reader_slots[i].in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+			uint32_t used = reader_slots_used.load(std::memory_order_relaxed);
+			while (used < i + 1 && !reader_slots_used.compare_exchange_weak(used, i + 1, std::memory_order_acq_rel)) {
+			}
+			thread_reader_slot = &reader_slots[i];
+			reader_slot_holder.in_use = &reader_slots[i].in_use;
+			return thread_reader_slot;
+		}
+	}
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::_lookup_and_ref(uint32_t p_hash, uint32_t p_idx, const T &p_name) {
+	ReaderSlot *slot = _get_reader_slot();
+	if (unlikely(!slot)) {
+		// Out of reader slots, removals can't happen while the shard is locked.
+		MutexLock lock(_get_shard(p_idx).mutex);
+		_Data *data = _table[p_idx].load(std::memory_order_acquire);
+		while (data) {
+			if (data->hash == p_hash && data->operator==(p_name) && data->refcount.ref()) {
+				break;
+			}
+			data = data->next.load(std::memory_order_acquire);
+		}
+		return data;
+	}
+
+	// Only this thread writes to its slot, so announcing the read doesn't contend with other threads.
+	// The fence makes either the removal of an entry see this reader, or this reader unable
+	// to reach the removed entry anymore. See unref() and _free_retired().
+	slot->epoch.store(global_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	_Data *data = _table[p_idx].load(std::memory_order_acquire);
+	while (data) {
+		// Compare hash first. Entries whose refcount already dropped to zero are
+		// about to be removed, so keep looking in case a new one was added meanwhile.
+		if (data->hash == p_hash && data->operator==(p_name) && data->refcount.ref()) {
+			break;
+		}
+		data = data->next.load(std::memory_order_acquire);
+	}
+
+	slot->epoch.store(0, std::memory_order_release);
+	return data;
+}
+
+// Must be called with the shard of the entry locked.
+void StringName::_link(_Data *p_data) {
+	_Data *head = _table[p_data->idx].load(std::memory_order_relaxed);
+	p_data->next.store(head, std::memory_order_relaxed);
+	p_data->prev = nullptr;
+	if (head) {
+		head->prev = p_data;
+	}
+	_table[p_data->idx].store(p_data, std::memory_order_release);
+}
+
+// Must be called with the shard locked.
+void StringName::_free_retired(Shard &p_shard) {
+	// Entries retired at an epoch older than the one of every active reader can't be reached anymore.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	uint64_t oldest_reader = UINT64_MAX;
+	uint32_t slots_used = reader_slots_used.load(std::memory_order_acquire);
+	for (uint32_t i = 0; i < slots_used; i++) {
+		uint64_t epoch = reader_slots[i].epoch.load(std::memory_order_acquire);
+		if (epoch && epoch < oldest_reader) {
+			oldest_reader = epoch;
+		}
+	}
+
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < p_shard.retired.size(); i++) {
+		if (p_shard.retired[i].epoch < oldest_reader) {
+			memdelete(p_shard.retired[i].data);
+		} else {
+			p_shard.retired[kept++] = p_shard.retired[i];
+		}
+	}
+	p_shard.retired.resize(kept);
+}
+
 void StringName::cleanup() {
 	MutexLock lock(mutex);
 
@@ -84,10 +186,10 @@ void StringName::cleanup() {
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
+			_Data *d = _table[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -97,10 +199,10 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references.get()));
+			if (data[i]->debug_references.get() == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (data[i]->debug_references.get() < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -111,8 +213,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
+		while (_table[i].load(std::memory_order_relaxed)) {
+			_Data *d = _table[i].load(std::memory_order_relaxed);
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -123,10 +225,16 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_table[i].store(d->next.load(std::memory_order_relaxed), std::memory_order_relaxed);
 			memdelete(d);
 		}
 	}
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+		for (const RetiredData &retired : shards[i].retired) {
+			memdelete(retired.data);
+		}
+		shards[i].retired.reset();
+	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
@@ -137,7 +245,9 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+		// Once the refcount reaches zero it can't be referenced again, so only the removal needs the lock.
+		Shard &shard = _get_shard(_data->idx);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
@@ -146,19 +256,27 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_seq_cst);
 		} else {
-			if (_table[_data->idx] != _data) {
+			if (_table[_data->idx].load(std::memory_order_relaxed) != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			_table[_data->idx].store(next, std::memory_order_seq_cst);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		memdelete(_data);
+
+		// Lookups may still be traversing it, so it can't be freed right away.
+		// Readers that announced themselves after the epoch advances can't reach it anymore.
+		RetiredData retired;
+		retired.data = _data;
+		retired.epoch = global_epoch.fetch_add(1, std::memory_order_seq_cst);
+		shard.retired.push_back(retired);
+		_free_retired(shard);
 	}
 
 	_data = nullptr;
@@ -277,56 +395,48 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_data = _table[idx];
+	_data = _lookup_and_ref(hash, idx, p_name);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	if (!_data) {
+		MutexLock lock(_get_shard(idx).mutex);
+
+		// Search again, it may have been added while not locked.
+		_data = _lookup_and_ref(hash, idx, p_name);
+
+		if (!_data) {
+			_data = memnew(_Data);
+			_data->name = p_name;
+			_data->refcount.init();
+			_data->static_count.set(p_static ? 1 : 0);
+			_data->hash = hash;
+			_data->idx = idx;
+			_data->cname = nullptr;
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
 #ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				_data->refcount.ref();
+				_data->static_count.increment();
+			}
 #endif
-		return;
+			_link(_data);
+			return;
+		}
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
+	// exists
+	if (p_static) {
+		_data->static_count.increment();
+	}
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		_data->debug_references.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -336,55 +446,47 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_data = _table[idx];
+	_data = _lookup_and_ref(hash, idx, p_static_string.ptr);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_static_string.ptr)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	if (!_data) {
+		MutexLock lock(_get_shard(idx).mutex);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
+		// Search again, it may have been added while not locked.
+		_data = _lookup_and_ref(hash, idx, p_static_string.ptr);
+
+		if (!_data) {
+			_data = memnew(_Data);
+
+			_data->refcount.init();
+			_data->static_count.set(p_static ? 1 : 0);
+			_data->hash = hash;
+			_data->idx = idx;
+			_data->cname = p_static_string.ptr;
 #ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				_data->refcount.ref();
+				_data->static_count.increment();
+			}
 #endif
-		return;
+			_link(_data);
+			return;
+		}
 	}
 
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
+	// exists
+	if (p_static) {
+		_data->static_count.increment();
+	}
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		_data->debug_references.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -396,54 +498,46 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_data = _table[idx];
+	_data = _lookup_and_ref(hash, idx, p_name);
 
-	while (_data) {
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	if (!_data) {
+		MutexLock lock(_get_shard(idx).mutex);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
+		// Search again, it may have been added while not locked.
+		_data = _lookup_and_ref(hash, idx, p_name);
+
+		if (!_data) {
+			_data = memnew(_Data);
+			_data->name = p_name;
+			_data->refcount.init();
+			_data->static_count.set(p_static ? 1 : 0);
+			_data->hash = hash;
+			_data->idx = idx;
+			_data->cname = nullptr;
 #ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				_data->refcount.ref();
+				_data->static_count.increment();
+			}
 #endif
-		return;
+			_link(_data);
+			return;
+		}
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
+	// exists
+	if (p_static) {
+		_data->static_count.increment();
+	}
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		_data->debug_references.increment();
 	}
 #endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName StringName::search(const char *p_name) {
@@ -454,25 +548,15 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_Data *_data = _table[idx];
+	_Data *_data = _lookup_and_ref(hash, idx, p_name);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 
@@ -490,23 +574,13 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_Data *_data = _table[idx];
+	_Data *_data = _lookup_and_ref(hash, idx, p_name);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 		return StringName(_data);
 	}
 
@@ -516,26 +590,16 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 
 	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_Data *_data = _lookup_and_ref(hash, idx, p_name);
 
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 		return StringName(_data);
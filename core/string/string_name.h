@@ -34,7 +34,9 @@
 #define STRING_NAME_H
 
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/string/ustring.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_refcount.h"
 
 #define UNIQUE_NODE_PREFIX "%"
@@ -59,7 +61,7 @@ class StringName {
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
 		bool operator==(const String &p_name) const;
@@ -69,15 +71,55 @@ class StringName {
 
 		int idx = 0;
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		_Data *prev = nullptr; // Only accessed with the shard locked.
+		std::atomic<_Data *> next = nullptr; // Read without locking by lookups.
 		_Data() {}
 	};
 
-	static inline _Data *_table[STRING_TABLE_LEN];
+	// Buckets are split among shards, each with its own lock for insertions and removals.
+	// Lookups don't lock. Instead, each thread publishes the epoch it started reading at in
+	// a reader slot of its own, and removed entries are freed once every reader active when
+	// they were removed is done (epoch-based reclamation).
+	enum {
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARDS = 1 << STRING_TABLE_SHARD_BITS,
+		// Threads beyond this many alive at once fall back to locking the shard to look up.
+		MAX_READER_SLOTS = 256,
+	};
+
+	struct RetiredData {
+		_Data *data = nullptr;
+		uint64_t epoch = 0;
+	};
+
+	struct alignas(Thread::CACHE_LINE_BYTES) Shard {
+		Mutex mutex;
+		LocalVector<RetiredData> retired;
+	};
+
+	struct alignas(Thread::CACHE_LINE_BYTES) ReaderSlot {
+		std::atomic<uint64_t> epoch; // Zero when not reading.
+		std::atomic<bool> in_use;
+	};
+
+	static inline std::atomic<_Data *> _table[STRING_TABLE_LEN];
+	static inline Shard shards[STRING_TABLE_SHARDS];
+	static inline ReaderSlot reader_slots[MAX_READER_SLOTS]; // Zero-initialized, they are static.
+	static inline std::atomic<uint32_t> reader_slots_used; // High-water mark.
+	static inline std::atomic<uint64_t> global_epoch{ 1 };
+	static inline thread_local ReaderSlot *thread_reader_slot = nullptr;
 
 	_Data *_data = nullptr;
 
+	_FORCE_INLINE_ static Shard &_get_shard(uint32_t p_idx) {
+		return shards[p_idx >> (STRING_TABLE_BITS - STRING_TABLE_SHARD_BITS)];
+	}
+	template <typename T>
+	static _Data *_lookup_and_ref(uint32_t p_hash, uint32_t p_idx, const T &p_name);
+	static void _link(_Data *p_data);
+	static void _free_retired(Shard &p_shard);
+	static ReaderSlot *_get_reader_slot();
+
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
@@ -90,7 +132,7 @@ class StringName {
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
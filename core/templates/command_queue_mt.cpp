@@ -35,9 +35,44 @@
 #include "core/config/project_settings.h"
 #include "core/os/os.h"
 
+CommandQueueMT::Stats CommandQueueMT::get_stats() const {
+	Stats stats;
+	stats.commands = stats_commands.get();
+	stats.locked_commands = stats_locked_commands.get();
+	stats.bytes = stats_locked_bytes.get() + (ring_reserve_pos.load(std::memory_order_relaxed) - stats_ring_base.get());
+	stats.max_pending_bytes = stats_max_pending_bytes.get();
+	stats.sync_count = stats_sync_count.get();
+	stats.sync_stall_usec = stats_sync_stall_usec.get();
+	return stats;
+}
+
+void CommandQueueMT::reset_stats() {
+	stats_commands.set(0);
+	stats_locked_commands.set(0);
+	stats_locked_bytes.set(0);
+	stats_ring_base.set(ring_reserve_pos.load(std::memory_order_relaxed));
+	stats_max_pending_bytes.set(0);
+	stats_sync_count.set(0);
+	stats_sync_stall_usec.set(0);
+}
+
 CommandQueueMT::CommandQueueMT() {
 	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+
+	uint32_t ring_size_kb = 0;
+	if (ProjectSettings::get_singleton()) {
+		ring_size_kb = GLOBAL_GET("memory/limits/command_queue/lock_free_ring_size_kb");
+	}
+	if (ring_size_kb > 0) {
+		ring_capacity = next_power_of_2(ring_size_kb * 1024);
+		ring_mask = ring_capacity - 1;
+		ring = (uint8_t *)Memory::alloc_static(ring_capacity);
+		memset(ring, 0, ring_capacity);
+	}
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	if (ring) {
+		Memory::free_static(ring);
+	}
 }
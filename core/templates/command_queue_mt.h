@@ -37,6 +37,8 @@
 #include "core/os/condition_variable.h"
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
@@ -249,10 +251,20 @@
 #define TYPE_ARG(N) P##N
 #define CMD_TYPE(N) Command##N<T, M COMMA(N) COMMA_SEP_LIST(TYPE_ARG, N)>
 #define CMD_ASSIGN_PARAM(N) cmd->p##N = p##N
+#define RING_CMD_ASSIGN_PARAM(N) ring_cmd->p##N = p##N
+#define RING_CMD_FILL(N)                 \
+	ring_cmd->instance = p_instance; \
+	ring_cmd->method = p_method;     \
+	SEMIC_SEP_LIST(RING_CMD_ASSIGN_PARAM, N)
 
 #define DECL_PUSH(N)                                                            \
 	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>    \
 	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) {    \
+		if (CMD_TYPE(N) *ring_cmd = _ring_allocate<CMD_TYPE(N)>()) {            \
+			RING_CMD_FILL(N);                                                   \
+			_ring_commit(ring_cmd);                                             \
+			return;                                                             \
+		}                                                                       \
 		MutexLock mlock(mutex);                                                 \
 		CMD_TYPE(N) *cmd = allocate<CMD_TYPE(N)>();                             \
 		cmd->instance = p_instance;                                             \
@@ -268,6 +280,15 @@
 #define DECL_PUSH_AND_RET(N)                                                                   \
 	template <typename T, typename M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) typename R>       \
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
+		if (CMD_RET_TYPE(N) *ring_cmd = _ring_allocate<CMD_RET_TYPE(N)>()) {                   \
+			RING_CMD_FILL(N);                                                                  \
+			ring_cmd->ret = r_ret;                                                             \
+			SafeFlag done;                                                                     \
+			ring_cmd->ring_done = &done;                                                       \
+			_ring_commit(ring_cmd);                                                            \
+			_wait_for_ring_sync(done);                                                         \
+			return;                                                                            \
+		}                                                                                      \
 		MutexLock mlock(mutex);                                                                \
 		CMD_RET_TYPE(N) *cmd = allocate<CMD_RET_TYPE(N)>();                                    \
 		cmd->instance = p_instance;                                                            \
@@ -286,6 +307,14 @@
 #define DECL_PUSH_AND_SYNC(N)                                                         \
 	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>          \
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		if (CMD_SYNC_TYPE(N) *ring_cmd = _ring_allocate<CMD_SYNC_TYPE(N)>()) {        \
+			RING_CMD_FILL(N);                                                         \
+			SafeFlag done;                                                            \
+			ring_cmd->ring_done = &done;                                              \
+			_ring_commit(ring_cmd);                                                   \
+			_wait_for_ring_sync(done);                                                \
+			return;                                                                   \
+		}                                                                             \
 		MutexLock mlock(mutex);                                                       \
 		CMD_SYNC_TYPE(N) *cmd = allocate<CMD_SYNC_TYPE(N)>();                         \
 		cmd->instance = p_instance;                                                   \
@@ -308,6 +337,7 @@ class CommandQueueMT {
 	};
 
 	struct SyncCommand : public CommandBase {
+		SafeFlag *ring_done = nullptr; // Only used by commands pushed to the ring.
 		virtual void call() override {}
 		SyncCommand() {
 			sync = true;
@@ -335,9 +365,39 @@ class CommandQueueMT {
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id = WorkerThreadPool::INVALID_TASK_ID; // Read without locking by ring producers.
 	uint64_t flush_read_ptr = 0;
 
+	/***** LOCK-FREE RING *******/
+
+	// When enabled, commands are pushed without locking into a ring buffer with many producers and
+	// a single consumer. Each slot starts with a header holding its size, which is zero until the
+	// producer has finished writing the command, and the consumer zeroes slots back once done.
+	// If the ring is full, commands go to command_mem under the mutex instead, and keep doing so
+	// until the consumer has run everything in the ring and then everything in command_mem.
+
+	static const uint64_t RING_PADDING_BIT = 1ULL << 63; // Header of the unused space left before wrapping around.
+
+	uint8_t *ring = nullptr;
+	uint64_t ring_capacity = 0;
+	uint64_t ring_mask = 0;
+	alignas(Thread::CACHE_LINE_BYTES) std::atomic<uint64_t> ring_reserve_pos = 0; // Written by producers.
+	alignas(Thread::CACHE_LINE_BYTES) std::atomic<uint64_t> ring_read_pos = 0; // Written by the consumer.
+	std::atomic<bool> ring_notify_pending = false;
+	SafeFlag ring_overflow;
+	BinaryMutex ring_flush_mutex;
+	std::atomic<Thread::ID> ring_flush_thread = Thread::UNASSIGNED_ID;
+
+	/***** STATS *******/
+
+	SafeNumeric<uint64_t> stats_commands;
+	SafeNumeric<uint64_t> stats_max_pending_bytes;
+	SafeNumeric<uint64_t> stats_sync_count;
+	SafeNumeric<uint64_t> stats_sync_stall_usec;
+	SafeNumeric<uint64_t> stats_locked_commands;
+	SafeNumeric<uint64_t> stats_locked_bytes;
+	SafeNumeric<uint64_t> stats_ring_base;
+
 	template <typename T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
@@ -346,9 +406,112 @@ class CommandQueueMT {
 		command_mem.resize(size + alloc_size + 8);
 		*(uint64_t *)&command_mem[size] = alloc_size;
 		T *cmd = memnew_placement(&command_mem[size + 8], T);
+		if (ring) {
+			ring_overflow.set();
+		}
+		stats_locked_commands.increment();
+		stats_locked_bytes.add(alloc_size + 8);
 		return cmd;
 	}
 
+	_FORCE_INLINE_ std::atomic<uint64_t> *_ring_header(uint64_t p_pos) {
+		return reinterpret_cast<std::atomic<uint64_t> *>(&ring[p_pos & ring_mask]);
+	}
+
+	template <typename T>
+	_FORCE_INLINE_ static constexpr uint64_t _ring_slot_size() {
+		return ((sizeof(T) + 8 - 1) & ~(8 - 1)) + 8;
+	}
+
+	// Returns nullptr if the ring is disabled or full, in which case the command must be pushed to command_mem.
+	template <typename T>
+	T *_ring_allocate() {
+		if (!ring || ring_overflow.is_set()) {
+			return nullptr;
+		}
+
+		const uint64_t slot_size = _ring_slot_size<T>();
+		uint64_t pos = ring_reserve_pos.load(std::memory_order_relaxed);
+		uint64_t padding;
+		do {
+			// Commands are never split, so skip the space left at the end if it doesn't fit.
+			const uint64_t contiguous = ring_capacity - (pos & ring_mask);
+			padding = slot_size > contiguous ? contiguous : 0;
+			if (pos + padding + slot_size - ring_read_pos.load(std::memory_order_acquire) > ring_capacity) {
+				return nullptr;
+			}
+		} while (!ring_reserve_pos.compare_exchange_weak(pos, pos + padding + slot_size, std::memory_order_relaxed));
+
+		if (padding) {
+			_ring_header(pos)->store(padding | RING_PADDING_BIT, std::memory_order_release);
+			pos += padding;
+		}
+		return memnew_placement(&ring[(pos & ring_mask) + 8], T);
+	}
+
+	template <typename T>
+	void _ring_commit(T *p_cmd) {
+		reinterpret_cast<std::atomic<uint64_t> *>(reinterpret_cast<uint8_t *>(p_cmd) - 8)->store(_ring_slot_size<T>(), std::memory_order_release);
+		_ring_notify_pump();
+	}
+
+	_FORCE_INLINE_ void _ring_notify_pump() {
+		// Notifying takes the pool lock, so only do it once until the consumer starts flushing again.
+		const WorkerThreadPool::TaskID pump_task = pump_task_id.load(std::memory_order_acquire);
+		if (pump_task != WorkerThreadPool::INVALID_TASK_ID && !ring_notify_pending.exchange(true, std::memory_order_acq_rel)) {
+			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task);
+		}
+	}
+
+	void _wait_for_ring_sync(SafeFlag &p_done) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		MutexLock lock(mutex);
+		while (!p_done.is_set()) {
+			sync_cond_var.wait(lock);
+		}
+		stats_sync_count.increment();
+		stats_sync_stall_usec.add(OS::get_singleton()->get_ticks_usec() - begin);
+	}
+
+	// Must be called by the flushing thread only.
+	void _flush_ring() {
+		ring_notify_pending.exchange(false, std::memory_order_acq_rel);
+
+		uint64_t read_pos = ring_read_pos.load(std::memory_order_relaxed);
+		stats_max_pending_bytes.exchange_if_greater(ring_reserve_pos.load(std::memory_order_relaxed) - read_pos);
+
+		while (true) {
+			const uint64_t header = _ring_header(read_pos)->load(std::memory_order_acquire);
+			if (header == 0) {
+				break; // Empty, or the next command is still being written.
+			}
+
+			const uint64_t size = header & ~RING_PADDING_BIT;
+			uint8_t *slot = &ring[read_pos & ring_mask];
+			if (!(header & RING_PADDING_BIT)) {
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(slot + 8);
+				cmd->call();
+				if (unlikely(cmd->sync)) {
+					SafeFlag *done = static_cast<SyncCommand *>(cmd)->ring_done;
+					cmd->~CommandBase();
+					done->set();
+					{
+						// Make sure the awaiter is either waiting or will see the flag.
+						MutexLock lock(mutex);
+					}
+					sync_cond_var.notify_all();
+				} else {
+					cmd->~CommandBase();
+				}
+				stats_commands.increment();
+			}
+
+			memset(slot, 0, size);
+			read_pos += size;
+			ring_read_pos.store(read_pos, std::memory_order_release);
+		}
+	}
+
 	_FORCE_INLINE_ void _prevent_sync_wraparound() {
 		bool safe_to_reset = !sync_awaiters;
 		bool already_sync_to_latest = sync_head == sync_tail;
@@ -359,6 +522,43 @@ class CommandQueueMT {
 	}
 
 	void _flush() {
+		if (ring) {
+			_flush_with_ring();
+			return;
+		}
+		_flush_command_mem();
+	}
+
+	void _flush_with_ring() {
+		if (ring_flush_thread.load(std::memory_order_relaxed) == Thread::get_caller_id()) {
+			// Re-entrant call.
+			return;
+		}
+
+		MutexLock flush_lock(ring_flush_mutex);
+		if (ring_flush_thread.load(std::memory_order_relaxed) != Thread::UNASSIGNED_ID) {
+			// Another thread is flushing and has released the lock while a command waits in the pool.
+			// It'll run everything pending once it resumes.
+			return;
+		}
+		ring_flush_thread.store(Thread::get_caller_id(), std::memory_order_relaxed);
+
+		// Commands may wait for pool tasks that push commands themselves, so the lock has to be released meanwhile.
+		uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(flush_lock);
+
+		_flush_ring();
+
+		// Commands that overflowed were pushed after everything reserved in the ring, so run them once it's drained.
+		if (ring_overflow.is_set() && ring_read_pos.load(std::memory_order_relaxed) == ring_reserve_pos.load(std::memory_order_acquire)) {
+			_flush_command_mem();
+		}
+
+		WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+		ring_flush_thread.store(Thread::UNASSIGNED_ID, std::memory_order_relaxed);
+	}
+
+	void _flush_command_mem() {
 		if (unlikely(flush_read_ptr)) {
 			// Re-entrant call.
 			return;
@@ -366,6 +566,8 @@ class CommandQueueMT {
 
 		MutexLock lock(mutex);
 
+		stats_max_pending_bytes.exchange_if_greater(command_mem.size());
+
 		while (flush_read_ptr < command_mem.size()) {
 			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
 			flush_read_ptr += 8;
@@ -389,15 +591,18 @@ class CommandQueueMT {
 			cmd->~CommandBase();
 
 			flush_read_ptr += size;
+			stats_commands.increment();
 		}
 
 		command_mem.clear();
 		flush_read_ptr = 0;
+		ring_overflow.clear();
 
 		_prevent_sync_wraparound();
 	}
 
 	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
 		sync_awaiters++;
 		uint32_t sync_head_goal = sync_tail;
 		do {
@@ -405,11 +610,22 @@ class CommandQueueMT {
 		} while (sync_head < sync_head_goal);
 		sync_awaiters--;
 		_prevent_sync_wraparound();
+		stats_sync_count.increment();
+		stats_sync_stall_usec.add(OS::get_singleton()->get_ticks_usec() - begin);
 	}
 
 	void _no_op() {}
 
 public:
+	struct Stats {
+		uint64_t commands = 0; // Commands run.
+		uint64_t locked_commands = 0; // Commands pushed under the mutex, because the ring is disabled or was full.
+		uint64_t bytes = 0; // Queue memory used by pushed commands.
+		uint64_t max_pending_bytes = 0; // Deepest the queue was when flushing.
+		uint64_t sync_count = 0; // Commands whose caller waited for them to run.
+		uint64_t sync_stall_usec = 0; // Total time callers waited for those.
+	};
+
 	/* NORMAL PUSH COMMANDS */
 	DECL_PUSH(0)
 	SPACE_SEP_LIST(DECL_PUSH, 15)
@@ -423,7 +639,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(command_mem.size() > 0 || (ring && ring_read_pos.load(std::memory_order_relaxed) != ring_reserve_pos.load(std::memory_order_relaxed)))) {
 			_flush();
 		}
 	}
@@ -437,16 +653,24 @@ public:
 	}
 
 	void wait_and_flush() {
-		ERR_FAIL_COND(pump_task_id == WorkerThreadPool::INVALID_TASK_ID);
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		const WorkerThreadPool::TaskID pump_task = pump_task_id.load(std::memory_order_acquire);
+		ERR_FAIL_COND(pump_task == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task);
 		_flush();
 	}
 
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
 		MutexLock lock(mutex);
-		pump_task_id = p_task_id;
+		pump_task_id.store(p_task_id, std::memory_order_release);
 	}
 
+	bool is_lock_free() const { return ring != nullptr; }
+
+	// Stats accumulate until reset, so resetting them once per frame gives per-frame numbers.
+	// They don't lock, so they can be used from commands being flushed.
+	Stats get_stats() const;
+	void reset_stats();
+
 	CommandQueueMT();
 	~CommandQueueMT();
 };
@@ -461,6 +685,8 @@ public:
 #undef TYPE_ARG
 #undef CMD_TYPE
 #undef CMD_ASSIGN_PARAM
+#undef RING_CMD_ASSIGN_PARAM
+#undef RING_CMD_FILL
 #undef DECL_PUSH
 #undef CMD_RET_TYPE
 #undef DECL_PUSH_AND_RET
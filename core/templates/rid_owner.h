@@ -43,6 +43,8 @@
 #include "core/templates/safe_refcount.h"
 
 #include <stdio.h>
+#include <atomic>
+#include <type_traits>
 #include <typeinfo>
 
 class RID_AllocBase {
@@ -69,17 +71,24 @@ public:
 	virtual ~RID_AllocBase() {}
 };
 
+// When THREAD_SAFE is true, only make_rid/allocate_rid/free and the owned list
+// functions take the mutex. Lookups (get_or_null, owns) never lock: the chunk
+// table is allocated once and never moves, new chunks are published through an
+// atomic max_alloc, and each element carries an atomic validator that is only
+// marked initialized once its data is fully constructed.
 template <typename T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
+	typedef std::conditional_t<THREAD_SAFE, std::atomic<uint32_t>, uint32_t> Counter;
+
 	struct Chunk {
 		T data;
-		uint32_t validator;
+		Counter validator;
 	};
 	Chunk **chunks = nullptr;
 	uint32_t **free_list_chunks = nullptr;
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
+	Counter max_alloc = 0;
 	uint32_t alloc_count = 0;
 	uint32_t chunk_limit = 0;
 
@@ -87,14 +96,71 @@ class RID_Alloc : public RID_AllocBase {
 
 	mutable Mutex mutex;
 
+	_FORCE_INLINE_ static uint32_t _load(const Counter &p_counter) {
+		if constexpr (THREAD_SAFE) {
+			return p_counter.load(std::memory_order_acquire);
+		} else {
+			return p_counter;
+		}
+	}
+
+	_FORCE_INLINE_ static void _store(Counter &p_counter, uint32_t p_value) {
+		if constexpr (THREAD_SAFE) {
+			p_counter.store(p_value, std::memory_order_release);
+		} else {
+			p_counter = p_value;
+		}
+	}
+
+	// Validates the RID and returns its element, marking it initialized if requested.
+	// Threaded lookups must not see the initialized validator before the data is constructed,
+	// so initialize_rid() marks it after construction instead.
+	_FORCE_INLINE_ Chunk *_get_chunk(const RID &p_rid, bool p_initialize) {
+		if (p_rid == RID()) {
+			return nullptr;
+		}
+
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		if (unlikely(idx >= _load(max_alloc))) {
+			return nullptr;
+		}
+
+		uint32_t idx_chunk = idx / elements_in_chunk;
+		uint32_t idx_element = idx % elements_in_chunk;
+
+		uint32_t validator = uint32_t(id >> 32);
+
+		Chunk &c = chunks[idx_chunk][idx_element];
+		uint32_t current = _load(c.validator);
+		if (unlikely(p_initialize)) {
+			if (unlikely(!(current & 0x80000000))) {
+				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
+			}
+
+			if (unlikely((current & 0x7FFFFFFF) != validator)) {
+				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
+			}
+
+		} else if (unlikely(current != validator)) {
+			if ((current & 0x80000000) && current != 0xFFFFFFFF) {
+				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
+			}
+			return nullptr;
+		}
+
+		return &c;
+	}
+
 	_FORCE_INLINE_ RID _allocate_rid() {
 		if constexpr (THREAD_SAFE) {
 			mutex.lock();
 		}
 
-		if (alloc_count == max_alloc) {
+		uint32_t current_max_alloc = _load(max_alloc);
+		if (alloc_count == current_max_alloc) {
 			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
+			uint32_t chunk_count = alloc_count == 0 ? 0 : (current_max_alloc / elements_in_chunk);
 			if (THREAD_SAFE && chunk_count == chunk_limit) {
 				mutex.unlock();
 				if (description != nullptr) {
@@ -118,11 +184,12 @@ class RID_Alloc : public RID_AllocBase {
 			//initialize
 			for (uint32_t i = 0; i < elements_in_chunk; i++) {
 				// Don't initialize chunk.
-				chunks[chunk_count][i].validator = 0xFFFFFFFF;
+				_store(chunks[chunk_count][i].validator, 0xFFFFFFFF);
 				free_list_chunks[chunk_count][i] = alloc_count + i;
 			}
 
-			max_alloc += elements_in_chunk;
+			// Publishes the new chunk to lock-free lookups.
+			_store(max_alloc, current_max_alloc + elements_in_chunk);
 		}
 
 		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
@@ -136,8 +203,7 @@ class RID_Alloc : public RID_AllocBase {
 		id <<= 32;
 		id |= free_index;
 
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
+		_store(chunks[free_chunk][free_element].validator, validator | 0x80000000); //mark uninitialized bit
 
 		alloc_count++;
 
@@ -166,66 +232,32 @@ public:
 	}
 
 	_FORCE_INLINE_ T *get_or_null(const RID &p_rid, bool p_initialize = false) {
-		if (p_rid == RID()) {
-			return nullptr;
-		}
-
-		uint64_t id = p_rid.get_id();
-		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
+		Chunk *c = _get_chunk(p_rid, p_initialize);
+		if (unlikely(!c)) {
 			return nullptr;
 		}
-
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
-		uint32_t validator = uint32_t(id >> 32);
-
-		Chunk &c = chunks[idx_chunk][idx_element];
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(c.validator & 0x80000000))) {
-				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
-			}
-
-			if (unlikely((c.validator & 0x7FFFFFFF) != validator)) {
-				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
-			}
-
-			c.validator &= 0x7FFFFFFF; //initialized
-
-		} else if (unlikely(c.validator != validator)) {
-			if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
-				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
-			}
-			return nullptr;
+			_store(c->validator, _load(c->validator) & 0x7FFFFFFF); //initialized
 		}
-
-		T *ptr = &c.data;
-
-		return ptr;
+		return &c->data;
 	}
 	void initialize_rid(RID p_rid) {
-		T *mem = get_or_null(p_rid, true);
-		ERR_FAIL_NULL(mem);
-		memnew_placement(mem, T);
+		Chunk *c = _get_chunk(p_rid, true);
+		ERR_FAIL_NULL(c);
+		memnew_placement(&c->data, T);
+		_store(c->validator, _load(c->validator) & 0x7FFFFFFF); //initialized
 	}
 	void initialize_rid(RID p_rid, const T &p_value) {
-		T *mem = get_or_null(p_rid, true);
-		ERR_FAIL_NULL(mem);
-		memnew_placement(mem, T(p_value));
+		Chunk *c = _get_chunk(p_rid, true);
+		ERR_FAIL_NULL(c);
+		memnew_placement(&c->data, T(p_value));
+		_store(c->validator, _load(c->validator) & 0x7FFFFFFF); //initialized
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _load(max_alloc))) {
 			return false;
 		}
 
@@ -234,13 +266,7 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (validator != 0x7FFFFFFF) && (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
-
-		return owned;
+		return (validator != 0x7FFFFFFF) && (_load(chunks[idx_chunk][idx_element].validator) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
@@ -250,7 +276,7 @@ public:
 
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
+		if (unlikely(idx >= _load(max_alloc))) {
 			if constexpr (THREAD_SAFE) {
 				mutex.unlock();
 			}
@@ -261,20 +287,21 @@ public:
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
+		uint32_t current = _load(chunks[idx_chunk][idx_element].validator);
+		if (unlikely(current & 0x80000000)) {
 			if constexpr (THREAD_SAFE) {
 				mutex.unlock();
 			}
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
+		} else if (unlikely(current != validator)) {
 			if constexpr (THREAD_SAFE) {
 				mutex.unlock();
 			}
 			ERR_FAIL();
 		}
 
+		_store(chunks[idx_chunk][idx_element].validator, 0xFFFFFFFF); // go invalid
 		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
 
 		alloc_count--;
 		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
@@ -291,8 +318,9 @@ public:
 		if constexpr (THREAD_SAFE) {
 			mutex.lock();
 		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+		const uint32_t current_max_alloc = _load(max_alloc);
+		for (size_t i = 0; i < current_max_alloc; i++) {
+			uint64_t validator = _load(chunks[i / elements_in_chunk][i % elements_in_chunk].validator);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
@@ -308,8 +336,9 @@ public:
 			mutex.lock();
 		}
 		uint32_t idx = 0;
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+		const uint32_t current_max_alloc = _load(max_alloc);
+		for (size_t i = 0; i < current_max_alloc; i++) {
+			uint64_t validator = _load(chunks[i / elements_in_chunk][i % elements_in_chunk].validator);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -339,8 +368,9 @@ public:
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
 					alloc_count, description ? description : typeid(T).name()));
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			const uint32_t current_max_alloc = _load(max_alloc);
+			for (size_t i = 0; i < current_max_alloc; i++) {
+				uint64_t validator = _load(chunks[i / elements_in_chunk][i % elements_in_chunk].validator);
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
@@ -350,7 +380,7 @@ public:
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		uint32_t chunk_count = _load(max_alloc) / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
 			memfree(chunks[i]);
 			memfree(free_list_chunks[i]);
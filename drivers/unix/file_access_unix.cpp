@@ -39,6 +39,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -165,6 +166,12 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_size);
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -271,6 +278,38 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_buffer(uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (!is_memory_mapping_enabled() || flags != READ) {
+		return nullptr; // Mapped files must not change size, which only the caller can promise.
+	}
+
+	if (!mapped) {
+		uint64_t size = get_length();
+		if (size == 0 || size > SIZE_MAX) {
+			return nullptr;
+		}
+		void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+		if (addr == MAP_FAILED) {
+			return nullptr;
+		}
+		mapped = (uint8_t *)addr;
+		mapped_size = size;
+	}
+
+	int64_t pos = ftello(f);
+	if (pos < 0 || (uint64_t)pos > mapped_size || p_length > mapped_size - pos) {
+		return nullptr;
+	}
+	if (fseeko(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return nullptr;
+	}
+
+	return mapped + pos;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
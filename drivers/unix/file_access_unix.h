@@ -51,6 +51,9 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	mutable uint8_t *mapped = nullptr;
+	mutable uint64_t mapped_size = 0;
+
 	void _close();
 
 #if defined(TOOLS_ENABLED)
@@ -74,6 +77,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
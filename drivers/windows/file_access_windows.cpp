@@ -232,6 +232,14 @@ void FileAccessWindows::_close() {
 		return;
 	}
 
+	if (mapped) {
+		UnmapViewOfFile(mapped);
+		CloseHandle((HANDLE)mapping);
+		mapping = nullptr;
+		mapped = nullptr;
+		mapped_size = 0;
+	}
+
 	fclose(f);
 	f = nullptr;
 
@@ -343,6 +351,48 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 	return read;
 }
 
+const uint8_t *FileAccessWindows::get_mapped_buffer(uint64_t p_length) const {
+	ERR_FAIL_NULL_V(f, nullptr);
+
+	if (!is_memory_mapping_enabled() || flags != READ) {
+		return nullptr; // Mapped files must not change size, which only the caller can promise.
+	}
+
+	if (!mapped) {
+		uint64_t size = get_length();
+		if (size == 0 || size > SIZE_MAX) {
+			return nullptr;
+		}
+		HANDLE fh = (HANDLE)_get_osfhandle(_fileno(f));
+		if (fh == INVALID_HANDLE_VALUE) {
+			return nullptr;
+		}
+		HANDLE mh = CreateFileMappingW(fh, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mh) {
+			return nullptr;
+		}
+		void *addr = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+		if (!addr) {
+			CloseHandle(mh);
+			return nullptr;
+		}
+		mapping = mh;
+		mapped = (uint8_t *)addr;
+		mapped_size = size;
+	}
+
+	int64_t pos = _ftelli64(f);
+	if (pos < 0 || (uint64_t)pos > mapped_size || p_length > mapped_size - pos) {
+		return nullptr;
+	}
+	if (_fseeki64(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return nullptr;
+	}
+
+	return mapped + pos;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
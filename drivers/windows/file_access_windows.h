@@ -50,6 +50,10 @@ class FileAccessWindows : public FileAccess {
 	String path_src;
 	String save_path;
 
+	mutable void *mapping = nullptr; // File mapping HANDLE.
+	mutable uint8_t *mapped = nullptr;
+	mutable uint64_t mapped_size = 0;
+
 	void _close();
 
 	static HashSet<String> invalid_files;
@@ -72,6 +76,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
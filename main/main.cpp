@@ -636,6 +636,9 @@ void Main::print_help(const char *p_binary) {
 #endif
 	print_help_option("--remote-debug <uri>", "Remote debug (<protocol>://<host/IP>[:<port>], e.g. tcp://127.0.0.1:6007).\n");
 	print_help_option("--single-threaded-scene", "Force scene tree to run in single-threaded mode. Sub-thread groups are disabled and run on the main thread.\n");
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+	print_help_option("--thread-cache-allocator <enable>", "Enable or disable the thread-caching allocator for small memory blocks [\"enable\", \"disable\"].\n");
+#endif
 #if defined(DEBUG_ENABLED)
 	print_help_option("--debug-collisions", "Show collision shapes when running the scene.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
 	print_help_option("--debug-paths", "Show path lines when running the scene.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
@@ -1434,6 +1437,24 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			}
 		} else if (arg == "--single-threaded-scene") {
 			single_threaded_scene = true;
+#ifdef THREAD_CACHE_ALLOCATOR_ENABLED
+		} else if (arg == "--thread-cache-allocator") {
+			if (N) {
+				String string = N->get();
+				if (string == "enable") {
+					Memory::set_thread_cache_allocator_enabled(true);
+				} else if (string == "disable") {
+					Memory::set_thread_cache_allocator_enabled(false);
+				} else {
+					OS::get_singleton()->print("Thread cache allocator argument not recognized, aborting.\n");
+					goto error;
+				}
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing thread cache allocator argument, aborting.\n");
+				goto error;
+			}
+#endif
 		} else if (arg == "--build-solutions") { // Build the scripting solution such C#
 
 			auto_build_solutions = true;
@@ -0,0 +1,395 @@
+/**************************************************************************/
+/*  gdscript_native_emitter.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_emitter.h"
+
+#include "../gdscript_analyzer.h"
+#include "../gdscript_compiler.h"
+#include "../gdscript_native.h"
+#include "../gdscript_parser.h"
+
+#include "core/io/file_access.h"
+
+struct GDScriptNativeTypedOperator {
+	GDScriptFunction::Opcode opcode;
+	const char *result_type;
+	const char *left_type;
+	const char *op;
+	const char *right_type;
+};
+
+// Keep in sync with the OPCODE_TYPED_OPERATOR() list in gdscript_vm.cpp.
+static const GDScriptNativeTypedOperator typed_operators[] = {
+	{ GDScriptFunction::OPCODE_ADD_INT_INT, "INT", "INT", "+", "INT" },
+	{ GDScriptFunction::OPCODE_SUBTRACT_INT_INT, "INT", "INT", "-", "INT" },
+	{ GDScriptFunction::OPCODE_MULTIPLY_INT_INT, "INT", "INT", "*", "INT" },
+	{ GDScriptFunction::OPCODE_LESS_INT_INT, "BOOL", "INT", "<", "INT" },
+	{ GDScriptFunction::OPCODE_LESS_EQUAL_INT_INT, "BOOL", "INT", "<=", "INT" },
+	{ GDScriptFunction::OPCODE_GREATER_INT_INT, "BOOL", "INT", ">", "INT" },
+	{ GDScriptFunction::OPCODE_GREATER_EQUAL_INT_INT, "BOOL", "INT", ">=", "INT" },
+	{ GDScriptFunction::OPCODE_EQUAL_INT_INT, "BOOL", "INT", "==", "INT" },
+	{ GDScriptFunction::OPCODE_NOT_EQUAL_INT_INT, "BOOL", "INT", "!=", "INT" },
+	{ GDScriptFunction::OPCODE_ADD_FLOAT_FLOAT, "FLOAT", "FLOAT", "+", "FLOAT" },
+	{ GDScriptFunction::OPCODE_SUBTRACT_FLOAT_FLOAT, "FLOAT", "FLOAT", "-", "FLOAT" },
+	{ GDScriptFunction::OPCODE_MULTIPLY_FLOAT_FLOAT, "FLOAT", "FLOAT", "*", "FLOAT" },
+	{ GDScriptFunction::OPCODE_DIVIDE_FLOAT_FLOAT, "FLOAT", "FLOAT", "/", "FLOAT" },
+	{ GDScriptFunction::OPCODE_LESS_FLOAT_FLOAT, "BOOL", "FLOAT", "<", "FLOAT" },
+	{ GDScriptFunction::OPCODE_LESS_EQUAL_FLOAT_FLOAT, "BOOL", "FLOAT", "<=", "FLOAT" },
+	{ GDScriptFunction::OPCODE_GREATER_FLOAT_FLOAT, "BOOL", "FLOAT", ">", "FLOAT" },
+	{ GDScriptFunction::OPCODE_GREATER_EQUAL_FLOAT_FLOAT, "BOOL", "FLOAT", ">=", "FLOAT" },
+};
+
+struct GDScriptNativeVectorOperator {
+	GDScriptFunction::Opcode opcode;
+	const char *function;
+	int size;
+};
+
+// Vector operators go through the component-wise helpers of gdscript_native_body.h.
+static const GDScriptNativeVectorOperator vector_operators[] = {
+	{ GDScriptFunction::OPCODE_ADD_VECTOR2_VECTOR2, "add", 2 },
+	{ GDScriptFunction::OPCODE_SUBTRACT_VECTOR2_VECTOR2, "subtract", 2 },
+	{ GDScriptFunction::OPCODE_MULTIPLY_VECTOR2_FLOAT, "multiply", 2 },
+	{ GDScriptFunction::OPCODE_ADD_VECTOR3_VECTOR3, "add", 3 },
+	{ GDScriptFunction::OPCODE_SUBTRACT_VECTOR3_VECTOR3, "subtract", 3 },
+	{ GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT, "multiply", 3 },
+};
+
+String GDScriptNativeEmitter::_address(const GDScriptFunction *p_function, int p_pos) {
+	int address = p_function->_code_ptr[p_pos];
+	int type = (address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+	int index = address & GDScriptFunction::ADDR_MASK;
+	return vformat("GDSCRIPT_NATIVE_ADDRESS(a, %d, %d)", type, index);
+}
+
+String GDScriptNativeEmitter::_jump(EmitState &p_state, int p_target) {
+	if (p_state.boundaries.has(p_target) && p_target < p_state.end) {
+		p_state.jump_targets.insert(p_target);
+		return vformat("goto L%d;", p_target);
+	}
+	return vformat("return %d;", p_target); // Leaves the body, the interpreter continues from there.
+}
+
+// Instruction arguments of call-like instructions start right after the opcode and the argument count.
+String GDScriptNativeEmitter::_args(const GDScriptFunction *p_function, int p_ip, int p_argc) {
+	if (p_argc == 0) {
+		return "const GDExtensionConstVariantPtr *args = nullptr;";
+	}
+	String list;
+	for (int i = 0; i < p_argc; i++) {
+		if (i > 0) {
+			list += ", ";
+		}
+		list += _address(p_function, p_ip + 2 + i);
+	}
+	return vformat("const GDExtensionConstVariantPtr args[%d] = { %s };", p_argc, list);
+}
+
+bool GDScriptNativeEmitter::_emit_instruction(EmitState &p_state, int p_ip, String &r_code, int &r_size) {
+	const GDScriptFunction *f = p_state.function;
+	const int *code = f->_code_ptr;
+	const int end_ip = f->_code_size - 1; // Always OPCODE_END.
+
+#define ADDR(m_ofs) _address(f, p_ip + 1 + (m_ofs))
+
+	const GDScriptFunction::Opcode opcode = GDScriptFunction::Opcode(code[p_ip]);
+
+	for (const GDScriptNativeTypedOperator &op : typed_operators) {
+		if (op.opcode == opcode) {
+			r_code = vformat("GDSCRIPT_NATIVE_%s(%s) = GDSCRIPT_NATIVE_%s(%s) %s GDSCRIPT_NATIVE_%s(%s);", op.result_type, ADDR(2), op.left_type, ADDR(0), op.op, op.right_type, ADDR(1));
+			r_size = 4;
+			return true;
+		}
+	}
+	for (const GDScriptNativeVectorOperator &op : vector_operators) {
+		if (op.opcode == opcode) {
+			r_code = vformat("gdscript_native_vector_%s(%s, %s, %s, %d);", op.function, ADDR(2), ADDR(0), ADDR(1), op.size);
+			r_size = 4;
+			return true;
+		}
+	}
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			r_code = vformat("gdscript_native_assign(%s, %s);", ADDR(0), ADDR(1));
+			r_size = 3;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL: {
+			r_code = vformat("gdscript_native_assign_nil(%s);", ADDR(0));
+			r_size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			r_code = vformat("gdscript_native_assign_bool(%s, %d);", ADDR(0), opcode == GDScriptFunction::OPCODE_ASSIGN_TRUE ? 1 : 0);
+			r_size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			// Conversions (and their errors) stay in the interpreter.
+			r_code = vformat("if (gdscript_native_variant_get_type(%s) != GDExtensionVariantType(%d)) { return %d; } gdscript_native_assign(%s, %s);", ADDR(1), code[p_ip + 3], p_ip, ADDR(0), ADDR(1));
+			r_size = 4;
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			r_code = vformat("c->operator_funcs[%d](%s, %s, %s);", code[p_ip + 4], ADDR(0), ADDR(1), ADDR(2));
+			r_size = 5;
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+			const char *test = opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF ? "" : "!";
+			r_code = vformat("c->operator_funcs[%d](%s, %s, %s); if (%sGDSCRIPT_NATIVE_BOOL(%s)) { %s }", code[p_ip + 4], ADDR(0), ADDR(1), ADDR(2), test, ADDR(2), _jump(p_state, code[p_ip + 5]));
+			r_size = 6;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			r_code = _jump(p_state, code[p_ip + 1]);
+			r_size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			const char *test = opcode == GDScriptFunction::OPCODE_JUMP_IF ? "" : "!";
+			r_code = vformat("if (%sgdscript_native_variant_booleanize(%s)) { %s }", test, ADDR(0), _jump(p_state, code[p_ip + 2]));
+			r_size = 3;
+		} break;
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+			r_code = vformat("c->getters[%d](%s, %s);", code[p_ip + 3], ADDR(0), ADDR(1));
+			r_size = 4;
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+			r_code = vformat("c->setters[%d](%s, %s);", code[p_ip + 3], ADDR(0), ADDR(1));
+			r_size = 4;
+		} break;
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+			// Out of bounds accesses are reported by the interpreter.
+			r_code = vformat("bool oob; c->indexed_getters[%d](%s, GDSCRIPT_NATIVE_INT(%s), %s, &oob); if (oob) { return %d; }", code[p_ip + 4], ADDR(0), ADDR(1), ADDR(2), p_ip);
+			r_size = 5;
+		} break;
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			r_code = vformat("bool oob; c->indexed_setters[%d](%s, GDSCRIPT_NATIVE_INT(%s), %s, &oob); if (oob) { return %d; }", code[p_ip + 4], ADDR(0), ADDR(1), ADDR(2), p_ip);
+			r_size = 5;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+			int instr_arg_count = code[p_ip + 1];
+			int argc = code[p_ip + 2 + instr_arg_count];
+			int index = code[p_ip + 3 + instr_arg_count];
+			r_code = vformat("%s c->constructors[%d](%s, args);", _args(f, p_ip, argc), index, _address(f, p_ip + 2 + argc));
+			r_size = 4 + instr_arg_count;
+		} break;
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			int instr_arg_count = code[p_ip + 1];
+			int argc = code[p_ip + 2 + instr_arg_count];
+			int index = code[p_ip + 3 + instr_arg_count];
+			r_code = vformat("%s c->utilities[%d](%s, args, %d);", _args(f, p_ip, argc), index, _address(f, p_ip + 2 + argc), argc);
+			r_size = 4 + instr_arg_count;
+		} break;
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			int instr_arg_count = code[p_ip + 1];
+			int argc = code[p_ip + 2 + instr_arg_count];
+			int index = code[p_ip + 3 + instr_arg_count];
+			r_code = vformat("%s c->builtin_methods[%d](%s, args, %d, %s);", _args(f, p_ip, argc), index, _address(f, p_ip + 2 + argc), argc, _address(f, p_ip + 3 + argc));
+			r_size = 4 + instr_arg_count;
+		} break;
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+			int instr_arg_count = code[p_ip + 1];
+			int argc = code[p_ip + 2 + instr_arg_count];
+			int index = code[p_ip + 3 + instr_arg_count];
+			// Null and freed receivers are reported by the interpreter.
+			const bool has_return = opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN;
+			r_code = vformat("%s if (!gdscript_native_call_method_bind(c->methods[%d], %s, args, %s, %d)) { return %d; }", _args(f, p_ip, argc), index, _address(f, p_ip + 2 + argc), _address(f, p_ip + 3 + argc), has_return ? 1 : 0, p_ip);
+			r_size = 4 + instr_arg_count;
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT: {
+			r_code = vformat("int64_t size = GDSCRIPT_NATIVE_INT(%s); gdscript_native_assign_int(%s, 0); ", ADDR(1), ADDR(0));
+			r_code += vformat("if (size <= 0) { %s } gdscript_native_assign_int(%s, 0);", _jump(p_state, code[p_ip + 4]), ADDR(2));
+			r_size = 5;
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			r_code = vformat("int64_t size = GDSCRIPT_NATIVE_INT(%s); int64_t *count = &GDSCRIPT_NATIVE_INT(%s); (*count)++; ", ADDR(1), ADDR(0));
+			r_code += vformat("if (*count >= size) { %s } GDSCRIPT_NATIVE_INT(%s) = *count;", _jump(p_state, code[p_ip + 4]), ADDR(2));
+			r_size = 5;
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			r_code = vformat("// Line %d.", code[p_ip + 1]);
+			r_size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_RETURN: {
+			r_code = vformat("gdscript_native_assign(c->retvalue, %s); return %d;", ADDR(0), end_ip);
+			r_size = 2;
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			r_code = vformat("if (gdscript_native_variant_get_type(%s) != GDExtensionVariantType(%d)) { return %d; } gdscript_native_assign(c->retvalue, %s); return %d;", ADDR(0), code[p_ip + 2], p_ip, ADDR(0), end_ip);
+			r_size = 3;
+		} break;
+		case GDScriptFunction::OPCODE_END: {
+			r_code = vformat("return %d;", p_ip);
+			r_size = 1;
+		} break;
+		default: {
+			return false;
+		}
+	}
+
+#undef ADDR
+
+	return true;
+}
+
+void GDScriptNativeEmitter::_emit_function(const GDScriptFunction *p_function, const String &p_script) {
+	if (!p_function->_code_ptr || p_function->_code_size == 0) {
+		return;
+	}
+
+	EmitState state;
+	state.function = p_function;
+
+	// First pass: find how far the body can go and where instructions start.
+	int ip = 0;
+	while (ip < p_function->_code_size) {
+		String discard;
+		int size = 0;
+		if (!_emit_instruction(state, ip, discard, size)) {
+			break;
+		}
+		state.boundaries.insert(ip);
+		ip += size;
+	}
+	state.end = ip;
+	if (state.end == 0) {
+		return; // Not worth a body, e.g. functions starting with default argument jumps.
+	}
+
+	// Second pass: translate, now that jumps can be resolved to labels.
+	Vector<Pair<int, String>> instructions;
+	ip = 0;
+	while (ip < state.end) {
+		String instruction;
+		int size = 0;
+		_emit_instruction(state, ip, instruction, size);
+		instructions.push_back(Pair<int, String>(ip, instruction));
+		ip += size;
+	}
+
+	// Only label what something jumps to, so the output builds without warnings.
+	String body;
+	for (const Pair<int, String> &instruction : instructions) {
+		if (state.jump_targets.has(instruction.first)) {
+			body += vformat("L%d:\n", instruction.first);
+		}
+		body += vformat("\t{\n\t\t%s\n\t}\n", instruction.second);
+	}
+	if (state.end < p_function->_code_size) {
+		body += vformat("\treturn %d;\n", state.end);
+	}
+
+	const String function_name = p_function->get_name();
+	const uint32_t code_hash = GDScriptNative::hash_function(p_function);
+	const String symbol = vformat("gdscript_native_body_%d", body_count++);
+
+	bodies += vformat("// %s::%s (covers %d of %d bytecode words).\n", p_script, function_name, state.end, p_function->_code_size);
+	bodies += vformat("static int %s(const GDScriptNativeContext *c) {\n\tconst GDExtensionVariantPtr *a = c->addresses;\n%s}\n\n", symbol, body);
+	registrations += vformat("\tp_register(\"%s\", \"%s\", 0x%sU, &%s);\n", p_script.c_escape(), function_name.c_escape(), String::num_uint64(code_hash, 16), symbol);
+}
+
+void GDScriptNativeEmitter::_emit_script(const GDScript *p_script) {
+	const String fqcn = p_script->get_fully_qualified_name();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->get_member_functions()) {
+		_emit_function(E.value, fqcn);
+		for (const GDScriptFunction *lambda : E.value->lambdas) {
+			_emit_function(lambda, fqcn);
+		}
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->get_subclasses()) {
+		_emit_script(E.value.ptr());
+	}
+}
+
+Error GDScriptNativeEmitter::add_script(const String &p_path) {
+	Error err = OK;
+	String source = FileAccess::get_file_as_string(p_path, &err);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	// Compile a private copy, so the live script keeps its debug bytecode.
+	GDScriptParser parser;
+	err = parser.parse(source, p_path, false);
+	if (err != OK) {
+		return err;
+	}
+	GDScriptAnalyzer analyzer(&parser);
+	err = analyzer.analyze();
+	if (err != OK) {
+		return err;
+	}
+
+	Ref<GDScript> scr;
+	scr.instantiate();
+	GDScriptCompiler compiler;
+	compiler.set_release_bytecode(release_bytecode);
+	err = compiler.compile(&parser, scr.ptr(), false);
+	if (err != OK) {
+		return err;
+	}
+
+	_emit_script(scr.ptr());
+	return OK;
+}
+
+String GDScriptNativeEmitter::get_source() const {
+	String out;
+	out += "// Generated by the GDScript native emitter. Do not edit.\n";
+	out += "// Only depends on the C interface headers of the engine, see get_build_script() for how to build it.\n\n";
+	out += "#include \"modules/gdscript/gdscript_native_body.h\"\n\n";
+	out += "#if defined(_WIN32)\n#define GDSCRIPT_NATIVE_EXPORT __declspec(dllexport)\n#else\n#define GDSCRIPT_NATIVE_EXPORT __attribute__((visibility(\"default\")))\n#endif\n\n";
+	out += bodies;
+	out += "extern \"C\" GDSCRIPT_NATIVE_EXPORT GDExtensionBool gdscript_native_init(GDExtensionInterfaceGetProcAddress p_get_proc_address, const GDScriptNativeInterface *p_interface, GDScriptNativeRegisterFunc p_register) {\n";
+	out += "\tif (!gdscript_native_load(p_get_proc_address, p_interface)) {\n\t\treturn 0;\n\t}\n";
+	out += registrations;
+	out += "\treturn 1;\n";
+	out += "}\n";
+	return out;
+}
+
+String GDScriptNativeEmitter::get_build_script(const String &p_source_file) {
+	const String library = p_source_file.get_file().get_basename();
+	String out;
+	out += "# Generated by the GDScript native emitter. Builds the library for the \"gdscript/native/library\" project setting:\n";
+	out += "#   scons -f " + library + ".scons engine_path=<engine source> [precision=double]\n";
+	out += "# Only the C interface headers are used, the engine itself doesn't need to be built.\n\n";
+	out += "import os\n\n";
+	out += "env = Environment(ENV=os.environ)\n";
+	out += "env.Append(CPPPATH=[ARGUMENTS.get(\"engine_path\", \".\")])\n";
+	out += "if ARGUMENTS.get(\"precision\", \"single\") == \"double\":\n";
+	out += "    env.Append(CPPDEFINES=[\"REAL_T_IS_DOUBLE\"])\n";
+	out += "if env[\"CC\"] == \"cl\":\n";
+	out += "    env.Append(CXXFLAGS=[\"/std:c++17\", \"/O2\"])\n";
+	out += "else:\n";
+	out += "    env.Append(CXXFLAGS=[\"-std=c++17\", \"-O2\", \"-fvisibility=hidden\"])\n";
+	out += "env.SharedLibrary(\"" + library.c_escape() + "\", [\"" + p_source_file.get_file().c_escape() + "\"])\n";
+	return out;
+}
@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  gdscript_native_emitter.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_EMITTER_H
+#define GDSCRIPT_NATIVE_EMITTER_H
+
+#include "../gdscript.h"
+
+#include "core/templates/hash_set.h"
+
+// Translates compiled GDScript bytecode into C++, one native body per function.
+// The output builds into a shared library that GDScriptNative loads at startup
+// (see the "gdscript/native/library" project setting).
+//
+// Bodies replace instruction dispatch, not semantics: they run on the interpreter's
+// stack and call the same validated operators, getters and method binds. They only use
+// the C interface of gdscript_native_body.h, so the library builds without engine sources
+// and loads into any export template with the same interface version and precision. Each function
+// is translated up to the first instruction the emitter doesn't cover; from there the
+// body hands the current address back to the interpreter, which finishes the call.
+class GDScriptNativeEmitter {
+	bool release_bytecode = true;
+	int body_count = 0;
+	String bodies;
+	String registrations;
+
+	struct EmitState {
+		const GDScriptFunction *function = nullptr;
+		int end = 0; // First address not covered by the body.
+		HashSet<int> boundaries;
+		HashSet<int> jump_targets;
+	};
+
+	static String _address(const GDScriptFunction *p_function, int p_pos);
+	static String _jump(EmitState &p_state, int p_target);
+	static String _args(const GDScriptFunction *p_function, int p_ip, int p_argc);
+	static bool _emit_instruction(EmitState &p_state, int p_ip, String &r_code, int &r_size);
+
+	void _emit_function(const GDScriptFunction *p_function, const String &p_script);
+	void _emit_script(const GDScript *p_script);
+
+public:
+	// Emit bodies matching the bytecode of release export templates (the default), or of debug ones.
+	void set_release_bytecode(bool p_enable) { release_bytecode = p_enable; }
+
+	Error add_script(const String &p_path);
+	int get_body_count() const { return body_count; }
+	String get_source() const;
+	// SCons script building the source written as p_source_file into a shared library.
+	static String get_build_script(const String &p_source_file);
+};
+
+#endif // GDSCRIPT_NATIVE_EMITTER_H
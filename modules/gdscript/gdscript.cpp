@@ -33,10 +33,13 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_native.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -815,74 +818,97 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	// Resource loads reload with p_keep_state too, only a script that never compiled is loaded for the first time.
+	const bool first_load = !is_valid();
+
+	// Only a first load can come from the cache, hot reloads need the old state carried over by the compiler.
+	const String bytecode_cache_path = first_load ? GDScriptBytecodeCache::get_cache_path(this) : String();
+
 	valid = false;
-	GDScriptParser parser;
 	Error err;
-	if (!binary_tokens.is_empty()) {
-		err = parser.parse_binary(binary_tokens, path);
+	if (!bytecode_cache_path.is_empty() && GDScriptBytecodeCache::load(this, bytecode_cache_path) == OK) {
+		can_run = ScriptServer::is_scripting_enabled() || is_tool();
 	} else {
-		err = parser.parse(source, path, false);
-	}
-	if (err) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+		GDScriptParser parser;
+		if (!binary_tokens.is_empty()) {
+			err = parser.parse_binary(binary_tokens, path);
+		} else {
+			err = parser.parse(source, path, false);
 		}
-		// TODO: Show all error messages.
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-		reloading = false;
-		return ERR_PARSE_ERROR;
-	}
-
-	GDScriptAnalyzer analyzer(&parser);
-	err = analyzer.analyze();
-
-	if (err) {
-		if (EngineDebugger::is_active()) {
-			GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+		if (err) {
+			if (EngineDebugger::is_active()) {
+				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			}
+			// TODO: Show all error messages.
+			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), parser.get_errors().front()->get().line, ("Parse Error: " + parser.get_errors().front()->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+			reloading = false;
+			return ERR_PARSE_ERROR;
 		}
 
-		const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
-		while (e != nullptr) {
-			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-			e = e->next();
+		if (first_load) {
+			// Parse the scripts this one refers to in parallel, rather than one at a time as the analysis reaches them.
+			// Hot reloads skip it, what they refer to was loaded with the previous version already.
+			GDScriptCache::prefetch_parsers(&parser);
 		}
-		reloading = false;
-		return ERR_PARSE_ERROR;
-	}
-
-	can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
 
-	GDScriptCompiler compiler;
-	err = compiler.compile(&parser, this, p_keep_state);
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
 
-	if (err) {
-		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
-		if (can_run) {
+		if (err) {
 			if (EngineDebugger::is_active()) {
-				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), compiler.get_error_line(), "Parser Error: " + compiler.get_error());
+				GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), parser.get_errors().front()->get().line, "Parser Error: " + parser.get_errors().front()->get().message);
+			}
+
+			const List<GDScriptParser::ParserError>::Element *e = parser.get_errors().front();
+			while (e != nullptr) {
+				_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), e->get().line, ("Parse Error: " + e->get().message).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+				e = e->next();
 			}
 			reloading = false;
-			return ERR_COMPILATION_FAILED;
-		} else {
-			reloading = false;
-			return err;
+			return ERR_PARSE_ERROR;
+		}
+
+		can_run = ScriptServer::is_scripting_enabled() || parser.is_tool();
+
+		GDScriptCompiler compiler;
+		err = compiler.compile(&parser, this, p_keep_state);
+
+		if (err) {
+			_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+			if (can_run) {
+				if (EngineDebugger::is_active()) {
+					GDScriptLanguage::get_singleton()->debug_break_parse(_get_debug_path(), compiler.get_error_line(), "Parser Error: " + compiler.get_error());
+				}
+				reloading = false;
+				return ERR_COMPILATION_FAILED;
+			} else {
+				reloading = false;
+				return err;
+			}
+		}
+
+		if (!bytecode_cache_path.is_empty()) {
+			Error cache_err = GDScriptBytecodeCache::save(this, parser, bytecode_cache_path);
+			if (cache_err != OK) {
+				print_verbose(vformat(R"(GDScript: Not caching the bytecode of "%s": %s.)", path, error_names[cache_err]));
+			}
 		}
-	}
 
 #ifdef TOOLS_ENABLED
-	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
-	// which are made by calling make_scripts() within compiler.compile() above.
-	GDScriptDocGen::generate_docs(this, parser.get_tree());
+		// Done after compilation because it needs the GDScript object's inner class GDScript objects,
+		// which are made by calling make_scripts() within compiler.compile() above.
+		GDScriptDocGen::generate_docs(this, parser.get_tree());
 #endif
 
 #ifdef DEBUG_ENABLED
-	for (const GDScriptWarning &warning : parser.get_warnings()) {
-		if (EngineDebugger::is_active()) {
-			Vector<ScriptLanguage::StackInfo> si;
-			EngineDebugger::get_script_debugger()->send_error("", get_script_path(), warning.start_line, warning.get_name(), warning.get_message(), false, ERR_HANDLER_WARNING, si);
+		for (const GDScriptWarning &warning : parser.get_warnings()) {
+			if (EngineDebugger::is_active()) {
+				Vector<ScriptLanguage::StackInfo> si;
+				EngineDebugger::get_script_debugger()->send_error("", get_script_path(), warning.start_line, warning.get_name(), warning.get_message(), false, ERR_HANDLER_WARNING, si);
+			}
 		}
-	}
 #endif
+	}
 
 	if (can_run) {
 		err = _static_init();
@@ -1653,6 +1679,9 @@ GDScript::~GDScript() {
 	}
 	destructing = true;
 
+	// The address of this script may be reused by another one, which must not hit its cache entries.
+	GDScriptFunction::invalidate_inline_caches();
+
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
 		if (!func_ptrs_to_update.is_empty()) {
@@ -2303,6 +2332,25 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+	GLOBAL_DEF("gdscript/bytecode_cache/enabled", false);
+
+	GLOBAL_DEF("debug/gdscript/sampling_profiler/enabled", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/gdscript/sampling_profiler/interval_usec", PROPERTY_HINT_RANGE, "50,100000,1,suffix:\u00B5s"), 1000);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "debug/gdscript/sampling_profiler/output_path", PROPERTY_HINT_SAVE_FILE), "user://gdscript_samples");
+	if (GLOBAL_GET("debug/gdscript/sampling_profiler/enabled") && !Engine::get_singleton()->is_editor_hint()) {
+		GDScriptSampler::start(GLOBAL_GET("debug/gdscript/sampling_profiler/interval_usec"));
+	}
+
+	String native_library = GLOBAL_DEF(PropertyInfo(Variant::STRING, "gdscript/native/library", PROPERTY_HINT_FILE, "*.so,*.dll,*.dylib"), String());
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		native_library = String(); // Scripts are edited live, never run stale native bodies in the editor.
+	}
+#endif
+	if (!native_library.is_empty()) {
+		GDScriptNative::load_library(native_library);
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2344,6 +2392,15 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	if (GDScriptSampler::is_running()) {
+		GDScriptSampler::stop();
+		const String output_path = GLOBAL_GET("debug/gdscript/sampling_profiler/output_path");
+		if (GDScriptSampler::save(output_path) == OK) {
+			print_line(vformat("GDScript sampling profiler: %d samples written to \"%s\".", GDScriptSampler::get_sample_count(), ProjectSettings::get_singleton()->globalize_path(output_path)));
+		}
+		GDScriptSampler::clear();
+	}
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2380,6 +2437,9 @@ void GDScriptLanguage::finish() {
 	script_list.clear();
 	function_list.clear();
 
+	GDScriptNative::unload_library();
+	GDScriptBytecodeCache::finish();
+
 	finishing = false;
 }
 
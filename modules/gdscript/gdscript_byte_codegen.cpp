@@ -33,9 +33,82 @@
 #include "gdscript_byte_codegen.h"
 
 #include "gdscript.h"
+#include "gdscript_native.h"
 
 #include "core/debugger/engine_debugger.h"
 
+// Returns the opcode operating directly on the values of the given types, or OPCODE_END if there is none.
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+#define TYPED_OPERATOR(m_operator, m_opcode) \
+	case Variant::m_operator:                \
+		return GDScriptFunction::OPCODE_##m_opcode
+
+	switch (p_left_type) {
+		case Variant::INT: {
+			if (p_right_type == Variant::INT) {
+				switch (p_operator) {
+					TYPED_OPERATOR(OP_ADD, ADD_INT_INT);
+					TYPED_OPERATOR(OP_SUBTRACT, SUBTRACT_INT_INT);
+					TYPED_OPERATOR(OP_MULTIPLY, MULTIPLY_INT_INT);
+					TYPED_OPERATOR(OP_LESS, LESS_INT_INT);
+					TYPED_OPERATOR(OP_LESS_EQUAL, LESS_EQUAL_INT_INT);
+					TYPED_OPERATOR(OP_GREATER, GREATER_INT_INT);
+					TYPED_OPERATOR(OP_GREATER_EQUAL, GREATER_EQUAL_INT_INT);
+					TYPED_OPERATOR(OP_EQUAL, EQUAL_INT_INT);
+					TYPED_OPERATOR(OP_NOT_EQUAL, NOT_EQUAL_INT_INT);
+					default:
+						break;
+				}
+			}
+		} break;
+		case Variant::FLOAT: {
+			if (p_right_type == Variant::FLOAT) {
+				switch (p_operator) {
+					TYPED_OPERATOR(OP_ADD, ADD_FLOAT_FLOAT);
+					TYPED_OPERATOR(OP_SUBTRACT, SUBTRACT_FLOAT_FLOAT);
+					TYPED_OPERATOR(OP_MULTIPLY, MULTIPLY_FLOAT_FLOAT);
+					TYPED_OPERATOR(OP_DIVIDE, DIVIDE_FLOAT_FLOAT);
+					TYPED_OPERATOR(OP_LESS, LESS_FLOAT_FLOAT);
+					TYPED_OPERATOR(OP_LESS_EQUAL, LESS_EQUAL_FLOAT_FLOAT);
+					TYPED_OPERATOR(OP_GREATER, GREATER_FLOAT_FLOAT);
+					TYPED_OPERATOR(OP_GREATER_EQUAL, GREATER_EQUAL_FLOAT_FLOAT);
+					default:
+						break;
+				}
+			}
+		} break;
+		case Variant::VECTOR2: {
+			if (p_right_type == Variant::VECTOR2) {
+				switch (p_operator) {
+					TYPED_OPERATOR(OP_ADD, ADD_VECTOR2_VECTOR2);
+					TYPED_OPERATOR(OP_SUBTRACT, SUBTRACT_VECTOR2_VECTOR2);
+					default:
+						break;
+				}
+			} else if (p_right_type == Variant::FLOAT && p_operator == Variant::OP_MULTIPLY) {
+				return GDScriptFunction::OPCODE_MULTIPLY_VECTOR2_FLOAT;
+			}
+		} break;
+		case Variant::VECTOR3: {
+			if (p_right_type == Variant::VECTOR3) {
+				switch (p_operator) {
+					TYPED_OPERATOR(OP_ADD, ADD_VECTOR3_VECTOR3);
+					TYPED_OPERATOR(OP_SUBTRACT, SUBTRACT_VECTOR3_VECTOR3);
+					default:
+						break;
+				}
+			} else if (p_right_type == Variant::FLOAT && p_operator == Variant::OP_MULTIPLY) {
+				return GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT;
+			}
+		} break;
+		default:
+			break;
+	}
+
+#undef TYPED_OPERATOR
+	return GDScriptFunction::OPCODE_END;
+}
+
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
 	function->_argument_count++;
 	function->argument_types.push_back(p_type);
@@ -150,10 +223,60 @@ void GDScriptByteCodeGenerator::pop_temporary() {
 	used_temporaries.pop_back();
 }
 
+void GDScriptByteCodeGenerator::append_conditional_jump(GDScriptFunction::Opcode p_jump, const Address &p_condition) {
+	// A comparison used only as condition is fused with the jump, unless something jumps right after it.
+	if (last_operator_pos >= last_jump_target && last_operator_pos + last_operator_size == opcodes.size() &&
+			last_operator_result_type == Variant::BOOL && is_same_address(last_operator_target, p_condition)) {
+		complete_validated_operator();
+		if (p_jump == GDScriptFunction::OPCODE_JUMP_IF) {
+			opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF;
+		} else {
+			opcodes.write[last_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+		}
+		last_operator_pos = -1;
+		return;
+	}
+
+	append_opcode(p_jump);
+	append(p_condition);
+}
+
+void GDScriptByteCodeGenerator::complete_validated_operator() {
+	// Typed operators don't store the validated evaluator, which the superinstructions need.
+	if (last_operator_size == 4) {
+		append(last_operator_func);
+#ifdef DEBUG_ENABLED
+		add_debug_name(operator_names, get_operation_pos(last_operator_func), Variant::get_operator_name(last_operator));
+#endif
+		last_operator_size = 5;
+	}
+}
+
+void GDScriptByteCodeGenerator::remove_opcode_word(int p_pos) {
+	opcodes.remove_at(p_pos);
+
+	// Temporaries are resolved in `write_end()`, so shift the positions of the ones written after the removed word.
+	for (int i = 0; i < temporaries.size(); i++) {
+		Vector<int> &indices = temporaries.write[i].bytecode_indices;
+		for (int j = indices.size() - 1; j >= 0 && indices[j] > p_pos; j--) {
+			indices.write[j]--;
+		}
+	}
+	Vector<int> &global_positions = function->global_index_positions;
+	for (int i = global_positions.size() - 1; i >= 0 && global_positions[i] > p_pos; i--) {
+		global_positions.write[i]--;
+	}
+	Vector<Pair<int, int>> &line_starts = function->line_starts;
+	for (int i = line_starts.size() - 1; i >= 0 && line_starts[i].first > p_pos; i--) {
+		line_starts.write[i].first--;
+	}
+}
+
 void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
 		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
+		mark_jump_target();
 	}
 }
 
@@ -397,6 +520,14 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -413,6 +544,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	function->gds_utilities_names = gds_utilities_names;
 #endif
 
+	GDScriptNative::attach(function);
+
 	ended = true;
 	return function;
 }
@@ -617,6 +750,24 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		last_operator_pos = opcodes.size();
+		last_operator_target = p_target;
+		last_operator_result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		last_operator = p_operator;
+		last_operator_func = op_func;
+
+		// Operate on the unboxed values when there's a specialized opcode for these types.
+		GDScriptFunction::Opcode typed_opcode = _get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			last_operator_size = 4;
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
+		last_operator_size = 5;
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -695,15 +846,13 @@ void GDScriptByteCodeGenerator::write_type_test(const Address &p_target, const A
 }
 
 void GDScriptByteCodeGenerator::write_and_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_left_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_and_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_right_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -722,18 +871,17 @@ void GDScriptByteCodeGenerator::write_end_and(const Address &p_target) {
 	logic_op_jump_pos2.pop_back();
 	append_opcode(GDScriptFunction::OPCODE_ASSIGN_FALSE);
 	append(p_target);
+	mark_jump_target(); // Target of the jump away from the other condition.
 }
 
 void GDScriptByteCodeGenerator::write_or_left_operand(const Address &p_left_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_left_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF, p_left_operand);
 	logic_op_jump_pos1.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
 
 void GDScriptByteCodeGenerator::write_or_right_operand(const Address &p_right_operand) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF);
-	append(p_right_operand);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF, p_right_operand);
 	logic_op_jump_pos2.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -752,6 +900,7 @@ void GDScriptByteCodeGenerator::write_end_or(const Address &p_target) {
 	logic_op_jump_pos2.pop_back();
 	append_opcode(GDScriptFunction::OPCODE_ASSIGN_TRUE);
 	append(p_target);
+	mark_jump_target(); // Target of the jump away from the other condition.
 }
 
 void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
@@ -759,8 +908,7 @@ void GDScriptByteCodeGenerator::write_start_ternary(const Address &p_target) {
 }
 
 void GDScriptByteCodeGenerator::write_ternary_condition(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_condition);
 	ternary_jump_fail_pos.push_back(opcodes.size());
 	append(0); // Jump target, will be patched.
 }
@@ -863,6 +1011,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append(inline_cache_count++);
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -881,15 +1030,31 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append(inline_cache_count++);
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
+	// Fuse `member op= value` (get member, validated operator, set member) into one instruction.
+	if (last_get_member_pos >= last_jump_target && last_get_member_pos + 3 == last_operator_pos && last_operator_pos + last_operator_size == opcodes.size() &&
+			last_get_member_name == p_name && is_same_address(last_operator_target, p_value)) {
+		complete_validated_operator();
+		// The opcode of the operator is no longer needed, the rest of it follows the member operands.
+		opcodes.write[last_get_member_pos] = GDScriptFunction::OPCODE_SET_MEMBER_OPERATOR_VALIDATED;
+		remove_opcode_word(last_operator_pos);
+		last_get_member_pos = -1;
+		last_operator_pos = -1;
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_SET_MEMBER);
 	append(p_value);
 	append(p_name);
 }
 
 void GDScriptByteCodeGenerator::write_get_member(const Address &p_target, const StringName &p_name) {
+	last_get_member_pos = opcodes.size();
+	last_get_member_name = p_name;
+
 	append_opcode(GDScriptFunction::OPCODE_GET_MEMBER);
 	append(p_target);
 	append(p_name);
@@ -996,7 +1161,7 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_target);
 		append(p_source);
 		append(p_target.type.builtin_type);
-	} else {
+	} else if (!is_same_address(p_target, p_source)) {
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
 		append(p_source);
@@ -1025,11 +1190,13 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 		write_assign(p_dst, p_src);
 	}
 	function->default_arguments.push_back(opcodes.size());
+	mark_jump_target();
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
+	function->global_index_positions.push_back(opcodes.size());
 	append(p_global_index);
 }
 
@@ -1095,6 +1262,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1120,6 +1288,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1354,6 +1523,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1367,6 +1537,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1380,6 +1551,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append(inline_cache_count++);
 	ct.cleanup();
 }
 
@@ -1514,8 +1686,7 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 }
 
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
 }
@@ -1680,12 +1851,14 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 	// Next iteration.
 	int continue_addr = opcodes.size();
 	continue_addrs.push_back(continue_addr);
+	mark_jump_target();
 	append_opcode(iterate_opcode);
 	append(counter);
 	append(container);
 	append(p_use_conversion ? temp : p_variable);
 	for_jmp_addrs.push_back(opcodes.size());
 	append(0); // Jump destination, will be patched.
+	mark_jump_target(); // Target of the jump skipping over 'continue' code.
 
 	if (p_use_conversion) {
 		write_assign_with_conversion(p_variable, temp);
@@ -1721,12 +1894,12 @@ void GDScriptByteCodeGenerator::write_endfor() {
 void GDScriptByteCodeGenerator::start_while_condition() {
 	current_breaks_to_patch.push_back(List<int>());
 	continue_addrs.push_back(opcodes.size());
+	mark_jump_target();
 }
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
-	append(p_condition);
+	append_conditional_jump(GDScriptFunction::OPCODE_JUMP_IF_NOT, p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
 	append(0); // End of loop address, will be patched.
 }
@@ -1764,11 +1937,23 @@ void GDScriptByteCodeGenerator::write_breakpoint() {
 }
 
 void GDScriptByteCodeGenerator::write_newline(int p_line) {
+	function->line_starts.push_back(Pair<int, int>(opcodes.size(), p_line));
 	append_opcode(GDScriptFunction::OPCODE_LINE);
 	append(p_line);
 	current_line = p_line;
 }
 
+void GDScriptByteCodeGenerator::write_line_start(int p_line) {
+	// Statements without code start where the next one does, only the last of them is kept.
+	Vector<Pair<int, int>> &line_starts = function->line_starts;
+	if (!line_starts.is_empty() && line_starts[line_starts.size() - 1].first == opcodes.size()) {
+		line_starts.write[line_starts.size() - 1].second = p_line;
+	} else {
+		line_starts.push_back(Pair<int, int>(opcodes.size(), p_line));
+	}
+	current_line = p_line;
+}
+
 void GDScriptByteCodeGenerator::write_return(const Address &p_return_value) {
 	if (!function->return_type.has_type || p_return_value.type.has_type) {
 		// Either the function is untyped or the return value is also typed.
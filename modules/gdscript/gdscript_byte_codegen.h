@@ -100,6 +100,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -160,6 +161,18 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	List<List<int>> current_breaks_to_patch;
 
+	// Peephole state. Instructions are fused with the ones written right before them
+	// as long as no jump may land in between, so the last jump target is tracked too.
+	int last_jump_target = 0;
+	int last_operator_pos = -1;
+	int last_operator_size = 0;
+	Address last_operator_target;
+	Variant::Type last_operator_result_type = Variant::NIL;
+	Variant::Operator last_operator = Variant::OP_MAX;
+	Variant::ValidatedOperatorEvaluator last_operator_func = nullptr;
+	int last_get_member_pos = -1;
+	StringName last_get_member_name;
+
 	void add_stack_identifier(const StringName &p_id, int p_stackpos) {
 		if (locals.size() > max_locals) {
 			max_locals = locals.size();
@@ -451,8 +464,21 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		mark_jump_target();
+	}
+
+	void mark_jump_target() {
+		last_jump_target = opcodes.size();
 	}
 
+	static bool is_same_address(const Address &p_a, const Address &p_b) {
+		return p_a.mode == p_b.mode && p_a.address == p_b.address;
+	}
+
+	void append_conditional_jump(GDScriptFunction::Opcode p_jump, const Address &p_condition);
+	void complete_validated_operator();
+	void remove_opcode_word(int p_pos);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -549,6 +575,7 @@ public:
 	virtual void write_continue() override;
 	virtual void write_breakpoint() override;
 	virtual void write_newline(int p_line) override;
+	virtual void write_line_start(int p_line) override;
 	virtual void write_return(const Address &p_return_value) override;
 	virtual void write_assert(const Address &p_test, const Address &p_message) override;
 
@@ -0,0 +1,1565 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript_cache.h"
+#include "gdscript_native.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/dir_access.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+
+static const uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+
+Mutex GDScriptBytecodeCache::mutex;
+GDScriptBytecodeCache::Symbols *GDScriptBytecodeCache::symbols = nullptr;
+HashMap<String, uint64_t> GDScriptBytecodeCache::source_hashes;
+uint64_t GDScriptBytecodeCache::environment_hash = 0;
+
+template <typename T>
+static uint64_t _symbol_key(T p_pointer) {
+	return (uint64_t)reinterpret_cast<uintptr_t>(p_pointer);
+}
+
+static bool _read_count(const Ref<FileAccess> &p_file, uint32_t &r_count) {
+	r_count = p_file->get_32();
+	return !p_file->eof_reached() && r_count <= p_file->get_length();
+}
+
+static bool _read_type(const Ref<FileAccess> &p_file, Variant::Type &r_type) {
+	const uint32_t type = p_file->get_32();
+	r_type = Variant::Type(type);
+	return type < Variant::VARIANT_MAX;
+}
+
+/* Engine tables, stored by the names they are looked up with. */
+
+static void _store_symbol(const Ref<FileAccess> &p_file, const Vector3i &p_symbol) {
+	p_file->store_32(p_symbol.x);
+	p_file->store_32(p_symbol.y);
+	p_file->store_32(p_symbol.z);
+}
+
+static void _store_symbol(const Ref<FileAccess> &p_file, const Vector2i &p_symbol) {
+	p_file->store_32(p_symbol.x);
+	p_file->store_32(p_symbol.y);
+}
+
+static void _store_symbol(const Ref<FileAccess> &p_file, Variant::Type p_symbol) {
+	p_file->store_32(p_symbol);
+}
+
+static void _store_symbol(const Ref<FileAccess> &p_file, const StringName &p_symbol) {
+	p_file->store_pascal_string(p_symbol);
+}
+
+static void _store_symbol(const Ref<FileAccess> &p_file, const Pair<Variant::Type, StringName> &p_symbol) {
+	p_file->store_32(p_symbol.first);
+	p_file->store_pascal_string(p_symbol.second);
+}
+
+template <typename T, typename S>
+static bool _store_table(const Ref<FileAccess> &p_file, const Vector<T> &p_table, const HashMap<uint64_t, S> &p_symbols) {
+	p_file->store_32(p_table.size());
+	for (const T &entry : p_table) {
+		const S *symbol = p_symbols.getptr(_symbol_key(entry));
+		if (symbol == nullptr) {
+			return false;
+		}
+		_store_symbol(p_file, *symbol);
+	}
+	return true;
+}
+
+static bool _resolve_operator(const Ref<FileAccess> &p_file, Variant::ValidatedOperatorEvaluator &r_entry) {
+	const uint32_t op = p_file->get_32();
+	Variant::Type left, right;
+	if (!_read_type(p_file, left) || !_read_type(p_file, right) || op >= Variant::OP_MAX) {
+		return false;
+	}
+	r_entry = Variant::get_validated_operator_evaluator(Variant::Operator(op), left, right);
+	return r_entry != nullptr;
+}
+
+static bool _resolve_setter(const Ref<FileAccess> &p_file, Variant::ValidatedSetter &r_entry) {
+	Variant::Type type;
+	const bool valid_type = _read_type(p_file, type);
+	const StringName member = p_file->get_pascal_string();
+	r_entry = valid_type ? Variant::get_member_validated_setter(type, member) : nullptr;
+	return r_entry != nullptr;
+}
+
+static bool _resolve_getter(const Ref<FileAccess> &p_file, Variant::ValidatedGetter &r_entry) {
+	Variant::Type type;
+	const bool valid_type = _read_type(p_file, type);
+	const StringName member = p_file->get_pascal_string();
+	r_entry = valid_type ? Variant::get_member_validated_getter(type, member) : nullptr;
+	return r_entry != nullptr;
+}
+
+static bool _resolve_keyed_setter(const Ref<FileAccess> &p_file, Variant::ValidatedKeyedSetter &r_entry) {
+	Variant::Type type;
+	r_entry = _read_type(p_file, type) ? Variant::get_member_validated_keyed_setter(type) : nullptr;
+	return r_entry != nullptr;
+}
+
+static bool _resolve_keyed_getter(const Ref<FileAccess> &p_file, Variant::ValidatedKeyedGetter &r_entry) {
+	Variant::Type type;
+	r_entry = _read_type(p_file, type) ? Variant::get_member_validated_keyed_getter(type) : nullptr;
+	return r_entry != nullptr;
+}
+
+static bool _resolve_indexed_setter(const Ref<FileAccess> &p_file, Variant::ValidatedIndexedSetter &r_entry) {
+	Variant::Type type;
+	r_entry = _read_type(p_file, type) ? Variant::get_member_validated_indexed_setter(type) : nullptr;
+	return r_entry != nullptr;
+}
+
+static bool _resolve_indexed_getter(const Ref<FileAccess> &p_file, Variant::ValidatedIndexedGetter &r_entry) {
+	Variant::Type type;
+	r_entry = _read_type(p_file, type) ? Variant::get_member_validated_indexed_getter(type) : nullptr;
+	return r_entry != nullptr;
+}
+
+static bool _resolve_builtin_method(const Ref<FileAccess> &p_file, Variant::ValidatedBuiltInMethod &r_entry) {
+	Variant::Type type;
+	const bool valid_type = _read_type(p_file, type);
+	const StringName method = p_file->get_pascal_string();
+	r_entry = valid_type ? Variant::get_validated_builtin_method(type, method) : nullptr;
+	return r_entry != nullptr;
+}
+
+static bool _resolve_constructor(const Ref<FileAccess> &p_file, Variant::ValidatedConstructor &r_entry) {
+	Variant::Type type;
+	const bool valid_type = _read_type(p_file, type);
+	const int constructor = p_file->get_32();
+	if (!valid_type || constructor < 0 || constructor >= Variant::get_constructor_count(type)) {
+		return false;
+	}
+	r_entry = Variant::get_validated_constructor(type, constructor);
+	return r_entry != nullptr;
+}
+
+static bool _resolve_utility(const Ref<FileAccess> &p_file, Variant::ValidatedUtilityFunction &r_entry) {
+	r_entry = Variant::get_validated_utility_function(p_file->get_pascal_string());
+	return r_entry != nullptr;
+}
+
+static bool _resolve_gds_utility(const Ref<FileAccess> &p_file, GDScriptUtilityFunctions::FunctionPtr &r_entry) {
+	r_entry = GDScriptUtilityFunctions::get_function(p_file->get_pascal_string());
+	return r_entry != nullptr;
+}
+
+template <typename T>
+static bool _load_table(const Ref<FileAccess> &p_file, Vector<T> &r_table, bool (*p_resolve)(const Ref<FileAccess> &, T &)) {
+	uint32_t size;
+	if (!_read_count(p_file, size)) {
+		return false;
+	}
+	r_table.resize(size);
+	for (uint32_t i = 0; i < size; i++) {
+		if (!p_resolve(p_file, r_table.write[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+const GDScriptBytecodeCache::Symbols *GDScriptBytecodeCache::_get_symbols() {
+	MutexLock lock(mutex);
+	if (symbols) {
+		return symbols;
+	}
+	symbols = memnew(Symbols);
+
+	for (int op = 0; op < Variant::OP_MAX; op++) {
+		for (int left = 0; left < Variant::VARIANT_MAX; left++) {
+			for (int right = 0; right < Variant::VARIANT_MAX; right++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(left), Variant::Type(right));
+				if (evaluator) {
+					symbols->operators.insert(_symbol_key(evaluator), Vector3i(op, left, right));
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = Variant::Type(i);
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			if (Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member)) {
+				symbols->setters.insert(_symbol_key(setter), Pair<Variant::Type, StringName>(type, member));
+			}
+			if (Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member)) {
+				symbols->getters.insert(_symbol_key(getter), Pair<Variant::Type, StringName>(type, member));
+			}
+		}
+
+		if (Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type)) {
+			symbols->keyed_setters.insert(_symbol_key(keyed_setter), type);
+		}
+		if (Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type)) {
+			symbols->keyed_getters.insert(_symbol_key(keyed_getter), type);
+		}
+		if (Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type)) {
+			symbols->indexed_setters.insert(_symbol_key(indexed_setter), type);
+		}
+		if (Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type)) {
+			symbols->indexed_getters.insert(_symbol_key(indexed_getter), type);
+		}
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			if (Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method)) {
+				symbols->builtin_methods.insert(_symbol_key(builtin_method), Pair<Variant::Type, StringName>(type, method));
+			}
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			if (Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j)) {
+				symbols->constructors.insert(_symbol_key(constructor), Vector2i(i, j));
+			}
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		if (Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(utility)) {
+			symbols->utilities.insert(_symbol_key(function), utility);
+		}
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		if (GDScriptUtilityFunctions::FunctionPtr function = GDScriptUtilityFunctions::get_function(utility)) {
+			symbols->gds_utilities.insert(_symbol_key(function), utility);
+		}
+	}
+
+	return symbols;
+}
+
+/* Hashes deciding whether a file is still valid. */
+
+uint64_t GDScriptBytecodeCache::_get_environment_hash() {
+	MutexLock lock(mutex);
+	if (environment_hash != 0) {
+		return environment_hash;
+	}
+
+	uint64_t hash = hash64_murmur3_64(FORMAT_VERSION, HASH_MURMUR3_SEED);
+	hash = hash64_murmur3_64(String(VERSION_FULL_BUILD).hash64(), hash);
+	hash = hash64_murmur3_64(String(VERSION_HASH).hash64(), hash);
+	hash = hash64_murmur3_64(GDScriptFunction::OPCODE_END, hash);
+
+	uint32_t flags = 0;
+#ifdef DEBUG_ENABLED
+	flags |= 1 << 0;
+#endif
+#ifdef TOOLS_ENABLED
+	flags |= 1 << 1;
+#endif
+	if (EngineDebugger::is_active()) {
+		flags |= 1 << 2; // Stack debug info and profiler signatures are only generated with a debugger attached.
+	}
+	hash = hash64_murmur3_64(flags, hash);
+
+	// Analysis resolves identifiers against global classes and autoloads, which aren't tracked as dependencies.
+	List<StringName> global_classes;
+	ScriptServer::get_global_class_list(&global_classes);
+	global_classes.sort_custom<StringName::AlphCompare>();
+	for (const StringName &name : global_classes) {
+		hash = hash64_murmur3_64(String(name).hash64(), hash);
+		hash = hash64_murmur3_64(ScriptServer::get_global_class_path(name).hash64(), hash);
+		hash = hash64_murmur3_64(String(ScriptServer::get_global_class_base(name)).hash64(), hash);
+	}
+
+	List<StringName> autoloads;
+	for (const KeyValue<StringName, ProjectSettings::AutoloadInfo> &E : ProjectSettings::get_singleton()->get_autoload_list()) {
+		autoloads.push_back(E.key);
+	}
+	autoloads.sort_custom<StringName::AlphCompare>();
+	for (const StringName &name : autoloads) {
+		const ProjectSettings::AutoloadInfo &info = ProjectSettings::get_singleton()->get_autoload_list()[name];
+		hash = hash64_murmur3_64(String(name).hash64(), hash);
+		hash = hash64_murmur3_64(info.path.hash64(), hash);
+		hash = hash64_murmur3_64(info.is_singleton, hash);
+	}
+
+	environment_hash = hash != 0 ? hash : 1;
+	return environment_hash;
+}
+
+uint64_t GDScriptBytecodeCache::_hash_source(const String &p_source, const Vector<uint8_t> &p_binary_tokens) {
+	CharString utf8;
+	const uint8_t *data = p_binary_tokens.ptr();
+	int length = p_binary_tokens.size();
+	if (p_binary_tokens.is_empty()) {
+		utf8 = p_source.utf8();
+		data = (const uint8_t *)utf8.get_data();
+		length = utf8.length();
+	}
+	return (uint64_t(hash_murmur3_buffer(data, length)) << 32) | hash_murmur3_buffer(data, length, ~HASH_MURMUR3_SEED);
+}
+
+uint64_t GDScriptBytecodeCache::_get_dependency_hash(const String &p_path) {
+	{
+		MutexLock lock(mutex);
+		const uint64_t *hash = source_hashes.getptr(p_path);
+		if (hash) {
+			return *hash;
+		}
+	}
+
+	// Read the same file GDScriptCache would, so the hash matches what the dependency gets compiled from.
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	uint64_t hash = 0;
+	if (FileAccess::exists(remapped_path)) {
+		if (remapped_path.get_extension().to_lower() == "gdc") {
+			hash = _hash_source(String(), GDScriptCache::get_binary_tokens(remapped_path));
+		} else {
+			hash = _hash_source(GDScriptCache::get_source_code(remapped_path), Vector<uint8_t>());
+		}
+	}
+
+	MutexLock lock(mutex);
+	source_hashes[p_path] = hash;
+	return hash;
+}
+
+static void _collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_paths) {
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+		if (r_paths.has(E.key)) {
+			continue;
+		}
+		r_paths.insert(E.key);
+		// What the analysis saw of a dependency can in turn depend on its own dependencies.
+		if (E.value.is_valid()) {
+			_collect_dependencies(E.value->get_parser(), r_paths);
+		}
+	}
+}
+
+/* Saving. */
+
+bool GDScriptBytecodeCache::_is_plain_variant(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID:
+		// Marshalling drops the read-only flag and the script element type of containers.
+		case Variant::ARRAY:
+		case Variant::DICTIONARY:
+			return false;
+		default:
+			return true;
+	}
+}
+
+bool GDScriptBytecodeCache::_store_script_ref(const SaveContext &p_context, const Ref<FileAccess> &p_file, const Script *p_script) {
+	if (p_script == nullptr) {
+		p_file->store_8(SCRIPT_REF_NONE);
+		return true;
+	}
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript) {
+		// Classes are found again from their file, so built-in scripts can only refer to themselves.
+		if (gdscript->path != p_context.main_path && !gdscript->path.is_resource_file()) {
+			return false;
+		}
+		p_file->store_8(SCRIPT_REF_GDSCRIPT);
+		p_file->store_pascal_string(gdscript->path);
+		p_file->store_pascal_string(gdscript->fully_qualified_name);
+		return true;
+	}
+
+	const String path = p_script->get_path();
+	if (!path.is_resource_file()) {
+		return false;
+	}
+	p_file->store_8(SCRIPT_REF_SCRIPT);
+	p_file->store_pascal_string(path);
+	return true;
+}
+
+bool GDScriptBytecodeCache::_store_variant(const SaveContext &p_context, const Ref<FileAccess> &p_file, const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			const Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				p_file->store_8(VARIANT_NULL_OBJECT);
+				return true;
+			}
+
+			const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object);
+			if (native_class) {
+				const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_class->get_name());
+				if (index == nullptr || GDScriptLanguage::get_singleton()->get_global_array()[*index].get_validated_object() != object) {
+					return false;
+				}
+				p_file->store_8(VARIANT_NATIVE_CLASS);
+				p_file->store_pascal_string(native_class->get_name());
+				return true;
+			}
+
+			const Script *script = Object::cast_to<Script>(object);
+			if (script) {
+				p_file->store_8(VARIANT_SCRIPT);
+				return _store_script_ref(p_context, p_file, script);
+			}
+
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource && resource->get_path().is_resource_file()) {
+				p_file->store_8(VARIANT_RESOURCE);
+				p_file->store_pascal_string(resource->get_path());
+				p_file->store_pascal_string(resource->get_class());
+				return true;
+			}
+
+			return false; // Only preloaded resources can be loaded again.
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			p_file->store_8(VARIANT_ARRAY);
+			p_file->store_8(array.is_read_only());
+			p_file->store_32(array.get_typed_builtin());
+			p_file->store_pascal_string(array.get_typed_class_name());
+			const Ref<Script> script = array.get_typed_script();
+			if (!_store_script_ref(p_context, p_file, script.ptr())) {
+				return false;
+			}
+			p_file->store_32(array.size());
+			for (const Variant &element : array) {
+				if (!_store_variant(p_context, p_file, element)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			p_file->store_8(VARIANT_DICTIONARY);
+			p_file->store_8(dictionary.is_read_only());
+			p_file->store_32(dictionary.get_typed_key_builtin());
+			p_file->store_pascal_string(dictionary.get_typed_key_class_name());
+			const Ref<Script> key_script = dictionary.get_typed_key_script();
+			if (!_store_script_ref(p_context, p_file, key_script.ptr())) {
+				return false;
+			}
+			p_file->store_32(dictionary.get_typed_value_builtin());
+			p_file->store_pascal_string(dictionary.get_typed_value_class_name());
+			const Ref<Script> value_script = dictionary.get_typed_value_script();
+			if (!_store_script_ref(p_context, p_file, value_script.ptr())) {
+				return false;
+			}
+
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			p_file->store_32(keys.size());
+			for (const Variant &key : keys) {
+				if (!_store_variant(p_context, p_file, key) || !_store_variant(p_context, p_file, dictionary[key])) {
+					return false;
+				}
+			}
+			return true;
+		}
+		default: {
+			if (!_is_plain_variant(p_value)) {
+				return false;
+			}
+			p_file->store_8(VARIANT_PLAIN);
+			p_file->store_var(p_value);
+			return true;
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::_store_data_type(const SaveContext &p_context, const Ref<FileAccess> &p_file, const GDScriptDataType &p_type) {
+	p_file->store_8(p_type.has_type);
+	p_file->store_8(p_type.kind);
+	p_file->store_32(p_type.builtin_type);
+	p_file->store_pascal_string(p_type.native_type);
+	if (!_store_script_ref(p_context, p_file, p_type.script_type)) {
+		return false;
+	}
+	p_file->store_32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		if (!_store_data_type(p_context, p_file, element_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_store_member(const SaveContext &p_context, const Ref<FileAccess> &p_file, const StringName &p_name, const GDScript::MemberInfo &p_member) {
+	p_file->store_pascal_string(p_name);
+	p_file->store_32(p_member.index);
+	p_file->store_pascal_string(p_member.setter);
+	p_file->store_pascal_string(p_member.getter);
+	if (!_store_data_type(p_context, p_file, p_member.data_type)) {
+		return false;
+	}
+	p_file->store_var(Dictionary(p_member.property_info));
+	return true;
+}
+
+bool GDScriptBytecodeCache::_store_function(const SaveContext &p_context, const Ref<FileAccess> &p_file, const GDScriptFunction *p_function) {
+	p_file->store_pascal_string(p_function->name);
+	p_file->store_8(p_function->_static);
+	p_file->store_32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		if (!_store_data_type(p_context, p_file, argument_type)) {
+			return false;
+		}
+	}
+	if (!_store_data_type(p_context, p_file, p_function->return_type)) {
+		return false;
+	}
+	p_file->store_var(Dictionary(p_function->method_info));
+	if (!_store_variant(p_context, p_file, p_function->rpc_config)) {
+		return false;
+	}
+	p_file->store_32(p_function->_initial_line);
+	p_file->store_32(p_function->_argument_count);
+	p_file->store_32(p_function->_stack_size);
+	p_file->store_32(p_function->_instruction_args_size);
+
+	p_file->store_32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_file->store_32(E.key);
+		p_file->store_32(E.value);
+	}
+
+	p_file->store_32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+		p_file->store_32(stack_debug.line);
+		p_file->store_32(stack_debug.pos);
+		p_file->store_8(stack_debug.added);
+		p_file->store_pascal_string(stack_debug.identifier);
+	}
+
+	p_file->store_32(p_function->line_starts.size());
+	for (const Pair<int, int> &line_start : p_function->line_starts) {
+		p_file->store_32(line_start.first);
+		p_file->store_32(line_start.second);
+	}
+
+	p_file->store_32(p_function->code.size());
+	p_file->store_buffer((const uint8_t *)p_function->code.ptr(), p_function->code.size() * sizeof(int));
+
+	// Global indices depend on registration order, keep the names instead.
+	p_file->store_32(p_function->global_index_positions.size());
+	for (int position : p_function->global_index_positions) {
+		const StringName *global_name = p_context.global_names.getptr(p_function->code[position]);
+		if (global_name == nullptr) {
+			return false;
+		}
+		p_file->store_32(position);
+		p_file->store_pascal_string(*global_name);
+	}
+
+	p_file->store_32(p_function->default_arguments.size());
+	for (int default_argument : p_function->default_arguments) {
+		p_file->store_32(default_argument);
+	}
+
+	p_file->store_32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_store_variant(p_context, p_file, constant)) {
+			return false;
+		}
+	}
+
+	p_file->store_32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_file->store_pascal_string(global_name);
+	}
+
+	const Symbols *table_symbols = p_context.symbols;
+	if (!_store_table(p_file, p_function->operator_funcs, table_symbols->operators) ||
+			!_store_table(p_file, p_function->setters, table_symbols->setters) ||
+			!_store_table(p_file, p_function->getters, table_symbols->getters) ||
+			!_store_table(p_file, p_function->keyed_setters, table_symbols->keyed_setters) ||
+			!_store_table(p_file, p_function->keyed_getters, table_symbols->keyed_getters) ||
+			!_store_table(p_file, p_function->indexed_setters, table_symbols->indexed_setters) ||
+			!_store_table(p_file, p_function->indexed_getters, table_symbols->indexed_getters) ||
+			!_store_table(p_file, p_function->builtin_methods, table_symbols->builtin_methods) ||
+			!_store_table(p_file, p_function->constructors, table_symbols->constructors) ||
+			!_store_table(p_file, p_function->utilities, table_symbols->utilities) ||
+			!_store_table(p_file, p_function->gds_utilities, table_symbols->gds_utilities)) {
+		return false;
+	}
+
+	p_file->store_32(p_function->methods.size());
+	for (MethodBind *method : p_function->methods) {
+		if (ClassDB::get_method(method->get_instance_class(), method->get_name()) != method) {
+			return false;
+		}
+		p_file->store_pascal_string(method->get_instance_class());
+		p_file->store_pascal_string(method->get_name());
+	}
+
+	p_file->store_32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *lambda_info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		if (lambda_info == nullptr) {
+			return false;
+		}
+		p_file->store_32(lambda_info->capture_count);
+		p_file->store_8(lambda_info->use_self);
+		if (!_store_function(p_context, p_file, lambda)) {
+			return false;
+		}
+	}
+
+	p_file->store_32(p_function->_inline_caches_count);
+
+#ifdef DEBUG_ENABLED
+	p_file->store_pascal_string(p_function->profile.signature);
+	p_file->store_var(p_function->operator_names);
+	p_file->store_var(p_function->setter_names);
+	p_file->store_var(p_function->getter_names);
+	p_file->store_var(p_function->builtin_methods_names);
+	p_file->store_var(p_function->constructors_names);
+	p_file->store_var(p_function->utilities_names);
+	p_file->store_var(p_function->gds_utilities_names);
+#endif
+
+	return true;
+}
+
+void GDScriptBytecodeCache::_store_skeleton(const Ref<FileAccess> &p_file, const GDScript *p_script) {
+	p_file->store_pascal_string(p_script->global_name);
+	p_file->store_pascal_string(p_script->simplified_icon_path);
+	p_file->store_32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_file->store_pascal_string(E.key);
+		p_file->store_pascal_string(E.value->fully_qualified_name);
+		_store_skeleton(p_file, E.value.ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::_store_class(const SaveContext &p_context, const Ref<FileAccess> &p_file, const GDScript *p_script) {
+	p_file->store_8(p_script->tool);
+	p_file->store_pascal_string(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+	if (!_store_script_ref(p_context, p_file, p_script->base.ptr())) {
+		return false;
+	}
+	if (!_store_variant(p_context, p_file, p_script->rpc_config)) {
+		return false;
+	}
+
+	p_file->store_32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		if (!_store_member(p_context, p_file, E.key, E.value)) {
+			return false;
+		}
+	}
+	p_file->store_32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_file->store_pascal_string(member);
+	}
+	p_file->store_32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		if (!_store_member(p_context, p_file, E.key, E.value)) {
+			return false;
+		}
+	}
+
+	p_file->store_32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_file->store_pascal_string(E.key);
+		if (!_store_variant(p_context, p_file, E.value)) {
+			return false;
+		}
+	}
+
+	p_file->store_32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_file->store_pascal_string(E.key);
+		p_file->store_var(Dictionary(E.value));
+	}
+
+#ifdef TOOLS_ENABLED
+	p_file->store_32(p_script->member_default_values.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+		p_file->store_pascal_string(E.key);
+		if (!_store_variant(p_context, p_file, E.value)) {
+			return false;
+		}
+	}
+#endif
+
+	p_file->store_32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		p_file->store_pascal_string(E.key);
+		if (!_store_function(p_context, p_file, E.value)) {
+			return false;
+		}
+	}
+
+	const GDScriptFunction *implicit_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : implicit_functions) {
+		p_file->store_8(function != nullptr);
+		if (function && !_store_function(p_context, p_file, function)) {
+			return false;
+		}
+	}
+
+	p_file->store_32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_file->store_pascal_string(E.key);
+		if (!_store_class(p_context, p_file, E.value.ptr())) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Loading. */
+
+bool GDScriptBytecodeCache::_load_script_ref(const LoadContext &p_context, const Ref<FileAccess> &p_file, Ref<Script> &r_script, bool &r_local) {
+	r_script = Ref<Script>();
+	r_local = false;
+
+	switch (p_file->get_8()) {
+		case SCRIPT_REF_NONE: {
+			return true;
+		}
+		case SCRIPT_REF_GDSCRIPT: {
+			const String path = p_file->get_pascal_string();
+			const String fully_qualified_name = p_file->get_pascal_string();
+
+			// Same lookup as GDScriptCompiler::_gdtype_from_datatype(), which also registers the dependency.
+			Ref<GDScript> root;
+			if (path == p_context.main_path) {
+				root = Ref<GDScript>(p_context.main_script);
+				r_local = true;
+			} else {
+				Error err = OK;
+				root = GDScriptCache::get_shallow_script(path, err, p_context.main_path);
+				if (err != OK || root.is_null()) {
+					return false;
+				}
+			}
+
+			GDScript *found = root->find_class(fully_qualified_name);
+			if (found == nullptr) {
+				return false;
+			}
+			r_script = Ref<Script>(found);
+			return true;
+		}
+		case SCRIPT_REF_SCRIPT: {
+			r_script = ResourceLoader::load(p_file->get_pascal_string(), "Script");
+			return r_script.is_valid();
+		}
+	}
+
+	return false;
+}
+
+bool GDScriptBytecodeCache::_load_variant(const LoadContext &p_context, const Ref<FileAccess> &p_file, Variant &r_value) {
+	switch (p_file->get_8()) {
+		case VARIANT_PLAIN: {
+			r_value = p_file->get_var(false);
+			return true;
+		}
+		case VARIANT_NULL_OBJECT: {
+			r_value = (Object *)nullptr;
+			return true;
+		}
+		case VARIANT_SCRIPT: {
+			Ref<Script> script;
+			bool local = false;
+			if (!_load_script_ref(p_context, p_file, script, local) || script.is_null()) {
+				return false;
+			}
+			r_value = script;
+			return true;
+		}
+		case VARIANT_NATIVE_CLASS: {
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(StringName(p_file->get_pascal_string()));
+			if (index == nullptr) {
+				return false;
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[*index];
+			return Object::cast_to<GDScriptNativeClass>(r_value.get_validated_object()) != nullptr;
+		}
+		case VARIANT_RESOURCE: {
+			// Same as a preload() in GDScriptAnalyzer::reduce_preload().
+			const String path = p_file->get_pascal_string();
+			const String type = p_file->get_pascal_string();
+			Error err = OK;
+			Ref<Resource> resource = ResourceLoader::load(path, type, ResourceFormatLoader::CACHE_MODE_REUSE, &err);
+			if (err == ERR_BUSY) {
+				resource = ResourceLoader::ensure_resource_ref_override_for_outer_load(path, type);
+			}
+			if (resource.is_null()) {
+				return false;
+			}
+			r_value = resource;
+			return true;
+		}
+		case VARIANT_ARRAY: {
+			const bool read_only = p_file->get_8();
+			const uint32_t builtin_type = p_file->get_32();
+			const StringName class_name = p_file->get_pascal_string();
+			Ref<Script> script;
+			bool local = false;
+			uint32_t size;
+			if (builtin_type >= Variant::VARIANT_MAX || !_load_script_ref(p_context, p_file, script, local) || !_read_count(p_file, size)) {
+				return false;
+			}
+
+			Array array;
+			if (builtin_type != Variant::NIL) {
+				array.set_typed(builtin_type, class_name, script);
+			}
+			array.resize(size);
+			for (uint32_t i = 0; i < size; i++) {
+				Variant element;
+				if (!_load_variant(p_context, p_file, element)) {
+					return false;
+				}
+				array.set(i, element);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_value = array;
+			return true;
+		}
+		case VARIANT_DICTIONARY: {
+			const bool read_only = p_file->get_8();
+			const uint32_t key_type = p_file->get_32();
+			const StringName key_class_name = p_file->get_pascal_string();
+			Ref<Script> key_script;
+			bool local = false;
+			if (key_type >= Variant::VARIANT_MAX || !_load_script_ref(p_context, p_file, key_script, local)) {
+				return false;
+			}
+			const uint32_t value_type = p_file->get_32();
+			const StringName value_class_name = p_file->get_pascal_string();
+			Ref<Script> value_script;
+			uint32_t size;
+			if (value_type >= Variant::VARIANT_MAX || !_load_script_ref(p_context, p_file, value_script, local) || !_read_count(p_file, size)) {
+				return false;
+			}
+
+			Dictionary dictionary;
+			if (key_type != Variant::NIL || value_type != Variant::NIL) {
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			for (uint32_t i = 0; i < size; i++) {
+				Variant key, value;
+				if (!_load_variant(p_context, p_file, key) || !_load_variant(p_context, p_file, value)) {
+					return false;
+				}
+				dictionary.set(key, value);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_value = dictionary;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool GDScriptBytecodeCache::_load_data_type(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScriptDataType &r_type) {
+	r_type.has_type = p_file->get_8();
+	const uint8_t kind = p_file->get_8();
+	if (kind > GDScriptDataType::GDSCRIPT || !_read_type(p_file, r_type.builtin_type)) {
+		return false;
+	}
+	r_type.kind = GDScriptDataType::Kind(kind);
+	r_type.native_type = p_file->get_pascal_string();
+
+	Ref<Script> script;
+	bool local = false;
+	if (!_load_script_ref(p_context, p_file, script, local)) {
+		return false;
+	}
+	r_type.script_type = script.ptr();
+	if (!local) {
+		// Like the compiler, only hold a strong reference to classes outside of this file, to avoid cycles.
+		r_type.script_type_ref = script;
+	}
+
+	uint32_t count;
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	r_type.container_element_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_load_data_type(p_context, p_file, r_type.container_element_types.write[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::_load_member(const LoadContext &p_context, const Ref<FileAccess> &p_file, StringName &r_name, GDScript::MemberInfo &r_member) {
+	r_name = p_file->get_pascal_string();
+	r_member.index = p_file->get_32();
+	r_member.setter = p_file->get_pascal_string();
+	r_member.getter = p_file->get_pascal_string();
+	if (!_load_data_type(p_context, p_file, r_member.data_type)) {
+		return false;
+	}
+	r_member.property_info = PropertyInfo::from_dict(p_file->get_var());
+	return !p_file->eof_reached();
+}
+
+bool GDScriptBytecodeCache::_load_function_body(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScriptFunction *p_function) {
+	const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	uint32_t count;
+
+	p_function->_static = p_file->get_8();
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	p_function->argument_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_load_data_type(p_context, p_file, p_function->argument_types.write[i])) {
+			return false;
+		}
+	}
+	if (!_load_data_type(p_context, p_file, p_function->return_type)) {
+		return false;
+	}
+	p_function->method_info = MethodInfo::from_dict(p_file->get_var());
+	if (!_load_variant(p_context, p_file, p_function->rpc_config)) {
+		return false;
+	}
+	p_function->_initial_line = p_file->get_32();
+	p_function->_argument_count = p_file->get_32();
+	p_function->_stack_size = p_file->get_32();
+	p_function->_instruction_args_size = p_file->get_32();
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const int slot = p_file->get_32();
+		Variant::Type type;
+		if (!_read_type(p_file, type)) {
+			return false;
+		}
+		p_function->temporary_slots[slot] = type;
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = p_file->get_32();
+		stack_debug.pos = p_file->get_32();
+		stack_debug.added = p_file->get_8();
+		stack_debug.identifier = p_file->get_pascal_string();
+		p_function->stack_debug.push_back(stack_debug);
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	p_function->line_starts.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		p_function->line_starts.write[i].first = p_file->get_32();
+		p_function->line_starts.write[i].second = p_file->get_32();
+	}
+
+	if (!_read_count(p_file, count) || count == 0) {
+		return false;
+	}
+	p_function->code.resize(count);
+	if (p_file->get_buffer((uint8_t *)p_function->code.ptrw(), count * sizeof(int)) != count * sizeof(int) || p_function->code[count - 1] != GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const int position = p_file->get_32();
+		const int *index = global_map.getptr(StringName(p_file->get_pascal_string()));
+		if (index == nullptr || position < 0 || position >= p_function->code.size()) {
+			return false;
+		}
+		p_function->code.write[position] = *index;
+		p_function->global_index_positions.push_back(position);
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	p_function->default_arguments.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		p_function->default_arguments.write[i] = p_file->get_32();
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	p_function->constants.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!_load_variant(p_context, p_file, p_function->constants.write[i])) {
+			return false;
+		}
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	p_function->global_names.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		p_function->global_names.write[i] = p_file->get_pascal_string();
+	}
+
+	if (!_load_table(p_file, p_function->operator_funcs, _resolve_operator) ||
+			!_load_table(p_file, p_function->setters, _resolve_setter) ||
+			!_load_table(p_file, p_function->getters, _resolve_getter) ||
+			!_load_table(p_file, p_function->keyed_setters, _resolve_keyed_setter) ||
+			!_load_table(p_file, p_function->keyed_getters, _resolve_keyed_getter) ||
+			!_load_table(p_file, p_function->indexed_setters, _resolve_indexed_setter) ||
+			!_load_table(p_file, p_function->indexed_getters, _resolve_indexed_getter) ||
+			!_load_table(p_file, p_function->builtin_methods, _resolve_builtin_method) ||
+			!_load_table(p_file, p_function->constructors, _resolve_constructor) ||
+			!_load_table(p_file, p_function->utilities, _resolve_utility) ||
+			!_load_table(p_file, p_function->gds_utilities, _resolve_gds_utility)) {
+		return false;
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	p_function->methods.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName class_name = p_file->get_pascal_string();
+		const StringName method_name = p_file->get_pascal_string();
+		p_function->methods.write[i] = ClassDB::get_method(class_name, method_name);
+		if (p_function->methods[i] == nullptr) {
+			return false;
+		}
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		GDScript::LambdaInfo lambda_info;
+		lambda_info.capture_count = p_file->get_32();
+		lambda_info.use_self = p_file->get_8();
+		GDScriptFunction *lambda = _load_function(p_context, p_file, p_function->_script);
+		if (lambda == nullptr) {
+			return false;
+		}
+		p_function->lambdas.push_back(lambda);
+		p_function->_script->lambda_info.insert(lambda, lambda_info);
+	}
+
+	const int inline_cache_count = p_file->get_32();
+	if (inline_cache_count < 0 || inline_cache_count > p_function->code.size()) {
+		return false;
+	}
+
+#ifdef DEBUG_ENABLED
+	p_function->profile.signature = p_file->get_pascal_string();
+	p_function->operator_names = p_file->get_var();
+	p_function->setter_names = p_file->get_var();
+	p_function->getter_names = p_file->get_var();
+	p_function->builtin_methods_names = p_file->get_var();
+	p_function->constructors_names = p_file->get_var();
+	p_function->utilities_names = p_file->get_var();
+	p_function->gds_utilities_names = p_file->get_var();
+#endif
+
+	if (p_file->eof_reached()) {
+		return false;
+	}
+
+	// Same layout as GDScriptByteCodeGenerator::write_end().
+	p_function->_code_ptr = p_function->code.ptrw();
+	p_function->_code_size = p_function->code.size();
+	p_function->_default_arg_count = p_function->default_arguments.is_empty() ? 0 : p_function->default_arguments.size() - 1;
+	p_function->_default_arg_ptr = p_function->default_arguments.ptr();
+	p_function->_constant_count = p_function->constants.size();
+	p_function->_constants_ptr = p_function->constants.ptrw();
+	p_function->_global_names_count = p_function->global_names.size();
+	p_function->_global_names_ptr = p_function->global_names.ptr();
+	p_function->_operator_funcs_count = p_function->operator_funcs.size();
+	p_function->_operator_funcs_ptr = p_function->operator_funcs.ptr();
+	p_function->_setters_count = p_function->setters.size();
+	p_function->_setters_ptr = p_function->setters.ptr();
+	p_function->_getters_count = p_function->getters.size();
+	p_function->_getters_ptr = p_function->getters.ptr();
+	p_function->_keyed_setters_count = p_function->keyed_setters.size();
+	p_function->_keyed_setters_ptr = p_function->keyed_setters.ptr();
+	p_function->_keyed_getters_count = p_function->keyed_getters.size();
+	p_function->_keyed_getters_ptr = p_function->keyed_getters.ptr();
+	p_function->_indexed_setters_count = p_function->indexed_setters.size();
+	p_function->_indexed_setters_ptr = p_function->indexed_setters.ptr();
+	p_function->_indexed_getters_count = p_function->indexed_getters.size();
+	p_function->_indexed_getters_ptr = p_function->indexed_getters.ptr();
+	p_function->_builtin_methods_count = p_function->builtin_methods.size();
+	p_function->_builtin_methods_ptr = p_function->builtin_methods.ptr();
+	p_function->_constructors_count = p_function->constructors.size();
+	p_function->_constructors_ptr = p_function->constructors.ptr();
+	p_function->_utilities_count = p_function->utilities.size();
+	p_function->_utilities_ptr = p_function->utilities.ptr();
+	p_function->_gds_utilities_count = p_function->gds_utilities.size();
+	p_function->_gds_utilities_ptr = p_function->gds_utilities.ptr();
+	p_function->_methods_count = p_function->methods.size();
+	p_function->_methods_ptr = p_function->methods.ptrw();
+	p_function->_lambdas_count = p_function->lambdas.size();
+	p_function->_lambdas_ptr = p_function->lambdas.ptrw();
+	if (inline_cache_count) {
+		p_function->_inline_caches_ptr = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+		p_function->_inline_caches_count = inline_cache_count;
+	}
+
+	GDScriptNative::attach(p_function);
+	return true;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_load_function(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->name = p_file->get_pascal_string();
+	function->source = p_script->get_script_path();
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	if (!_load_function_body(p_context, p_file, function)) {
+		memdelete(function);
+		return nullptr;
+	}
+	return function;
+}
+
+bool GDScriptBytecodeCache::_load_skeleton(const Ref<FileAccess> &p_file, GDScript *p_script) {
+	p_script->global_name = p_file->get_pascal_string();
+	p_script->simplified_icon_path = p_file->get_pascal_string();
+
+	// Keep the inner class objects other scripts may already point to, as GDScriptCompiler::make_scripts() does.
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	uint32_t count;
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_file->get_pascal_string();
+		const String fully_qualified_name = p_file->get_pascal_string();
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		subclass->local_name = name;
+		subclass->fully_qualified_name = fully_qualified_name;
+		p_script->subclasses.insert(name, subclass);
+
+		if (!_load_skeleton(p_file, subclass.ptr())) {
+			return false;
+		}
+	}
+
+	return !p_file->eof_reached();
+}
+
+bool GDScriptBytecodeCache::_load_class(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScript *p_script) {
+	const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	uint32_t count;
+
+	// Another script's compilation may have populated members of this one already (see GDScriptCompiler::_prepare_compilation()).
+	// Keep the old constants alive until the new ones are in, they may hold the last reference to something they point to.
+	HashMap<StringName, Variant> old_constants = p_script->constants;
+	p_script->constants.clear();
+	p_script->members.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->_signals.clear();
+
+	p_script->tool = p_file->get_8();
+
+	const int *native_index = global_map.getptr(StringName(p_file->get_pascal_string()));
+	if (native_index == nullptr) {
+		return false;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+	if (p_script->native.is_null()) {
+		return false;
+	}
+
+	Ref<Script> base;
+	bool local = false;
+	if (!_load_script_ref(p_context, p_file, base, local)) {
+		return false;
+	}
+	p_script->base = base;
+	p_script->_base = p_script->base.ptr();
+	if (base.is_valid() && p_script->base.is_null()) {
+		return false;
+	}
+
+	Variant rpc_config;
+	if (!_load_variant(p_context, p_file, rpc_config)) {
+		return false;
+	}
+	p_script->rpc_config = rpc_config;
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name;
+		GDScript::MemberInfo member;
+		if (!_load_member(p_context, p_file, name, member)) {
+			return false;
+		}
+		p_script->member_indices.insert(name, member);
+	}
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		p_script->members.insert(p_file->get_pascal_string());
+	}
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		StringName name;
+		GDScript::MemberInfo member;
+		if (!_load_member(p_context, p_file, name, member)) {
+			return false;
+		}
+		p_script->static_variables_indices.insert(name, member);
+	}
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_file->get_pascal_string();
+		Variant value;
+		if (!_load_variant(p_context, p_file, value)) {
+			return false;
+		}
+		p_script->constants.insert(name, value);
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_file->get_pascal_string();
+		p_script->_signals[name] = MethodInfo::from_dict(p_file->get_var());
+	}
+
+#ifdef TOOLS_ENABLED
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_file->get_pascal_string();
+		Variant value;
+		if (!_load_variant(p_context, p_file, value)) {
+			return false;
+		}
+		p_script->member_default_values[name] = value;
+	}
+#endif
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		const StringName name = p_file->get_pascal_string();
+		GDScriptFunction *function = _load_function(p_context, p_file, p_script);
+		if (function == nullptr) {
+			return false;
+		}
+		p_script->member_functions[name] = function;
+		if (name == GDScriptLanguage::get_singleton()->strings._init) {
+			p_script->initializer = function;
+		}
+	}
+
+	GDScriptFunction **implicit_functions[] = { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer };
+	for (GDScriptFunction **function : implicit_functions) {
+		if (p_file->get_8()) {
+			*function = _load_function(p_context, p_file, p_script);
+			if (*function == nullptr) {
+				return false;
+			}
+		}
+	}
+
+	if (!_read_count(p_file, count)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < count; i++) {
+		Ref<GDScript> *subclass = p_script->subclasses.getptr(p_file->get_pascal_string());
+		if (subclass == nullptr || !_load_class(p_context, p_file, subclass->ptr())) {
+			return false;
+		}
+	}
+
+	return !p_file->eof_reached();
+}
+
+void GDScriptBytecodeCache::_finish_class(GDScript *p_script) {
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_finish_class(E.value.ptr());
+	}
+	p_script->_static_default_init();
+	p_script->valid = true;
+}
+
+bool GDScriptBytecodeCache::_has_static_data(const GDScript *p_script) {
+	if (p_script->static_initializer) {
+		return true;
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (_has_static_data(E.value.ptr())) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GDScriptBytecodeCache::_is_pristine(const GDScript *p_script) {
+	if (p_script->valid || !p_script->member_functions.is_empty() || p_script->implicit_initializer || p_script->implicit_ready || p_script->static_initializer) {
+		return false;
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (!_is_pristine(E.value.ptr())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Ref<FileAccess> GDScriptBytecodeCache::_open(const String &p_cache_path, const GDScript *p_script, bool p_check_dependencies, bool &r_register_static) {
+	if (!FileAccess::exists(p_cache_path)) {
+		return Ref<FileAccess>();
+	}
+	Ref<FileAccess> file = FileAccess::open(p_cache_path, FileAccess::READ);
+	if (file.is_null()) {
+		return Ref<FileAccess>();
+	}
+
+	uint8_t magic[4] = {};
+	file->get_buffer(magic, 4);
+	if (memcmp(magic, BYTECODE_CACHE_MAGIC, 4) != 0 || file->get_32() != FORMAT_VERSION) {
+		return Ref<FileAccess>();
+	}
+	if (file->get_64() != _get_environment_hash() || file->get_64() != _hash_source(p_script->source, p_script->binary_tokens)) {
+		return Ref<FileAccess>();
+	}
+
+	uint32_t dependency_count;
+	if (!_read_count(file, dependency_count)) {
+		return Ref<FileAccess>();
+	}
+	for (uint32_t i = 0; i < dependency_count; i++) {
+		const String path = file->get_pascal_string();
+		const uint64_t hash = file->get_64();
+		if (p_check_dependencies && _get_dependency_hash(path) != hash) {
+			return Ref<FileAccess>();
+		}
+	}
+
+	r_register_static = file->get_8();
+	return file->eof_reached() ? Ref<FileAccess>() : file;
+}
+
+String GDScriptBytecodeCache::get_cache_path(const GDScript *p_script) {
+	if (!GLOBAL_GET("gdscript/bytecode_cache/enabled") || Engine::get_singleton()->is_editor_hint()) {
+		return String();
+	}
+	// Built-in scripts are compiled along with the resource holding them.
+	const String script_path = p_script->get_script_path();
+	if (!p_script->is_root_script() || !script_path.is_resource_file()) {
+		return String();
+	}
+	return String("user://gdscript_cache").path_join(script_path.md5_text() + ".gdbc");
+}
+
+Error GDScriptBytecodeCache::save(const GDScript *p_script, GDScriptParser &p_parser, const String &p_cache_path) {
+	HashSet<String> dependencies;
+	_collect_dependencies(&p_parser, dependencies);
+	dependencies.erase(p_script->path);
+
+	Vector<String> dependency_list;
+	for (const String &dependency : dependencies) {
+		dependency_list.push_back(dependency);
+	}
+	return save(p_script, dependency_list, p_parser.get_tree()->annotated_static_unload, p_cache_path);
+}
+
+Error GDScriptBytecodeCache::save(const GDScript *p_script, const Vector<String> &p_dependencies, bool p_static_unload, const String &p_cache_path) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!p_script->valid || !p_script->is_root_script(), ERR_INVALID_PARAMETER);
+
+	SaveContext context;
+	context.symbols = _get_symbols();
+	context.main_path = p_script->path;
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		context.global_names.insert(E.value, E.key);
+	}
+
+	Error err = DirAccess::make_dir_recursive_absolute(p_cache_path.get_base_dir());
+	if (err != OK && err != ERR_ALREADY_EXISTS) {
+		return err;
+	}
+
+	// Written next to the final file and moved in place, so a reader never sees a partial file.
+	const String temp_path = p_cache_path + ".tmp";
+	Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+	if (file.is_null()) {
+		return err;
+	}
+
+	file->store_buffer(BYTECODE_CACHE_MAGIC, 4);
+	file->store_32(FORMAT_VERSION);
+	file->store_64(_get_environment_hash());
+	file->store_64(_hash_source(p_script->source, p_script->binary_tokens));
+	file->store_32(p_dependencies.size());
+	for (const String &dependency : p_dependencies) {
+		file->store_pascal_string(dependency);
+		file->store_64(_get_dependency_hash(dependency));
+	}
+	file->store_8(_has_static_data(p_script) && !p_static_unload);
+
+	file->store_pascal_string(p_script->local_name);
+	file->store_pascal_string(p_script->fully_qualified_name);
+	_store_skeleton(file, p_script);
+	const bool stored = _store_class(context, file, p_script);
+	file.unref();
+
+	if (!stored) {
+		DirAccess::remove_absolute(temp_path);
+		return ERR_UNAVAILABLE;
+	}
+	return DirAccess::rename_absolute(temp_path, p_cache_path);
+}
+
+bool GDScriptBytecodeCache::make_scripts(GDScript *p_script, const String &p_cache_path) {
+	bool register_static = false;
+	Ref<FileAccess> file = _open(p_cache_path, p_script, false, register_static);
+	if (file.is_null()) {
+		return false;
+	}
+
+	p_script->local_name = file->get_pascal_string();
+	p_script->fully_qualified_name = file->get_pascal_string();
+	return _load_skeleton(file, p_script);
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const String &p_cache_path) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	if (!_is_pristine(p_script)) {
+		return ERR_ALREADY_IN_USE;
+	}
+
+	bool register_static = false;
+	Ref<FileAccess> file = _open(p_cache_path, p_script, true, register_static);
+	if (file.is_null()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+
+	LoadContext context;
+	context.main_script = p_script;
+	context.main_path = p_script->path;
+
+	// Member layouts and functions are about to be replaced, call sites must not reuse what they resolved.
+	GDScriptFunction::invalidate_inline_caches();
+
+	p_script->_owner = nullptr;
+	p_script->local_name = file->get_pascal_string();
+	p_script->fully_qualified_name = file->get_pascal_string();
+	const bool loaded = _load_skeleton(file, p_script) && _load_class(context, file, p_script);
+	GDScriptFunction::invalidate_inline_caches();
+	if (!loaded) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	_finish_class(p_script);
+	if (register_static) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
+
+void GDScriptBytecodeCache::finish() {
+	MutexLock lock(mutex);
+	if (symbols) {
+		memdelete(symbols);
+		symbols = nullptr;
+	}
+	source_hashes.clear();
+	environment_hash = 0;
+}
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+
+class GDScriptParser;
+
+// Compiled scripts stored on disk, so later runs can skip parsing, analysis and compilation.
+// Everything that points into the engine (operator evaluators, getters, method binds, globals...)
+// is written by name and looked up again when loading. A file is only used while the script and
+// every script its analysis depended on still hash to what they were when it was written.
+class GDScriptBytecodeCache {
+	enum {
+		FORMAT_VERSION = 2,
+	};
+
+	enum ScriptRefKind {
+		SCRIPT_REF_NONE,
+		SCRIPT_REF_GDSCRIPT,
+		SCRIPT_REF_SCRIPT,
+	};
+
+	enum VariantKind {
+		VARIANT_PLAIN,
+		VARIANT_NULL_OBJECT,
+		VARIANT_SCRIPT,
+		VARIANT_NATIVE_CLASS,
+		VARIANT_RESOURCE,
+		VARIANT_ARRAY,
+		VARIANT_DICTIONARY,
+	};
+
+	// Names the engine function pointers held by compiled functions were looked up with.
+	struct Symbols {
+		HashMap<uint64_t, Vector3i> operators; // Operator, left type, right type.
+		HashMap<uint64_t, Pair<Variant::Type, StringName>> setters;
+		HashMap<uint64_t, Pair<Variant::Type, StringName>> getters;
+		HashMap<uint64_t, Variant::Type> keyed_setters;
+		HashMap<uint64_t, Variant::Type> keyed_getters;
+		HashMap<uint64_t, Variant::Type> indexed_setters;
+		HashMap<uint64_t, Variant::Type> indexed_getters;
+		HashMap<uint64_t, Pair<Variant::Type, StringName>> builtin_methods;
+		HashMap<uint64_t, Vector2i> constructors; // Type, constructor index.
+		HashMap<uint64_t, StringName> utilities;
+		HashMap<uint64_t, StringName> gds_utilities;
+	};
+
+	struct SaveContext {
+		const Symbols *symbols = nullptr;
+		String main_path;
+		HashMap<int, StringName> global_names; // Inverse of the language's global map.
+	};
+
+	struct LoadContext {
+		GDScript *main_script = nullptr;
+		String main_path;
+	};
+
+	static Mutex mutex;
+	static Symbols *symbols;
+	static HashMap<String, uint64_t> source_hashes;
+	static uint64_t environment_hash;
+
+	static const Symbols *_get_symbols();
+	static uint64_t _get_environment_hash();
+	static uint64_t _hash_source(const String &p_source, const Vector<uint8_t> &p_binary_tokens);
+	static uint64_t _get_dependency_hash(const String &p_path);
+	static bool _is_plain_variant(const Variant &p_value);
+
+	static bool _store_script_ref(const SaveContext &p_context, const Ref<FileAccess> &p_file, const Script *p_script);
+	static bool _store_variant(const SaveContext &p_context, const Ref<FileAccess> &p_file, const Variant &p_value);
+	static bool _store_data_type(const SaveContext &p_context, const Ref<FileAccess> &p_file, const GDScriptDataType &p_type);
+	static bool _store_member(const SaveContext &p_context, const Ref<FileAccess> &p_file, const StringName &p_name, const GDScript::MemberInfo &p_member);
+	static bool _store_function(const SaveContext &p_context, const Ref<FileAccess> &p_file, const GDScriptFunction *p_function);
+	static void _store_skeleton(const Ref<FileAccess> &p_file, const GDScript *p_script);
+	static bool _store_class(const SaveContext &p_context, const Ref<FileAccess> &p_file, const GDScript *p_script);
+
+	static bool _load_script_ref(const LoadContext &p_context, const Ref<FileAccess> &p_file, Ref<Script> &r_script, bool &r_local);
+	static bool _load_variant(const LoadContext &p_context, const Ref<FileAccess> &p_file, Variant &r_value);
+	static bool _load_data_type(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScriptDataType &r_type);
+	static bool _load_member(const LoadContext &p_context, const Ref<FileAccess> &p_file, StringName &r_name, GDScript::MemberInfo &r_member);
+	static bool _load_function_body(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScriptFunction *p_function);
+	static GDScriptFunction *_load_function(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScript *p_script);
+	static bool _load_skeleton(const Ref<FileAccess> &p_file, GDScript *p_script);
+	static bool _load_class(const LoadContext &p_context, const Ref<FileAccess> &p_file, GDScript *p_script);
+	static void _finish_class(GDScript *p_script);
+	static bool _has_static_data(const GDScript *p_script);
+	static bool _is_pristine(const GDScript *p_script);
+
+	static Ref<FileAccess> _open(const String &p_cache_path, const GDScript *p_script, bool p_check_dependencies, bool &r_register_static);
+
+public:
+	// Where the compiled form of p_script is kept, or an empty string when it must not be cached.
+	static String get_cache_path(const GDScript *p_script);
+
+	static Error save(const GDScript *p_script, GDScriptParser &p_parser, const String &p_cache_path);
+	static Error save(const GDScript *p_script, const Vector<String> &p_dependencies, bool p_static_unload, const String &p_cache_path);
+
+	// Creates the inner class objects of a shallow script, like GDScriptCompiler::make_scripts() but without parsing.
+	static bool make_scripts(GDScript *p_script, const String &p_cache_path);
+	// Replaces GDScriptCompiler::compile() for a script that was never compiled before.
+	static Error load(GDScript *p_script, const String &p_cache_path);
+
+	static void finish();
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -34,11 +34,16 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
+#include "core/config/project_settings.h"
 #include "core/io/file_access.h"
+#include "core/io/resource_uid.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
+#include "servers/text_server.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
 	return status;
@@ -239,6 +244,113 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+void GDScriptCache::_get_referenced_scripts(const GDScriptParser *p_parser, Vector<String> &r_paths) {
+	for (const String &referenced_path : p_parser->referenced_paths) {
+		// Resolved like GDScriptAnalyzer does for `extends` and `preload()`.
+		String path = ResourceUID::ensure_path(referenced_path);
+		if (path.is_relative_path()) {
+			path = p_parser->script_path.get_base_dir().path_join(path);
+		}
+		r_paths.push_back(path.simplify_path());
+	}
+
+	// Names are only known to refer to a script once the analysis resolves them, so this may parse a few scripts
+	// that end up unused. Locals and members shadowing a global class are the only way to get one wrong.
+	const HashMap<StringName, ProjectSettings::AutoloadInfo> &autoloads = ProjectSettings::get_singleton()->get_autoload_list();
+	for (const StringName &name : p_parser->referenced_names) {
+		if (ScriptServer::is_global_class(name)) {
+			r_paths.push_back(ScriptServer::get_global_class_path(name));
+		} else if (const ProjectSettings::AutoloadInfo *autoload = autoloads.getptr(name)) {
+			if (autoload->is_singleton) {
+				r_paths.push_back(autoload->path);
+			}
+		}
+	}
+}
+
+void GDScriptCache::_parse_prefetched(void *p_userdata, uint32_t p_index) {
+	Ref<GDScriptParserRef> *parser_refs = static_cast<Ref<GDScriptParserRef> *>(p_userdata);
+	parser_refs[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+void GDScriptCache::prefetch_parsers(GDScriptParser *p_parser) {
+	if (singleton == nullptr || WorkerThreadPool::get_singleton() == nullptr) {
+		return;
+	}
+
+	MutexLock lock(singleton->mutex);
+
+	// Tables the parser builds lazily on first use must not be built concurrently.
+	GDScriptParser::get_builtin_type(StringName());
+#ifdef DEBUG_ENABLED
+	if (TS->has_feature(TextServer::FEATURE_UNICODE_SECURITY)) {
+		TS->spoof_check("_");
+	}
+#endif
+
+	HashSet<String> visited;
+	visited.insert(p_parser->script_path);
+	Vector<const GDScriptParser *> sources = { p_parser };
+
+	// Parse the scripts referenced so far all at once, then the ones those reference, and so on.
+	while (!sources.is_empty() && !singleton->cleared) {
+		Vector<String> paths;
+		for (const GDScriptParser *source : sources) {
+			_get_referenced_scripts(source, paths);
+		}
+		sources.clear();
+
+		Vector<Ref<GDScriptParserRef>> wave;
+		for (const String &path : paths) {
+			if (visited.has(path)) {
+				continue;
+			}
+			visited.insert(path);
+
+			const String extension = path.get_extension().to_lower();
+			if ((extension != "gd" && extension != "gdc") || singleton->parser_map.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+				continue;
+			}
+
+			Ref<GDScriptParserRef> parser_ref;
+			parser_ref.instantiate();
+			parser_ref->path = path;
+			parser_ref->abandoned = true; // Not in the parser map until it's parsed.
+			parser_ref->get_parser(); // Constructed here, the first parser registers the annotations.
+			wave.push_back(parser_ref);
+		}
+
+		if (wave.is_empty()) {
+			break;
+		}
+
+		if (wave.size() == 1) {
+			_parse_prefetched(wave.ptrw(), 0);
+		} else {
+			// Waiting releases the cache mutex, so another thread may ask for the same scripts meanwhile.
+			// Those get their own parsers, which is why the ones parsed here were kept out of the map.
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&GDScriptCache::_parse_prefetched, wave.ptrw(), wave.size(), -1, true, String("GDScriptParseDependencies"));
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(singleton->mutex);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		}
+
+		for (Ref<GDScriptParserRef> &parser_ref : wave) {
+			if (singleton->cleared || singleton->parser_map.has(parser_ref->path)) {
+				continue;
+			}
+			parser_ref->abandoned = false;
+			singleton->parser_map[parser_ref->path] = parser_ref.ptr();
+			singleton->prefetched_parser_count++;
+			// Kept alive by the parser being compiled, until its analysis picks them up as dependencies.
+			p_parser->prefetched_parsers.push_back(parser_ref);
+			if (parser_ref->result == OK) {
+				sources.push_back(parser_ref->get_parser());
+			}
+		}
+	}
+}
+
 bool GDScriptCache::has_parser(const String &p_path) {
 	MutexLock lock(singleton->mutex);
 	return singleton->parser_map.has(p_path);
@@ -329,9 +441,12 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	const String bytecode_cache_path = GDScriptBytecodeCache::get_cache_path(script.ptr());
+	if (bytecode_cache_path.is_empty() || !GDScriptBytecodeCache::make_scripts(script.ptr(), bytecode_cache_path)) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
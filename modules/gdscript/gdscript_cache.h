@@ -92,10 +92,15 @@ class GDScriptCache {
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
+	friend class TestGDScriptCacheInternalsAccessor;
 
 	static GDScriptCache *singleton;
 
 	bool cleared = false;
+	uint32_t prefetched_parser_count = 0; // Parsers added to the map by prefetch_parsers().
+
+	static void _get_referenced_scripts(const GDScriptParser *p_parser, Vector<String> &r_paths);
+	static void _parse_prefetched(void *p_userdata, uint32_t p_index);
 
 public:
 	static const int BINARY_MUTEX_TAG = 2;
@@ -108,6 +113,7 @@ public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
+	static void prefetch_parsers(GDScriptParser *p_parser);
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
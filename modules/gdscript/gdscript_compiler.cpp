@@ -253,6 +253,34 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+static bool _can_operate_in_place(Variant::Operator p_operator, const GDScriptDataType &p_target_type, const GDScriptDataType &p_value_type) {
+	if (!p_target_type.has_type || p_target_type.kind != GDScriptDataType::BUILTIN || !p_value_type.has_type || p_value_type.kind != GDScriptDataType::BUILTIN) {
+		return false;
+	}
+	switch (p_target_type.builtin_type) {
+		// Only value types, whose validated operators compute the result before storing it,
+		// so the target can also be the left operand.
+		case Variant::INT:
+		case Variant::VECTOR2I:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4I:
+			// Integer division and modulo aren't validated (division by zero check),
+			// and the generic path resets the target before evaluating.
+			if (p_operator == Variant::OP_DIVIDE || p_operator == Variant::OP_MODULE) {
+				return false;
+			}
+			break;
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::VECTOR4:
+			break;
+		default:
+			return false;
+	}
+	return Variant::get_operator_return_type(p_operator, p_target_type.builtin_type, p_value_type.builtin_type) == p_target_type.builtin_type;
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -1339,7 +1367,14 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 
 				GDScriptCodeGenerator::Address to_assign;
 				bool has_operation = assignment->operation != GDScriptParser::AssignmentNode::OP_NONE;
-				if (has_operation) {
+				// A typed local can take the result of the operation directly when it keeps its type,
+				// which saves moving it from a temporary.
+				bool operate_in_place = has_operation && !is_member && !assignment->use_conversion_assign && target.mode == GDScriptCodeGenerator::Address::LOCAL_VARIABLE &&
+						_can_operate_in_place(assignment->variant_op, target.type, assigned_value.type);
+				if (operate_in_place) {
+					gen->write_binary_operator(target, assignment->variant_op, target, assigned_value);
+					to_assign = target;
+				} else if (has_operation) {
 					// Perform operation.
 					GDScriptCodeGenerator::Address op_result = codegen.add_temporary(_gdtype_from_datatype(assignment->get_datatype(), codegen.script));
 					GDScriptCodeGenerator::Address og_value = _parse_expression(codegen, r_error, assignment->assignee);
@@ -1368,7 +1403,7 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 					}
 					gen->write_set_static_variable(temp, static_var_class, static_var_index);
 					gen->pop_temporary();
-				} else {
+				} else if (!operate_in_place) {
 					// Just assign.
 					if (assignment->use_conversion_assign) {
 						gen->write_assign_with_conversion(target, to_assign);
@@ -1895,9 +1930,16 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 	for (int i = 0; i < p_block->statements.size(); i++) {
 		const GDScriptParser::Node *s = p_block->statements[i];
 
-#ifdef DEBUG_ENABLED
 		// Add a newline before each statement, since the debugger needs those.
-		gen->write_newline(s->start_line);
+		// Release bytecode only records where lines start, for the sampling profiler.
+#ifdef DEBUG_ENABLED
+		if (!release_bytecode) {
+			gen->write_newline(s->start_line);
+		} else {
+			gen->write_line_start(s->start_line);
+		}
+#else
+		gen->write_line_start(s->start_line);
 #endif
 
 		switch (s->type) {
@@ -1947,9 +1989,15 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 					// Add locals in block before patterns, so temporaries don't use the stack address for binds.
 					List<GDScriptCodeGenerator::Address> branch_locals = _add_block_locals(codegen, branch->block);
 
-#ifdef DEBUG_ENABLED
 					// Add a newline before each branch, since the debugger needs those.
-					gen->write_newline(branch->start_line);
+#ifdef DEBUG_ENABLED
+					if (!release_bytecode) {
+						gen->write_newline(branch->start_line);
+					} else {
+						gen->write_line_start(branch->start_line);
+					}
+#else
+					gen->write_line_start(branch->start_line);
 #endif
 					// For each pattern in branch.
 					GDScriptCodeGenerator::Address pattern_result = codegen.add_temporary();
@@ -2137,6 +2185,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::ASSERT: {
 #ifdef DEBUG_ENABLED
+				if (release_bytecode) {
+					break;
+				}
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, as->condition);
@@ -2164,7 +2215,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::BREAKPOINT: {
 #ifdef DEBUG_ENABLED
-				gen->write_breakpoint();
+				if (!release_bytecode) {
+					gen->write_breakpoint();
+				}
 #endif
 			} break;
 			case GDScriptParser::Node::VARIABLE: {
@@ -3247,6 +3300,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
+	// Member layouts and functions are about to be rebuilt, call sites must not reuse what they resolved.
+	GDScriptFunction::invalidate_inline_caches();
+
 	// Create scripts for subclasses beforehand so they can be referenced
 	make_scripts(p_script, root, p_keep_state);
 
@@ -3254,10 +3310,12 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	Error err = _prepare_compilation(main_script, parser->get_tree(), p_keep_state);
 
 	if (err) {
+		GDScriptFunction::invalidate_inline_caches();
 		return err;
 	}
 
 	err = _compile_class(main_script, root, p_keep_state);
+	GDScriptFunction::invalidate_inline_caches();
 	if (err) {
 		return err;
 	}
@@ -176,12 +176,17 @@ class GDScriptCompiler {
 	String error;
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
 	bool has_static_data = false;
+	bool release_bytecode = false;
 
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
 	static void make_scripts(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
 	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
 
+	// Leave out the debug-only instructions (lines, asserts, breakpoints), so the bytecode matches
+	// what release export templates generate. Used when compiling scripts ahead of time.
+	void set_release_bytecode(bool p_enable) { release_bytecode = p_enable; }
+
 	String get_error() const;
 	int get_error_line() const;
 	int get_error_column() const;
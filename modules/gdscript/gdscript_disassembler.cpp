@@ -143,6 +143,57 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += opcode == OPCODE_OPERATOR_VALIDATED_JUMP_IF ? " and jump-if to " : " and jump-if-not to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
+
+#define DISASSEMBLE_TYPED_OPERATOR(m_opcode, m_operator) \
+	case OPCODE_##m_opcode: {                            \
+		text += "typed operator ";                       \
+		text += DADDR(3);                                \
+		text += " = ";                                   \
+		text += DADDR(1);                                \
+		text += " " m_operator " ";                      \
+		text += DADDR(2);                                \
+		incr += 4;                                       \
+	} break
+
+				DISASSEMBLE_TYPED_OPERATOR(ADD_INT_INT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_INT_INT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_INT_INT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_INT_INT, "<");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_EQUAL_INT_INT, "<=");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_INT_INT, ">");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_EQUAL_INT_INT, ">=");
+				DISASSEMBLE_TYPED_OPERATOR(EQUAL_INT_INT, "==");
+				DISASSEMBLE_TYPED_OPERATOR(NOT_EQUAL_INT_INT, "!=");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_FLOAT_FLOAT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_FLOAT_FLOAT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_FLOAT_FLOAT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(DIVIDE_FLOAT_FLOAT, "/");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_FLOAT_FLOAT, "<");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_EQUAL_FLOAT_FLOAT, "<=");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_FLOAT_FLOAT, ">");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_EQUAL_FLOAT_FLOAT, ">=");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_VECTOR2_VECTOR2, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_VECTOR2_VECTOR2, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR2_FLOAT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_VECTOR3_VECTOR3, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_VECTOR3_VECTOR3, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, "*");
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -310,7 +361,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -331,7 +382,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -363,6 +414,19 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 3;
 			} break;
+			case OPCODE_SET_MEMBER_OPERATOR_VALIDATED: {
+				text += "set_member validated operator ";
+				text += "[\"";
+				text += _global_names_ptr[_code_ptr[ip + 2]];
+				text += "\"] = ";
+				text += DADDR(3);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 6]];
+				text += " ";
+				text += DADDR(4);
+
+				incr += 7;
+			} break;
 			case OPCODE_SET_STATIC_VARIABLE: {
 				Ref<GDScript> gdscript = get_constant(_code_ptr[ip + 2] & ADDR_MASK);
 
@@ -700,7 +764,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
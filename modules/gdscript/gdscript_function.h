@@ -33,6 +33,7 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_native_interface.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
@@ -259,6 +260,32 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF, // Superinstruction: validated operator followed by JUMP_IF.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, // Superinstruction: validated operator followed by JUMP_IF_NOT.
+		// Operators on unboxed values, for operands the analyzer knows the type of.
+		OPCODE_ADD_INT_INT,
+		OPCODE_SUBTRACT_INT_INT,
+		OPCODE_MULTIPLY_INT_INT,
+		OPCODE_LESS_INT_INT,
+		OPCODE_LESS_EQUAL_INT_INT,
+		OPCODE_GREATER_INT_INT,
+		OPCODE_GREATER_EQUAL_INT_INT,
+		OPCODE_EQUAL_INT_INT,
+		OPCODE_NOT_EQUAL_INT_INT,
+		OPCODE_ADD_FLOAT_FLOAT,
+		OPCODE_SUBTRACT_FLOAT_FLOAT,
+		OPCODE_MULTIPLY_FLOAT_FLOAT,
+		OPCODE_DIVIDE_FLOAT_FLOAT,
+		OPCODE_LESS_FLOAT_FLOAT,
+		OPCODE_LESS_EQUAL_FLOAT_FLOAT,
+		OPCODE_GREATER_FLOAT_FLOAT,
+		OPCODE_GREATER_EQUAL_FLOAT_FLOAT,
+		OPCODE_ADD_VECTOR2_VECTOR2,
+		OPCODE_SUBTRACT_VECTOR2_VECTOR2,
+		OPCODE_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_ADD_VECTOR3_VECTOR3,
+		OPCODE_SUBTRACT_VECTOR3_VECTOR3,
+		OPCODE_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -276,6 +303,7 @@ public:
 		OPCODE_GET_NAMED_VALIDATED,
 		OPCODE_SET_MEMBER,
 		OPCODE_GET_MEMBER,
+		OPCODE_SET_MEMBER_OPERATOR_VALIDATED, // Superinstruction: GET_MEMBER, validated operator and SET_MEMBER.
 		OPCODE_SET_STATIC_VARIABLE, // Only for GDScript.
 		OPCODE_GET_STATIC_VARIABLE, // Only for GDScript.
 		OPCODE_ASSIGN,
@@ -442,11 +470,22 @@ public:
 		StringName identifier;
 	};
 
+	// What a body compiled ahead of time (see GDScriptNativeEmitter) sees of the function it replaces,
+	// laid out in gdscript_native_interface.h so native libraries don't depend on engine types.
+	// It runs on the interpreter's own stack and indexes the same validated call tables as the bytecode.
+	typedef GDScriptNativeContext NativeContext;
+	typedef GDScriptNativeBody NativeBody;
+
 private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptNative;
+	friend class GDScriptNativeEmitter;
+	friend class GDScriptBytecodeCache;
+	friend class GDScriptSampler;
+	friend class TestGDScriptFunctionInternalsAccessor;
 
 	StringName name;
 	StringName source;
@@ -485,6 +524,11 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+	// Code offsets holding an index into the language's global array, which is not stable between runs.
+	Vector<int> global_index_positions;
+	// Code offset and line of each OPCODE_LINE, in code order.
+	Vector<Pair<int, int>> line_starts;
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
@@ -521,6 +565,79 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	// Per call site caches for OPCODE_CALL, OPCODE_GET_NAMED and OPCODE_SET_NAMED on untyped receivers.
+	// Each site remembers the last receivers it saw, keyed on their script and native class, along with
+	// what the name resolved to for them (a GDScriptFunction, a MethodBind or a script member slot).
+	// Entries are stamped with a global epoch that is bumped whenever scripts are compiled or freed,
+	// so a reload never leaves a site pointing at a stale target.
+	struct InlineCache {
+		static constexpr uint32_t ENTRY_COUNT = 2;
+
+		struct Entry {
+			std::atomic<uintptr_t> script_key = { 0 };
+			std::atomic<uintptr_t> class_key = { 0 };
+			std::atomic<uintptr_t> target = { 0 };
+			std::atomic<uint32_t> epoch = { 0 };
+		};
+
+		// Seqlock: odd while an entry is being written. Readers that race with a writer take the slow path.
+		std::atomic<uint32_t> sequence = { 0 };
+		Entry entries[ENTRY_COUNT];
+
+		_FORCE_INLINE_ uintptr_t find(uintptr_t p_script_key, uintptr_t p_class_key, uint32_t p_epoch) const {
+			const uint32_t seq = sequence.load(std::memory_order_acquire);
+			if (unlikely(seq & 1)) {
+				return 0;
+			}
+			uintptr_t found = 0;
+			for (uint32_t i = 0; i < ENTRY_COUNT; i++) {
+				const Entry &e = entries[i];
+				if (e.class_key.load(std::memory_order_relaxed) == p_class_key && e.script_key.load(std::memory_order_relaxed) == p_script_key && e.epoch.load(std::memory_order_relaxed) == p_epoch) {
+					found = e.target.load(std::memory_order_relaxed);
+					break;
+				}
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return sequence.load(std::memory_order_relaxed) == seq ? found : 0;
+		}
+
+		void store(uintptr_t p_script_key, uintptr_t p_class_key, uintptr_t p_target, uint32_t p_epoch) {
+			uint32_t seq = sequence.load(std::memory_order_relaxed);
+			if ((seq & 1) || !sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+				return; // Another thread is filling this site, let it win.
+			}
+			std::atomic_thread_fence(std::memory_order_release);
+
+			// Prefer an empty or stale slot, otherwise rotate so the site stays polymorphic.
+			uint32_t slot = (seq >> 1) % ENTRY_COUNT;
+			for (uint32_t i = 0; i < ENTRY_COUNT; i++) {
+				if (entries[i].epoch.load(std::memory_order_relaxed) != p_epoch) {
+					slot = i;
+					break;
+				}
+			}
+			Entry &e = entries[slot];
+			e.script_key.store(p_script_key, std::memory_order_relaxed);
+			e.class_key.store(p_class_key, std::memory_order_relaxed);
+			e.target.store(p_target, std::memory_order_relaxed);
+			e.epoch.store(p_epoch, std::memory_order_relaxed);
+
+			sequence.store(seq + 2, std::memory_order_release);
+		}
+	};
+
+	int _inline_caches_count = 0;
+	InlineCache *_inline_caches_ptr = nullptr;
+
+	NativeBody _native_body = nullptr; // Set when a matching body was registered with GDScriptNative.
+
+	static inline SafeNumeric<uint32_t> inline_cache_epoch{ 1 };
+
+	static uintptr_t _resolve_inline_call(GDScriptInstance *p_instance, Object *p_object, const StringName &p_method);
+	bool _inline_cache_call(InlineCache &p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	bool _inline_cache_get(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	bool _inline_cache_set(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -589,6 +706,9 @@ public:
 	StringName get_global_name(int p_idx) const;
 
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
+
+	// Drops every inline cache entry. Must be called whenever a script, a function or a member layout goes away.
+	static void invalidate_inline_caches() { inline_cache_epoch.increment(); }
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 #ifdef DEBUG_ENABLED
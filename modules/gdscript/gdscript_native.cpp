@@ -0,0 +1,144 @@
+/**************************************************************************/
+/*  gdscript_native.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native.h"
+
+#include "gdscript.h"
+
+#include "core/config/project_settings.h"
+#include "core/object/method_bind.h"
+#include "core/os/os.h"
+#include "core/variant/variant_internal.h"
+
+extern GDExtensionInterfaceFunctionPtr gdextension_get_proc_address(const char *p_name);
+
+static_assert(sizeof(Variant) == GDSCRIPT_NATIVE_VARIANT_SIZE, "GDSCRIPT_NATIVE_VARIANT_SIZE doesn't match the Variant layout.");
+
+HashMap<String, GDScriptFunction::NativeBody> GDScriptNative::bodies;
+void *GDScriptNative::library = nullptr;
+
+String GDScriptNative::_make_key(const String &p_script, const String &p_function, uint32_t p_code_hash) {
+	return p_script + "::" + p_function + "#" + String::num_uint64(p_code_hash, 16);
+}
+
+void GDScriptNative::_register_body(const char *p_script, const char *p_function, uint32_t p_code_hash, GDScriptNativeBody p_body) {
+	ERR_FAIL_NULL(p_body);
+	bodies[_make_key(String::utf8(p_script), String::utf8(p_function), p_code_hash)] = p_body;
+}
+
+// Same as the OPCODE_CALL_METHOD_BIND_VALIDATED_* instructions, minus the error reporting left to the interpreter.
+GDExtensionBool GDScriptNative::_call_method_bind(GDExtensionMethodBindPtr p_method, GDExtensionConstVariantPtr p_base, const GDExtensionConstVariantPtr *p_args, GDExtensionVariantPtr r_ret, GDExtensionBool p_has_return) {
+	Object *base = reinterpret_cast<const Variant *>(p_base)->get_validated_object();
+	if (!base) {
+		return false;
+	}
+	Variant *ret = reinterpret_cast<Variant *>(r_ret);
+	if (!p_has_return) {
+		VariantInternal::initialize(ret, Variant::NIL);
+		ret = nullptr;
+	}
+	reinterpret_cast<const MethodBind *>(p_method)->validated_call(base, (const Variant **)p_args, ret);
+	return true;
+}
+
+uint32_t GDScriptNative::hash_function(const GDScriptFunction *p_function) {
+	uint32_t h = hash_murmur3_buffer(p_function->code.ptr(), p_function->code.size() * sizeof(int));
+	h = hash_murmur3_one_32(p_function->_stack_size, h);
+	h = hash_murmur3_one_32(p_function->_instruction_args_size, h);
+	return hash_fmix32(h);
+}
+
+void GDScriptNative::attach(GDScriptFunction *p_function) {
+	p_function->_native_body = nullptr;
+	if (bodies.is_empty() || !p_function->_script) {
+		return;
+	}
+	HashMap<String, GDScriptFunction::NativeBody>::ConstIterator E = bodies.find(_make_key(p_function->_script->get_fully_qualified_name(), p_function->name, hash_function(p_function)));
+	if (E) {
+		p_function->_native_body = E->value;
+	}
+}
+
+Error GDScriptNative::load_library(const String &p_path) {
+	ERR_FAIL_COND_V(library != nullptr, ERR_ALREADY_IN_USE);
+
+	// Like GDExtension libraries, exported ones live next to the executable rather than in the pack.
+	String abs_path = p_path.is_relative_path() ? OS::get_singleton()->get_executable_path().get_base_dir().path_join(p_path) : ProjectSettings::get_singleton()->globalize_path(p_path);
+
+	Error err = OS::get_singleton()->open_dynamic_library(abs_path, library);
+	if (err != OK) {
+		library = nullptr;
+		ERR_FAIL_V_MSG(err, vformat(R"(Could not open GDScript native library "%s".)", abs_path));
+	}
+
+	void *init = nullptr;
+	err = OS::get_singleton()->get_dynamic_library_symbol_handle(library, INIT_SYMBOL, init);
+	if (err == OK) {
+		err = initialize(reinterpret_cast<GDScriptNativeInitFunc>(init));
+	}
+	if (err != OK) {
+		OS::get_singleton()->close_dynamic_library(library);
+		library = nullptr;
+		ERR_FAIL_V_MSG(err, vformat(R"(GDScript native library "%s" could not be initialized.)", abs_path));
+	}
+
+	print_verbose(vformat(R"(GDScript: Loaded %d native function bodies from "%s".)", bodies.size(), abs_path));
+	return OK;
+}
+
+Error GDScriptNative::initialize(GDScriptNativeInitFunc p_init) {
+	ERR_FAIL_NULL_V(p_init, ERR_INVALID_PARAMETER);
+
+	// Bodies read typed values at a fixed offset, make sure it's where Variant keeps them.
+	Variant probe = int64_t(0);
+	const intptr_t data_offset = reinterpret_cast<const uint8_t *>(VariantInternal::get_int(&probe)) - reinterpret_cast<const uint8_t *>(&probe);
+	ERR_FAIL_COND_V_MSG(data_offset != GDSCRIPT_NATIVE_VARIANT_DATA_OFFSET, ERR_BUG, "GDSCRIPT_NATIVE_VARIANT_DATA_OFFSET doesn't match the Variant layout.");
+
+	GDScriptNativeInterface native_interface;
+	native_interface.version = GDSCRIPT_NATIVE_INTERFACE_VERSION;
+	native_interface.variant_size = GDSCRIPT_NATIVE_VARIANT_SIZE;
+	native_interface.call_method_bind = &_call_method_bind;
+
+	if (!p_init(&gdextension_get_proc_address, &native_interface, &_register_body)) {
+		bodies.clear();
+		ERR_FAIL_V_MSG(ERR_INVALID_DATA, "GDScript native library was built for another engine version or precision.");
+	}
+	return OK;
+}
+
+void GDScriptNative::unload_library() {
+	bodies.clear();
+	if (library) {
+		OS::get_singleton()->close_dynamic_library(library);
+		library = nullptr;
+	}
+}
@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  gdscript_native.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_H
+#define GDSCRIPT_NATIVE_H
+
+#include "gdscript_function.h"
+
+#include "core/templates/hash_map.h"
+
+// Bodies compiled ahead of time from GDScript bytecode (see GDScriptNativeEmitter).
+// A library built from the emitted C++ registers one body per function, keyed on the
+// script's fully qualified name, the function name and a hash of the bytecode it was
+// generated from. Functions whose bytecode doesn't match exactly keep being interpreted.
+// Libraries only see the C interface from gdscript_native_interface.h.
+class GDScriptNative {
+public:
+	static constexpr const char *INIT_SYMBOL = "gdscript_native_init";
+
+private:
+	static HashMap<String, GDScriptFunction::NativeBody> bodies;
+	static void *library;
+
+	static String _make_key(const String &p_script, const String &p_function, uint32_t p_code_hash);
+	static void _register_body(const char *p_script, const char *p_function, uint32_t p_code_hash, GDScriptNativeBody p_body);
+	static GDExtensionBool _call_method_bind(GDExtensionMethodBindPtr p_method, GDExtensionConstVariantPtr p_base, const GDExtensionConstVariantPtr *p_args, GDExtensionVariantPtr r_ret, GDExtensionBool p_has_return);
+
+public:
+	static uint32_t hash_function(const GDScriptFunction *p_function);
+	static void attach(GDScriptFunction *p_function);
+
+	// Registers the bodies of a library whose entry point is already known, e.g. one linked statically.
+	static Error initialize(GDScriptNativeInitFunc p_init);
+	static Error load_library(const String &p_path);
+	static void unload_library();
+	static bool has_bodies() { return !bodies.is_empty(); }
+};
+
+#endif // GDSCRIPT_NATIVE_H
@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  gdscript_native_body.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_BODY_H
+#define GDSCRIPT_NATIVE_BODY_H
+
+/* Helpers for the code emitted by GDScriptNativeEmitter, only meant to be included by the
+ * translation unit of a native library. Everything is static, each library keeps its own
+ * copy of the engine functions it loads in gdscript_native_load().
+ */
+
+#include "gdscript_native_interface.h"
+
+static GDExtensionInterfaceVariantNewCopy gdscript_native_variant_new_copy = NULL;
+static GDExtensionInterfaceVariantNewNil gdscript_native_variant_new_nil = NULL;
+static GDExtensionInterfaceVariantDestroy gdscript_native_variant_destroy = NULL;
+static GDExtensionInterfaceVariantBooleanize gdscript_native_variant_booleanize = NULL;
+static GDExtensionInterfaceVariantGetType gdscript_native_variant_get_type = NULL;
+static GDExtensionVariantFromTypeConstructorFunc gdscript_native_variant_from_bool = NULL;
+static GDExtensionVariantFromTypeConstructorFunc gdscript_native_variant_from_int = NULL;
+static GDScriptNativeCallMethodBind gdscript_native_call_method_bind = NULL;
+
+static inline GDExtensionBool gdscript_native_load(GDExtensionInterfaceGetProcAddress p_get_proc_address, const GDScriptNativeInterface *p_interface) {
+	if (p_interface->version != GDSCRIPT_NATIVE_INTERFACE_VERSION || p_interface->variant_size != GDSCRIPT_NATIVE_VARIANT_SIZE) {
+		return 0;
+	}
+
+	gdscript_native_variant_new_copy = (GDExtensionInterfaceVariantNewCopy)p_get_proc_address("variant_new_copy");
+	gdscript_native_variant_new_nil = (GDExtensionInterfaceVariantNewNil)p_get_proc_address("variant_new_nil");
+	gdscript_native_variant_destroy = (GDExtensionInterfaceVariantDestroy)p_get_proc_address("variant_destroy");
+	gdscript_native_variant_booleanize = (GDExtensionInterfaceVariantBooleanize)p_get_proc_address("variant_booleanize");
+	gdscript_native_variant_get_type = (GDExtensionInterfaceVariantGetType)p_get_proc_address("variant_get_type");
+
+	GDExtensionInterfaceGetVariantFromTypeConstructor get_variant_from_type_constructor = (GDExtensionInterfaceGetVariantFromTypeConstructor)p_get_proc_address("get_variant_from_type_constructor");
+	if (!get_variant_from_type_constructor) {
+		return 0;
+	}
+	gdscript_native_variant_from_bool = get_variant_from_type_constructor(GDEXTENSION_VARIANT_TYPE_BOOL);
+	gdscript_native_variant_from_int = get_variant_from_type_constructor(GDEXTENSION_VARIANT_TYPE_INT);
+	gdscript_native_call_method_bind = p_interface->call_method_bind;
+
+	return gdscript_native_variant_new_copy && gdscript_native_variant_new_nil && gdscript_native_variant_destroy && gdscript_native_variant_booleanize && gdscript_native_variant_get_type && gdscript_native_call_method_bind;
+}
+
+// Address m_index of the given address type, like GET_VARIANT_PTR in the VM.
+#define GDSCRIPT_NATIVE_ADDRESS(m_addresses, m_type, m_index) ((GDExtensionVariantPtr)((uint8_t *)(m_addresses)[m_type] + (size_t)(m_index) * GDSCRIPT_NATIVE_VARIANT_SIZE))
+
+// Typed values, like VariantInternal::get_*(). The Variant must already hold that type.
+#define GDSCRIPT_NATIVE_DATA(m_type, m_variant) ((m_type *)((uint8_t *)(m_variant) + GDSCRIPT_NATIVE_VARIANT_DATA_OFFSET))
+#define GDSCRIPT_NATIVE_BOOL(m_variant) (*GDSCRIPT_NATIVE_DATA(bool, m_variant))
+#define GDSCRIPT_NATIVE_INT(m_variant) (*GDSCRIPT_NATIVE_DATA(int64_t, m_variant))
+#define GDSCRIPT_NATIVE_FLOAT(m_variant) (*GDSCRIPT_NATIVE_DATA(double, m_variant))
+#define GDSCRIPT_NATIVE_VECTOR(m_variant) GDSCRIPT_NATIVE_DATA(GDScriptNativeReal, m_variant)
+
+static inline void gdscript_native_assign(GDExtensionVariantPtr p_dst, GDExtensionConstVariantPtr p_src) {
+	if (p_dst != p_src) {
+		gdscript_native_variant_destroy(p_dst);
+		gdscript_native_variant_new_copy(p_dst, p_src);
+	}
+}
+
+static inline void gdscript_native_assign_nil(GDExtensionVariantPtr p_dst) {
+	gdscript_native_variant_destroy(p_dst);
+	gdscript_native_variant_new_nil(p_dst);
+}
+
+static inline void gdscript_native_assign_bool(GDExtensionVariantPtr p_dst, GDExtensionBool p_value) {
+	gdscript_native_variant_destroy(p_dst);
+	gdscript_native_variant_from_bool(p_dst, &p_value);
+}
+
+// Like VariantInternal::initialize() followed by a store.
+static inline void gdscript_native_assign_int(GDExtensionVariantPtr p_dst, GDExtensionInt p_value) {
+	gdscript_native_variant_destroy(p_dst);
+	gdscript_native_variant_from_int(p_dst, &p_value);
+}
+
+// Vector2 and Vector3 operators, component by component. The result may alias an operand.
+static inline void gdscript_native_vector_add(GDExtensionVariantPtr r_ret, GDExtensionConstVariantPtr p_left, GDExtensionConstVariantPtr p_right, int p_size) {
+	const GDScriptNativeReal *a = GDSCRIPT_NATIVE_VECTOR(p_left);
+	const GDScriptNativeReal *b = GDSCRIPT_NATIVE_VECTOR(p_right);
+	GDScriptNativeReal *r = GDSCRIPT_NATIVE_VECTOR(r_ret);
+	for (int i = 0; i < p_size; i++) {
+		r[i] = a[i] + b[i];
+	}
+}
+
+static inline void gdscript_native_vector_subtract(GDExtensionVariantPtr r_ret, GDExtensionConstVariantPtr p_left, GDExtensionConstVariantPtr p_right, int p_size) {
+	const GDScriptNativeReal *a = GDSCRIPT_NATIVE_VECTOR(p_left);
+	const GDScriptNativeReal *b = GDSCRIPT_NATIVE_VECTOR(p_right);
+	GDScriptNativeReal *r = GDSCRIPT_NATIVE_VECTOR(r_ret);
+	for (int i = 0; i < p_size; i++) {
+		r[i] = a[i] - b[i];
+	}
+}
+
+static inline void gdscript_native_vector_multiply(GDExtensionVariantPtr r_ret, GDExtensionConstVariantPtr p_left, GDExtensionConstVariantPtr p_scalar, int p_size) {
+	const GDScriptNativeReal *a = GDSCRIPT_NATIVE_VECTOR(p_left);
+	const GDScriptNativeReal s = (GDScriptNativeReal)GDSCRIPT_NATIVE_FLOAT(p_scalar);
+	GDScriptNativeReal *r = GDSCRIPT_NATIVE_VECTOR(r_ret);
+	for (int i = 0; i < p_size; i++) {
+		r[i] = a[i] * s;
+	}
+}
+
+#endif // GDSCRIPT_NATIVE_BODY_H
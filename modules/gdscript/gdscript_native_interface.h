@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*  gdscript_native_interface.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_INTERFACE_H
+#define GDSCRIPT_NATIVE_INTERFACE_H
+
+/* Interface between the GDScript VM and native bodies (see GDScriptNativeEmitter).
+ * Like gdextension_interface.h, this is a C header with no engine dependencies: native
+ * libraries build against these headers only, and reach the engine through the GDExtension
+ * interface and the function tables passed below, never through engine symbols.
+ */
+
+#include "core/extension/gdextension_interface.h"
+
+#ifndef __cplusplus
+#include <stdbool.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bumped whenever anything below changes. Libraries built for another version are rejected.
+#define GDSCRIPT_NATIVE_INTERFACE_VERSION 1
+
+// Layout of Variant, which bodies access directly for typed values.
+// The value sits past the type tag, vectors are stored inline as real_t components.
+#ifdef REAL_T_IS_DOUBLE
+#define GDSCRIPT_NATIVE_VARIANT_SIZE 40
+typedef double GDScriptNativeReal;
+#else
+#define GDSCRIPT_NATIVE_VARIANT_SIZE 24
+typedef float GDScriptNativeReal;
+#endif
+#define GDSCRIPT_NATIVE_VARIANT_DATA_OFFSET 8
+
+// Same signatures as the validated calls of Variant (e.g. Variant::ValidatedOperatorEvaluator).
+typedef void (*GDScriptNativeOperatorEvaluator)(GDExtensionConstVariantPtr p_left, GDExtensionConstVariantPtr p_right, GDExtensionVariantPtr r_ret);
+typedef void (*GDScriptNativeSetter)(GDExtensionVariantPtr p_base, GDExtensionConstVariantPtr p_value);
+typedef void (*GDScriptNativeGetter)(GDExtensionConstVariantPtr p_base, GDExtensionVariantPtr r_value);
+typedef void (*GDScriptNativeIndexedSetter)(GDExtensionVariantPtr p_base, GDExtensionInt p_index, GDExtensionConstVariantPtr p_value, bool *r_oob);
+typedef void (*GDScriptNativeIndexedGetter)(GDExtensionConstVariantPtr p_base, GDExtensionInt p_index, GDExtensionVariantPtr r_value, bool *r_oob);
+typedef void (*GDScriptNativeBuiltInMethod)(GDExtensionVariantPtr p_base, const GDExtensionConstVariantPtr *p_args, int p_argcount, GDExtensionVariantPtr r_ret);
+typedef void (*GDScriptNativeConstructor)(GDExtensionVariantPtr r_ret, const GDExtensionConstVariantPtr *p_args);
+typedef void (*GDScriptNativeUtilityFunction)(GDExtensionVariantPtr r_ret, const GDExtensionConstVariantPtr *p_args, int p_argcount);
+
+// Calls a method bind on the object held by p_base. Returns false without calling it when the
+// object is null or freed. Without p_has_return, r_ret is set to null instead of receiving a value.
+typedef GDExtensionBool (*GDScriptNativeCallMethodBind)(GDExtensionMethodBindPtr p_method, GDExtensionConstVariantPtr p_base, const GDExtensionConstVariantPtr *p_args, GDExtensionVariantPtr r_ret, GDExtensionBool p_has_return);
+
+// State of the function being run, filled by the VM for each call.
+typedef struct {
+	const GDExtensionVariantPtr *addresses; // Base of each address type, indexed like the VM.
+	GDExtensionVariantPtr retvalue;
+	const GDScriptNativeOperatorEvaluator *operator_funcs;
+	const GDScriptNativeSetter *setters;
+	const GDScriptNativeGetter *getters;
+	const GDScriptNativeIndexedSetter *indexed_setters;
+	const GDScriptNativeIndexedGetter *indexed_getters;
+	const GDScriptNativeBuiltInMethod *builtin_methods;
+	const GDScriptNativeConstructor *constructors;
+	const GDScriptNativeUtilityFunction *utilities;
+	const GDExtensionMethodBindPtr *methods;
+} GDScriptNativeContext;
+
+// Returns the bytecode address the interpreter resumes at. Bodies that run to completion
+// store the return value and return the address of the final OPCODE_END.
+typedef int (*GDScriptNativeBody)(const GDScriptNativeContext *p_context);
+
+typedef struct {
+	uint32_t version; // GDSCRIPT_NATIVE_INTERFACE_VERSION of the engine.
+	uint32_t variant_size; // GDSCRIPT_NATIVE_VARIANT_SIZE of the engine.
+	GDScriptNativeCallMethodBind call_method_bind;
+} GDScriptNativeInterface;
+
+typedef void (*GDScriptNativeRegisterFunc)(const char *p_script, const char *p_function, uint32_t p_code_hash, GDScriptNativeBody p_body);
+
+// Entry point of native libraries, exported as "gdscript_native_init". Returning false rejects
+// the library, e.g. when it was built for another interface version or precision.
+typedef GDExtensionBool (*GDScriptNativeInitFunc)(GDExtensionInterfaceGetProcAddress p_get_proc_address, const GDScriptNativeInterface *p_interface, GDScriptNativeRegisterFunc p_register);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GDSCRIPT_NATIVE_INTERFACE_H
@@ -1332,6 +1332,7 @@ public:
 
 private:
 	friend class GDScriptAnalyzer;
+	friend class GDScriptCache;
 	friend class GDScriptParserRef;
 
 	bool _is_tool = false;
@@ -1343,6 +1344,10 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	// What the script may depend on, noted while parsing so dependencies can be parsed before the analysis asks for them.
+	HashSet<String> referenced_paths;
+	HashSet<StringName> referenced_names;
+	Vector<Ref<GDScriptParserRef>> prefetched_parsers;
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
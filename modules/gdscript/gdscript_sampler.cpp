@@ -0,0 +1,497 @@
+/**************************************************************************/
+/*  gdscript_sampler.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampler.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/string/string_builder.h"
+
+static const char *opcode_names[] = {
+	"OPERATOR",
+	"OPERATOR_VALIDATED",
+	"OPERATOR_VALIDATED_JUMP_IF",
+	"OPERATOR_VALIDATED_JUMP_IF_NOT",
+	"ADD_INT_INT",
+	"SUBTRACT_INT_INT",
+	"MULTIPLY_INT_INT",
+	"LESS_INT_INT",
+	"LESS_EQUAL_INT_INT",
+	"GREATER_INT_INT",
+	"GREATER_EQUAL_INT_INT",
+	"EQUAL_INT_INT",
+	"NOT_EQUAL_INT_INT",
+	"ADD_FLOAT_FLOAT",
+	"SUBTRACT_FLOAT_FLOAT",
+	"MULTIPLY_FLOAT_FLOAT",
+	"DIVIDE_FLOAT_FLOAT",
+	"LESS_FLOAT_FLOAT",
+	"LESS_EQUAL_FLOAT_FLOAT",
+	"GREATER_FLOAT_FLOAT",
+	"GREATER_EQUAL_FLOAT_FLOAT",
+	"ADD_VECTOR2_VECTOR2",
+	"SUBTRACT_VECTOR2_VECTOR2",
+	"MULTIPLY_VECTOR2_FLOAT",
+	"ADD_VECTOR3_VECTOR3",
+	"SUBTRACT_VECTOR3_VECTOR3",
+	"MULTIPLY_VECTOR3_FLOAT",
+	"TYPE_TEST_BUILTIN",
+	"TYPE_TEST_ARRAY",
+	"TYPE_TEST_DICTIONARY",
+	"TYPE_TEST_NATIVE",
+	"TYPE_TEST_SCRIPT",
+	"SET_KEYED",
+	"SET_KEYED_VALIDATED",
+	"SET_INDEXED_VALIDATED",
+	"GET_KEYED",
+	"GET_KEYED_VALIDATED",
+	"GET_INDEXED_VALIDATED",
+	"SET_NAMED",
+	"SET_NAMED_VALIDATED",
+	"GET_NAMED",
+	"GET_NAMED_VALIDATED",
+	"SET_MEMBER",
+	"GET_MEMBER",
+	"SET_MEMBER_OPERATOR_VALIDATED",
+	"SET_STATIC_VARIABLE",
+	"GET_STATIC_VARIABLE",
+	"ASSIGN",
+	"ASSIGN_NULL",
+	"ASSIGN_TRUE",
+	"ASSIGN_FALSE",
+	"ASSIGN_TYPED_BUILTIN",
+	"ASSIGN_TYPED_ARRAY",
+	"ASSIGN_TYPED_DICTIONARY",
+	"ASSIGN_TYPED_NATIVE",
+	"ASSIGN_TYPED_SCRIPT",
+	"CAST_TO_BUILTIN",
+	"CAST_TO_NATIVE",
+	"CAST_TO_SCRIPT",
+	"CONSTRUCT",
+	"CONSTRUCT_VALIDATED",
+	"CONSTRUCT_ARRAY",
+	"CONSTRUCT_TYPED_ARRAY",
+	"CONSTRUCT_DICTIONARY",
+	"CONSTRUCT_TYPED_DICTIONARY",
+	"CALL",
+	"CALL_RETURN",
+	"CALL_ASYNC",
+	"CALL_UTILITY",
+	"CALL_UTILITY_VALIDATED",
+	"CALL_GDSCRIPT_UTILITY",
+	"CALL_BUILTIN_TYPE_VALIDATED",
+	"CALL_SELF_BASE",
+	"CALL_METHOD_BIND",
+	"CALL_METHOD_BIND_RET",
+	"CALL_BUILTIN_STATIC",
+	"CALL_NATIVE_STATIC",
+	"CALL_NATIVE_STATIC_VALIDATED_RETURN",
+	"CALL_NATIVE_STATIC_VALIDATED_NO_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_RETURN",
+	"CALL_METHOD_BIND_VALIDATED_NO_RETURN",
+	"AWAIT",
+	"AWAIT_RESUME",
+	"CREATE_LAMBDA",
+	"CREATE_SELF_LAMBDA",
+	"JUMP",
+	"JUMP_IF",
+	"JUMP_IF_NOT",
+	"JUMP_TO_DEF_ARGUMENT",
+	"JUMP_IF_SHARED",
+	"RETURN",
+	"RETURN_TYPED_BUILTIN",
+	"RETURN_TYPED_ARRAY",
+	"RETURN_TYPED_DICTIONARY",
+	"RETURN_TYPED_NATIVE",
+	"RETURN_TYPED_SCRIPT",
+	"ITERATE_BEGIN",
+	"ITERATE_BEGIN_INT",
+	"ITERATE_BEGIN_FLOAT",
+	"ITERATE_BEGIN_VECTOR2",
+	"ITERATE_BEGIN_VECTOR2I",
+	"ITERATE_BEGIN_VECTOR3",
+	"ITERATE_BEGIN_VECTOR3I",
+	"ITERATE_BEGIN_STRING",
+	"ITERATE_BEGIN_DICTIONARY",
+	"ITERATE_BEGIN_ARRAY",
+	"ITERATE_BEGIN_PACKED_BYTE_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_INT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT32_ARRAY",
+	"ITERATE_BEGIN_PACKED_FLOAT64_ARRAY",
+	"ITERATE_BEGIN_PACKED_STRING_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR2_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR3_ARRAY",
+	"ITERATE_BEGIN_PACKED_COLOR_ARRAY",
+	"ITERATE_BEGIN_PACKED_VECTOR4_ARRAY",
+	"ITERATE_BEGIN_OBJECT",
+	"ITERATE",
+	"ITERATE_INT",
+	"ITERATE_FLOAT",
+	"ITERATE_VECTOR2",
+	"ITERATE_VECTOR2I",
+	"ITERATE_VECTOR3",
+	"ITERATE_VECTOR3I",
+	"ITERATE_STRING",
+	"ITERATE_DICTIONARY",
+	"ITERATE_ARRAY",
+	"ITERATE_PACKED_BYTE_ARRAY",
+	"ITERATE_PACKED_INT32_ARRAY",
+	"ITERATE_PACKED_INT64_ARRAY",
+	"ITERATE_PACKED_FLOAT32_ARRAY",
+	"ITERATE_PACKED_FLOAT64_ARRAY",
+	"ITERATE_PACKED_STRING_ARRAY",
+	"ITERATE_PACKED_VECTOR2_ARRAY",
+	"ITERATE_PACKED_VECTOR3_ARRAY",
+	"ITERATE_PACKED_COLOR_ARRAY",
+	"ITERATE_PACKED_VECTOR4_ARRAY",
+	"ITERATE_OBJECT",
+	"STORE_GLOBAL",
+	"STORE_NAMED_GLOBAL",
+	"TYPE_ADJUST_BOOL",
+	"TYPE_ADJUST_INT",
+	"TYPE_ADJUST_FLOAT",
+	"TYPE_ADJUST_STRING",
+	"TYPE_ADJUST_VECTOR2",
+	"TYPE_ADJUST_VECTOR2I",
+	"TYPE_ADJUST_RECT2",
+	"TYPE_ADJUST_RECT2I",
+	"TYPE_ADJUST_VECTOR3",
+	"TYPE_ADJUST_VECTOR3I",
+	"TYPE_ADJUST_TRANSFORM2D",
+	"TYPE_ADJUST_VECTOR4",
+	"TYPE_ADJUST_VECTOR4I",
+	"TYPE_ADJUST_PLANE",
+	"TYPE_ADJUST_QUATERNION",
+	"TYPE_ADJUST_AABB",
+	"TYPE_ADJUST_BASIS",
+	"TYPE_ADJUST_TRANSFORM3D",
+	"TYPE_ADJUST_PROJECTION",
+	"TYPE_ADJUST_COLOR",
+	"TYPE_ADJUST_STRING_NAME",
+	"TYPE_ADJUST_NODE_PATH",
+	"TYPE_ADJUST_RID",
+	"TYPE_ADJUST_OBJECT",
+	"TYPE_ADJUST_CALLABLE",
+	"TYPE_ADJUST_SIGNAL",
+	"TYPE_ADJUST_DICTIONARY",
+	"TYPE_ADJUST_ARRAY",
+	"TYPE_ADJUST_PACKED_BYTE_ARRAY",
+	"TYPE_ADJUST_PACKED_INT32_ARRAY",
+	"TYPE_ADJUST_PACKED_INT64_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT32_ARRAY",
+	"TYPE_ADJUST_PACKED_FLOAT64_ARRAY",
+	"TYPE_ADJUST_PACKED_STRING_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR2_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR3_ARRAY",
+	"TYPE_ADJUST_PACKED_COLOR_ARRAY",
+	"TYPE_ADJUST_PACKED_VECTOR4_ARRAY",
+	"ASSERT",
+	"BREAKPOINT",
+	"LINE",
+	"END",
+};
+
+static_assert(sizeof(opcode_names) / sizeof(opcode_names[0]) == GDScriptFunction::OPCODE_END + 1, "Amount of opcode names don't match the amount of opcodes.");
+
+SafeFlag GDScriptSampler::active;
+SafeFlag GDScriptSampler::exit_thread;
+Thread GDScriptSampler::thread;
+int GDScriptSampler::interval_usec = 1000;
+thread_local GDScriptSampler::ThreadStackOwner GDScriptSampler::thread_stack;
+
+Mutex GDScriptSampler::mutex;
+LocalVector<GDScriptSampler::ThreadStack *> GDScriptSampler::thread_stacks;
+HashMap<GDScriptFunction *, GDScriptSampler::FunctionInfo> GDScriptSampler::functions;
+HashMap<String, uint64_t> GDScriptSampler::folded_stacks;
+HashMap<String, GDScriptSampler::LineStats> GDScriptSampler::lines;
+uint64_t GDScriptSampler::sample_count = 0;
+
+GDScriptSampler::ThreadStackOwner::~ThreadStackOwner() {
+	if (stack == nullptr) {
+		return;
+	}
+	MutexLock lock(mutex);
+	thread_stacks.erase(stack);
+	memdelete(stack);
+	stack = nullptr;
+}
+
+const char *GDScriptSampler::get_opcode_name(int p_opcode) {
+	if (p_opcode < 0 || p_opcode > GDScriptFunction::OPCODE_END) {
+		return "<invalid>";
+	}
+	return opcode_names[p_opcode];
+}
+
+GDScriptSampler::Frame *GDScriptSampler::_enter(GDScriptFunction *p_function, int p_ip) {
+	ThreadStack *stack = thread_stack.stack;
+	if (unlikely(stack == nullptr)) {
+		stack = memnew(ThreadStack);
+		stack->thread_id = Thread::get_caller_id();
+		MutexLock lock(mutex);
+		thread_stacks.push_back(stack);
+		thread_stack.stack = stack;
+	}
+
+	// The frame is filled before the depth is raised, so the sampler never sees a half written one.
+	const uint32_t depth = stack->depth.get();
+	Frame *frame = &stack->frames[MIN(depth, (uint32_t)MAX_DEPTH)];
+	if (depth <= MAX_DEPTH) {
+		frame->function = p_function;
+		frame->ip.set(p_ip);
+	}
+	stack->depth.set(depth + 1);
+	return frame;
+}
+
+void GDScriptSampler::forget_function(GDScriptFunction *p_function) {
+	MutexLock lock(mutex);
+	functions.erase(p_function);
+}
+
+const GDScriptSampler::FunctionInfo &GDScriptSampler::_get_function_info(GDScriptFunction *p_function) {
+	HashMap<GDScriptFunction *, FunctionInfo>::Iterator E = functions.find(p_function);
+	if (E) {
+		return E->value;
+	}
+
+	FunctionInfo info;
+	info.name = p_function->get_name();
+	GDScript *script = p_function->get_script();
+	info.path = script ? script->get_script_path() : String();
+	if (info.path.is_empty()) {
+		info.path = "<built-in>";
+	}
+	info.line_starts = p_function->line_starts;
+	info.code = p_function->code;
+	return functions.insert(p_function, info)->value;
+}
+
+int GDScriptSampler::_get_line(const FunctionInfo &p_info, int p_ip) {
+	// Last line starting at or before the instruction.
+	int low = 0;
+	int high = p_info.line_starts.size();
+	while (low < high) {
+		const int middle = (low + high) / 2;
+		if (p_info.line_starts[middle].first <= p_ip) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low > 0 ? p_info.line_starts[low - 1].second : 0;
+}
+
+void GDScriptSampler::_take_sample() {
+	MutexLock lock(mutex);
+
+	struct SampledFrame {
+		const FunctionInfo *info = nullptr;
+		int ip = 0;
+		int line = 0;
+	};
+	SampledFrame sampled[MAX_DEPTH + 1];
+
+	GDScriptFunction *sampled_functions[MAX_DEPTH + 1];
+
+	for (ThreadStack *stack : thread_stacks) {
+		const uint32_t pops = stack->pops.get();
+		const uint32_t depth = MIN(stack->depth.get(), (uint32_t)MAX_DEPTH + 1);
+		if (depth == 0) {
+			continue; // Not running script code.
+		}
+		for (uint32_t i = 0; i < depth; i++) {
+			sampled_functions[i] = stack->frames[i].function;
+			sampled[i].ip = stack->frames[i].ip.get();
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (stack->pops.get() != pops) {
+			// A call returned meanwhile, its function may be gone. Only frames that were live once the mutex
+			// was held are safe to look at, as freeing a function waits for the mutex in forget_function().
+			continue;
+		}
+
+		for (uint32_t i = 0; i < depth; i++) {
+			sampled[i].info = &_get_function_info(sampled_functions[i]);
+			sampled[i].line = _get_line(*sampled[i].info, sampled[i].ip);
+		}
+
+		StringBuilder folded;
+		folded.append(stack->thread_id == Thread::get_main_id() ? "Main Thread" : vformat("Thread %d", stack->thread_id));
+		HashSet<String> seen_lines;
+		for (uint32_t i = 0; i < depth; i++) {
+			const String location = sampled[i].info->path + ":" + itos(sampled[i].line);
+			folded.append(";");
+			folded.append(sampled[i].info->name + " (" + location + ")");
+
+			LineStats &line_stats = lines[location];
+			line_stats.function = sampled[i].info->name;
+			if (!seen_lines.has(location)) {
+				seen_lines.insert(location); // Recursion must not count a line more than once per sample.
+				line_stats.total_samples++;
+			}
+			if (i == depth - 1) {
+				line_stats.self_samples++;
+				const Vector<int> &code = sampled[i].info->code;
+				const int opcode = sampled[i].ip >= 0 && sampled[i].ip < code.size() ? code[sampled[i].ip] : -1;
+				line_stats.opcode_samples[opcode]++;
+			}
+		}
+		folded_stacks[folded.as_string()]++;
+		sample_count++;
+	}
+}
+
+void GDScriptSampler::_thread_func(void *p_userdata) {
+	while (!exit_thread.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		_take_sample();
+	}
+}
+
+void GDScriptSampler::start(int p_interval_usec) {
+	ERR_FAIL_COND_MSG(active.is_set(), "The GDScript sampling profiler is already running.");
+	interval_usec = MAX(p_interval_usec, 50);
+	exit_thread.clear();
+	active.set();
+	thread.start(&GDScriptSampler::_thread_func, nullptr);
+}
+
+void GDScriptSampler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+	// Frames already entered keep popping themselves, only new calls stop being tracked.
+	active.clear();
+	exit_thread.set();
+	thread.wait_to_finish();
+}
+
+uint64_t GDScriptSampler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
+
+String GDScriptSampler::get_folded_stacks() {
+	MutexLock lock(mutex);
+
+	LocalVector<String> stacks;
+	for (const KeyValue<String, uint64_t> &E : folded_stacks) {
+		stacks.push_back(E.key + " " + itos(E.value));
+	}
+	stacks.sort();
+
+	StringBuilder result;
+	for (const String &stack : stacks) {
+		result.append(stack);
+		result.append("\n");
+	}
+	return result.as_string();
+}
+
+String GDScriptSampler::get_line_report() {
+	MutexLock lock(mutex);
+
+	struct Entry {
+		const String *location = nullptr;
+		const LineStats *stats = nullptr;
+
+		bool operator<(const Entry &p_other) const {
+			if (stats->self_samples != p_other.stats->self_samples) {
+				return stats->self_samples > p_other.stats->self_samples;
+			}
+			if (stats->total_samples != p_other.stats->total_samples) {
+				return stats->total_samples > p_other.stats->total_samples;
+			}
+			return *location < *p_other.location;
+		}
+	};
+
+	LocalVector<Entry> entries;
+	for (const KeyValue<String, LineStats> &E : lines) {
+		entries.push_back({ &E.key, &E.value });
+	}
+	entries.sort();
+
+	const double total = MAX(sample_count, (uint64_t)1);
+	StringBuilder result;
+	result.append(vformat("# %d samples, one every %d usec.\n", sample_count, interval_usec));
+	result.append("# self\tself %\ttotal\ttotal %\tlocation\tfunction\tinstructions (samples)\n");
+	for (const Entry &entry : entries) {
+		const LineStats &stats = *entry.stats;
+
+		LocalVector<Pair<uint64_t, int>> opcodes;
+		for (const KeyValue<int, uint64_t> &E : stats.opcode_samples) {
+			opcodes.push_back(Pair<uint64_t, int>(E.value, E.key));
+		}
+		opcodes.sort_custom<PairSort<uint64_t, int>>();
+		String instructions;
+		for (int i = opcodes.size() - 1; i >= 0; i--) {
+			if (!instructions.is_empty()) {
+				instructions += ", ";
+			}
+			instructions += vformat("%s (%d)", get_opcode_name(opcodes[i].second), opcodes[i].first);
+		}
+
+		result.append(vformat("%d\t%.2f\t%d\t%.2f\t%s\t%s\t%s\n", stats.self_samples, stats.self_samples * 100.0 / total, stats.total_samples, stats.total_samples * 100.0 / total, *entry.location, stats.function, instructions));
+	}
+	return result.as_string();
+}
+
+Error GDScriptSampler::save(const String &p_base_path) {
+	Error err = DirAccess::make_dir_recursive_absolute(p_base_path.get_base_dir());
+	if (err != OK && err != ERR_ALREADY_EXISTS) {
+		return err;
+	}
+
+	Ref<FileAccess> file = FileAccess::open(p_base_path + ".folded", FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat(R"(Can't write GDScript samples to "%s.folded".)", p_base_path));
+	file->store_string(get_folded_stacks());
+
+	file = FileAccess::open(p_base_path + ".lines.tsv", FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(file.is_null(), err, vformat(R"(Can't write GDScript samples to "%s.lines.tsv".)", p_base_path));
+	file->store_string(get_line_report());
+	return OK;
+}
+
+void GDScriptSampler::clear() {
+	MutexLock lock(mutex);
+	functions.clear();
+	folded_stacks.clear();
+	lines.clear();
+	sample_count = 0;
+}
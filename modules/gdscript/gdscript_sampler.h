@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  gdscript_sampler.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLER_H
+#define GDSCRIPT_SAMPLER_H
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Statistical profiler: a background thread periodically looks at which function and instruction
+// each thread is running. Unlike the instrumented profiler it doesn't time calls, so it works in
+// release builds and barely changes what it measures. Results are written as folded stacks
+// (the input format of flame graph tools) and as a per-line report.
+class GDScriptSampler {
+	friend class TestGDScriptSamplerInternalsAccessor;
+
+public:
+	enum {
+		MAX_DEPTH = 256, // Deeper calls are attributed to the frame at this depth.
+	};
+
+	struct Frame {
+		GDScriptFunction *function = nullptr;
+		SafeNumeric<int> ip;
+	};
+
+private:
+	struct ThreadStack {
+		Frame frames[MAX_DEPTH + 1];
+		SafeNumeric<uint32_t> depth;
+		SafeNumeric<uint32_t> pops; // Lets the sampler tell whether the frames changed while it read them.
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+	};
+
+	struct ThreadStackOwner {
+		ThreadStack *stack = nullptr;
+		~ThreadStackOwner();
+	};
+
+	struct FunctionInfo {
+		String name;
+		String path;
+		Vector<Pair<int, int>> line_starts;
+		Vector<int> code;
+	};
+
+	struct LineStats {
+		String function;
+		uint64_t self_samples = 0;
+		uint64_t total_samples = 0;
+		HashMap<int, uint64_t> opcode_samples;
+	};
+
+	static SafeFlag active;
+	static SafeFlag exit_thread;
+	static Thread thread;
+	static int interval_usec;
+	static thread_local ThreadStackOwner thread_stack;
+
+	static Mutex mutex;
+	static LocalVector<ThreadStack *> thread_stacks;
+	static HashMap<GDScriptFunction *, FunctionInfo> functions;
+	static HashMap<String, uint64_t> folded_stacks;
+	static HashMap<String, LineStats> lines;
+	static uint64_t sample_count;
+
+	static Frame *_enter(GDScriptFunction *p_function, int p_ip);
+	static void _thread_func(void *p_userdata);
+	static void _take_sample();
+	static const FunctionInfo &_get_function_info(GDScriptFunction *p_function);
+	static int _get_line(const FunctionInfo &p_info, int p_ip);
+
+public:
+	static const char *get_opcode_name(int p_opcode);
+
+	// Called by the VM around every function call, returns the frame to publish the instruction pointer to.
+	_FORCE_INLINE_ static Frame *enter(GDScriptFunction *p_function, int p_ip) {
+		if (likely(!active.is_set())) {
+			return nullptr;
+		}
+		return _enter(p_function, p_ip);
+	}
+	_FORCE_INLINE_ static void exit(Frame *p_frame) {
+		if (unlikely(p_frame != nullptr)) {
+			// Only ever written by their own thread.
+			ThreadStack *stack = thread_stack.stack;
+			stack->pops.set(stack->pops.get() + 1);
+			stack->depth.set(stack->depth.get() - 1);
+		}
+	}
+	static void forget_function(GDScriptFunction *p_function);
+
+	static bool is_running() { return active.is_set(); }
+	static void start(int p_interval_usec);
+	static void stop();
+	static uint64_t get_sample_count();
+	static String get_folded_stacks();
+	static String get_line_report();
+	static Error save(const String &p_base_path);
+	static void clear();
+};
+
+#endif // GDSCRIPT_SAMPLER_H
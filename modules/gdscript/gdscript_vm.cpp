@@ -33,8 +33,11 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampler.h"
 
+#include "core/config/engine.h"
 #include "core/os/os.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -187,6 +190,168 @@ String GDScriptFunction::_get_call_error(const String &p_where, const Variant **
 	return "Bug: Invalid call error code " + itos(p_err.error) + ".";
 }
 
+// Returns the receiver of a cacheable access, along with its GDScript instance if it has one.
+// Objects running other script languages (or placeholders) are left to the generic path.
+static _FORCE_INLINE_ Object *_get_inline_cache_receiver(const Variant *p_base, GDScriptInstance *&r_instance) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return nullptr;
+	}
+	Object *obj = p_base->get_validated_object();
+	if (unlikely(!obj)) {
+		return nullptr;
+	}
+	ScriptInstance *si = obj->get_script_instance();
+	if (si) {
+		if (si->get_language() != GDScriptLanguage::get_singleton() || si->is_placeholder()) {
+			return nullptr;
+		}
+		r_instance = static_cast<GDScriptInstance *>(si);
+	} else {
+		r_instance = nullptr;
+	}
+	return obj;
+}
+
+uintptr_t GDScriptFunction::_resolve_inline_call(GDScriptInstance *p_instance, Object *p_object, const StringName &p_method) {
+	if (p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+		return 0; // Both have side effects in Object/GDScriptInstance::callp() that a direct call would skip.
+	}
+
+	if (p_instance) {
+		for (GDScript *sptr = p_instance->script.ptr(); sptr; sptr = sptr->_base) {
+			if (unlikely(!sptr->valid)) {
+				return 0;
+			}
+			HashMap<StringName, GDScriptFunction *>::Iterator E = sptr->member_functions.find(p_method);
+			if (E) {
+				return reinterpret_cast<uintptr_t>(E->value);
+			}
+		}
+	}
+
+	// Only engine classes, extension classes may be unloaded while the cache still points at them.
+	const StringName &class_name = p_object->get_class_name();
+	ClassDB::APIType api = ClassDB::get_api_type(class_name);
+	if (api != ClassDB::API_CORE && api != ClassDB::API_EDITOR) {
+		return 0;
+	}
+	MethodBind *method = ClassDB::get_method(class_name, p_method);
+	if (!method) {
+		return 0;
+	}
+	return reinterpret_cast<uintptr_t>(method) | 1; // Tag native targets.
+}
+
+bool GDScriptFunction::_inline_cache_call(InlineCache &p_cache, const Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	GDScriptInstance *instance;
+	Object *obj = _get_inline_cache_receiver(p_base, instance);
+	if (!obj) {
+		return false;
+	}
+
+	const uintptr_t script_key = instance ? reinterpret_cast<uintptr_t>(instance->script.ptr()) : 0;
+	const uintptr_t class_key = reinterpret_cast<uintptr_t>(obj->get_class_name().data_unique_pointer());
+	const uint32_t epoch = inline_cache_epoch.get();
+
+	uintptr_t target = p_cache.find(script_key, class_key, epoch);
+	if (!target) {
+		target = _resolve_inline_call(instance, obj, p_method);
+		if (!target) {
+			return false;
+		}
+		p_cache.store(script_key, class_key, target, epoch);
+	}
+
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(obj);
+#endif
+	r_err.error = Callable::CallError::CALL_OK;
+	if (target & 1) {
+		r_ret = reinterpret_cast<MethodBind *>(target & ~uintptr_t(1))->call(obj, p_args, p_argcount, r_err);
+	} else {
+		r_ret = reinterpret_cast<GDScriptFunction *>(target)->call(instance, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_get(InlineCache &p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	GDScriptInstance *instance;
+	Object *obj = _get_inline_cache_receiver(p_base, instance);
+	if (!obj || !instance) {
+		return false; // Native properties keep going through ClassDB.
+	}
+
+	GDScript *scr = instance->script.ptr();
+	const uintptr_t script_key = reinterpret_cast<uintptr_t>(scr);
+	const uintptr_t class_key = reinterpret_cast<uintptr_t>(obj->get_class_name().data_unique_pointer());
+	const uint32_t epoch = inline_cache_epoch.get();
+
+	const GDScript::MemberInfo *member = reinterpret_cast<const GDScript::MemberInfo *>(p_cache.find(script_key, class_key, epoch));
+	if (!member) {
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = scr->member_indices.find(p_name);
+		if (!E || !scr->valid || E->value.getter != StringName()) {
+			return false;
+		}
+		member = &E->value;
+		p_cache.store(script_key, class_key, reinterpret_cast<uintptr_t>(member), epoch);
+	}
+
+	if (unlikely(member->index < 0 || member->index >= instance->members.size())) {
+		return false;
+	}
+	// Copy first: the receiver may be the only reference to the instance and share storage with r_ret.
+	const Variant value = instance->members[member->index];
+	r_ret = value;
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_set(InlineCache &p_cache, Variant *p_base, const StringName &p_name, const Variant &p_value) {
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false; // Object::set() also marks the object as edited.
+	}
+#endif
+
+	GDScriptInstance *instance;
+	Object *obj = _get_inline_cache_receiver(p_base, instance);
+	if (!obj || !instance) {
+		return false;
+	}
+
+	GDScript *scr = instance->script.ptr();
+	const uintptr_t script_key = reinterpret_cast<uintptr_t>(scr);
+	const uintptr_t class_key = reinterpret_cast<uintptr_t>(obj->get_class_name().data_unique_pointer());
+	const uint32_t epoch = inline_cache_epoch.get();
+
+	const GDScript::MemberInfo *member = reinterpret_cast<const GDScript::MemberInfo *>(p_cache.find(script_key, class_key, epoch));
+	if (!member) {
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = scr->member_indices.find(p_name);
+		if (!E || !scr->valid || E->value.setter != StringName()) {
+			return false;
+		}
+		member = &E->value;
+		p_cache.store(script_key, class_key, reinterpret_cast<uintptr_t>(member), epoch);
+	}
+
+	if (unlikely(member->index < 0 || member->index >= instance->members.size())) {
+		return false;
+	}
+	if (member->data_type.has_type && !member->data_type.is_type(p_value)) {
+		// Same conversion as GDScriptInstance::set(), failures are reported by the generic path.
+		Variant converted;
+		const Variant *args = &p_value;
+		Callable::CallError err;
+		Variant::construct(member->data_type.builtin_type, converted, &args, 1, err);
+		if (err.error != Callable::CallError::CALL_OK || !member->data_type.is_type(converted)) {
+			return false;
+		}
+		instance->members.write[member->index] = converted;
+	} else {
+		instance->members.write[member->index] = p_value;
+	}
+	return true;
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -229,11 +394,42 @@ void (*type_init_function_table[])(Variant *) = {
 	&VariantInitializer<PackedVector4Array>::init, // PACKED_VECTOR4_ARRAY.
 };
 
+// Tells the sampling profiler which instruction is running, only a test when it's off.
+#define SAMPLE_IP                              \
+	if (unlikely(sample_frame != nullptr)) {   \
+		sample_frame->ip.set(ip);              \
+	}
+
 #if defined(__GNUC__) || defined(__clang__)
 #define OPCODES_TABLE                                    \
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,             \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_ADD_INT_INT,                            \
+		&&OPCODE_SUBTRACT_INT_INT,                       \
+		&&OPCODE_MULTIPLY_INT_INT,                       \
+		&&OPCODE_LESS_INT_INT,                           \
+		&&OPCODE_LESS_EQUAL_INT_INT,                     \
+		&&OPCODE_GREATER_INT_INT,                        \
+		&&OPCODE_GREATER_EQUAL_INT_INT,                  \
+		&&OPCODE_EQUAL_INT_INT,                          \
+		&&OPCODE_NOT_EQUAL_INT_INT,                      \
+		&&OPCODE_ADD_FLOAT_FLOAT,                        \
+		&&OPCODE_SUBTRACT_FLOAT_FLOAT,                   \
+		&&OPCODE_MULTIPLY_FLOAT_FLOAT,                   \
+		&&OPCODE_DIVIDE_FLOAT_FLOAT,                     \
+		&&OPCODE_LESS_FLOAT_FLOAT,                       \
+		&&OPCODE_LESS_EQUAL_FLOAT_FLOAT,                 \
+		&&OPCODE_GREATER_FLOAT_FLOAT,                    \
+		&&OPCODE_GREATER_EQUAL_FLOAT_FLOAT,              \
+		&&OPCODE_ADD_VECTOR2_VECTOR2,                    \
+		&&OPCODE_SUBTRACT_VECTOR2_VECTOR2,               \
+		&&OPCODE_MULTIPLY_VECTOR2_FLOAT,                 \
+		&&OPCODE_ADD_VECTOR3_VECTOR3,                    \
+		&&OPCODE_SUBTRACT_VECTOR3_VECTOR3,               \
+		&&OPCODE_MULTIPLY_VECTOR3_FLOAT,                 \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -251,6 +447,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_GET_NAMED_VALIDATED,                    \
 		&&OPCODE_SET_MEMBER,                             \
 		&&OPCODE_GET_MEMBER,                             \
+		&&OPCODE_SET_MEMBER_OPERATOR_VALIDATED,          \
 		&&OPCODE_SET_STATIC_VARIABLE,                    \
 		&&OPCODE_GET_STATIC_VARIABLE,                    \
 		&&OPCODE_ASSIGN,                                 \
@@ -402,10 +599,13 @@ void (*type_init_function_table[])(Variant *) = {
 
 #ifdef DEBUG_ENABLED
 #define DISPATCH_OPCODE          \
+	SAMPLE_IP;                   \
 	last_opcode = _code_ptr[ip]; \
 	goto *switch_table_ops[last_opcode]
 #else // !DEBUG_ENABLED
-#define DISPATCH_OPCODE goto *switch_table_ops[_code_ptr[ip]]
+#define DISPATCH_OPCODE \
+	SAMPLE_IP;          \
+	goto *switch_table_ops[_code_ptr[ip]]
 #endif // DEBUG_ENABLED
 
 #define OPCODE_BREAK goto OPSEXIT
@@ -629,6 +829,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	String err_text;
 
+	GDScriptSampler::Frame *sample_frame = GDScriptSampler::enter(this, ip);
+
 #ifdef DEBUG_ENABLED
 
 	if (EngineDebugger::is_active()) {
@@ -712,6 +914,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+	// Run the ahead-of-time compiled body, if any. It hands back to the interpreter at the first
+	// instruction it doesn't cover, or at OPCODE_END with the return value already stored.
+	// The debugger and profiler need per-instruction state, so they keep using the bytecode.
+#ifdef DEBUG_ENABLED
+	if (_native_body && !p_state && !EngineDebugger::is_active() && !GDScriptLanguage::get_singleton()->profiling) {
+#else
+	if (_native_body && !p_state) {
+#endif
+		// The tables hold plain function pointers taking Variant pointers, which the C interface sees as opaque.
+		NativeContext native_context;
+		native_context.addresses = reinterpret_cast<const GDExtensionVariantPtr *>(variant_addresses);
+		native_context.retvalue = &retvalue;
+		native_context.operator_funcs = reinterpret_cast<const GDScriptNativeOperatorEvaluator *>(_operator_funcs_ptr);
+		native_context.setters = reinterpret_cast<const GDScriptNativeSetter *>(_setters_ptr);
+		native_context.getters = reinterpret_cast<const GDScriptNativeGetter *>(_getters_ptr);
+		native_context.indexed_setters = reinterpret_cast<const GDScriptNativeIndexedSetter *>(_indexed_setters_ptr);
+		native_context.indexed_getters = reinterpret_cast<const GDScriptNativeIndexedGetter *>(_indexed_getters_ptr);
+		native_context.builtin_methods = reinterpret_cast<const GDScriptNativeBuiltInMethod *>(_builtin_methods_ptr);
+		native_context.constructors = reinterpret_cast<const GDScriptNativeConstructor *>(_constructors_ptr);
+		native_context.utilities = reinterpret_cast<const GDScriptNativeUtilityFunction *>(_utilities_ptr);
+		native_context.methods = reinterpret_cast<const GDExtensionMethodBindPtr *>(_methods_ptr);
+		ip = _native_body(&native_context);
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -719,6 +945,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	OPCODE_WHILE(true) {
 #endif
 
+		SAMPLE_IP;
 		OPCODE_SWITCH(_code_ptr[ip]) {
 			OPCODE(OPCODE_OPERATOR) {
 				constexpr int _pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*_code_ptr);
@@ -824,6 +1051,88 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				// Only fused when the operator returns a bool, so no need to booleanize.
+				if (*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!*VariantInternal::get_bool(dst)) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_TYPED_OPERATOR(m_opcode, m_result_type, m_left_type, m_operator, m_right_type)                                                   \
+	OPCODE(OPCODE_##m_opcode) {                                                                                                                 \
+		CHECK_SPACE(4);                                                                                                                         \
+		GET_VARIANT_PTR(a, 0);                                                                                                                  \
+		GET_VARIANT_PTR(b, 1);                                                                                                                  \
+		GET_VARIANT_PTR(dst, 2);                                                                                                                \
+		*VariantInternal::get_##m_result_type(dst) = *VariantInternal::get_##m_left_type(a) m_operator *VariantInternal::get_##m_right_type(b); \
+		ip += 4;                                                                                                                                \
+	}                                                                                                                                           \
+	DISPATCH_OPCODE
+
+			OPCODE_TYPED_OPERATOR(ADD_INT_INT, int, int, +, int);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_INT_INT, int, int, -, int);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_INT_INT, int, int, *, int);
+			OPCODE_TYPED_OPERATOR(LESS_INT_INT, bool, int, <, int);
+			OPCODE_TYPED_OPERATOR(LESS_EQUAL_INT_INT, bool, int, <=, int);
+			OPCODE_TYPED_OPERATOR(GREATER_INT_INT, bool, int, >, int);
+			OPCODE_TYPED_OPERATOR(GREATER_EQUAL_INT_INT, bool, int, >=, int);
+			OPCODE_TYPED_OPERATOR(EQUAL_INT_INT, bool, int, ==, int);
+			OPCODE_TYPED_OPERATOR(NOT_EQUAL_INT_INT, bool, int, !=, int);
+			OPCODE_TYPED_OPERATOR(ADD_FLOAT_FLOAT, float, float, +, float);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_FLOAT_FLOAT, float, float, -, float);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_FLOAT_FLOAT, float, float, *, float);
+			OPCODE_TYPED_OPERATOR(DIVIDE_FLOAT_FLOAT, float, float, /, float);
+			OPCODE_TYPED_OPERATOR(LESS_FLOAT_FLOAT, bool, float, <, float);
+			OPCODE_TYPED_OPERATOR(LESS_EQUAL_FLOAT_FLOAT, bool, float, <=, float);
+			OPCODE_TYPED_OPERATOR(GREATER_FLOAT_FLOAT, bool, float, >, float);
+			OPCODE_TYPED_OPERATOR(GREATER_EQUAL_FLOAT_FLOAT, bool, float, >=, float);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR2_VECTOR2, vector2, vector2, +, vector2);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR2_VECTOR2, vector2, vector2, -, vector2);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR2_FLOAT, vector2, vector2, *, float);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR3_VECTOR3, vector3, vector3, +, vector3);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR3_VECTOR3, vector3, vector3, -, vector3);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, vector3, vector3, *, float);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1168,7 +1477,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1178,8 +1487,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-				dst->set_named(*index, *value, valid);
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
+				bool valid = true;
+				if (!_inline_cache_set(_inline_caches_ptr[cache_idx], dst, *index, *value)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1200,7 +1514,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1230,13 +1544,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
+				bool valid = true;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
-
+				Variant ret;
+				if (!_inline_cache_get(_inline_caches_ptr[cache_idx], src, *index, ret)) {
+					ret = src->get_named(*index, valid);
+				}
 #else
-				*dst = src->get_named(*index, valid);
+				if (!_inline_cache_get(_inline_caches_ptr[cache_idx], src, *index, *dst)) {
+					*dst = src->get_named(*index, valid);
+				}
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1245,7 +1566,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1307,6 +1628,46 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_SET_MEMBER_OPERATOR_VALIDATED) {
+				CHECK_SPACE(7);
+				GET_VARIANT_PTR(member, 0);
+				int indexname = _code_ptr[ip + 2];
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+
+				int operator_idx = _code_ptr[ip + 6];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 2);
+				GET_VARIANT_PTR(b, 3);
+				GET_VARIANT_PTR(dst, 4);
+
+				bool valid;
+#ifndef DEBUG_ENABLED
+				ClassDB::get_property(p_instance->owner, *index, *member);
+				operator_func(a, b, dst);
+				ClassDB::set_property(p_instance->owner, *index, *dst, &valid);
+#else
+				bool ok = ClassDB::get_property(p_instance->owner, *index, *member);
+				if (!ok) {
+					err_text = "Internal error getting property: " + String(*index);
+					OPCODE_BREAK;
+				}
+				operator_func(a, b, dst);
+				ok = ClassDB::set_property(p_instance->owner, *index, *dst, &valid);
+				if (!ok) {
+					err_text = "Internal error setting property: " + String(*index);
+					OPCODE_BREAK;
+				} else if (!valid) {
+					err_text = "Error setting property '" + String(*index) + "' with value of type " + Variant::get_type_name(dst->get_type()) + ".";
+					OPCODE_BREAK;
+				}
+#endif
+				ip += 7;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_SET_STATIC_VARIABLE) {
 				CHECK_SPACE(4);
 
@@ -1864,7 +2225,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1875,6 +2236,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				InlineCache &inline_cache = _inline_caches_ptr[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1893,7 +2258,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1922,7 +2289,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
+				} else if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
 					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
@@ -1973,7 +2340,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -3899,6 +4266,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		stack[i].~Variant();
 	}
 
+	GDScriptSampler::exit(sample_frame);
 	call_depth--;
 
 	return retvalue;
@@ -41,6 +41,7 @@
 
 #ifdef TOOLS_ENABLED
 #include "editor/gdscript_highlighter.h"
+#include "editor/gdscript_native_emitter.h"
 #include "editor/gdscript_translation_parser_plugin.h"
 
 #ifndef GDSCRIPT_NO_LSP
@@ -87,7 +88,15 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
 
+	String native_source_path;
+	GDScriptNativeEmitter *native_emitter = nullptr;
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		// Where to write the C++ translation of the exported scripts. Empty disables it.
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_source_path", PROPERTY_HINT_GLOBAL_SAVE_FILE, "*.cpp"), ""));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
 
@@ -95,9 +104,22 @@ protected:
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		native_source_path = preset.is_valid() ? String(get_option("gdscript/native_source_path")) : String();
+		if (!native_source_path.is_empty()) {
+			native_emitter = memnew(GDScriptNativeEmitter);
+			// Debug templates keep line and assert instructions, bodies must match their bytecode.
+			native_emitter->set_release_bytecode(!p_debug);
+		}
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
+		if (native_emitter && p_path.get_extension() == "gd") {
+			if (native_emitter->add_script(p_path) != OK) {
+				WARN_PRINT(vformat(R"(GDScript: "%s" could not be compiled to native code, it will be interpreted.)", p_path));
+			}
+		}
+
 		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
 			return;
 		}
@@ -118,6 +140,32 @@ protected:
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
+	virtual void _export_end() override {
+		if (!native_emitter) {
+			return;
+		}
+
+		Error err = OK;
+		Ref<FileAccess> f = FileAccess::open(native_source_path, FileAccess::WRITE, &err);
+		if (f.is_valid()) {
+			f->store_string(native_emitter->get_source());
+			print_line(vformat(R"(GDScript: Wrote %d native function bodies to "%s".)", native_emitter->get_body_count(), native_source_path));
+		} else {
+			ERR_PRINT(vformat(R"(GDScript: Could not write native source to "%s".)", native_source_path));
+		}
+
+		const String build_script_path = native_source_path.get_basename() + ".scons";
+		f = FileAccess::open(build_script_path, FileAccess::WRITE, &err);
+		if (f.is_valid()) {
+			f->store_string(GDScriptNativeEmitter::get_build_script(native_source_path));
+		} else {
+			ERR_PRINT(vformat(R"(GDScript: Could not write native build script to "%s".)", build_script_path));
+		}
+
+		memdelete(native_emitter);
+		native_emitter = nullptr;
+	}
+
 public:
 	virtual String get_name() const override { return "GDScript"; }
 };
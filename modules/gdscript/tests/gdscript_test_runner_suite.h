@@ -35,7 +35,40 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_analyzer.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_compiler.h"
+#include "../gdscript_native.h"
+#include "../gdscript_native_body.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_sampler.h"
+
+#ifdef TOOLS_ENABLED
+#include "../editor/gdscript_native_emitter.h"
+#endif
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+class TestGDScriptCacheInternalsAccessor {
+public:
+	static uint32_t get_prefetched_parser_count() { return GDScriptCache::singleton->prefetched_parser_count; }
+};
+
+class TestGDScriptFunctionInternalsAccessor {
+public:
+	static int get_end_address(const GDScriptFunction *p_function) { return p_function->_code_size - 1; }
+	static const Vector<int> &get_code(const GDScriptFunction *p_function) { return p_function->code; }
+	static const Vector<Pair<int, int>> &get_line_starts(const GDScriptFunction *p_function) { return p_function->line_starts; }
+};
+
+class TestGDScriptSamplerInternalsAccessor {
+public:
+	static int get_line(GDScriptFunction *p_function, int p_ip) {
+		MutexLock lock(GDScriptSampler::mutex);
+		return GDScriptSampler::_get_line(GDScriptSampler::_get_function_info(p_function), p_ip);
+	}
+};
 
 namespace GDScriptTests {
 
@@ -72,8 +105,352 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE("[Modules][GDScript] Load compiled bytecode from the cache and run it") {
+	const String source = R"(
+extends RefCounted
+
+const SCALE := 3
+const TABLE := { "a": [1, 2], "b": Vector2(1, 2) }
+
+class Counter:
+	var total := 0
+
+	func add(amount: int) -> int:
+		total += amount
+		return total
+
+func compute(count: int) -> int:
+	var counter := Counter.new()
+	var double := func(value: int) -> int: return value * 2
+	for i in count:
+		counter.add(double.call(i) * SCALE)
+	return counter.total + TABLE.a.size() + int(TABLE.b.y)
+)";
+	const String cache_path = TestUtils::get_temp_path("gdscript_bytecode_cache.gdbc");
+
+	Ref<GDScript> compiled = memnew(GDScript);
+	compiled->set_source_code(source);
+	ERR_PRINT_OFF;
+	Error error = compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+	REQUIRE(GDScriptBytecodeCache::save(compiled.ptr(), Vector<String>(), false, cache_path) == OK);
+
+	// A script whose source changed must not pick up the file.
+	Ref<GDScript> modified = memnew(GDScript);
+	modified->set_source_code(source + "\n# Changed.\n");
+	CHECK(GDScriptBytecodeCache::load(modified.ptr(), cache_path) != OK);
+
+	Ref<GDScript> cached = memnew(GDScript);
+	cached->set_source_code(source);
+	REQUIRE_MESSAGE(GDScriptBytecodeCache::load(cached.ptr(), cache_path) == OK, "The cached script should load without compiling it.");
+	CHECK(cached->is_valid());
+	CHECK(cached->get_subclasses().has("Counter"));
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(cached);
+	CHECK_MESSAGE(int(ref_counted->call("compute", 4)) == 40, "The cached script should run like the compiled one.");
+}
+
+TEST_CASE("[Modules][GDScript] Parse referenced scripts before the analysis") {
+	const String main_path = TestUtils::get_temp_path("gdscript_prefetch_main.gd");
+	const String preloaded_path = TestUtils::get_temp_path("gdscript_prefetch_preloaded.gd");
+	const String extended_path = TestUtils::get_temp_path("gdscript_prefetch_extended.gd");
+
+	Ref<FileAccess> file = FileAccess::open(preloaded_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string("extends \"gdscript_prefetch_extended.gd\"\n");
+	file = FileAccess::open(extended_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string("extends RefCounted\n");
+	file.unref();
+
+	GDScriptParser parser;
+	REQUIRE(parser.parse("const Preloaded = preload(\"gdscript_prefetch_preloaded.gd\")\n", main_path, false) == OK);
+	GDScriptCache::prefetch_parsers(&parser);
+
+	// Scripts referenced by prefetched scripts are parsed too.
+	CHECK(GDScriptCache::has_parser(preloaded_path));
+	CHECK(GDScriptCache::has_parser(extended_path));
+
+	Error error = OK;
+	Ref<GDScriptParserRef> parser_ref = GDScriptCache::get_parser(extended_path, GDScriptParserRef::EMPTY, error);
+	REQUIRE(parser_ref.is_valid());
+	CHECK(parser_ref->get_status() == GDScriptParserRef::PARSED);
+}
+
+TEST_CASE("[Modules][GDScript] Parse the dependencies of scripts loaded as resources") {
+	const auto write_script = [](const String &p_name, const String &p_source) {
+		const String path = TestUtils::get_temp_path(p_name);
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_string(p_source);
+		return path;
+	};
+	const String main_path = write_script("gdscript_prefetch_load_main.gd", R"(
+extends RefCounted
+
+const First = preload("gdscript_prefetch_load_first.gd")
+const Second = preload("gdscript_prefetch_load_second.gd")
+
+func total() -> int:
+	return First.new().value() + Second.new().value()
+)");
+	write_script("gdscript_prefetch_load_first.gd", R"(
+extends "gdscript_prefetch_load_base.gd"
+
+func value() -> int:
+	return base_value() + 1
+)");
+	write_script("gdscript_prefetch_load_second.gd", R"(
+extends RefCounted
+
+func value() -> int:
+	return 10
+)");
+	write_script("gdscript_prefetch_load_base.gd", R"(
+extends RefCounted
+
+func base_value() -> int:
+	return 100
+)");
+
+	// Loading a script as a resource is its first load, even though the cache reloads it keeping state.
+	const uint32_t prefetched_parser_count = TestGDScriptCacheInternalsAccessor::get_prefetched_parser_count();
+	Ref<GDScript> gdscript = ResourceLoader::load(main_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP);
+	REQUIRE(gdscript.is_valid());
+	CHECK(gdscript->is_valid());
+	CHECK_MESSAGE(TestGDScriptCacheInternalsAccessor::get_prefetched_parser_count() - prefetched_parser_count == 3,
+			"The two preloaded scripts and the one they extend should be parsed ahead of the analysis.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK(int(ref_counted->call("total")) == 111);
+
+	// Reloading it keeps what was already loaded.
+	const uint32_t reloaded_parser_count = TestGDScriptCacheInternalsAccessor::get_prefetched_parser_count();
+	ref_counted->set_script(Variant());
+	REQUIRE(gdscript->reload(true) == OK);
+	CHECK(TestGDScriptCacheInternalsAccessor::get_prefetched_parser_count() == reloaded_parser_count);
+}
+
+TEST_CASE("[Modules][GDScript] Sample running functions") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func spin(count: int) -> int:
+	var total := 0
+	for i in count:
+		total += i % 7
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSampler::clear();
+	GDScriptSampler::start(50);
+	const uint64_t start_time = OS::get_singleton()->get_ticks_msec();
+	while (GDScriptSampler::get_sample_count() == 0 && OS::get_singleton()->get_ticks_msec() - start_time < 5000) {
+		ref_counted->call("spin", 10000);
+	}
+	GDScriptSampler::stop();
+
+	REQUIRE_MESSAGE(GDScriptSampler::get_sample_count() > 0, "Samples should be taken while a script function runs.");
+	CHECK(GDScriptSampler::get_folded_stacks().begins_with("Main Thread;spin (<built-in>:"));
+	const String report = GDScriptSampler::get_line_report();
+	CHECK(report.contains("\tspin\t"));
+	GDScriptSampler::clear();
+}
+
+TEST_CASE("[Modules][GDScript] Map sampled instructions to lines without line instructions") {
+	const String source = R"(
+extends RefCounted
+
+func spin(count: int) -> int:
+	var total := 0
+	for i in count:
+		total += i % 7
+	return total
+)";
+
+	// Release bytecode, as export templates run it, has no OPCODE_LINE to tell where lines start.
+	const auto compile = [&source](bool p_release_bytecode) {
+		GDScriptParser parser;
+		REQUIRE(parser.parse(source, "gdscript_sampler_lines.gd", false) == OK);
+		GDScriptAnalyzer analyzer(&parser);
+		REQUIRE(analyzer.analyze() == OK);
+		Ref<GDScript> gdscript;
+		gdscript.instantiate();
+		GDScriptCompiler compiler;
+		compiler.set_release_bytecode(p_release_bytecode);
+		REQUIRE(compiler.compile(&parser, gdscript.ptr(), false) == OK);
+		return gdscript;
+	};
+	Ref<GDScript> release_script = compile(true);
+	Ref<GDScript> debug_script = compile(false);
+	GDScriptFunction *release_spin = release_script->get_member_functions()["spin"];
+	GDScriptFunction *debug_spin = debug_script->get_member_functions()["spin"];
+
+	const Vector<Pair<int, int>> &release_starts = TestGDScriptFunctionInternalsAccessor::get_line_starts(release_spin);
+	const Vector<Pair<int, int>> &debug_starts = TestGDScriptFunctionInternalsAccessor::get_line_starts(debug_spin);
+	CHECK(TestGDScriptFunctionInternalsAccessor::get_code(release_spin).size() < TestGDScriptFunctionInternalsAccessor::get_code(debug_spin).size());
+
+	// Every statement starts a line, in both flavors.
+	Vector<int> release_lines;
+	for (const Pair<int, int> &line_start : release_starts) {
+		release_lines.push_back(line_start.second);
+	}
+	Vector<int> debug_lines;
+	for (const Pair<int, int> &line_start : debug_starts) {
+		debug_lines.push_back(line_start.second);
+	}
+	CHECK(release_lines == Vector<int>({ 5, 6, 7, 8 }));
+	CHECK(release_lines == debug_lines);
+
+	// Each instruction maps to the line it was generated for, up to the next line start.
+	GDScriptSampler::clear();
+	for (int i = 0; i < release_starts.size(); i++) {
+		const int begin = release_starts[i].first;
+		const int end = i + 1 < release_starts.size() ? release_starts[i + 1].first : TestGDScriptFunctionInternalsAccessor::get_code(release_spin).size();
+		REQUIRE(begin < end);
+		CHECK(TestGDScriptSamplerInternalsAccessor::get_line(release_spin, begin) == release_starts[i].second);
+		CHECK(TestGDScriptSamplerInternalsAccessor::get_line(release_spin, end - 1) == release_starts[i].second);
+	}
+	GDScriptSampler::clear();
+}
+
+TEST_CASE("[Modules][GDScript] Emit native bodies matching runtime bytecode") {
+	const String path = "modules/gdscript/tests/scripts/runtime/features/typed_operators.gd";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(FileAccess::get_file_as_string(path));
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+
+	GDScriptFunction *const *steer = gdscript->get_member_functions().getptr(StringName("steer"));
+	REQUIRE(steer != nullptr);
+
+	// The editor runs debug bytecode, so emit the matching flavor.
+	GDScriptNativeEmitter emitter;
+	emitter.set_release_bytecode(false);
+	REQUIRE(emitter.add_script(path) == OK);
+	CHECK(emitter.get_body_count() > 0);
+
+	const String source = emitter.get_source();
+	CHECK(source.contains("gdscript_native_init"));
+	CHECK_MESSAGE(source.contains(vformat(R"("steer", 0x%sU)", String::num_uint64(GDScriptNative::hash_function(*steer), 16))),
+			"Emitting a private copy of the script should produce the same bytecode as loading it.");
+
+	// Export templates don't export engine symbols, the library may only use the C interface.
+	CHECK(source.contains(R"(#include "modules/gdscript/gdscript_native_body.h")"));
+	CHECK_FALSE(source.contains(R"(#include "core/)"));
+	CHECK_FALSE(source.contains("VariantInternal"));
+	CHECK_FALSE(source.contains("Variant *"));
+
+	const String build_script = GDScriptNativeEmitter::get_build_script("res://native/gdscript_native.cpp");
+	CHECK(build_script.contains(R"(env.SharedLibrary("gdscript_native", ["gdscript_native.cpp"]))"));
+}
 #endif // TOOLS_ENABLED
 
+// Stands in for a library built from emitted source, using nothing but gdscript_native_body.h.
+namespace NativeTestLibrary {
+static CharString script_name;
+static uint32_t code_hash = 0;
+static int end_address = 0;
+static int calls = 0;
+
+static int combine_body(const GDScriptNativeContext *c) {
+	calls++;
+	// Arguments follow the fixed addresses at the bottom of the stack.
+	GDExtensionConstVariantPtr a = GDSCRIPT_NATIVE_ADDRESS(c->addresses, GDScriptFunction::ADDR_TYPE_STACK, GDScriptFunction::FIXED_ADDRESSES_MAX);
+	GDExtensionConstVariantPtr b = GDSCRIPT_NATIVE_ADDRESS(c->addresses, GDScriptFunction::ADDR_TYPE_STACK, GDScriptFunction::FIXED_ADDRESSES_MAX + 1);
+	gdscript_native_assign_int(c->retvalue, GDSCRIPT_NATIVE_INT(a) * 1000 + GDSCRIPT_NATIVE_INT(b));
+	return end_address;
+}
+
+// Hands the whole call back to the interpreter, like bodies stopping at an instruction they don't cover.
+static int fallback_body(const GDScriptNativeContext *c) {
+	calls++;
+	return 0;
+}
+
+static GDScriptNativeBody body = nullptr;
+
+static GDExtensionBool init(GDExtensionInterfaceGetProcAddress p_get_proc_address, const GDScriptNativeInterface *p_interface, GDScriptNativeRegisterFunc p_register) {
+	if (!gdscript_native_load(p_get_proc_address, p_interface)) {
+		return 0;
+	}
+	p_register(script_name.get_data(), "combine", code_hash, body);
+	return 1;
+}
+} // namespace NativeTestLibrary
+
+TEST_CASE("[Modules][GDScript] Run native bodies registered through the C interface") {
+	const String source = R"(
+extends RefCounted
+
+func combine(a: int, b: int) -> int:
+	return a * 1000 + b
+)";
+
+	// Bodies attach when functions are compiled, so each library gets a freshly compiled script.
+	const auto instantiate = [&source]() {
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The script should compile successfully.");
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		return ref_counted;
+	};
+
+	Ref<RefCounted> interpreted = instantiate();
+	Ref<GDScript> interpreted_script = interpreted->get_script();
+	GDScriptFunction *const *combine = interpreted_script->get_member_functions().getptr(StringName("combine"));
+	REQUIRE(combine != nullptr);
+	NativeTestLibrary::script_name = interpreted_script->get_fully_qualified_name().utf8();
+	NativeTestLibrary::code_hash = GDScriptNative::hash_function(*combine);
+	NativeTestLibrary::end_address = TestGDScriptFunctionInternalsAccessor::get_end_address(*combine);
+	const Variant expected = interpreted->call("combine", 7, 42);
+	CHECK(expected == Variant(7042));
+
+	SUBCASE("Bodies running to completion store the return value") {
+		NativeTestLibrary::body = &NativeTestLibrary::combine_body;
+		NativeTestLibrary::calls = 0;
+		REQUIRE(GDScriptNative::initialize(&NativeTestLibrary::init) == OK);
+		CHECK(GDScriptNative::has_bodies());
+
+		Ref<RefCounted> native = instantiate();
+		CHECK(native->call("combine", 7, 42) == expected);
+		CHECK(native->call("combine", -3, 5) == interpreted->call("combine", -3, 5));
+		CHECK_MESSAGE(NativeTestLibrary::calls == 2, "Calls should run the native body.");
+	}
+
+	SUBCASE("Bodies can hand the call back to the interpreter") {
+		NativeTestLibrary::body = &NativeTestLibrary::fallback_body;
+		NativeTestLibrary::calls = 0;
+		REQUIRE(GDScriptNative::initialize(&NativeTestLibrary::init) == OK);
+
+		Ref<RefCounted> native = instantiate();
+		CHECK(native->call("combine", 7, 42) == expected);
+		CHECK(NativeTestLibrary::calls == 1);
+	}
+
+	GDScriptNative::unload_library();
+	CHECK_FALSE(GDScriptNative::has_bodies());
+}
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,65 @@
+# Exercises the bytecode that gets fused into superinstructions,
+# making sure it behaves the same as the separate instructions.
+extends Node
+
+func compare_and_jump(a: int, b: int) -> String:
+	if a < b:
+		return "less"
+	elif a == b:
+		return "equal"
+	return "greater"
+
+func compare_in_logic(a: int, b: int) -> bool:
+	return a > 0 and b > 0 or a < -10
+
+func test():
+	print(compare_and_jump(1, 2))
+	print(compare_and_jump(2, 2))
+	print(compare_and_jump(3, 2))
+
+	print(compare_in_logic(1, 1))
+	print(compare_in_logic(1, -1))
+	print(compare_in_logic(-20, -1))
+
+	var i := 0
+	var skipped := 0
+	while i < 10:
+		i += 1
+		if i % 2 == 0:
+			skipped += 1
+			continue
+	print(i)
+	print(skipped)
+
+	var value := 3.5
+	print("big" if value > 3.0 else "small")
+
+	# The comparison result is still stored, even when fused with the jump.
+	var is_less := i < 20
+	if is_less:
+		print(is_less)
+
+	# Operations on typed locals write to them directly.
+	var n := 7
+	n += 3
+	n *= 2
+	n -= 5
+	n %= 4
+	print(n)
+	var f := 1.5
+	f *= 4
+	f += 0.5
+	print(f)
+	var v := Vector2(1, 2)
+	v += Vector2(2, 3)
+	v *= 2
+	print(v)
+	var vi := Vector3i(1, 2, 3)
+	vi -= Vector3i(1, 1, 1)
+	print(vi)
+
+	# Native members updated in place.
+	process_priority = 4
+	process_priority += 6
+	process_priority *= 3
+	print(process_priority)
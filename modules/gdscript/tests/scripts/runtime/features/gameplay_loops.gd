@@ -0,0 +1,55 @@
+# Typical gameplay loops, dominated by comparisons, jumps and compound
+# assignments. Useful as a workload when measuring the VM dispatch.
+extends Node
+
+const STEPS = 1000
+
+func integrate_particles() -> Vector2:
+	var position := Vector2()
+	var velocity := Vector2(1, 0)
+	var gravity := Vector2(0, -0.5)
+	var bounces := 0
+	for _step in STEPS:
+		velocity += gravity
+		position += velocity
+		if position.y < 0.0:
+			position.y = 0.0
+			velocity.y = -velocity.y * 0.5
+			bounces += 1
+	return Vector2(bounces, position.x)
+
+func count_in_range(values: Array[int], low: int, high: int) -> int:
+	var count := 0
+	var i := 0
+	while i < values.size():
+		if values[i] >= low and values[i] < high:
+			count += 1
+		i += 1
+	return count
+
+func cooldowns() -> int:
+	var timer_msec := 0
+	var shots := 0
+	for _step in STEPS:
+		timer_msec += 16
+		if timer_msec >= 250:
+			timer_msec -= 250
+			shots += 1
+	return shots
+
+func test():
+	var particle := integrate_particles()
+	print(int(particle.x))
+	print(int(particle.y))
+
+	var values: Array[int] = []
+	for i in STEPS:
+		values.append(i % 37)
+	print(count_in_range(values, 10, 20))
+
+	print(cooldowns())
+
+	process_priority = 0
+	for _i in STEPS:
+		process_priority += 1
+	print(process_priority)
@@ -0,0 +1,51 @@
+# Operators on typed values use opcodes working on the unboxed values.
+
+func steer(position: Vector2, target: Vector2, speed: float) -> Vector2:
+	var desired := target - position
+	return position + desired * speed
+
+func damage(base: int, armor: int, multiplier: float) -> float:
+	var reduced := base - armor
+	if reduced < 0:
+		reduced = 0
+	return float(reduced) * multiplier
+
+func test():
+	var a := 7
+	var b := 3
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	print(a < b)
+	print(a <= b)
+	print(a > b)
+	print(a >= b)
+	print(a == b)
+	print(a != b)
+
+	var x := 1.5
+	var y := 0.5
+	print(x + y)
+	print(x - y)
+	print(x * y)
+	print(x / y)
+	print(x < y)
+	print(x <= y)
+	print(x > y)
+	print(x >= y)
+
+	var v := Vector3(1, 2, 3)
+	var w := Vector3(3, 2, 1)
+	print(v + w)
+	print(v - w)
+	print(v * 2.0)
+
+	print(steer(Vector2(0, 0), Vector2(10, 20), 0.5))
+	print(damage(10, 4, 1.5))
+	print(damage(2, 4, 1.5))
+
+	var total := 0
+	for i in 10:
+		var step: int = i
+		total = total + step * step
+	print(total)
@@ -0,0 +1,87 @@
+# Untyped call sites see several receiver classes, so their inline caches have to
+# tell them apart and fall back correctly when a new class shows up.
+
+class Walker:
+	var speed = 1
+	var label: String = "walker"
+
+	func describe():
+		return "walker %d" % speed
+
+	func get_label():
+		return label
+
+
+class Runner extends Walker:
+	var stamina: int = 10
+
+	func describe():
+		return "runner %d" % speed
+
+
+class Swimmer:
+	var speed = 3
+
+	func describe():
+		return "swimmer %d" % speed
+
+
+class Guarded:
+	var value = 0:
+		set(v):
+			value = v * 2
+		get:
+			return value + 1
+
+
+func describe_all(things):
+	var out = []
+	for thing in things:
+		out.append(thing.describe())
+	return out
+
+
+func total_speed(things):
+	var total = 0
+	for thing in things:
+		total += thing.speed
+	return total
+
+
+func boost(things):
+	for thing in things:
+		thing.speed = thing.speed + 1
+
+
+func test():
+	var things = [Walker.new(), Runner.new(), Swimmer.new(), Walker.new(), Runner.new()]
+
+	# Polymorphic call site, more classes than cache entries.
+	print(describe_all(things))
+	print(describe_all(things))
+
+	# Member get and set through the same sites.
+	print(total_speed(things))
+	boost(things)
+	print(total_speed(things))
+
+	# Inherited method and member on a subclass.
+	var runner = things[1]
+	print(runner.get_label())
+	runner.label = "fast"
+	print(runner.get_label())
+
+	# Typed member conversion still applies.
+	runner.stamina = 2.5
+	print(runner.stamina)
+
+	# Setters and getters are never bypassed.
+	var guarded = Guarded.new()
+	for i in 3:
+		guarded.value = i
+		print(guarded.value)
+
+	# Native methods and script methods on the same site.
+	var mixed = [RefCounted.new(), Walker.new()]
+	for obj in mixed:
+		print(obj.get_reference_count() > 0)
@@ -58,6 +58,7 @@ void GodotBodyPair2D::_contact_added_callback(const Vector2 &p_point_A, const Ve
 	contact.local_A = local_A;
 	contact.local_B = local_B;
 	contact.normal = (p_point_A - p_point_B).normalized();
+	contact.local_normal = A->get_inv_transform().basis_xform(contact.normal).normalized();
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
@@ -139,6 +140,10 @@ void GodotBodyPair2D::_validate_contacts() {
 		} else {
 			c.used = false;
 
+			// Bodies can rotate together without moving relative to each other, which keeps the
+			// manifold cached. Rotate the normal with A so it doesn't point the old way.
+			c.normal = transform_A.basis_xform(c.local_normal).normalized();
+
 			Vector2 global_A = transform_A.basis_xform(c.local_A);
 			Vector2 global_B = transform_B.basis_xform(c.local_B) + offset_B;
 			Vector2 axis = global_A - global_B;
@@ -163,6 +168,37 @@ void GodotBodyPair2D::_validate_contacts() {
 	}
 }
 
+bool GodotBodyPair2D::_can_reuse_manifold(const Transform2D &p_relative_transform) const {
+	real_t threshold = space->get_contact_cache_threshold();
+	if (threshold <= 0.0 || report_contacts_only || contact_count == 0 || contact_count != cached_contact_count) {
+		return false;
+	}
+
+	if (A->get_shapes_version() != cached_shapes_version_A || B->get_shapes_version() != cached_shapes_version_B) {
+		return false;
+	}
+
+	// Continuous collision detection depends on the motion of the bodies, not only on their transforms.
+	if (A->get_continuous_collision_detection_mode() != PhysicsServer2D::CCD_MODE_DISABLED || B->get_continuous_collision_detection_mode() != PhysicsServer2D::CCD_MODE_DISABLED) {
+		return false;
+	}
+
+	// Contacts are stored relative to each body, so they stay valid as long as B has barely moved
+	// relative to A since the last narrowphase. Check the contact points and the origin of B.
+	real_t threshold_squared = threshold * threshold;
+	if (p_relative_transform.get_origin().distance_squared_to(cached_relative_transform.get_origin()) > threshold_squared) {
+		return false;
+	}
+	for (int i = 0; i < contact_count; i++) {
+		const Vector2 &local_B = contacts[i].local_B;
+		if (p_relative_transform.xform(local_B).distance_squared_to(cached_relative_transform.xform(local_B)) > threshold_squared) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // `_test_ccd` prevents tunneling by slowing down a high velocity body that is about to collide so
 // that next frame it will be at an appropriate location to collide (i.e. slight overlap).
 // WARNING: The way velocity is adjusted down to cause a collision means the momentum will be
@@ -252,6 +288,9 @@ real_t combine_friction(GodotBody2D *A, GodotBody2D *B) {
 bool GodotBodyPair2D::setup(real_t p_step) {
 	check_ccd = false;
 
+	bool was_cached = manifold_cached;
+	manifold_cached = false;
+
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
 		return false;
@@ -275,6 +314,16 @@ bool GodotBodyPair2D::setup(real_t p_step) {
 
 	_validate_contacts();
 
+	Transform2D relative_transform = A->get_inv_transform() * B->get_transform();
+	if (was_cached && collided && !oneway_disabled && _can_reuse_manifold(relative_transform)) {
+		// Skip the narrowphase, the contacts and their accumulated impulses are kept as they are for warm starting.
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].used = true;
+		}
+		manifold_cached = true;
+		return true;
+	}
+
 	const Vector2 &offset_A = A->get_transform().get_origin();
 	Transform2D xform_Au = A->get_transform().untranslated();
 	Transform2D xform_A = xform_Au * A->get_shape_transform(shape_A);
@@ -356,6 +405,12 @@ bool GodotBodyPair2D::setup(real_t p_step) {
 		}
 	}
 
+	cached_relative_transform = relative_transform;
+	cached_shapes_version_A = A->get_shapes_version();
+	cached_shapes_version_B = B->get_shapes_version();
+	cached_contact_count = contact_count;
+	manifold_cached = true;
+
 	return true;
 }
 
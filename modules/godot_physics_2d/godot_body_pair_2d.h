@@ -37,6 +37,8 @@
 #include "godot_constraint_2d.h"
 
 class GodotBodyPair2D : public GodotConstraint2D {
+	friend class TestGodotBodyPair2DInternalsAccessor;
+
 	enum {
 		MAX_CONTACTS = 2
 	};
@@ -61,6 +63,7 @@ class GodotBodyPair2D : public GodotConstraint2D {
 		Vector2 position;
 		Vector2 normal;
 		Vector2 local_A, local_B;
+		Vector2 local_normal; // Normal in the local orientation of A, so it follows A while the contact is kept.
 		Vector2 acc_impulse; // accumulated impulse
 		real_t acc_normal_impulse = 0.0; // accumulated normal impulse (Pn)
 		real_t acc_tangent_impulse = 0.0; // accumulated tangent impulse (Pt)
@@ -86,6 +89,14 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	bool oneway_disabled = false;
 	bool report_contacts_only = false;
 
+	// State of the last narrowphase, used to reuse its contacts while the bodies don't move relative to each other.
+	Transform2D cached_relative_transform;
+	uint64_t cached_shapes_version_A = 0;
+	uint64_t cached_shapes_version_B = 0;
+	int cached_contact_count = 0;
+	bool manifold_cached = false;
+
+	bool _can_reuse_manifold(const Transform2D &p_relative_transform) const;
 	bool _test_ccd(real_t p_step, GodotBody2D *p_A, int p_shape_A, const Transform2D &p_xform_A, GodotBody2D *p_B, int p_shape_B, const Transform2D &p_xform_B);
 	void _validate_contacts();
 	static void _add_contact(const Vector2 &p_point_A, const Vector2 &p_point_B, void *p_self);
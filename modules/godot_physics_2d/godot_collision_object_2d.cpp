@@ -45,6 +45,7 @@ void GodotCollisionObject2D::add_shape(GodotShape2D *p_shape, const Transform2D
 	s.one_way_collision_margin = 0;
 	shapes.push_back(s);
 	p_shape->add_owner(this);
+	shapes_version++;
 
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer2D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
@@ -57,6 +58,7 @@ void GodotCollisionObject2D::set_shape(int p_index, GodotShape2D *p_shape) {
 	shapes.write[p_index].shape = p_shape;
 
 	p_shape->add_owner(this);
+	shapes_version++;
 
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer2D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
@@ -68,6 +70,7 @@ void GodotCollisionObject2D::set_shape_transform(int p_index, const Transform2D
 
 	shapes.write[p_index].xform = p_transform;
 	shapes.write[p_index].xform_inv = p_transform.affine_inverse();
+	shapes_version++;
 
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer2D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
@@ -83,6 +86,7 @@ void GodotCollisionObject2D::set_shape_disabled(int p_idx, bool p_disabled) {
 	}
 
 	shape.disabled = p_disabled;
+	shapes_version++;
 
 	if (!space) {
 		return;
@@ -124,6 +128,7 @@ void GodotCollisionObject2D::remove_shape(int p_index) {
 	}
 	shapes[p_index].shape->remove_owner(this);
 	shapes.remove_at(p_index);
+	shapes_version++;
 
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer2D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
@@ -236,6 +241,7 @@ void GodotCollisionObject2D::_set_space(GodotSpace2D *p_space) {
 }
 
 void GodotCollisionObject2D::_shape_changed() {
+	shapes_version++;
 	_update_shapes();
 	_shapes_changed();
 }
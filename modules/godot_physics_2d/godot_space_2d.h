@@ -99,8 +99,10 @@ private:
 	GodotArea2D *area = nullptr;
 
 	int solver_iterations = 0;
+	int parallel_island_min_constraints = 0;
 
 	real_t contact_recycle_radius = 0.0;
+	real_t contact_cache_threshold = 0.0;
 	real_t contact_max_separation = 0.0;
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
@@ -161,7 +163,9 @@ public:
 	const HashSet<GodotCollisionObject2D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ int get_parallel_island_min_constraints() const { return parallel_island_min_constraints; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
+	_FORCE_INLINE_ real_t get_contact_cache_threshold() const { return contact_cache_threshold; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
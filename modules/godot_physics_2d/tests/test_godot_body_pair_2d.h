@@ -0,0 +1,191 @@
+/**************************************************************************/
+/*  test_godot_body_pair_2d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_BODY_PAIR_2D_H
+#define TEST_GODOT_BODY_PAIR_2D_H
+
+#include "../godot_body_2d.h"
+#include "../godot_body_pair_2d.h"
+#include "../godot_shape_2d.h"
+#include "../godot_space_2d.h"
+
+#include "tests/test_macros.h"
+
+class TestGodotBodyPair2DInternalsAccessor {
+public:
+	static bool is_manifold_cached(const GodotBodyPair2D &p_pair) {
+		return p_pair.manifold_cached;
+	}
+
+	// Only updated when the narrowphase runs.
+	static const Transform2D &get_cached_relative_transform(const GodotBodyPair2D &p_pair) {
+		return p_pair.cached_relative_transform;
+	}
+
+	static int get_contact_count(const GodotBodyPair2D &p_pair) {
+		return p_pair.contact_count;
+	}
+
+	static Vector2 get_contact_normal(const GodotBodyPair2D &p_pair, int p_index) {
+		return p_pair.contacts[p_index].normal;
+	}
+};
+
+namespace TestGodotBodyPair2D {
+
+TEST_CASE("[SceneTree][Modules][GodotPhysics2D] Contacts are reused while bodies stay at rest") {
+	const real_t step = 1.0 / 60.0;
+
+	GodotSpace2D *space = memnew(GodotSpace2D);
+	GodotRectangleShape2D *ground_shape = memnew(GodotRectangleShape2D);
+	ground_shape->set_data(Vector2(100, 10));
+	GodotRectangleShape2D *box_shape = memnew(GodotRectangleShape2D);
+	box_shape->set_data(Vector2(10, 10));
+
+	GodotBody2D *ground = memnew(GodotBody2D);
+	ground->set_space(space);
+	ground->set_mode(PhysicsServer2D::BODY_MODE_STATIC);
+	ground->add_shape(ground_shape);
+
+	// Resting on the ground with a slight overlap.
+	GodotBody2D *box = memnew(GodotBody2D);
+	box->set_space(space);
+	box->add_shape(box_shape);
+	box->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, -19.9)));
+
+	GodotBodyPair2D *pair = memnew(GodotBodyPair2D(box, 0, ground, 0));
+	REQUIRE(pair->setup(step));
+	REQUIRE(TestGodotBodyPair2DInternalsAccessor::is_manifold_cached(*pair));
+	const Transform2D first_relative_transform = TestGodotBodyPair2DInternalsAccessor::get_cached_relative_transform(*pair);
+
+	SUBCASE("Reused when moving less than the threshold") {
+		box->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0.01, -19.9)));
+		CHECK(pair->setup(step));
+		CHECK(TestGodotBodyPair2DInternalsAccessor::is_manifold_cached(*pair));
+		CHECK_MESSAGE(TestGodotBodyPair2DInternalsAccessor::get_cached_relative_transform(*pair) == first_relative_transform, "The narrowphase should be skipped.");
+	}
+
+	SUBCASE("Invalidated when moving more than the threshold") {
+		box->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(1, -19.5)));
+		CHECK(pair->setup(step));
+		CHECK(TestGodotBodyPair2DInternalsAccessor::get_cached_relative_transform(*pair) == box->get_inv_transform() * ground->get_transform());
+	}
+
+	SUBCASE("Invalidated when shapes change") {
+		box->set_shape_transform(0, Transform2D(0, Vector2(0, 0.05)));
+		box->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0.01, -19.9)));
+		CHECK(pair->setup(step));
+		CHECK(TestGodotBodyPair2DInternalsAccessor::get_cached_relative_transform(*pair) == box->get_inv_transform() * ground->get_transform());
+	}
+
+	SUBCASE("Not reused with continuous collision detection") {
+		for (PhysicsServer2D::CCDMode ccd_mode : { PhysicsServer2D::CCD_MODE_CAST_RAY, PhysicsServer2D::CCD_MODE_CAST_SHAPE }) {
+			box->set_continuous_collision_detection_mode(ccd_mode);
+			box->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, box->get_transform().translated(Vector2(0.01, 0)));
+			CHECK(pair->setup(step));
+			CHECK(TestGodotBodyPair2DInternalsAccessor::get_cached_relative_transform(*pair) == box->get_inv_transform() * ground->get_transform());
+		}
+	}
+
+	memdelete(pair);
+	box->remove_shape(0);
+	ground->remove_shape(0);
+	box->set_space(nullptr);
+	ground->set_space(nullptr);
+	memdelete(box);
+	memdelete(ground);
+	memdelete(box_shape);
+	memdelete(ground_shape);
+	memdelete(space);
+}
+
+TEST_CASE("[SceneTree][Modules][GodotPhysics2D] Reused contacts follow bodies rotating together") {
+	const real_t step = 1.0 / 60.0;
+
+	GodotSpace2D *space = memnew(GodotSpace2D);
+	GodotRectangleShape2D *platform_shape = memnew(GodotRectangleShape2D);
+	platform_shape->set_data(Vector2(100, 10));
+	GodotRectangleShape2D *box_shape = memnew(GodotRectangleShape2D);
+	box_shape->set_data(Vector2(10, 10));
+
+	GodotBody2D *platform = memnew(GodotBody2D);
+	platform->set_space(space);
+	platform->set_mode(PhysicsServer2D::BODY_MODE_KINEMATIC);
+	platform->add_shape(platform_shape);
+	platform->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D());
+
+	// Resting on the platform with a slight overlap.
+	const Vector2 box_origin(20, -19.9);
+	GodotBody2D *box = memnew(GodotBody2D);
+	box->set_space(space);
+	box->add_shape(box_shape);
+	box->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, box_origin));
+
+	GodotBodyPair2D *pair = memnew(GodotBodyPair2D(box, 0, platform, 0));
+	REQUIRE(pair->setup(step));
+	const Transform2D first_relative_transform = TestGodotBodyPair2DInternalsAccessor::get_cached_relative_transform(*pair);
+	const int contact_count = TestGodotBodyPair2DInternalsAccessor::get_contact_count(*pair);
+	REQUIRE(contact_count > 0);
+	Vector2 first_normals[2];
+	for (int i = 0; i < contact_count; i++) {
+		first_normals[i] = TestGodotBodyPair2DInternalsAccessor::get_contact_normal(*pair, i);
+	}
+
+	// Tilt the platform and carry the box along, so they don't move relative to each other.
+	const real_t rotation = 0.5;
+	platform->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(rotation, Vector2()));
+	platform->integrate_velocities(step); // Moves the kinematic body, like a step does.
+	box->set_state(PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(rotation, box_origin.rotated(rotation)));
+
+	CHECK(pair->setup(step));
+	CHECK_MESSAGE(TestGodotBodyPair2DInternalsAccessor::get_cached_relative_transform(*pair) == first_relative_transform, "The narrowphase should be skipped.");
+	REQUIRE(TestGodotBodyPair2DInternalsAccessor::get_contact_count(*pair) == contact_count);
+	for (int i = 0; i < contact_count; i++) {
+		CHECK_MESSAGE(TestGodotBodyPair2DInternalsAccessor::get_contact_normal(*pair, i).is_equal_approx(first_normals[i].rotated(rotation)), "The contact normals should rotate with the bodies.");
+	}
+	CHECK(pair->pre_solve(step));
+
+	memdelete(pair);
+	box->remove_shape(0);
+	platform->remove_shape(0);
+	box->set_space(nullptr);
+	platform->set_space(nullptr);
+	memdelete(box);
+	memdelete(platform);
+	memdelete(box_shape);
+	memdelete(platform_shape);
+	memdelete(space);
+}
+
+} // namespace TestGodotBodyPair2D
+
+#endif // TEST_GODOT_BODY_PAIR_2D_H
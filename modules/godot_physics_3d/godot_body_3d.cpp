@@ -43,6 +43,8 @@ void GodotBody3D::_mass_properties_changed() {
 }
 
 void GodotBody3D::_update_transform_dependent() {
+	integrator_transform_valid = false;
+
 	center_of_mass = get_transform().basis.xform(center_of_mass_local);
 	principal_inertia_axes = get_transform().basis * principal_inertia_axes_local;
 
@@ -300,6 +302,7 @@ Variant GodotBody3D::get_param(PhysicsServer3D::BodyParameter p_param) const {
 void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 	PhysicsServer3D::BodyMode prev = mode;
 	mode = p_mode;
+	integrator_transform_valid = false;
 
 	switch (p_mode) {
 		case PhysicsServer3D::BODY_MODE_STATIC:
@@ -453,6 +456,7 @@ void GodotBody3D::set_space(GodotSpace3D *p_space) {
 	}
 
 	_set_space(p_space);
+	integrator_transform_valid = false;
 
 	if (get_space()) {
 		_mass_properties_changed();
@@ -475,12 +479,14 @@ bool GodotBody3D::is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const {
 	return locked_axis & p_axis;
 }
 
-void GodotBody3D::integrate_forces(real_t p_step) {
+bool GodotBody3D::pre_integrate_forces(real_t p_step, bool &r_integrate) {
+	r_integrate = false;
+
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
-		return;
+		return false;
 	}
 
-	ERR_FAIL_NULL(get_space());
+	ERR_FAIL_NULL_V(get_space(), false);
 
 	int ac = areas.size();
 
@@ -568,7 +574,7 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	// Add default gravity and damping from space area.
 	if (!stopped) {
 		GodotArea3D *default_area = get_space()->get_default_area();
-		ERR_FAIL_NULL(default_area);
+		ERR_FAIL_NULL_V(default_area, false);
 
 		if (!gravity_done) {
 			Vector3 default_gravity;
@@ -610,13 +616,9 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	prev_linear_velocity = linear_velocity;
 	prev_angular_velocity = angular_velocity;
 
-	Vector3 motion;
-	bool do_motion = false;
-
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
 		//compute motion, angular and etc. velocities from prev transform
-		motion = new_transform.origin - get_transform().origin;
-		do_motion = true;
+		Vector3 motion = new_transform.origin - get_transform().origin;
 		linear_velocity = constant_linear_velocity + motion / p_step;
 
 		//compute a FAKE angular velocity, not so easy
@@ -627,36 +629,24 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 		rot.get_axis_angle(axis, angle);
 		axis.normalize();
 		angular_velocity = constant_angular_velocity + axis * (angle / p_step);
-	} else {
-		if (!omit_force_integration) {
-			//overridden by direct state query
-
-			Vector3 force = gravity * mass + applied_force + constant_force;
-			Vector3 torque = applied_torque + constant_torque;
-
-			real_t damp = 1.0 - p_step * total_linear_damp;
-
-			if (damp < 0) { // reached zero in the given time
-				damp = 0;
-			}
-
-			real_t angular_damp_new = 1.0 - p_step * total_angular_damp;
-
-			if (angular_damp_new < 0) { // reached zero in the given time
-				angular_damp_new = 0;
-			}
+		return true;
+	}
 
-			linear_velocity *= damp;
-			angular_velocity *= angular_damp_new;
+	// Damping and forces are applied by the integrator, unless overridden by direct state query.
+	r_integrate = !omit_force_integration;
+	return true;
+}
 
-			linear_velocity += _inv_mass * force * p_step;
-			angular_velocity += _inv_inertia_tensor.xform(torque) * p_step;
-		}
+void GodotBody3D::post_integrate_forces(real_t p_step) {
+	Vector3 motion;
+	bool do_motion = false;
 
-		if (continuous_cd) {
-			motion = linear_velocity * p_step;
-			do_motion = true;
-		}
+	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
+		motion = new_transform.origin - get_transform().origin;
+		do_motion = true;
+	} else if (continuous_cd) {
+		motion = linear_velocity * p_step;
+		do_motion = true;
 	}
 
 	applied_force = Vector3();
@@ -672,12 +662,12 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	contact_count = 0;
 }
 
-void GodotBody3D::integrate_velocities(real_t p_step) {
+bool GodotBody3D::pre_integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
-		return;
+		return false;
 	}
 
-	ERR_FAIL_NULL(get_space());
+	ERR_FAIL_NULL_V(get_space(), false);
 
 	if (fi_callback_data || body_state_callback.is_valid()) {
 		get_space()->body_add_to_state_query_list(&direct_state_query_list);
@@ -706,33 +696,15 @@ void GodotBody3D::integrate_velocities(real_t p_step) {
 			set_active(false); //stopped moving, deactivate
 		}
 
-		return;
-	}
-
-	Vector3 total_angular_velocity = angular_velocity + biased_angular_velocity;
-
-	real_t ang_vel = total_angular_velocity.length();
-	Transform3D transform_new = get_transform();
-
-	if (!Math::is_zero_approx(ang_vel)) {
-		Vector3 ang_vel_axis = total_angular_velocity / ang_vel;
-		Basis rot(ang_vel_axis, ang_vel * p_step);
-		Basis identity3(1, 0, 0, 0, 1, 0, 0, 0, 1);
-		transform_new.origin += ((identity3 - rot) * transform_new.basis).xform(center_of_mass_local);
-		transform_new.basis = rot * transform_new.basis;
-		transform_new.orthonormalize();
+		return false;
 	}
 
-	Vector3 total_linear_velocity = linear_velocity + biased_linear_velocity;
-	/*for(int i=0;i<3;i++) {
-		if (axis_lock&(1<<i)) {
-			transform_new.origin[i]=0.0;
-		}
-	}*/
-
-	transform_new.origin += total_linear_velocity * p_step;
+	// The new transform is computed by the integrator from the total (regular and biased) velocities.
+	return true;
+}
 
-	_set_transform(transform_new);
+void GodotBody3D::post_integrate_velocities(const Transform3D &p_transform) {
+	_set_transform(p_transform);
 	_set_inv_transform(get_transform().inverse());
 
 	_update_transform_dependent();
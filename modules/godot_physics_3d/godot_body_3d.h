@@ -148,9 +148,13 @@ class GodotBody3D : public GodotCollisionObject3D {
 
 	uint64_t island_step = 0;
 
+	// Whether the transform kept by GodotBodyIntegrator3D since the last step still matches this body.
+	bool integrator_transform_valid = false;
+
 	void _update_transform_dependent();
 
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
+	friend class GodotBodyIntegrator3D; // Reads and writes the hot state in batches.
 
 public:
 	void set_state_sync_callback(const Callable &p_callable);
@@ -318,8 +322,13 @@ public:
 	void set_axis_lock(PhysicsServer3D::BodyAxis p_axis, bool lock);
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
-	void integrate_forces(real_t p_step);
-	void integrate_velocities(real_t p_step);
+	// Integration is split around the batch kernels of GodotBodyIntegrator3D.
+	// pre_integrate_forces() returns false when the body is skipped, the post function must only be called otherwise.
+	// r_integrate and the return value of pre_integrate_velocities() tell whether the kernels must integrate the body.
+	bool pre_integrate_forces(real_t p_step, bool &r_integrate);
+	void post_integrate_forces(real_t p_step);
+	bool pre_integrate_velocities(real_t p_step);
+	void post_integrate_velocities(const Transform3D &p_transform);
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
 		return linear_velocity + angular_velocity.cross(rel_pos - center_of_mass);
@@ -0,0 +1,325 @@
+/**************************************************************************/
+/*  godot_body_integrator_3d.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_body_integrator_3d.h"
+
+#include "core/object/worker_thread_pool.h"
+
+void GodotBodyIntegrator3D::_resize_forces(uint32_t p_count) {
+	for (int i = 0; i < 3; i++) {
+		linear_velocity[i].resize(p_count);
+		angular_velocity[i].resize(p_count);
+		force[i].resize(p_count);
+		torque[i].resize(p_count);
+	}
+	for (int i = 0; i < 9; i++) {
+		inv_inertia_tensor[i].resize(p_count);
+	}
+	inv_mass.resize(p_count);
+	linear_damp.resize(p_count);
+	angular_damp.resize(p_count);
+}
+
+void GodotBodyIntegrator3D::_resize_velocities(uint32_t p_count) {
+	for (int i = 0; i < 3; i++) {
+		linear_velocity[i].resize(p_count);
+		angular_velocity[i].resize(p_count);
+		origin[i].resize(p_count);
+		center_of_mass_local[i].resize(p_count);
+	}
+	for (int i = 0; i < 9; i++) {
+		basis[i].resize(p_count);
+	}
+	rotated.resize(p_count);
+}
+
+void GodotBodyIntegrator3D::_integrate_forces_batch(uint32_t p_batch_index, void *p_userdata) {
+	const uint32_t begin = p_batch_index * BATCH_SIZE;
+	const uint32_t end = MIN(begin + BATCH_SIZE, force_bodies.size());
+
+	real_t *lvx = linear_velocity[0].ptr();
+	real_t *lvy = linear_velocity[1].ptr();
+	real_t *lvz = linear_velocity[2].ptr();
+	real_t *avx = angular_velocity[0].ptr();
+	real_t *avy = angular_velocity[1].ptr();
+	real_t *avz = angular_velocity[2].ptr();
+	const real_t *fx = force[0].ptr();
+	const real_t *fy = force[1].ptr();
+	const real_t *fz = force[2].ptr();
+	const real_t *tx = torque[0].ptr();
+	const real_t *ty = torque[1].ptr();
+	const real_t *tz = torque[2].ptr();
+	const real_t *im = inv_mass.ptr();
+	const real_t *ld = linear_damp.ptr();
+	const real_t *ad = angular_damp.ptr();
+	const real_t *it[9];
+	for (int i = 0; i < 9; i++) {
+		it[i] = inv_inertia_tensor[i].ptr();
+	}
+
+	const real_t s = step;
+	for (uint32_t i = begin; i < end; i++) {
+		// Reached zero in the given time when negative.
+		const real_t damp = MAX(real_t(1.0) - s * ld[i], real_t(0.0));
+		const real_t angular_damp_new = MAX(real_t(1.0) - s * ad[i], real_t(0.0));
+
+		// Same order of operations as the scalar code, so the results don't depend on the batching.
+		lvx[i] = lvx[i] * damp + im[i] * fx[i] * s;
+		lvy[i] = lvy[i] * damp + im[i] * fy[i] * s;
+		lvz[i] = lvz[i] * damp + im[i] * fz[i] * s;
+
+		const real_t ax = it[0][i] * tx[i] + it[1][i] * ty[i] + it[2][i] * tz[i];
+		const real_t ay = it[3][i] * tx[i] + it[4][i] * ty[i] + it[5][i] * tz[i];
+		const real_t az = it[6][i] * tx[i] + it[7][i] * ty[i] + it[8][i] * tz[i];
+		avx[i] = avx[i] * angular_damp_new + ax * s;
+		avy[i] = avy[i] * angular_damp_new + ay * s;
+		avz[i] = avz[i] * angular_damp_new + az * s;
+	}
+}
+
+void GodotBodyIntegrator3D::_integrate_velocities_batch(uint32_t p_batch_index, void *p_userdata) {
+	const uint32_t begin = p_batch_index * BATCH_SIZE;
+	const uint32_t end = MIN(begin + BATCH_SIZE, velocity_bodies.size());
+
+	real_t *b[9];
+	for (int i = 0; i < 9; i++) {
+		b[i] = basis[i].ptr();
+	}
+	real_t *ox = origin[0].ptr();
+	real_t *oy = origin[1].ptr();
+	real_t *oz = origin[2].ptr();
+	const real_t *lvx = linear_velocity[0].ptr();
+	const real_t *lvy = linear_velocity[1].ptr();
+	const real_t *lvz = linear_velocity[2].ptr();
+	const real_t *avx = angular_velocity[0].ptr();
+	const real_t *avy = angular_velocity[1].ptr();
+	const real_t *avz = angular_velocity[2].ptr();
+	const real_t *cx = center_of_mass_local[0].ptr();
+	const real_t *cy = center_of_mass_local[1].ptr();
+	const real_t *cz = center_of_mass_local[2].ptr();
+	uint8_t *rot_flags = rotated.ptr();
+
+	const real_t s = step;
+	for (uint32_t i = begin; i < end; i++) {
+		const real_t ang_vel = Math::sqrt(avx[i] * avx[i] + avy[i] * avy[i] + avz[i] * avz[i]);
+		rot_flags[i] = !Math::is_zero_approx(ang_vel);
+
+		if (rot_flags[i]) {
+			// Rotation around the center of mass, same as `Basis(axis, angle)`.
+			const real_t x = avx[i] / ang_vel;
+			const real_t y = avy[i] / ang_vel;
+			const real_t z = avz[i] / ang_vel;
+			const real_t angle = ang_vel * s;
+			const real_t cosine = Math::cos(angle);
+			const real_t sine = Math::sin(angle);
+			const real_t t = 1 - cosine;
+
+			real_t r[9];
+			r[0] = x * x + cosine * (1 - x * x);
+			r[4] = y * y + cosine * (1 - y * y);
+			r[8] = z * z + cosine * (1 - z * z);
+			r[1] = x * y * t - z * sine;
+			r[3] = x * y * t + z * sine;
+			r[2] = x * z * t + y * sine;
+			r[6] = x * z * t - y * sine;
+			r[5] = y * z * t - x * sine;
+			r[7] = y * z * t + x * sine;
+
+			real_t rb[9];
+			real_t mb[9];
+			for (int row = 0; row < 3; row++) {
+				for (int col = 0; col < 3; col++) {
+					const real_t r0 = r[row * 3 + 0];
+					const real_t r1 = r[row * 3 + 1];
+					const real_t r2 = r[row * 3 + 2];
+					rb[row * 3 + col] = r0 * b[col][i] + r1 * b[3 + col][i] + r2 * b[6 + col][i];
+					// (identity - rotation) * basis.
+					mb[row * 3 + col] = (real_t(row == 0) - r0) * b[col][i] + (real_t(row == 1) - r1) * b[3 + col][i] + (real_t(row == 2) - r2) * b[6 + col][i];
+				}
+			}
+
+			ox[i] += mb[0] * cx[i] + mb[1] * cy[i] + mb[2] * cz[i];
+			oy[i] += mb[3] * cx[i] + mb[4] * cy[i] + mb[5] * cz[i];
+			oz[i] += mb[6] * cx[i] + mb[7] * cy[i] + mb[8] * cz[i];
+			for (int j = 0; j < 9; j++) {
+				b[j][i] = rb[j];
+			}
+		}
+	}
+
+	// Kept as a separate loop without branches, so it vectorizes.
+	for (uint32_t i = begin; i < end; i++) {
+		ox[i] += lvx[i] * s;
+		oy[i] += lvy[i] * s;
+		oz[i] += lvz[i] * s;
+	}
+}
+
+void GodotBodyIntegrator3D::_run_batches(uint32_t p_body_count, void (GodotBodyIntegrator3D::*p_kernel)(uint32_t, void *), const StringName &p_name) {
+	const uint32_t batch_count = (p_body_count + BATCH_SIZE - 1) / BATCH_SIZE;
+	if (p_body_count < PARALLEL_MIN_BODIES) {
+		for (uint32_t i = 0; i < batch_count; i++) {
+			(this->*p_kernel)(i, nullptr);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_kernel, nullptr, batch_count, -1, true, p_name);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+int GodotBodyIntegrator3D::integrate_forces(const SelfList<GodotBody3D>::List &p_body_list, real_t p_step) {
+	step = p_step;
+	stepped_bodies.clear();
+	force_bodies.clear();
+
+	int body_count = 0;
+	const SelfList<GodotBody3D> *b = p_body_list.first();
+	while (b) {
+		GodotBody3D *body = b->self();
+		bool integrate = false;
+		if (body->pre_integrate_forces(p_step, integrate)) {
+			stepped_bodies.push_back(body);
+			if (integrate) {
+				force_bodies.push_back(body);
+			}
+		}
+		b = b->next();
+		body_count++;
+	}
+
+	_resize_forces(force_bodies.size());
+	for (uint32_t i = 0; i < force_bodies.size(); i++) {
+		const GodotBody3D *body = force_bodies[i];
+		const Vector3 body_force = body->gravity * body->mass + body->applied_force + body->constant_force;
+		const Vector3 body_torque = body->applied_torque + body->constant_torque;
+		for (int j = 0; j < 3; j++) {
+			linear_velocity[j][i] = body->linear_velocity[j];
+			angular_velocity[j][i] = body->angular_velocity[j];
+			force[j][i] = body_force[j];
+			torque[j][i] = body_torque[j];
+			for (int k = 0; k < 3; k++) {
+				inv_inertia_tensor[j * 3 + k][i] = body->_inv_inertia_tensor.rows[j][k];
+			}
+		}
+		inv_mass[i] = body->_inv_mass;
+		linear_damp[i] = body->total_linear_damp;
+		angular_damp[i] = body->total_angular_damp;
+	}
+
+	_run_batches(force_bodies.size(), &GodotBodyIntegrator3D::_integrate_forces_batch, SNAME("Physics3DIntegrateForces"));
+
+	for (uint32_t i = 0; i < force_bodies.size(); i++) {
+		GodotBody3D *body = force_bodies[i];
+		body->linear_velocity = Vector3(linear_velocity[0][i], linear_velocity[1][i], linear_velocity[2][i]);
+		body->angular_velocity = Vector3(angular_velocity[0][i], angular_velocity[1][i], angular_velocity[2][i]);
+	}
+
+	for (GodotBody3D *body : stepped_bodies) {
+		body->post_integrate_forces(p_step);
+	}
+
+	return body_count;
+}
+
+void GodotBodyIntegrator3D::integrate_velocities(const SelfList<GodotBody3D>::List &p_body_list, real_t p_step) {
+	step = p_step;
+
+	uint32_t body_count = 0;
+	const SelfList<GodotBody3D> *b = p_body_list.first();
+	while (b) {
+		const SelfList<GodotBody3D> *n = b->next();
+		GodotBody3D *body = b->self();
+		if (body->pre_integrate_velocities(p_step)) {
+			// The arrays only hold the transform of the body if it had the same index in the last step.
+			if (body_count == velocity_bodies.size()) {
+				velocity_bodies.push_back(body);
+				body->integrator_transform_valid = false;
+			} else if (velocity_bodies[body_count] != body) {
+				velocity_bodies[body_count] = body;
+				body->integrator_transform_valid = false;
+			}
+			body_count++;
+		}
+		b = n; // In case it shuts itself down.
+	}
+	velocity_bodies.resize(body_count);
+
+	_resize_velocities(body_count);
+	for (uint32_t i = 0; i < body_count; i++) {
+		const GodotBody3D *body = velocity_bodies[i];
+		const Vector3 total_linear_velocity = body->linear_velocity + body->biased_linear_velocity;
+		const Vector3 total_angular_velocity = body->angular_velocity + body->biased_angular_velocity;
+		for (int j = 0; j < 3; j++) {
+			linear_velocity[j][i] = total_linear_velocity[j];
+			angular_velocity[j][i] = total_angular_velocity[j];
+		}
+
+		if (body->integrator_transform_valid) {
+			continue;
+		}
+
+		const Transform3D &transform = body->get_transform();
+		for (int j = 0; j < 3; j++) {
+			origin[j][i] = transform.origin[j];
+			center_of_mass_local[j][i] = body->center_of_mass_local[j];
+			for (int k = 0; k < 3; k++) {
+				basis[j * 3 + k][i] = transform.basis.rows[j][k];
+			}
+		}
+	}
+
+	_run_batches(body_count, &GodotBodyIntegrator3D::_integrate_velocities_batch, SNAME("Physics3DIntegrateVelocities"));
+
+	// Updating shapes and the broadphase isn't thread safe, so the transforms are applied serially.
+	for (uint32_t i = 0; i < body_count; i++) {
+		Transform3D transform_new;
+		for (int j = 0; j < 3; j++) {
+			transform_new.origin[j] = origin[j][i];
+			for (int k = 0; k < 3; k++) {
+				transform_new.basis.rows[j][k] = basis[j * 3 + k][i];
+			}
+		}
+		if (rotated[i]) {
+			transform_new.orthonormalize();
+			for (int j = 0; j < 3; j++) {
+				for (int k = 0; k < 3; k++) {
+					basis[j * 3 + k][i] = transform_new.basis.rows[j][k];
+				}
+			}
+		}
+
+		GodotBody3D *body = velocity_bodies[i];
+		body->post_integrate_velocities(transform_new);
+		body->integrator_transform_valid = true;
+	}
+}
@@ -0,0 +1,91 @@
+/**************************************************************************/
+/*  godot_body_integrator_3d.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_BODY_INTEGRATOR_3D_H
+#define GODOT_BODY_INTEGRATOR_3D_H
+
+#include "godot_body_3d.h"
+
+#include "core/templates/local_vector.h"
+#include "core/templates/self_list.h"
+
+// Integrates the active bodies of a space in batches.
+// The hot state of the bodies (velocities, forces, inverse inertia, damping and transforms)
+// is kept in one array per component, so the integration kernels run over contiguous
+// memory in loops the compiler can vectorize, and are split across threads for large spaces.
+// Bodies keep their index in the velocity arrays while the active list doesn't change, so their
+// transform stays in the arrays from one step to the next and is only gathered again when it was
+// changed outside of the integrator. The inputs of the forces pass are recomputed by the bodies
+// every step and are always gathered.
+class GodotBodyIntegrator3D {
+	static constexpr uint32_t BATCH_SIZE = 256;
+	static constexpr uint32_t PARALLEL_MIN_BODIES = 2048;
+
+	real_t step = 0.0;
+
+	// Bodies which passed pre_integrate_forces(), in list order.
+	LocalVector<GodotBody3D *> stepped_bodies;
+	LocalVector<GodotBody3D *> force_bodies;
+	// Body owning each index of the velocities pass arrays, kept across steps.
+	LocalVector<GodotBody3D *> velocity_bodies;
+
+	LocalVector<real_t> linear_velocity[3];
+	LocalVector<real_t> angular_velocity[3];
+
+	// Forces pass.
+	LocalVector<real_t> force[3];
+	LocalVector<real_t> torque[3];
+	LocalVector<real_t> inv_mass;
+	LocalVector<real_t> inv_inertia_tensor[9];
+	LocalVector<real_t> linear_damp;
+	LocalVector<real_t> angular_damp;
+
+	// Velocities pass, bases are stored row by row.
+	LocalVector<real_t> basis[9];
+	LocalVector<real_t> origin[3];
+	LocalVector<real_t> center_of_mass_local[3];
+	LocalVector<uint8_t> rotated;
+
+	void _resize_forces(uint32_t p_count);
+	void _resize_velocities(uint32_t p_count);
+
+	void _integrate_forces_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
+	void _integrate_velocities_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
+	void _run_batches(uint32_t p_body_count, void (GodotBodyIntegrator3D::*p_kernel)(uint32_t, void *), const StringName &p_name);
+
+public:
+	// Returns the number of bodies in the list.
+	int integrate_forces(const SelfList<GodotBody3D>::List &p_body_list, real_t p_step);
+	void integrate_velocities(const SelfList<GodotBody3D>::List &p_body_list, real_t p_step);
+};
+
+#endif // GODOT_BODY_INTEGRATOR_3D_H
@@ -59,6 +59,7 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.local_A = local_A;
 	contact.local_B = local_B;
 	contact.normal = (p_point_A - p_point_B).normalized();
+	contact.local_normal = A->get_inv_transform().basis.xform(contact.normal).normalized();
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
@@ -140,6 +141,10 @@ void GodotBodyPair3D::validate_contacts() {
 		} else {
 			c.used = false;
 
+			// Bodies can rotate together without moving relative to each other, which keeps the
+			// manifold cached. Rotate the normal with A so it doesn't point the old way.
+			c.normal = basis_A.xform(c.local_normal).normalized();
+
 			Vector3 global_A = basis_A.xform(c.local_A);
 			Vector3 global_B = basis_B.xform(c.local_B) + offset_B;
 			Vector3 axis = global_A - global_B;
@@ -163,6 +168,37 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
+bool GodotBodyPair3D::_can_reuse_manifold(const Transform3D &p_relative_transform) const {
+	real_t threshold = space->get_contact_cache_threshold();
+	if (threshold <= 0.0 || report_contacts_only || contact_count == 0 || contact_count != cached_contact_count) {
+		return false;
+	}
+
+	if (A->get_shapes_version() != cached_shapes_version_A || B->get_shapes_version() != cached_shapes_version_B) {
+		return false;
+	}
+
+	// Continuous collision detection depends on the motion of the bodies, not only on their transforms.
+	if (A->is_continuous_collision_detection_enabled() || B->is_continuous_collision_detection_enabled()) {
+		return false;
+	}
+
+	// Contacts are stored relative to each body, so they stay valid as long as B has barely moved
+	// relative to A since the last narrowphase. Check the contact points and the origin of B.
+	real_t threshold_squared = threshold * threshold;
+	if (p_relative_transform.origin.distance_squared_to(cached_relative_transform.origin) > threshold_squared) {
+		return false;
+	}
+	for (int i = 0; i < contact_count; i++) {
+		const Vector3 &local_B = contacts[i].local_B;
+		if (p_relative_transform.xform(local_B).distance_squared_to(cached_relative_transform.xform(local_B)) > threshold_squared) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // `_test_ccd` prevents tunneling by slowing down a high velocity body that is about to collide so
 // that next frame it will be at an appropriate location to collide (i.e. slight overlap).
 // WARNING: The way velocity is adjusted down to cause a collision means the momentum will be
@@ -265,6 +301,9 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 bool GodotBodyPair3D::setup(real_t p_step) {
 	check_ccd = false;
 
+	bool was_cached = manifold_cached;
+	manifold_cached = false;
+
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
 		return false;
@@ -287,6 +326,16 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 
 	validate_contacts();
 
+	Transform3D relative_transform = A->get_inv_transform() * B->get_transform();
+	if (was_cached && collided && _can_reuse_manifold(relative_transform)) {
+		// Skip the narrowphase, the contacts and their accumulated impulses are kept as they are for warm starting.
+		for (int i = 0; i < contact_count; i++) {
+			contacts[i].used = true;
+		}
+		manifold_cached = true;
+		return true;
+	}
+
 	const Vector3 &offset_A = A->get_transform().get_origin();
 	Transform3D xform_Au = Transform3D(A->get_transform().basis, Vector3());
 	Transform3D xform_A = xform_Au * A->get_shape_transform(shape_A);
@@ -314,6 +363,12 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 		return false;
 	}
 
+	cached_relative_transform = relative_transform;
+	cached_shapes_version_A = A->get_shapes_version();
+	cached_shapes_version_B = B->get_shapes_version();
+	cached_contact_count = contact_count;
+	manifold_cached = true;
+
 	return true;
 }
 
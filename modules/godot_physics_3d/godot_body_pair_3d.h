@@ -46,6 +46,7 @@ protected:
 		Vector3 normal;
 		int index_A = 0, index_B = 0;
 		Vector3 local_A, local_B;
+		Vector3 local_normal; // Normal in the local orientation of A, so it follows A while the contact is kept.
 		Vector3 acc_impulse; // accumulated impulse - only one of the object's impulse is needed as impulse_a == -impulse_b
 		real_t acc_normal_impulse = 0.0; // accumulated normal impulse (Pn)
 		Vector3 acc_tangent_impulse; // accumulated tangent impulse (Pt)
@@ -73,6 +74,8 @@ protected:
 };
 
 class GodotBodyPair3D : public GodotBodyContact3D {
+	friend class TestGodotBodyPair3DInternalsAccessor;
+
 	enum {
 		MAX_CONTACTS = 4
 	};
@@ -99,11 +102,19 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// State of the last narrowphase, used to reuse its contacts while the bodies don't move relative to each other.
+	Transform3D cached_relative_transform;
+	uint64_t cached_shapes_version_A = 0;
+	uint64_t cached_shapes_version_B = 0;
+	int cached_contact_count = 0;
+	bool manifold_cached = false;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
+	bool _can_reuse_manifold(const Transform3D &p_relative_transform) const;
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
 
 public:
@@ -44,6 +44,7 @@ void GodotCollisionObject3D::add_shape(GodotShape3D *p_shape, const Transform3D
 	s.disabled = p_disabled;
 	shapes.push_back(s);
 	p_shape->add_owner(this);
+	shapes_version++;
 
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer3D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
@@ -56,6 +57,7 @@ void GodotCollisionObject3D::set_shape(int p_index, GodotShape3D *p_shape) {
 	shapes.write[p_index].shape = p_shape;
 
 	p_shape->add_owner(this);
+	shapes_version++;
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer3D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
 	}
@@ -66,6 +68,7 @@ void GodotCollisionObject3D::set_shape_transform(int p_index, const Transform3D
 
 	shapes.write[p_index].xform = p_transform;
 	shapes.write[p_index].xform_inv = p_transform.affine_inverse();
+	shapes_version++;
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer3D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
 	}
@@ -80,6 +83,7 @@ void GodotCollisionObject3D::set_shape_disabled(int p_idx, bool p_disabled) {
 	}
 
 	shape.disabled = p_disabled;
+	shapes_version++;
 
 	if (!space) {
 		return;
@@ -121,6 +125,7 @@ void GodotCollisionObject3D::remove_shape(int p_index) {
 	}
 	shapes[p_index].shape->remove_owner(this);
 	shapes.remove_at(p_index);
+	shapes_version++;
 
 	if (!pending_shape_update_list.in_list()) {
 		GodotPhysicsServer3D::godot_singleton->pending_shape_update_list.add(&pending_shape_update_list);
@@ -234,6 +239,7 @@ void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 }
 
 void GodotCollisionObject3D::_shape_changed() {
+	shapes_version++;
 	_update_shapes();
 	_shapes_changed();
 }
@@ -80,6 +80,7 @@ private:
 	bool _static = true;
 
 	SelfList<GodotCollisionObject3D> pending_shape_update_list;
+	uint64_t shapes_version = 0;
 
 	void _update_shapes();
 
@@ -118,6 +119,8 @@ public:
 	void _shape_changed() override;
 
 	_FORCE_INLINE_ Type get_type() const { return type; }
+	// Incremented whenever shapes are added, removed, moved or modified.
+	_FORCE_INLINE_ uint64_t get_shapes_version() const { return shapes_version; }
 	void add_shape(GodotShape3D *p_shape, const Transform3D &p_transform = Transform3D(), bool p_disabled = false);
 	void set_shape(int p_index, GodotShape3D *p_shape);
 	void set_shape_transform(int p_index, const Transform3D &p_transform);
@@ -36,6 +36,7 @@
 #include "godot_area_3d.h"
 #include "godot_area_pair_3d.h"
 #include "godot_body_3d.h"
+#include "godot_body_integrator_3d.h"
 #include "godot_body_pair_3d.h"
 #include "godot_broad_phase_3d.h"
 #include "godot_collision_object_3d.h"
@@ -88,6 +89,9 @@ private:
 	SelfList<GodotArea3D>::List area_moved_list;
 	SelfList<GodotSoftBody3D>::List active_soft_body_list;
 
+	// Keeps the integration state of the active bodies from one step to the next.
+	GodotBodyIntegrator3D body_integrator;
+
 	static void *_broadphase_pair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_self);
 	static void _broadphase_unpair(GodotCollisionObject3D *A, int p_subindex_A, GodotCollisionObject3D *B, int p_subindex_B, void *p_data, void *p_self);
 
@@ -96,8 +100,10 @@ private:
 	GodotArea3D *area = nullptr;
 
 	int solver_iterations = 0;
+	int parallel_island_min_constraints = 0;
 
 	real_t contact_recycle_radius = 0.0;
+	real_t contact_cache_threshold = 0.0;
 	real_t contact_max_separation = 0.0;
 	real_t contact_max_allowed_penetration = 0.0;
 	real_t contact_bias = 0.0;
@@ -140,6 +146,7 @@ public:
 	const SelfList<GodotBody3D>::List &get_active_body_list() const;
 	void body_add_to_active_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody3D> *p_body);
+	GodotBodyIntegrator3D &get_body_integrator() { return body_integrator; }
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 
@@ -163,7 +170,9 @@ public:
 	const HashSet<GodotCollisionObject3D *> &get_objects() const;
 
 	_FORCE_INLINE_ int get_solver_iterations() const { return solver_iterations; }
+	_FORCE_INLINE_ int get_parallel_island_min_constraints() const { return parallel_island_min_constraints; }
 	_FORCE_INLINE_ real_t get_contact_recycle_radius() const { return contact_recycle_radius; }
+	_FORCE_INLINE_ real_t get_contact_cache_threshold() const { return contact_cache_threshold; }
 	_FORCE_INLINE_ real_t get_contact_max_separation() const { return contact_max_separation; }
 	_FORCE_INLINE_ real_t get_contact_max_allowed_penetration() const { return contact_max_allowed_penetration; }
 	_FORCE_INLINE_ real_t get_contact_bias() const { return contact_bias; }
@@ -133,7 +133,7 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 }
 
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
-	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
+	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[serial_islands[p_island_index]];
 
 	int current_priority = 1;
 
@@ -160,6 +160,146 @@ void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	}
 }
 
+bool GodotStep3D::_can_solve_island_in_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island) const {
+	if (p_constraint_island.size() < 2 * SOLVER_BATCH_SIZE) {
+		return false;
+	}
+	for (const GodotConstraint3D *constraint : p_constraint_island) {
+		if (constraint->get_soft_body_count() > 0) {
+			// Soft body constraints write to the soft body nodes, which aren't tracked by coloring.
+			return false;
+		}
+	}
+	return true;
+}
+
+void GodotStep3D::_color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	// Greedy coloring in island order: a constraint takes the first color not used yet by any of its dynamic bodies.
+	// Static and kinematic bodies are only read while solving, so they don't prevent constraints from sharing a color.
+	// The result only depends on the island order, which keeps solving deterministic for any thread count.
+	uint32_t constraint_count = p_constraint_island.size();
+	constraint_colors.resize(constraint_count);
+	body_colors.clear();
+
+	uint32_t color_counts[SOLVER_COLOR_COUNT] = {};
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		const GodotConstraint3D *constraint = p_constraint_island[constraint_index];
+		GodotBody3D *const *bodies = constraint->get_body_ptr();
+
+		uint64_t used_colors = 0;
+		for (int i = 0; i < constraint->get_body_count(); i++) {
+			if (bodies[i]->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+				const uint64_t *body_used_colors = body_colors.getptr(bodies[i]);
+				if (body_used_colors) {
+					used_colors |= *body_used_colors;
+				}
+			}
+		}
+
+		uint32_t color = 0;
+		while (color < SOLVER_COLOR_OVERFLOW && (used_colors & (uint64_t(1) << color))) {
+			color++;
+		}
+
+		if (color < SOLVER_COLOR_OVERFLOW) {
+			for (int i = 0; i < constraint->get_body_count(); i++) {
+				if (bodies[i]->get_mode() > PhysicsServer3D::BODY_MODE_KINEMATIC) {
+					body_colors[bodies[i]] |= uint64_t(1) << color;
+				}
+			}
+		}
+
+		constraint_colors[constraint_index] = color;
+		color_counts[color]++;
+	}
+
+	// Sort by color, keeping the island order inside each color.
+	color_offsets[0] = 0;
+	for (uint32_t color = 0; color < SOLVER_COLOR_COUNT; ++color) {
+		color_offsets[color + 1] = color_offsets[color] + color_counts[color];
+		color_counts[color] = color_offsets[color];
+	}
+	colored_constraints.resize(constraint_count);
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		colored_constraints[color_counts[constraint_colors[constraint_index]]++] = p_constraint_island[constraint_index];
+	}
+}
+
+void GodotStep3D::_solve_color_batch(uint32_t p_batch_index, void *p_userdata) {
+	uint32_t begin = color_offsets[solving_color] + p_batch_index * SOLVER_BATCH_SIZE;
+	uint32_t end = MIN(begin + SOLVER_BATCH_SIZE, color_offsets[solving_color + 1]);
+	for (uint32_t constraint_index = begin; constraint_index < end; ++constraint_index) {
+		colored_constraints[constraint_index]->solve(delta);
+	}
+}
+
+void GodotStep3D::_solve_color(uint32_t p_color) {
+	uint32_t begin = color_offsets[p_color];
+	uint32_t end = color_offsets[p_color + 1];
+
+	if (p_color == SOLVER_COLOR_OVERFLOW || end - begin < 2 * SOLVER_BATCH_SIZE) {
+		// Not worth dispatching, or constraints may share bodies.
+		for (uint32_t constraint_index = begin; constraint_index < end; ++constraint_index) {
+			colored_constraints[constraint_index]->solve(delta);
+		}
+		return;
+	}
+
+	solving_color = p_color;
+	uint32_t batch_count = (end - begin + SOLVER_BATCH_SIZE - 1) / SOLVER_BATCH_SIZE;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_color_batch, nullptr, batch_count, -1, true, SNAME("Physics3DConstraintSolveBatches"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+void GodotStep3D::_solve_island_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	_color_island(p_constraint_island);
+
+	int current_priority = 1;
+
+	while (!colored_constraints.is_empty()) {
+		for (int i = 0; i < iterations; i++) {
+			// Colors are solved one after another, constraints of the same color in parallel.
+			for (uint32_t color = 0; color < SOLVER_COLOR_COUNT; ++color) {
+				_solve_color(color);
+			}
+		}
+
+		// Check priority to keep only higher priority constraints, removing constraints doesn't invalidate colors.
+		uint32_t priority_constraint_count = 0;
+		++current_priority;
+		uint32_t color_begin = 0;
+		for (uint32_t color = 0; color < SOLVER_COLOR_COUNT; ++color) {
+			uint32_t color_end = color_offsets[color + 1];
+			color_offsets[color] = priority_constraint_count;
+			for (uint32_t constraint_index = color_begin; constraint_index < color_end; ++constraint_index) {
+				GodotConstraint3D *constraint = colored_constraints[constraint_index];
+				if (constraint->get_priority() >= current_priority) {
+					// Keep this constraint for the next iteration.
+					colored_constraints[priority_constraint_count++] = constraint;
+				}
+			}
+			color_begin = color_end;
+		}
+		color_offsets[SOLVER_COLOR_COUNT] = priority_constraint_count;
+		colored_constraints.resize(priority_constraint_count);
+	}
+}
+
+void GodotStep3D::_split_islands(uint32_t p_island_count, int p_parallel_island_min_constraints) {
+	// Large islands would keep a single thread busy, so they are split in colors solved in parallel batches instead.
+	serial_islands.clear();
+	parallel_islands.clear();
+	uint32_t parallel_island_min_constraints = MAX(p_parallel_island_min_constraints, 0);
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		const LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[island_index];
+		if (parallel_island_min_constraints > 0 && constraint_island.size() >= parallel_island_min_constraints && _can_solve_island_in_parallel(constraint_island)) {
+			parallel_islands.push_back(island_index);
+		} else {
+			serial_islands.push_back(island_index);
+		}
+	}
+}
+
 void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const {
 	bool can_sleep = true;
 
@@ -203,14 +343,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	uint64_t profile_begtime = OS::get_singleton()->get_ticks_usec();
 	uint64_t profile_endtime = 0;
 
-	int active_count = 0;
-
-	const SelfList<GodotBody3D> *b = body_list->first();
-	while (b) {
-		b->self()->integrate_forces(p_delta);
-		b = b->next();
-		active_count++;
-	}
+	int active_count = p_space->get_body_integrator().integrate_forces(*body_list, p_delta);
 
 	/* UPDATE SOFT BODY MOTION */
 
@@ -262,7 +395,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* GENERATE CONSTRAINT ISLANDS FOR ACTIVE RIGID BODIES */
 
-	b = body_list->first();
+	const SelfList<GodotBody3D> *b = body_list->first();
 
 	uint32_t body_island_count = 0;
 
@@ -364,9 +497,17 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
+	_split_islands(island_count, p_space->get_parallel_island_min_constraints());
+
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, serial_islands.size(), -1, true, SNAME("Physics3DConstraintSolveIslands"));
+
+	// Islands don't share dynamic bodies, so large islands can be solved while the small ones are processed.
+	for (uint32_t island_index : parallel_islands) {
+		_solve_island_parallel(constraint_islands[island_index]);
+	}
+
 	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 
 	{ //profile
@@ -377,12 +518,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	/* INTEGRATE VELOCITIES */
 
-	b = body_list->first();
-	while (b) {
-		const SelfList<GodotBody3D> *n = b->next();
-		b->self()->integrate_velocities(p_delta);
-		b = n;
-	}
+	p_space->get_body_integrator().integrate_velocities(*body_list, p_delta);
 
 	/* SLEEP / WAKE UP ISLANDS */
 
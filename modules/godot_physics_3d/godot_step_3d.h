@@ -35,9 +35,17 @@
 
 #include "godot_space_3d.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 
 class GodotStep3D {
+	friend class TestGodotStep3DInternalsAccessor;
+
+	// Colors used to split large islands, the last one holds constraints that couldn't be colored and is solved serially.
+	static constexpr uint32_t SOLVER_COLOR_COUNT = 64;
+	static constexpr uint32_t SOLVER_COLOR_OVERFLOW = SOLVER_COLOR_COUNT - 1;
+	static constexpr uint32_t SOLVER_BATCH_SIZE = 64;
+
 	uint64_t _step = 1;
 
 	int iterations = 0;
@@ -47,11 +55,27 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
 
+	LocalVector<uint32_t> serial_islands;
+	LocalVector<uint32_t> parallel_islands;
+
+	// Constraints of the large island being solved, sorted by color.
+	LocalVector<GodotConstraint3D *> colored_constraints;
+	LocalVector<uint8_t> constraint_colors;
+	uint32_t color_offsets[SOLVER_COLOR_COUNT + 1] = {};
+	HashMap<const GodotBody3D *, uint64_t> body_colors;
+	uint32_t solving_color = 0;
+
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	bool _can_solve_island_in_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island) const;
+	void _color_island(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _solve_color_batch(uint32_t p_batch_index, void *p_userdata = nullptr);
+	void _solve_color(uint32_t p_color);
+	void _solve_island_parallel(const LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _split_islands(uint32_t p_island_count, int p_parallel_island_min_constraints);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
 public:
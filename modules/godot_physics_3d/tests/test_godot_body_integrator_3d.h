@@ -0,0 +1,214 @@
+/**************************************************************************/
+/*  test_godot_body_integrator_3d.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_BODY_INTEGRATOR_3D_H
+#define TEST_GODOT_BODY_INTEGRATOR_3D_H
+
+#include "../godot_area_3d.h"
+#include "../godot_body_3d.h"
+#include "../godot_body_direct_state_3d.h"
+#include "../godot_body_integrator_3d.h"
+#include "../godot_space_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotBodyIntegrator3D {
+
+// Integration of rigid bodies without axis locks as done by GodotBody3D before it was batched.
+static void reference_integrate_forces(GodotBody3D *p_body, real_t p_step) {
+	bool integrate = false;
+	if (!p_body->pre_integrate_forces(p_step, integrate)) {
+		return;
+	}
+
+	if (integrate) {
+		GodotPhysicsDirectBodyState3D *state = p_body->get_direct_state();
+		real_t mass = p_body->get_param(PhysicsServer3D::BODY_PARAM_MASS);
+		Vector3 force = state->get_total_gravity() * mass + p_body->get_constant_force();
+		Vector3 torque = p_body->get_constant_torque();
+
+		real_t damp = 1.0 - p_step * state->get_total_linear_damp();
+		if (damp < 0) {
+			damp = 0;
+		}
+		real_t angular_damp_new = 1.0 - p_step * state->get_total_angular_damp();
+		if (angular_damp_new < 0) {
+			angular_damp_new = 0;
+		}
+
+		Vector3 linear_velocity = p_body->get_linear_velocity();
+		Vector3 angular_velocity = p_body->get_angular_velocity();
+		linear_velocity *= damp;
+		angular_velocity *= angular_damp_new;
+		linear_velocity += p_body->get_inv_mass() * force * p_step;
+		angular_velocity += p_body->get_inv_inertia_tensor().xform(torque) * p_step;
+		p_body->set_linear_velocity(linear_velocity);
+		p_body->set_angular_velocity(angular_velocity);
+	}
+
+	p_body->post_integrate_forces(p_step);
+}
+
+static void reference_integrate_velocities(GodotBody3D *p_body, real_t p_step) {
+	if (!p_body->pre_integrate_velocities(p_step)) {
+		return;
+	}
+
+	Vector3 total_angular_velocity = p_body->get_angular_velocity() + p_body->get_biased_angular_velocity();
+	real_t ang_vel = total_angular_velocity.length();
+	Transform3D transform_new = p_body->get_transform();
+
+	if (!Math::is_zero_approx(ang_vel)) {
+		Vector3 ang_vel_axis = total_angular_velocity / ang_vel;
+		Basis rot(ang_vel_axis, ang_vel * p_step);
+		Basis identity3(1, 0, 0, 0, 1, 0, 0, 0, 1);
+		transform_new.origin += ((identity3 - rot) * transform_new.basis).xform(p_body->get_center_of_mass_local());
+		transform_new.basis = rot * transform_new.basis;
+		transform_new.orthonormalize();
+	}
+
+	Vector3 total_linear_velocity = p_body->get_linear_velocity() + p_body->get_biased_linear_velocity();
+	transform_new.origin += total_linear_velocity * p_step;
+
+	p_body->post_integrate_velocities(transform_new);
+}
+
+static GodotSpace3D *create_space() {
+	GodotSpace3D *space = memnew(GodotSpace3D);
+	GodotArea3D *area = memnew(GodotArea3D);
+	space->set_default_area(area);
+	area->set_space(space);
+	return space;
+}
+
+static void free_space(GodotSpace3D *p_space) {
+	GodotArea3D *area = p_space->get_default_area();
+	area->set_space(nullptr);
+	memdelete(area);
+	memdelete(p_space);
+}
+
+static GodotBody3D *create_body(GodotSpace3D *p_space, int p_index) {
+	GodotBody3D *body = memnew(GodotBody3D);
+	body->set_space(p_space);
+	body->set_param(PhysicsServer3D::BODY_PARAM_MASS, 1.0 + 0.5 * (p_index % 7));
+	body->set_param(PhysicsServer3D::BODY_PARAM_INERTIA, Vector3(1.0 + 0.1 * (p_index % 5), 2.0, 0.5 + 0.2 * (p_index % 3)));
+	body->set_param(PhysicsServer3D::BODY_PARAM_CENTER_OF_MASS, Vector3(0.1 * (p_index % 4), -0.2, 0.3));
+	body->set_param(PhysicsServer3D::BODY_PARAM_LINEAR_DAMP, 0.1 * (p_index % 4));
+	body->set_param(PhysicsServer3D::BODY_PARAM_ANGULAR_DAMP, 0.05 * (p_index % 3));
+	body->update_mass_properties();
+
+	body->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(Vector3(0, 1, 0), 0.3 * p_index), Vector3(p_index, 2, -p_index)));
+	body->set_state(PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(1, 0.5 * (p_index % 6), -2));
+	if (p_index % 4 != 3) {
+		// Every fourth body doesn't rotate.
+		body->set_state(PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0.5 * (p_index % 5), 1, -0.25 * (p_index % 3)));
+		body->set_constant_torque(Vector3(0.1 * (p_index % 8), 0, 0.2));
+	}
+	body->set_constant_force(Vector3(0, 0, p_index % 10));
+	return body;
+}
+
+static void check_integration_matches_reference(int p_body_count) {
+	const real_t step = 1.0 / 60.0;
+
+	GodotSpace3D *space = create_space();
+	GodotSpace3D *reference_space = create_space();
+	LocalVector<GodotBody3D *> bodies;
+	LocalVector<GodotBody3D *> reference_bodies;
+	for (int i = 0; i < p_body_count; i++) {
+		bodies.push_back(create_body(space, i));
+		reference_bodies.push_back(create_body(reference_space, i));
+	}
+
+	GodotBodyIntegrator3D integrator;
+	bool matches = true;
+	for (int step_index = 0; step_index < 60; step_index++) {
+		if (step_index == 20) {
+			// Moved outside of the integrator, its transform must be gathered again.
+			const Transform3D transform(Basis(Vector3(1, 0, 0), 0.5), Vector3(-3, 4, 5));
+			bodies[2]->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, transform);
+			reference_bodies[2]->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, transform);
+		}
+		if (step_index == 30 || step_index == 40) {
+			// Changes the index of the other bodies in the arrays of the integrator.
+			bodies[1]->set_active(step_index == 40);
+			reference_bodies[1]->set_active(step_index == 40);
+		}
+
+		integrator.integrate_forces(space->get_active_body_list(), step);
+		for (const SelfList<GodotBody3D> *b = reference_space->get_active_body_list().first(); b; b = b->next()) {
+			reference_integrate_forces(b->self(), step);
+		}
+
+		integrator.integrate_velocities(space->get_active_body_list(), step);
+		const SelfList<GodotBody3D> *b = reference_space->get_active_body_list().first();
+		while (b) {
+			const SelfList<GodotBody3D> *n = b->next();
+			reference_integrate_velocities(b->self(), step);
+			b = n;
+		}
+
+		for (int i = 0; i < p_body_count; i++) {
+			if (!bodies[i]->get_transform().is_equal_approx(reference_bodies[i]->get_transform()) ||
+					!bodies[i]->get_linear_velocity().is_equal_approx(reference_bodies[i]->get_linear_velocity()) ||
+					!bodies[i]->get_angular_velocity().is_equal_approx(reference_bodies[i]->get_angular_velocity())) {
+				matches = false;
+			}
+		}
+	}
+
+	CHECK_MESSAGE(matches, "Batched integration should give the same results as integrating each body.");
+
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		bodies[i]->set_space(nullptr);
+		memdelete(bodies[i]);
+		reference_bodies[i]->set_space(nullptr);
+		memdelete(reference_bodies[i]);
+	}
+	free_space(space);
+	free_space(reference_space);
+}
+
+TEST_CASE("[SceneTree][Modules][GodotPhysics3D] Batched integration matches the per body integration") {
+	SUBCASE("Serial batches") {
+		check_integration_matches_reference(32);
+	}
+
+	SUBCASE("Parallel batches") {
+		check_integration_matches_reference(4096);
+	}
+}
+
+} // namespace TestGodotBodyIntegrator3D
+
+#endif // TEST_GODOT_BODY_INTEGRATOR_3D_H
@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_godot_body_pair_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_BODY_PAIR_3D_H
+#define TEST_GODOT_BODY_PAIR_3D_H
+
+#include "../godot_body_3d.h"
+#include "../godot_body_pair_3d.h"
+#include "../godot_shape_3d.h"
+#include "../godot_space_3d.h"
+
+#include "tests/test_macros.h"
+
+class TestGodotBodyPair3DInternalsAccessor {
+public:
+	static bool is_manifold_cached(const GodotBodyPair3D &p_pair) {
+		return p_pair.manifold_cached;
+	}
+
+	// Only updated when the narrowphase runs.
+	static const Transform3D &get_cached_relative_transform(const GodotBodyPair3D &p_pair) {
+		return p_pair.cached_relative_transform;
+	}
+
+	static int get_contact_count(const GodotBodyPair3D &p_pair) {
+		return p_pair.contact_count;
+	}
+
+	static Vector3 get_contact_normal(const GodotBodyPair3D &p_pair, int p_index) {
+		return p_pair.contacts[p_index].normal;
+	}
+};
+
+namespace TestGodotBodyPair3D {
+
+TEST_CASE("[SceneTree][Modules][GodotPhysics3D] Contacts are reused while bodies stay at rest") {
+	const real_t step = 1.0 / 60.0;
+
+	GodotSpace3D *space = memnew(GodotSpace3D);
+	GodotBoxShape3D *ground_shape = memnew(GodotBoxShape3D);
+	ground_shape->set_data(Vector3(10, 1, 10));
+	GodotBoxShape3D *box_shape = memnew(GodotBoxShape3D);
+	box_shape->set_data(Vector3(1, 1, 1));
+
+	GodotBody3D *ground = memnew(GodotBody3D);
+	ground->set_space(space);
+	ground->set_mode(PhysicsServer3D::BODY_MODE_STATIC);
+	ground->add_shape(ground_shape);
+
+	// Resting on the ground with a slight overlap.
+	GodotBody3D *box = memnew(GodotBody3D);
+	box->set_space(space);
+	box->add_shape(box_shape);
+	box->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, 1.99, 0)));
+
+	GodotBodyPair3D *pair = memnew(GodotBodyPair3D(box, 0, ground, 0));
+	REQUIRE(pair->setup(step));
+	REQUIRE(TestGodotBodyPair3DInternalsAccessor::is_manifold_cached(*pair));
+	const Transform3D first_relative_transform = TestGodotBodyPair3DInternalsAccessor::get_cached_relative_transform(*pair);
+
+	SUBCASE("Reused when moving less than the threshold") {
+		box->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0001, 1.99, 0)));
+		CHECK(pair->setup(step));
+		CHECK(TestGodotBodyPair3DInternalsAccessor::is_manifold_cached(*pair));
+		CHECK_MESSAGE(TestGodotBodyPair3DInternalsAccessor::get_cached_relative_transform(*pair) == first_relative_transform, "The narrowphase should be skipped.");
+	}
+
+	SUBCASE("Invalidated when moving more than the threshold") {
+		box->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.1, 1.95, 0)));
+		CHECK(pair->setup(step));
+		CHECK(TestGodotBodyPair3DInternalsAccessor::get_cached_relative_transform(*pair) == box->get_inv_transform() * ground->get_transform());
+	}
+
+	SUBCASE("Invalidated when shapes change") {
+		box->set_shape_transform(0, Transform3D(Basis(), Vector3(0, -0.005, 0)));
+		box->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0001, 1.99, 0)));
+		CHECK(pair->setup(step));
+		CHECK(TestGodotBodyPair3DInternalsAccessor::get_cached_relative_transform(*pair) == box->get_inv_transform() * ground->get_transform());
+	}
+
+	SUBCASE("Not reused with continuous collision detection") {
+		box->set_continuous_collision_detection(true);
+		box->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0001, 1.99, 0)));
+		CHECK(pair->setup(step));
+		CHECK(TestGodotBodyPair3DInternalsAccessor::get_cached_relative_transform(*pair) == box->get_inv_transform() * ground->get_transform());
+	}
+
+	memdelete(pair);
+	box->remove_shape(0);
+	ground->remove_shape(0);
+	box->set_space(nullptr);
+	ground->set_space(nullptr);
+	memdelete(box);
+	memdelete(ground);
+	memdelete(box_shape);
+	memdelete(ground_shape);
+	memdelete(space);
+}
+
+TEST_CASE("[SceneTree][Modules][GodotPhysics3D] Reused contacts follow bodies rotating together") {
+	const real_t step = 1.0 / 60.0;
+
+	GodotSpace3D *space = memnew(GodotSpace3D);
+	GodotBoxShape3D *platform_shape = memnew(GodotBoxShape3D);
+	platform_shape->set_data(Vector3(10, 1, 10));
+	GodotBoxShape3D *box_shape = memnew(GodotBoxShape3D);
+	box_shape->set_data(Vector3(1, 1, 1));
+
+	GodotBody3D *platform = memnew(GodotBody3D);
+	platform->set_space(space);
+	platform->set_mode(PhysicsServer3D::BODY_MODE_KINEMATIC);
+	platform->add_shape(platform_shape);
+	platform->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D());
+
+	// Resting on the platform with a slight overlap.
+	const Vector3 box_origin(2, 1.99, 0);
+	GodotBody3D *box = memnew(GodotBody3D);
+	box->set_space(space);
+	box->add_shape(box_shape);
+	box->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), box_origin));
+
+	GodotBodyPair3D *pair = memnew(GodotBodyPair3D(box, 0, platform, 0));
+	REQUIRE(pair->setup(step));
+	const Transform3D first_relative_transform = TestGodotBodyPair3DInternalsAccessor::get_cached_relative_transform(*pair);
+	const int contact_count = TestGodotBodyPair3DInternalsAccessor::get_contact_count(*pair);
+	REQUIRE(contact_count > 0);
+	Vector3 first_normals[4];
+	for (int i = 0; i < contact_count; i++) {
+		first_normals[i] = TestGodotBodyPair3DInternalsAccessor::get_contact_normal(*pair, i);
+	}
+
+	// Tilt the platform and carry the box along, so they don't move relative to each other.
+	const Basis rotation(Vector3(0, 0, 1), 0.5);
+	platform->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(rotation, Vector3()));
+	platform->pre_integrate_velocities(step); // Moves the kinematic body, like a step does.
+	box->set_state(PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(rotation, rotation.xform(box_origin)));
+
+	CHECK(pair->setup(step));
+	CHECK_MESSAGE(TestGodotBodyPair3DInternalsAccessor::get_cached_relative_transform(*pair) == first_relative_transform, "The narrowphase should be skipped.");
+	REQUIRE(TestGodotBodyPair3DInternalsAccessor::get_contact_count(*pair) == contact_count);
+	for (int i = 0; i < contact_count; i++) {
+		CHECK_MESSAGE(TestGodotBodyPair3DInternalsAccessor::get_contact_normal(*pair, i).is_equal_approx(rotation.xform(first_normals[i])), "The contact normals should rotate with the bodies.");
+	}
+	CHECK(pair->pre_solve(step));
+
+	memdelete(pair);
+	box->remove_shape(0);
+	platform->remove_shape(0);
+	box->set_space(nullptr);
+	platform->set_space(nullptr);
+	memdelete(box);
+	memdelete(platform);
+	memdelete(box_shape);
+	memdelete(platform_shape);
+	memdelete(space);
+}
+
+} // namespace TestGodotBodyPair3D
+
+#endif // TEST_GODOT_BODY_PAIR_3D_H
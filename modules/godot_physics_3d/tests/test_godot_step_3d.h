@@ -0,0 +1,232 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_STEP_3D_H
+#define TEST_GODOT_STEP_3D_H
+
+#include "../godot_body_3d.h"
+#include "../godot_constraint_3d.h"
+#include "../godot_step_3d.h"
+
+#include "tests/test_macros.h"
+
+class TestGodotStep3DInternalsAccessor {
+public:
+	static constexpr uint32_t color_count = GodotStep3D::SOLVER_COLOR_COUNT;
+	static constexpr uint32_t color_overflow = GodotStep3D::SOLVER_COLOR_OVERFLOW;
+	static constexpr uint32_t batch_size = GodotStep3D::SOLVER_BATCH_SIZE;
+
+	static void color_island(GodotStep3D &p_step, const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+		p_step._color_island(p_constraint_island);
+	}
+
+	static const LocalVector<GodotConstraint3D *> &get_colored_constraints(const GodotStep3D &p_step) {
+		return p_step.colored_constraints;
+	}
+
+	static uint32_t get_color_offset(const GodotStep3D &p_step, uint32_t p_color) {
+		return p_step.color_offsets[p_color];
+	}
+
+	static void split_islands(GodotStep3D &p_step, const LocalVector<LocalVector<GodotConstraint3D *>> &p_constraint_islands, int p_parallel_island_min_constraints) {
+		p_step.constraint_islands = p_constraint_islands;
+		p_step._split_islands(p_constraint_islands.size(), p_parallel_island_min_constraints);
+	}
+
+	static const LocalVector<uint32_t> &get_serial_islands(const GodotStep3D &p_step) {
+		return p_step.serial_islands;
+	}
+
+	static const LocalVector<uint32_t> &get_parallel_islands(const GodotStep3D &p_step) {
+		return p_step.parallel_islands;
+	}
+};
+
+namespace TestGodotStep3D {
+
+class TestConstraint3D : public GodotConstraint3D {
+	GodotBody3D *bodies[2] = {};
+
+public:
+	virtual bool setup(real_t p_step) override { return true; }
+	virtual bool pre_solve(real_t p_step) override { return true; }
+	virtual void solve(real_t p_step) override {}
+
+	TestConstraint3D(GodotBody3D *p_body_a, GodotBody3D *p_body_b) :
+			GodotConstraint3D(bodies, 2) {
+		bodies[0] = p_body_a;
+		bodies[1] = p_body_b;
+	}
+};
+
+static void check_colors(const GodotStep3D &p_step, const LocalVector<GodotConstraint3D *> &p_constraint_island) {
+	const LocalVector<GodotConstraint3D *> &colored_constraints = TestGodotStep3DInternalsAccessor::get_colored_constraints(p_step);
+	REQUIRE(colored_constraints.size() == p_constraint_island.size());
+	CHECK(TestGodotStep3DInternalsAccessor::get_color_offset(p_step, TestGodotStep3DInternalsAccessor::color_count) == p_constraint_island.size());
+
+	HashSet<const GodotConstraint3D *> seen_constraints;
+	for (const GodotConstraint3D *constraint : colored_constraints) {
+		seen_constraints.insert(constraint);
+	}
+	CHECK_MESSAGE(seen_constraints.size() == p_constraint_island.size(), "Every constraint should be colored exactly once.");
+
+	// The overflow color is solved serially, so only the other colors must not share dynamic bodies.
+	bool shared_body = false;
+	for (uint32_t color = 0; color < TestGodotStep3DInternalsAccessor::color_overflow; color++) {
+		HashSet<const GodotBody3D *> color_bodies;
+		uint32_t end = TestGodotStep3DInternalsAccessor::get_color_offset(p_step, color + 1);
+		for (uint32_t i = TestGodotStep3DInternalsAccessor::get_color_offset(p_step, color); i < end; i++) {
+			const GodotConstraint3D *constraint = colored_constraints[i];
+			for (int j = 0; j < constraint->get_body_count(); j++) {
+				const GodotBody3D *body = constraint->get_body_ptr()[j];
+				if (body->get_mode() <= PhysicsServer3D::BODY_MODE_KINEMATIC) {
+					continue;
+				}
+				if (color_bodies.has(body)) {
+					shared_body = true;
+				}
+				color_bodies.insert(body);
+			}
+		}
+	}
+	CHECK_MESSAGE(!shared_body, "Constraints of the same color should never share a dynamic body.");
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Colored batches never share a dynamic body") {
+	GodotStep3D step;
+
+	// A pile of bodies resting on a static ground, linked to their neighbors.
+	const int pile_size = 32;
+	GodotBody3D *ground = memnew(GodotBody3D);
+	ground->set_mode(PhysicsServer3D::BODY_MODE_STATIC);
+	LocalVector<GodotBody3D *> bodies;
+	for (int i = 0; i < pile_size * pile_size; i++) {
+		bodies.push_back(memnew(GodotBody3D));
+	}
+
+	LocalVector<GodotConstraint3D *> constraint_island;
+	for (int y = 0; y < pile_size; y++) {
+		for (int x = 0; x < pile_size; x++) {
+			GodotBody3D *body = bodies[y * pile_size + x];
+			if (x + 1 < pile_size) {
+				constraint_island.push_back(memnew(TestConstraint3D(body, bodies[y * pile_size + x + 1])));
+			}
+			if (y + 1 < pile_size) {
+				constraint_island.push_back(memnew(TestConstraint3D(body, bodies[(y + 1) * pile_size + x])));
+			}
+			if (y == 0) {
+				constraint_island.push_back(memnew(TestConstraint3D(ground, body)));
+			}
+		}
+	}
+
+	TestGodotStep3DInternalsAccessor::color_island(step, constraint_island);
+	check_colors(step, constraint_island);
+	CHECK_MESSAGE(TestGodotStep3DInternalsAccessor::get_color_offset(step, TestGodotStep3DInternalsAccessor::color_overflow) == constraint_island.size(),
+			"A pile where each body has few contacts should fit in the regular colors.");
+
+	// A single body touching more bodies than there are colors pushes the rest to the overflow color.
+	GodotBody3D *hub = memnew(GodotBody3D);
+	LocalVector<GodotConstraint3D *> hub_island;
+	for (int i = 0; i < 100; i++) {
+		hub_island.push_back(memnew(TestConstraint3D(hub, bodies[i])));
+	}
+
+	TestGodotStep3DInternalsAccessor::color_island(step, hub_island);
+	check_colors(step, hub_island);
+	CHECK(TestGodotStep3DInternalsAccessor::get_color_offset(step, TestGodotStep3DInternalsAccessor::color_overflow) == TestGodotStep3DInternalsAccessor::color_overflow);
+
+	for (GodotConstraint3D *constraint : constraint_island) {
+		memdelete(constraint);
+	}
+	for (GodotConstraint3D *constraint : hub_island) {
+		memdelete(constraint);
+	}
+	for (GodotBody3D *body : bodies) {
+		memdelete(body);
+	}
+	memdelete(hub);
+	memdelete(ground);
+}
+
+TEST_CASE("[Modules][GodotPhysics3D] Small islands are solved serially") {
+	GodotStep3D step;
+
+	GodotBody3D *body_a = memnew(GodotBody3D);
+	GodotBody3D *body_b = memnew(GodotBody3D);
+	TestConstraint3D constraint(body_a, body_b);
+
+	// Only the size of the islands matters when splitting them.
+	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
+	constraint_islands.resize(3);
+	constraint_islands[0].resize(16);
+	constraint_islands[1].resize(2048);
+	constraint_islands[2].resize(TestGodotStep3DInternalsAccessor::batch_size);
+	for (LocalVector<GodotConstraint3D *> &constraint_island : constraint_islands) {
+		for (GodotConstraint3D *&island_constraint : constraint_island) {
+			island_constraint = &constraint;
+		}
+	}
+
+	SUBCASE("Disabled by default") {
+		TestGodotStep3DInternalsAccessor::split_islands(step, constraint_islands, 0);
+		CHECK(TestGodotStep3DInternalsAccessor::get_serial_islands(step).size() == 3);
+		CHECK(TestGodotStep3DInternalsAccessor::get_parallel_islands(step).is_empty());
+	}
+
+	SUBCASE("Only islands above the threshold are split") {
+		TestGodotStep3DInternalsAccessor::split_islands(step, constraint_islands, 1024);
+		const LocalVector<uint32_t> &serial_islands = TestGodotStep3DInternalsAccessor::get_serial_islands(step);
+		const LocalVector<uint32_t> &parallel_islands = TestGodotStep3DInternalsAccessor::get_parallel_islands(step);
+		REQUIRE(serial_islands.size() == 2);
+		CHECK(serial_islands[0] == 0);
+		CHECK(serial_islands[1] == 2);
+		REQUIRE(parallel_islands.size() == 1);
+		CHECK(parallel_islands[0] == 1);
+	}
+
+	SUBCASE("Islands too small for two batches stay serial") {
+		TestGodotStep3DInternalsAccessor::split_islands(step, constraint_islands, 1);
+		const LocalVector<uint32_t> &serial_islands = TestGodotStep3DInternalsAccessor::get_serial_islands(step);
+		REQUIRE(serial_islands.size() == 2);
+		CHECK(serial_islands[0] == 0);
+		CHECK(serial_islands[1] == 2);
+		CHECK(TestGodotStep3DInternalsAccessor::get_parallel_islands(step).size() == 1);
+	}
+
+	memdelete(body_a);
+	memdelete(body_b);
+}
+
+} // namespace TestGodotStep3D
+
+#endif // TEST_GODOT_STEP_3D_H
@@ -470,6 +470,32 @@ void GodotNavigationServer2D::query_path(const Ref<NavigationPathQueryParameters
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+void GodotNavigationServer2D::query_paths(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) const {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must match.");
+
+	const uint32_t query_count = p_query_parameters.size();
+	LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+	parameters.resize(query_count);
+	for (uint32_t i = 0; i < query_count; i++) {
+		const Ref<NavigationPathQueryParameters2D> query_parameters = p_query_parameters[i];
+		ERR_FAIL_COND(query_parameters.is_null());
+		ERR_FAIL_COND(Ref<NavigationPathQueryResult2D>(p_query_results[i]).is_null());
+		parameters[i] = query_parameters->get_parameters();
+	}
+
+	LocalVector<NavigationUtilities::PathQueryResult> results;
+	results.resize(query_count);
+	NavigationServer3D::get_singleton()->_query_paths(parameters.ptr(), results.ptr(), query_count);
+
+	for (uint32_t i = 0; i < query_count; i++) {
+		Ref<NavigationPathQueryResult2D> query_result = p_query_results[i];
+		query_result->set_path(vector_v3_to_v2(results[i].path));
+		query_result->set_path_types(results[i].path_types);
+		query_result->set_path_rids(results[i].path_rids);
+		query_result->set_path_owner_ids(results[i].path_owner_ids);
+	}
+}
+
 RID GodotNavigationServer2D::source_geometry_parser_create() {
 #ifdef CLIPPER2_ENABLED
 	if (navmesh_generator_2d) {
@@ -32,6 +32,7 @@
 
 #include "godot_navigation_server_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
 
@@ -1387,6 +1388,33 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
+	return _query_path_in_arena(p_parameters, nullptr);
+}
+
+void GodotNavigationServer3D::_query_path_batch_task(void *p_userdata, uint32_t p_index) {
+	PathQueryBatch *batch = static_cast<PathQueryBatch *>(p_userdata);
+	// Threads outside the pool report -1 and use the first arena.
+	gd::PathSearchArena *arena = &batch->arenas[WorkerThreadPool::get_thread_index() + 1];
+	batch->results[p_index] = batch->server->_query_path_in_arena(batch->parameters[p_index], arena);
+}
+
+void GodotNavigationServer3D::_query_paths(const PathQueryParameters *p_parameters, PathQueryResult *r_results, uint32_t p_count) const {
+	if (p_count < 2) {
+		NavigationServer3D::_query_paths(p_parameters, r_results, p_count);
+		return;
+	}
+
+	PathQueryBatch batch;
+	batch.server = this;
+	batch.parameters = p_parameters;
+	batch.results = r_results;
+	batch.arenas.resize(WorkerThreadPool::get_singleton()->get_thread_count() + 1);
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_query_path_batch_task, &batch, p_count, -1, true, SNAME("NavigationServerPathQueries"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_path_in_arena(const PathQueryParameters &p_parameters, gd::PathSearchArena *r_arena) const {
 	PathQueryResult r_query_result;
 
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
@@ -1404,7 +1432,8 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 					p_parameters.navigation_layers,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
+					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr,
+					r_arena);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
 			r_query_result.path = map->get_path(
 					p_parameters.start_position,
@@ -1413,7 +1442,8 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 					p_parameters.navigation_layers,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_TYPES) ? &r_query_result.path_types : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
-					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
+					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr,
+					r_arena);
 		}
 	} else {
 		return r_query_result;
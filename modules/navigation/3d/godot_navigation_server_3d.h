@@ -291,10 +291,21 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void _query_paths(const NavigationUtilities::PathQueryParameters *p_parameters, NavigationUtilities::PathQueryResult *r_results, uint32_t p_count) const override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
+	struct PathQueryBatch {
+		const GodotNavigationServer3D *server = nullptr;
+		const NavigationUtilities::PathQueryParameters *parameters = nullptr;
+		NavigationUtilities::PathQueryResult *results = nullptr;
+		LocalVector<gd::PathSearchArena> arenas;
+	};
+
+	NavigationUtilities::PathQueryResult _query_path_in_arena(const NavigationUtilities::PathQueryParameters &p_parameters, gd::PathSearchArena *r_arena) const;
+	static void _query_path_batch_task(void *p_userdata, uint32_t p_index);
+
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
 };
@@ -74,6 +74,8 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D *> NavMeshGenerator3D::tile_caches;
 RID_Owner<NavMeshGenerator3D::NavMeshGeometryParser3D> NavMeshGenerator3D::generator_parser_owner;
 LocalVector<NavMeshGenerator3D::NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
 
@@ -98,6 +100,21 @@ NavMeshGenerator3D::~NavMeshGenerator3D() {
 }
 
 void NavMeshGenerator3D::sync() {
+	if (!tile_caches.is_empty()) {
+		MutexLock tile_cache_lock(tile_cache_mutex);
+
+		LocalVector<ObjectID> freed_navmesh_ids;
+		for (const KeyValue<ObjectID, NavMeshTileCache3D *> &E : tile_caches) {
+			if (!ObjectDB::get_instance(E.key)) {
+				freed_navmesh_ids.push_back(E.key);
+			}
+		}
+		for (const ObjectID &freed_navmesh_id : freed_navmesh_ids) {
+			memdelete(tile_caches[freed_navmesh_id]);
+			tile_caches.erase(freed_navmesh_id);
+		}
+	}
+
 	if (generator_tasks.size() == 0) {
 		return;
 	}
@@ -144,6 +161,13 @@ void NavMeshGenerator3D::cleanup() {
 		}
 		generator_tasks.clear();
 
+		tile_cache_mutex.lock();
+		for (KeyValue<ObjectID, NavMeshTileCache3D *> &E : tile_caches) {
+			memdelete(E.value);
+		}
+		tile_caches.clear();
+		tile_cache_mutex.unlock();
+
 		generator_rid_rwlock.write_lock();
 		for (NavMeshGeometryParser3D *parser : generator_parsers) {
 			generator_parser_owner.free(parser->self);
@@ -673,6 +697,181 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 	}
 }
 
+static bool generator_bake_recast(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_nav_vertices, Vector<Vector<int>> &r_nav_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// added to keep track of steps, no functionality right now
+	String bake_state = "";
+
+	bake_state = "Creating heightfield..."; // step #3
+	hf = rcAllocHeightfield();
+
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
+
+	bake_state = "Marking walkable triangles..."; // step #4
+	{
+		Vector<unsigned char> tri_areas;
+		tri_areas.resize(p_ntris);
+
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
+
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
+
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
+	}
+
+	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
+	}
+	if (p_navigation_mesh->get_filter_ledge_spans()) {
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
+	}
+	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
+	}
+
+	bake_state = "Constructing compact heightfield..."; // step #5
+
+	chf = rcAllocCompactHeightfield();
+
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
+
+	rcFreeHeightField(hf);
+	hf = nullptr;
+
+	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+			if (projected_obstruction.carve) {
+				continue;
+			}
+			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+				continue;
+			}
+
+			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
+			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+
+			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+		}
+	}
+
+	bake_state = "Eroding walkable area..."; // step #6
+
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), false);
+
+	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+			if (!projected_obstruction.carve) {
+				continue;
+			}
+			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+				continue;
+			}
+
+			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
+			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+
+			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+		}
+	}
+
+	bake_state = "Partitioning..."; // step #7
+
+	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
+	} else {
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
+	}
+
+	bake_state = "Creating contours..."; // step #8
+
+	cset = rcAllocContourSet();
+
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
+
+	bake_state = "Creating polymesh..."; // step #9
+
+	poly_mesh = rcAllocPolyMesh();
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
+
+	detail_mesh = rcAllocPolyMeshDetail();
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
+
+	rcFreeCompactHeightfield(chf);
+	chf = nullptr;
+	rcFreeContourSet(cset);
+	cset = nullptr;
+
+	bake_state = "Converting to native navigation mesh..."; // step #10
+
+	HashMap<Vector3, int> recast_vertex_to_native_index;
+	LocalVector<int> recast_index_to_native_index;
+	recast_index_to_native_index.resize(detail_mesh->nverts);
+
+	for (int i = 0; i < detail_mesh->nverts; i++) {
+		const float *v = &detail_mesh->verts[i * 3];
+		const Vector3 vertex = Vector3(v[0], v[1], v[2]);
+		int *existing_index_ptr = recast_vertex_to_native_index.getptr(vertex);
+		if (!existing_index_ptr) {
+			int new_index = recast_vertex_to_native_index.size();
+			recast_index_to_native_index[i] = new_index;
+			recast_vertex_to_native_index[vertex] = new_index;
+			r_nav_vertices.push_back(vertex);
+		} else {
+			recast_index_to_native_index[i] = *existing_index_ptr;
+		}
+	}
+
+	for (int i = 0; i < detail_mesh->nmeshes; i++) {
+		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
+		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
+		const unsigned int detail_mesh_m_btris = detail_mesh_m[2];
+		const unsigned int detail_mesh_ntris = detail_mesh_m[3];
+		const unsigned char *detail_mesh_tris = &detail_mesh->tris[detail_mesh_m_btris * 4];
+		for (unsigned int j = 0; j < detail_mesh_ntris; j++) {
+			Vector<int> nav_indices;
+			nav_indices.resize(3);
+			// Polygon order in recast is opposite than godot's
+			int index1 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
+			int index2 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
+			int index3 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
+
+			nav_indices.write[0] = recast_index_to_native_index[index1];
+			nav_indices.write[1] = recast_index_to_native_index[index2];
+			nav_indices.write[2] = recast_index_to_native_index[index3];
+
+			r_nav_polygons.push_back(nav_indices);
+		}
+	}
+
+	bake_state = "Cleanup..."; // step #11
+
+	rcFreePolyMesh(poly_mesh);
+	poly_mesh = nullptr;
+	rcFreePolyMeshDetail(detail_mesh);
+	detail_mesh = nullptr;
+
+	bake_state = "Baking finished."; // step #12
+
+	return true;
+}
+
 void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data) {
 	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
 		return;
@@ -691,13 +890,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
@@ -777,6 +969,12 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiles_from_source_geometry_data(p_navigation_mesh, p_source_geometry_data, cfg);
+		return;
+	}
+	generator_clear_tile_cache(p_navigation_mesh->get_instance_id());
+
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
@@ -791,171 +989,434 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	bake_state = "Creating heightfield..."; // step #3
-	hf = rcAllocHeightfield();
-
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
 
-	bake_state = "Marking walkable triangles..."; // step #4
-	{
-		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+	if (!generator_bake_recast(p_navigation_mesh, cfg, verts, nverts, tris, ntris, projected_obstructions, nav_vertices, nav_polygons)) {
+		return;
+	}
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+}
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+struct NavMeshTileBakeJob3D {
+	Ref<NavigationMesh> navigation_mesh;
+	rcConfig cfg;
+	const float *verts = nullptr;
+	int nverts = 0;
+	LocalVector<int> tris;
+	float min_height = FLT_MAX;
+	float max_height = -FLT_MAX;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
+	uint32_t source_hash = 0;
+	bool baked = false;
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+};
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
-	}
+struct NavMeshTileSeamSplit3D {
+	float weight = 0.0;
+	int index = -1;
 
-	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
-	}
-	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
-	}
-	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+	bool operator<(const NavMeshTileSeamSplit3D &p_other) const {
+		return weight < p_other.weight;
 	}
+};
 
-	bake_state = "Constructing compact heightfield..."; // step #5
+static void generator_bake_tile(void *p_arg) {
+	NavMeshTileBakeJob3D *tile_job = static_cast<NavMeshTileBakeJob3D *>(p_arg);
 
-	chf = rcAllocCompactHeightfield();
+	tile_job->baked = generator_bake_recast(tile_job->navigation_mesh, tile_job->cfg, tile_job->verts, tile_job->nverts, tile_job->tris.ptr(), tile_job->tris.size() / 3, tile_job->projected_obstructions, tile_job->nav_vertices, tile_job->nav_polygons);
+}
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+static void generator_get_tile_bounds(const Vector2i &p_tile, float p_tile_world_size, bool p_clamp, const rcConfig &p_cfg, Vector2 &r_min, Vector2 &r_max) {
+	r_min = Vector2(p_tile.x * p_tile_world_size, p_tile.y * p_tile_world_size);
+	r_max = r_min + Vector2(p_tile_world_size, p_tile_world_size);
+	if (p_clamp) {
+		r_min = Vector2(MAX(r_min.x, p_cfg.bmin[0]), MAX(r_min.y, p_cfg.bmin[2]));
+		r_max = Vector2(MIN(r_max.x, p_cfg.bmax[0]), MIN(r_max.y, p_cfg.bmax[2]));
+	}
+}
 
-	rcFreeHeightField(hf);
-	hf = nullptr;
+void NavMeshGenerator3D::generator_bake_tiles_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const rcConfig &p_cfg) {
+	Vector<float> source_geometry_vertices;
+	Vector<int> source_geometry_indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
 
-	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (projected_obstruction.carve) {
-				continue;
-			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
-				continue;
-			}
+	p_source_geometry_data->get_data(
+			source_geometry_vertices,
+			source_geometry_indices,
+			projected_obstructions);
 
-			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
-			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+	const float *verts = source_geometry_vertices.ptr();
+	const int nverts = source_geometry_vertices.size() / 3;
+	const int *tris = source_geometry_indices.ptr();
+	const int ntris = source_geometry_indices.size() / 3;
 
-			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+	// Tiles are aligned to the world origin and not to the source geometry bounds.
+	// This keeps already baked tiles valid when geometry is added or removed elsewhere.
+	const int tile_cells = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / p_cfg.cs));
+	const float tile_world_size = tile_cells * p_cfg.cs;
+	// Each tile also rasterizes a border of its neighbors so that erosion and region building match across tile edges.
+	const int tile_border = p_cfg.walkableRadius + 3;
+	const float tile_border_size = tile_border * p_cfg.cs;
+	const bool clamp_to_baking_aabb = p_navigation_mesh->get_filter_baking_aabb().has_volume();
+
+	const Vector2i tile_grid_min = Vector2i((int)Math::floor(p_cfg.bmin[0] / tile_world_size), (int)Math::floor(p_cfg.bmin[2] / tile_world_size));
+	const Vector2i tile_grid_max = Vector2i((int)Math::floor(p_cfg.bmax[0] / tile_world_size), (int)Math::floor(p_cfg.bmax[2] / tile_world_size));
+
+	uint32_t settings_hash = hash_murmur3_one_32(tile_cells);
+	settings_hash = hash_murmur3_one_float(p_cfg.cs, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.ch, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.walkableSlopeAngle, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.walkableHeight, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.walkableClimb, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.walkableRadius, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.maxEdgeLen, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.maxSimplificationError, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.minRegionArea, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.mergeRegionArea, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.maxVertsPerPoly, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.detailSampleDist, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.detailSampleMaxError, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(clamp_to_baking_aabb, settings_hash);
+	if (clamp_to_baking_aabb) {
+		for (int i = 0; i < 3; i++) {
+			settings_hash = hash_murmur3_one_float(p_cfg.bmin[i], settings_hash);
+			settings_hash = hash_murmur3_one_float(p_cfg.bmax[i], settings_hash);
+		}
+	}
+	settings_hash = hash_fmix32(settings_hash);
+
+	// Sort the source triangles into every tile that they overlap, including the tile borders.
+	HashMap<Vector2i, NavMeshTileBakeJob3D> tile_jobs;
+
+	for (int i = 0; i < ntris; i++) {
+		const float *v0 = &verts[tris[i * 3 + 0] * 3];
+		const float *v1 = &verts[tris[i * 3 + 1] * 3];
+		const float *v2 = &verts[tris[i * 3 + 2] * 3];
+
+		const float tri_min_x = MIN(v0[0], MIN(v1[0], v2[0])) - tile_border_size;
+		const float tri_max_x = MAX(v0[0], MAX(v1[0], v2[0])) + tile_border_size;
+		const float tri_min_z = MIN(v0[2], MIN(v1[2], v2[2])) - tile_border_size;
+		const float tri_max_z = MAX(v0[2], MAX(v1[2], v2[2])) + tile_border_size;
+		const float tri_min_y = MIN(v0[1], MIN(v1[1], v2[1]));
+		const float tri_max_y = MAX(v0[1], MAX(v1[1], v2[1]));
+
+		const int tile_min_x = MAX(tile_grid_min.x, (int)Math::floor(tri_min_x / tile_world_size));
+		const int tile_max_x = MIN(tile_grid_max.x, (int)Math::floor(tri_max_x / tile_world_size));
+		const int tile_min_z = MAX(tile_grid_min.y, (int)Math::floor(tri_min_z / tile_world_size));
+		const int tile_max_z = MIN(tile_grid_max.y, (int)Math::floor(tri_max_z / tile_world_size));
+
+		for (int tile_z = tile_min_z; tile_z <= tile_max_z; tile_z++) {
+			for (int tile_x = tile_min_x; tile_x <= tile_max_x; tile_x++) {
+				NavMeshTileBakeJob3D &tile_job = tile_jobs[Vector2i(tile_x, tile_z)];
+				tile_job.tris.push_back(tris[i * 3 + 0]);
+				tile_job.tris.push_back(tris[i * 3 + 1]);
+				tile_job.tris.push_back(tris[i * 3 + 2]);
+				tile_job.min_height = MIN(tile_job.min_height, tri_min_y);
+				tile_job.max_height = MAX(tile_job.max_height, tri_max_y);
+			}
 		}
 	}
 
-	bake_state = "Eroding walkable area..."; // step #6
+	for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+		if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+			continue;
+		}
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+		Vector2 obstruction_min = Vector2(FLT_MAX, FLT_MAX);
+		Vector2 obstruction_max = Vector2(-FLT_MAX, -FLT_MAX);
+		for (int i = 0; i < projected_obstruction.vertices.size(); i += 3) {
+			obstruction_min = obstruction_min.min(Vector2(projected_obstruction.vertices[i], projected_obstruction.vertices[i + 2]));
+			obstruction_max = obstruction_max.max(Vector2(projected_obstruction.vertices[i], projected_obstruction.vertices[i + 2]));
+		}
 
-	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
-			if (!projected_obstruction.carve) {
-				continue;
-			}
-			if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
-				continue;
-			}
+		const int tile_min_x = MAX(tile_grid_min.x, (int)Math::floor((obstruction_min.x - tile_border_size) / tile_world_size));
+		const int tile_max_x = MIN(tile_grid_max.x, (int)Math::floor((obstruction_max.x + tile_border_size) / tile_world_size));
+		const int tile_min_z = MAX(tile_grid_min.y, (int)Math::floor((obstruction_min.y - tile_border_size) / tile_world_size));
+		const int tile_max_z = MIN(tile_grid_max.y, (int)Math::floor((obstruction_max.y + tile_border_size) / tile_world_size));
 
-			const float *projected_obstruction_verts = projected_obstruction.vertices.ptr();
-			const int projected_obstruction_nverts = projected_obstruction.vertices.size() / 3;
+		for (int tile_z = tile_min_z; tile_z <= tile_max_z; tile_z++) {
+			for (int tile_x = tile_min_x; tile_x <= tile_max_x; tile_x++) {
+				NavMeshTileBakeJob3D *tile_job = tile_jobs.getptr(Vector2i(tile_x, tile_z));
+				if (tile_job) {
+					tile_job->projected_obstructions.push_back(projected_obstruction);
+				}
+			}
+		}
+	}
 
-			rcMarkConvexPolyArea(&ctx, projected_obstruction_verts, projected_obstruction_nverts, projected_obstruction.elevation, projected_obstruction.elevation + projected_obstruction.height, RC_NULL_AREA, *chf);
+	NavMeshTileCache3D *tile_cache = nullptr;
+	{
+		MutexLock tile_cache_lock(tile_cache_mutex);
+		NavMeshTileCache3D **tile_cache_ptr = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+		if (tile_cache_ptr) {
+			tile_cache = *tile_cache_ptr;
+		} else {
+			tile_cache = memnew(NavMeshTileCache3D);
+			tile_caches.insert(p_navigation_mesh->get_instance_id(), tile_cache);
 		}
 	}
 
-	bake_state = "Partitioning..."; // step #7
+	if (tile_cache->settings_hash != settings_hash) {
+		tile_cache->tiles.clear();
+		tile_cache->settings_hash = settings_hash;
+	}
 
-	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
-	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
-	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+	LocalVector<Vector2i> removed_tiles;
+	for (const KeyValue<Vector2i, NavMeshTile3D> &E : tile_cache->tiles) {
+		if (!tile_jobs.has(E.key)) {
+			removed_tiles.push_back(E.key);
+		}
+	}
+	for (const Vector2i &removed_tile : removed_tiles) {
+		tile_cache->tiles.erase(removed_tile);
 	}
 
-	bake_state = "Creating contours..."; // step #8
+	// Only tiles whose source geometry or obstructions changed since the last bake need to run through Recast again.
+	LocalVector<NavMeshTileBakeJob3D *> dirty_tile_jobs;
 
-	cset = rcAllocContourSet();
+	for (KeyValue<Vector2i, NavMeshTileBakeJob3D> &E : tile_jobs) {
+		NavMeshTileBakeJob3D &tile_job = E.value;
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+		uint32_t source_hash = hash_murmur3_one_32(tile_job.tris.size());
+		for (const int &index : tile_job.tris) {
+			const float *v = &verts[index * 3];
+			source_hash = hash_murmur3_one_float(v[0], source_hash);
+			source_hash = hash_murmur3_one_float(v[1], source_hash);
+			source_hash = hash_murmur3_one_float(v[2], source_hash);
+		}
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : tile_job.projected_obstructions) {
+			source_hash = hash_murmur3_buffer(projected_obstruction.vertices.ptr(), projected_obstruction.vertices.size() * sizeof(float), source_hash);
+			source_hash = hash_murmur3_one_float(projected_obstruction.elevation, source_hash);
+			source_hash = hash_murmur3_one_float(projected_obstruction.height, source_hash);
+			source_hash = hash_murmur3_one_32(projected_obstruction.carve, source_hash);
+		}
+		tile_job.source_hash = hash_fmix32(source_hash);
 
-	bake_state = "Creating polymesh..."; // step #9
+		const NavMeshTile3D *cached_tile = tile_cache->tiles.getptr(E.key);
+		if (cached_tile && cached_tile->source_hash == tile_job.source_hash) {
+			continue;
+		}
 
-	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+		Vector2 tile_min;
+		Vector2 tile_max;
+		generator_get_tile_bounds(E.key, tile_world_size, clamp_to_baking_aabb, p_cfg, tile_min, tile_max);
+		if (tile_max.x <= tile_min.x || tile_max.y <= tile_min.y) {
+			continue;
+		}
 
-	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+		tile_job.navigation_mesh = p_navigation_mesh;
+		tile_job.cfg = p_cfg;
+		tile_job.cfg.borderSize = tile_border;
+		tile_job.cfg.bmin[0] = tile_min.x - tile_border_size;
+		tile_job.cfg.bmin[2] = tile_min.y - tile_border_size;
+		tile_job.cfg.bmax[0] = tile_max.x + tile_border_size;
+		tile_job.cfg.bmax[2] = tile_max.y + tile_border_size;
+		if (!clamp_to_baking_aabb) {
+			// Snapped to cell_height so that span heights are quantized the same way in neighboring tiles.
+			tile_job.cfg.bmin[1] = Math::floor(tile_job.min_height / p_cfg.ch) * p_cfg.ch;
+			tile_job.cfg.bmax[1] = tile_job.max_height;
+		}
+		rcCalcGridSize(tile_job.cfg.bmin, tile_job.cfg.bmax, tile_job.cfg.cs, &tile_job.cfg.width, &tile_job.cfg.height);
+		tile_job.verts = verts;
+		tile_job.nverts = nverts;
 
-	rcFreeCompactHeightfield(chf);
-	chf = nullptr;
-	rcFreeContourSet(cset);
-	cset = nullptr;
+		dirty_tile_jobs.push_back(&tile_job);
+	}
 
-	bake_state = "Converting to native navigation mesh..."; // step #10
+	if (use_threads && dirty_tile_jobs.size() > 1) {
+		// Tiles are added as individual tasks instead of a group task so that
+		// an async bake that is already running on a worker thread can wait for them collaboratively.
+		LocalVector<WorkerThreadPool::TaskID> tile_task_ids;
+		tile_task_ids.reserve(dirty_tile_jobs.size());
+		for (NavMeshTileBakeJob3D *tile_job : dirty_tile_jobs) {
+			tile_task_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(&generator_bake_tile, tile_job, NavMeshGenerator3D::baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTile3D")));
+		}
+		for (WorkerThreadPool::TaskID tile_task_id : tile_task_ids) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(tile_task_id);
+		}
+	} else {
+		for (NavMeshTileBakeJob3D *tile_job : dirty_tile_jobs) {
+			generator_bake_tile(tile_job);
+		}
+	}
+
+	for (const KeyValue<Vector2i, NavMeshTileBakeJob3D> &E : tile_jobs) {
+		const NavMeshTileBakeJob3D &tile_job = E.value;
+		if (tile_job.navigation_mesh.is_null()) {
+			// Reused from the cache or outside of the baking bounds.
+			continue;
+		}
+		if (!tile_job.baked) {
+			tile_cache->tiles.erase(E.key);
+			continue;
+		}
+		NavMeshTile3D &tile = tile_cache->tiles[E.key];
+		tile.source_hash = tile_job.source_hash;
+		tile.vertices = tile_job.nav_vertices;
+		tile.polygons = tile_job.nav_polygons;
+	}
+
+	// Stitch the tiles into a single navigation mesh.
+	// Vertices on a tile edge are snapped to the edge and shared with the neighbor tile.
+	// Polygon edges on a tile edge are split at the neighbor's vertices so that the navigation region can merge them.
+	LocalVector<Vector2i> tile_coords;
+	tile_coords.reserve(tile_cache->tiles.size());
+	for (const KeyValue<Vector2i, NavMeshTile3D> &E : tile_cache->tiles) {
+		tile_coords.push_back(E.key);
+	}
+	tile_coords.sort();
+
+	const float snap_distance = p_cfg.cs * 0.1;
+	const Vector3 vertex_quantize = Vector3(1.0 / (p_cfg.cs * 0.1), 1.0 / (p_cfg.ch * 0.5), 1.0 / (p_cfg.cs * 0.1));
+	const float seam_max_height_difference = (p_cfg.walkableClimb + 1) * p_cfg.ch;
 
 	Vector<Vector3> nav_vertices;
-	Vector<Vector<int>> nav_polygons;
+	LocalVector<Vector2i> nav_vertex_seams;
+	HashMap<Vector3i, int> quantized_vertex_to_native_index;
+	// Keyed by the tile edge index and the tile index along the edge.
+	HashMap<Vector2i, LocalVector<int>> x_seam_vertices;
+	HashMap<Vector2i, LocalVector<int>> z_seam_vertices;
+	LocalVector<LocalVector<int>> tile_polygons;
+	LocalVector<Vector2i> tile_polygon_coords;
+
+	for (const Vector2i &tile_coord : tile_coords) {
+		const NavMeshTile3D &tile = tile_cache->tiles[tile_coord];
+
+		Vector2 tile_min;
+		Vector2 tile_max;
+		generator_get_tile_bounds(tile_coord, tile_world_size, clamp_to_baking_aabb, p_cfg, tile_min, tile_max);
+
+		LocalVector<int> tile_index_to_native_index;
+		tile_index_to_native_index.resize(tile.vertices.size());
+
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			Vector3 vertex = tile.vertices[i];
+			Vector2i seam = Vector2i(INT32_MIN, INT32_MIN);
+			if (Math::abs(vertex.x - tile_min.x) <= snap_distance) {
+				vertex.x = tile_min.x;
+				seam.x = tile_coord.x;
+			} else if (Math::abs(vertex.x - tile_max.x) <= snap_distance) {
+				vertex.x = tile_max.x;
+				seam.x = tile_coord.x + 1;
+			}
+			if (Math::abs(vertex.z - tile_min.y) <= snap_distance) {
+				vertex.z = tile_min.y;
+				seam.y = tile_coord.y;
+			} else if (Math::abs(vertex.z - tile_max.y) <= snap_distance) {
+				vertex.z = tile_max.y;
+				seam.y = tile_coord.y + 1;
+			}
 
-	HashMap<Vector3, int> recast_vertex_to_native_index;
-	LocalVector<int> recast_index_to_native_index;
-	recast_index_to_native_index.resize(detail_mesh->nverts);
+			const Vector3i quantized_vertex = Vector3i((int)Math::round(vertex.x * vertex_quantize.x), (int)Math::round(vertex.y * vertex_quantize.y), (int)Math::round(vertex.z * vertex_quantize.z));
+			int *existing_index_ptr = quantized_vertex_to_native_index.getptr(quantized_vertex);
+			if (existing_index_ptr) {
+				tile_index_to_native_index[i] = *existing_index_ptr;
+				continue;
+			}
 
-	for (int i = 0; i < detail_mesh->nverts; i++) {
-		const float *v = &detail_mesh->verts[i * 3];
-		const Vector3 vertex = Vector3(v[0], v[1], v[2]);
-		int *existing_index_ptr = recast_vertex_to_native_index.getptr(vertex);
-		if (!existing_index_ptr) {
-			int new_index = recast_vertex_to_native_index.size();
-			recast_index_to_native_index[i] = new_index;
-			recast_vertex_to_native_index[vertex] = new_index;
+			const int new_index = nav_vertices.size();
+			tile_index_to_native_index[i] = new_index;
+			quantized_vertex_to_native_index.insert(quantized_vertex, new_index);
 			nav_vertices.push_back(vertex);
-		} else {
-			recast_index_to_native_index[i] = *existing_index_ptr;
+			nav_vertex_seams.push_back(seam);
+			if (seam.x != INT32_MIN) {
+				x_seam_vertices[Vector2i(seam.x, tile_coord.y)].push_back(new_index);
+			}
+			if (seam.y != INT32_MIN) {
+				z_seam_vertices[Vector2i(seam.y, tile_coord.x)].push_back(new_index);
+			}
+		}
+
+		for (const Vector<int> &polygon : tile.polygons) {
+			LocalVector<int> native_polygon;
+			native_polygon.resize(polygon.size());
+			for (int i = 0; i < polygon.size(); i++) {
+				native_polygon[i] = tile_index_to_native_index[polygon[i]];
+			}
+			tile_polygons.push_back(native_polygon);
+			tile_polygon_coords.push_back(tile_coord);
 		}
 	}
 
-	for (int i = 0; i < detail_mesh->nmeshes; i++) {
-		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
-		const unsigned int detail_mesh_bverts = detail_mesh_m[0];
-		const unsigned int detail_mesh_m_btris = detail_mesh_m[2];
-		const unsigned int detail_mesh_ntris = detail_mesh_m[3];
-		const unsigned char *detail_mesh_tris = &detail_mesh->tris[detail_mesh_m_btris * 4];
-		for (unsigned int j = 0; j < detail_mesh_ntris; j++) {
-			Vector<int> nav_indices;
-			nav_indices.resize(3);
-			// Polygon order in recast is opposite than godot's
-			int index1 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
-			int index2 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
-			int index3 = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
+	const Vector3 *nav_vertices_ptr = nav_vertices.ptr();
 
-			nav_indices.write[0] = recast_index_to_native_index[index1];
-			nav_indices.write[1] = recast_index_to_native_index[index2];
-			nav_indices.write[2] = recast_index_to_native_index[index3];
+	Vector<Vector<int>> nav_polygons;
+	nav_polygons.resize(tile_polygons.size());
+
+	LocalVector<NavMeshTileSeamSplit3D> seam_splits;
+
+	for (uint32_t polygon_index = 0; polygon_index < tile_polygons.size(); polygon_index++) {
+		const LocalVector<int> &polygon = tile_polygons[polygon_index];
+		const Vector2i &tile_coord = tile_polygon_coords[polygon_index];
+		Vector<int> &nav_polygon = nav_polygons.write[polygon_index];
+
+		for (uint32_t i = 0; i < polygon.size(); i++) {
+			const int index_a = polygon[i];
+			const int index_b = polygon[(i + 1) % polygon.size()];
+			nav_polygon.push_back(index_a);
+
+			const Vector2i &seam_a = nav_vertex_seams[index_a];
+			const Vector2i &seam_b = nav_vertex_seams[index_b];
+
+			const LocalVector<int> *seam_vertices = nullptr;
+			int seam_axis = 0;
+			if (seam_a.x != INT32_MIN && seam_a.x == seam_b.x) {
+				seam_vertices = x_seam_vertices.getptr(Vector2i(seam_a.x, tile_coord.y));
+				seam_axis = Vector3::AXIS_Z;
+			} else if (seam_a.y != INT32_MIN && seam_a.y == seam_b.y) {
+				seam_vertices = z_seam_vertices.getptr(Vector2i(seam_a.y, tile_coord.x));
+				seam_axis = Vector3::AXIS_X;
+			}
+			if (!seam_vertices) {
+				continue;
+			}
 
-			nav_polygons.push_back(nav_indices);
+			const Vector3 &vertex_a = nav_vertices_ptr[index_a];
+			const Vector3 &vertex_b = nav_vertices_ptr[index_b];
+			const float edge_length = vertex_b[seam_axis] - vertex_a[seam_axis];
+			if (edge_length == 0.0) {
+				continue;
+			}
+
+			seam_splits.clear();
+			for (const int &seam_vertex_index : *seam_vertices) {
+				if (seam_vertex_index == index_a || seam_vertex_index == index_b) {
+					continue;
+				}
+				const Vector3 &seam_vertex = nav_vertices_ptr[seam_vertex_index];
+				const float weight = (seam_vertex[seam_axis] - vertex_a[seam_axis]) / edge_length;
+				if (weight <= 0.0 || weight >= 1.0) {
+					continue;
+				}
+				if (Math::abs(Math::lerp(vertex_a.y, vertex_b.y, weight) - seam_vertex.y) > seam_max_height_difference) {
+					continue;
+				}
+				seam_splits.push_back({ weight, seam_vertex_index });
+			}
+			seam_splits.sort();
+			for (const NavMeshTileSeamSplit3D &seam_split : seam_splits) {
+				nav_polygon.push_back(seam_split.index);
+			}
 		}
 	}
 
 	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+}
 
-	bake_state = "Cleanup..."; // step #11
-
-	rcFreePolyMesh(poly_mesh);
-	poly_mesh = nullptr;
-	rcFreePolyMeshDetail(detail_mesh);
-	detail_mesh = nullptr;
-
-	bake_state = "Baking finished."; // step #12
+void NavMeshGenerator3D::generator_clear_tile_cache(ObjectID p_navigation_mesh_id) {
+	MutexLock tile_cache_lock(tile_cache_mutex);
+	NavMeshTileCache3D **tile_cache_ptr = tile_caches.getptr(p_navigation_mesh_id);
+	if (tile_cache_ptr) {
+		memdelete(*tile_cache_ptr);
+		tile_caches.erase(p_navigation_mesh_id);
+	}
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
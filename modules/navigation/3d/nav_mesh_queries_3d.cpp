@@ -129,7 +129,7 @@ Vector3 NavMeshQueries3D::polygons_get_random_point(const LocalVector<gd::Polygo
 	}
 }
 
-Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size) {
+Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygon> &p_polygons, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up, uint32_t p_link_polygons_size, const LocalVector<gd::Cluster> *p_clusters, gd::PathSearchArena *r_arena) {
 	// Clear metadata outputs.
 	if (r_path_types) {
 		r_path_types->clear();
@@ -207,9 +207,14 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 		return path;
 	}
 
+	// Without a caller provided arena, the search state only lives for this query.
+	gd::PathSearchArena local_arena;
+	gd::PathSearchArena &arena = r_arena ? *r_arena : local_arena;
+	arena.begin(p_polygons.size() + p_link_polygons_size);
+
 	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.resize(p_polygons.size() + p_link_polygons_size);
+	LocalVector<gd::NavigationPoly> &navigation_polys = arena.navigation_polys;
+	LocalVector<uint32_t> &touched_polys = arena.touched_polys;
 
 	// Initialize the matching navigation polygon.
 	gd::NavigationPoly &begin_navigation_poly = navigation_polys[begin_poly->id];
@@ -217,12 +222,21 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
+	touched_polys.push_back(begin_poly->id);
 
 	// Heap of polygons to travel next.
-	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer>
-			traversable_polys;
+	gd::Heap<gd::NavigationPoly *, gd::NavPolyTravelCostGreaterThan, gd::NavPolyHeapIndexer> &traversable_polys = arena.traversable_polys;
 	traversable_polys.reserve(p_polygons.size() * 0.25);
 
+	// With a hierarchical graph, first find the clusters a route passes through
+	// and only search the polygons inside that corridor. The polygons of a
+	// cluster are connected to each other, so the corridor always holds a route.
+	const LocalVector<gd::NavigationCluster> &navigation_clusters = arena.navigation_clusters;
+	bool use_corridor = false;
+	if (p_clusters && begin_poly->cluster != end_poly->cluster && begin_poly->cluster < p_clusters->size() && end_poly->cluster < p_clusters->size()) {
+		use_corridor = clusters_mark_corridor(*p_clusters, begin_poly->cluster, end_poly->cluster, begin_point, end_point, p_navigation_layers, arena);
+	}
+
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = begin_poly->id;
 	int prev_least_cost_id = -1;
@@ -244,6 +258,11 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 					continue;
 				}
 
+				// Stay inside the corridor of clusters found by the hierarchical search.
+				if (use_corridor && (connection.polygon->cluster >= navigation_clusters.size() || !navigation_clusters[connection.polygon->cluster].in_corridor)) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -289,6 +308,7 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 							new_entry.distance_to(end_point) *
 							neighbor_poly.poly->owner->get_travel_cost();
 					neighbor_poly.entry = new_entry;
+					touched_polys.push_back(connection.polygon->id);
 
 					// Add the polygon to the heap of polygons to traverse next.
 					traversable_polys.push(&neighbor_poly);
@@ -360,8 +380,8 @@ Vector<Vector3> NavMeshQueries3D::polygons_get_path(const LocalVector<gd::Polygo
 				return path;
 			}
 
-			for (gd::NavigationPoly &nav_poly : navigation_polys) {
-				nav_poly.poly = nullptr;
+			for (uint32_t id : touched_polys) {
+				navigation_polys[id].poly = nullptr;
 			}
 			navigation_polys[begin_poly->id].poly = begin_poly;
 
@@ -680,6 +700,81 @@ RID NavMeshQueries3D::polygons_get_closest_point_owner(const LocalVector<gd::Pol
 	return cp.owner;
 }
 
+bool NavMeshQueries3D::clusters_mark_corridor(const LocalVector<gd::Cluster> &p_clusters, uint32_t p_begin_cluster, uint32_t p_end_cluster, const Vector3 &p_begin_point, const Vector3 &p_end_point, uint32_t p_navigation_layers, gd::PathSearchArena &r_arena) {
+	r_arena.begin_clusters(p_clusters.size());
+
+	LocalVector<gd::NavigationCluster> &navigation_clusters = r_arena.navigation_clusters;
+	LocalVector<uint32_t> &touched_clusters = r_arena.touched_clusters;
+	gd::Heap<gd::NavigationCluster *, gd::NavClusterTravelCostGreaterThan, gd::NavClusterHeapIndexer> &traversable_clusters = r_arena.traversable_clusters;
+
+	gd::NavigationCluster &begin_navigation_cluster = navigation_clusters[p_begin_cluster];
+	begin_navigation_cluster.cluster = &p_clusters[p_begin_cluster];
+	begin_navigation_cluster.entry = p_begin_point;
+	begin_navigation_cluster.distance_to_destination = p_begin_point.distance_to(p_end_point);
+	touched_clusters.push_back(p_begin_cluster);
+	traversable_clusters.push(&begin_navigation_cluster);
+
+	// A* over the cluster graph, entering each cluster through the portal it was reached by.
+	while (!traversable_clusters.is_empty()) {
+		const gd::NavigationCluster *least_cost_cluster = traversable_clusters.pop();
+		const uint32_t least_cost_id = least_cost_cluster->cluster - p_clusters.ptr();
+
+		if (least_cost_id == p_end_cluster) {
+			// Mark the clusters of the route, walking it backwards.
+			for (uint32_t id = least_cost_id; id != UINT32_MAX; id = navigation_clusters[id].back_cluster) {
+				navigation_clusters[id].in_corridor = true;
+			}
+
+			// The route between portal positions only approximates the polygon path,
+			// widen the corridor with the neighbors of its clusters so the polygon
+			// search can still take the shortest way through them.
+			for (uint32_t id = least_cost_id; id != UINT32_MAX; id = navigation_clusters[id].back_cluster) {
+				for (const gd::Cluster::Portal &portal : p_clusters[id].portals) {
+					gd::NavigationCluster &neighbor_cluster = navigation_clusters[portal.cluster];
+					if (neighbor_cluster.cluster == nullptr) {
+						neighbor_cluster.cluster = &p_clusters[portal.cluster];
+						touched_clusters.push_back(portal.cluster);
+					}
+					neighbor_cluster.in_corridor = true;
+				}
+			}
+			return true;
+		}
+
+		const real_t travel_cost = least_cost_cluster->cluster->owner->get_travel_cost();
+		for (const gd::Cluster::Portal &portal : least_cost_cluster->cluster->portals) {
+			const gd::Cluster &neighbor = p_clusters[portal.cluster];
+			if (neighbor.owner == nullptr || (p_navigation_layers & neighbor.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			const real_t new_traveled_distance = least_cost_cluster->entry.distance_to(portal.position) * travel_cost + least_cost_cluster->traveled_distance;
+
+			gd::NavigationCluster &neighbor_cluster = navigation_clusters[portal.cluster];
+			if (neighbor_cluster.cluster != nullptr) {
+				if (neighbor_cluster.traversable_cluster_index < traversable_clusters.size() &&
+						new_traveled_distance < neighbor_cluster.traveled_distance) {
+					neighbor_cluster.back_cluster = least_cost_id;
+					neighbor_cluster.traveled_distance = new_traveled_distance;
+					neighbor_cluster.distance_to_destination = portal.position.distance_to(p_end_point) * neighbor.owner->get_travel_cost();
+					neighbor_cluster.entry = portal.position;
+					traversable_clusters.shift(neighbor_cluster.traversable_cluster_index);
+				}
+			} else {
+				neighbor_cluster.cluster = &neighbor;
+				neighbor_cluster.back_cluster = least_cost_id;
+				neighbor_cluster.traveled_distance = new_traveled_distance;
+				neighbor_cluster.distance_to_destination = portal.position.distance_to(p_end_point) * neighbor.owner->get_travel_cost();
+				neighbor_cluster.entry = portal.position;
+				touched_clusters.push_back(portal.cluster);
+				traversable_clusters.push(&neighbor_cluster);
+			}
+		}
+	}
+
+	return false;
+}
+
 void NavMeshQueries3D::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, const Vector3 &p_map_up) {
 	Vector3 from = path[path.size() - 1];
 
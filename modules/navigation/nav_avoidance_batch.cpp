@@ -0,0 +1,773 @@
+/**************************************************************************/
+/*  nav_avoidance_batch.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_avoidance_batch.h"
+
+#include "nav_agent.h"
+
+// Same tolerance as the RVO2 library, so both avoidance paths agree on (almost) parallel constraints.
+#define ORCA_EPSILON 0.00001f
+
+// Constraint buffers of the worker threads, reused between agents and steps.
+static thread_local LocalVector<NavAvoidanceBatch::OrcaLine> orca_lines;
+static thread_local LocalVector<NavAvoidanceBatch::OrcaLine> orca_projected_lines;
+static thread_local LocalVector<NavAvoidanceBatch::OrcaPlane> orca_planes;
+static thread_local LocalVector<NavAvoidanceBatch::OrcaPlane> orca_projected_planes;
+
+void NavAvoidanceBatch::update(const LocalVector<NavAgent *> &p_agents, float p_time_step) {
+	time_step = p_time_step;
+
+	bool agents_changed = agents.size() != p_agents.size();
+	for (uint32_t i = 0; i < p_agents.size() && !agents_changed; i++) {
+		agents_changed = agents[i] != p_agents[i];
+	}
+
+	const uint32_t agent_count = p_agents.size();
+	if (agents_changed) {
+		agents = p_agents;
+		position_x.resize(agent_count);
+		position_y.resize(agent_count);
+		position_z.resize(agent_count);
+		velocity_x.resize(agent_count);
+		velocity_y.resize(agent_count);
+		velocity_z.resize(agent_count);
+		radius.resize(agent_count);
+		height.resize(agent_count);
+		time_horizon.resize(agent_count);
+		neighbor_distance.resize(agent_count);
+		max_neighbors.resize(agent_count);
+		avoidance_layers.resize(agent_count);
+		avoidance_mask.resize(agent_count);
+		avoidance_priority.resize(agent_count);
+		neighbor_offsets.resize(agent_count);
+	}
+
+	uint32_t neighbor_slot_count = 0;
+	for (uint32_t i = 0; i < agent_count; i++) {
+		NavAgent *agent = agents[i];
+		if (use_3d_avoidance) {
+			const RVO3D::Agent3D *rvo_agent = agent->get_rvo_agent_3d();
+			position_x[i] = rvo_agent->position_.x();
+			position_y[i] = rvo_agent->position_.y();
+			position_z[i] = rvo_agent->position_.z();
+			velocity_x[i] = rvo_agent->velocity_.x();
+			velocity_y[i] = rvo_agent->velocity_.y();
+			velocity_z[i] = rvo_agent->velocity_.z();
+			radius[i] = rvo_agent->radius_;
+			height[i] = rvo_agent->height_;
+			time_horizon[i] = rvo_agent->timeHorizon_;
+			neighbor_distance[i] = rvo_agent->neighborDist_;
+			max_neighbors[i] = rvo_agent->maxNeighbors_;
+			avoidance_layers[i] = rvo_agent->avoidance_layers_;
+			avoidance_mask[i] = rvo_agent->avoidance_mask_;
+			avoidance_priority[i] = rvo_agent->avoidance_priority_;
+		} else {
+			const RVO2D::Agent2D *rvo_agent = agent->get_rvo_agent_2d();
+			position_x[i] = rvo_agent->position_.x();
+			position_y[i] = rvo_agent->elevation_;
+			position_z[i] = rvo_agent->position_.y();
+			velocity_x[i] = rvo_agent->velocity_.x();
+			velocity_y[i] = 0.0;
+			velocity_z[i] = rvo_agent->velocity_.y();
+			radius[i] = rvo_agent->radius_;
+			height[i] = rvo_agent->height_;
+			time_horizon[i] = rvo_agent->timeHorizon_;
+			neighbor_distance[i] = rvo_agent->neighborDist_;
+			max_neighbors[i] = rvo_agent->maxNeighbors_;
+			avoidance_layers[i] = rvo_agent->avoidance_layers_;
+			avoidance_mask[i] = rvo_agent->avoidance_mask_;
+			avoidance_priority[i] = rvo_agent->avoidance_priority_;
+		}
+		neighbor_offsets[i] = neighbor_slot_count;
+		neighbor_slot_count += max_neighbors[i];
+	}
+	neighbor_indices.resize(neighbor_slot_count);
+	neighbor_distances_sq.resize(neighbor_slot_count);
+
+	if (agents_changed) {
+		_rebuild_grid();
+	} else {
+		_update_grid();
+	}
+}
+
+void NavAvoidanceBatch::_rebuild_grid() {
+	// The cell size only affects how many cells a query visits, not which neighbors are found.
+	float neighbor_distance_sum = 0.0;
+	uint32_t neighbor_distance_count = 0;
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		if (neighbor_distance[i] > 0.0) {
+			neighbor_distance_sum += neighbor_distance[i];
+			neighbor_distance_count++;
+		}
+	}
+	cell_size = neighbor_distance_count > 0 ? MAX(neighbor_distance_sum / neighbor_distance_count, 0.1f) : 1.0f;
+	inv_cell_size = 1.0f / cell_size;
+
+	cells.clear();
+	agent_cells.resize(agents.size());
+
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		const Vector2i cell = _get_cell(position_x[i], position_z[i]);
+		agent_cells[i] = cell;
+		cells[cell].push_back(i);
+	}
+}
+
+void NavAvoidanceBatch::_update_grid() {
+	for (uint32_t i = 0; i < agents.size(); i++) {
+		const Vector2i cell = _get_cell(position_x[i], position_z[i]);
+		if (cell == agent_cells[i]) {
+			continue;
+		}
+		_remove_from_cell(i, agent_cells[i]);
+		cells[cell].push_back(i);
+		agent_cells[i] = cell;
+	}
+}
+
+void NavAvoidanceBatch::_remove_from_cell(uint32_t p_index, const Vector2i &p_cell) {
+	LocalVector<uint32_t> *cell_agents = cells.getptr(p_cell);
+	ERR_FAIL_NULL(cell_agents);
+
+	int64_t cell_agent_index = cell_agents->find(p_index);
+	if (cell_agent_index >= 0) {
+		cell_agents->remove_at_unordered(cell_agent_index);
+	}
+	if (cell_agents->is_empty()) {
+		cells.erase(p_cell);
+	}
+}
+
+void NavAvoidanceBatch::_add_cell_neighbors(uint32_t p_index, const LocalVector<uint32_t> &p_cell_agents, uint32_t &r_neighbor_count, float &r_range_sq) {
+	const float *positions_x = position_x.ptr();
+	const float *positions_y = position_y.ptr();
+	const float *positions_z = position_z.ptr();
+	const float *heights = height.ptr();
+	const uint32_t *layers = avoidance_layers.ptr();
+	const float *priorities = avoidance_priority.ptr();
+
+	const float x = positions_x[p_index];
+	const float y = positions_y[p_index];
+	const float z = positions_z[p_index];
+	const float agent_height = heights[p_index];
+	const uint32_t mask = avoidance_mask[p_index];
+	const float priority = priorities[p_index];
+	const uint32_t agent_max_neighbors = max_neighbors[p_index];
+
+	uint32_t *indices = neighbor_indices.ptr() + neighbor_offsets[p_index];
+	float *distances_sq = neighbor_distances_sq.ptr() + neighbor_offsets[p_index];
+
+	// Same rules as the RVO2 agent neighbor query: the closest agents are kept sorted by distance,
+	// and once the list is full only agents closer than the last one are considered.
+	for (const uint32_t &other : p_cell_agents) {
+		const float dx = positions_x[other] - x;
+		const float dz = positions_z[other] - z;
+		float distance_sq = dx * dx + dz * dz;
+		if (use_3d_avoidance) {
+			const float dy = positions_y[other] - y;
+			distance_sq += dy * dy;
+		} else if (y > positions_y[other] + heights[other] || y + agent_height < positions_y[other]) {
+			continue;
+		}
+		if (distance_sq >= r_range_sq || other == p_index) {
+			continue;
+		}
+		if ((mask & layers[other]) == 0 || priority > priorities[other]) {
+			continue;
+		}
+
+		uint32_t slot = r_neighbor_count < agent_max_neighbors ? r_neighbor_count++ : r_neighbor_count - 1;
+		while (slot != 0 && distance_sq < distances_sq[slot - 1]) {
+			indices[slot] = indices[slot - 1];
+			distances_sq[slot] = distances_sq[slot - 1];
+			slot--;
+		}
+		indices[slot] = other;
+		distances_sq[slot] = distance_sq;
+
+		if (r_neighbor_count == agent_max_neighbors) {
+			r_range_sq = distances_sq[r_neighbor_count - 1];
+		}
+	}
+}
+
+uint32_t NavAvoidanceBatch::_compute_agent_neighbors(uint32_t p_index) {
+	if (max_neighbors[p_index] == 0) {
+		return 0;
+	}
+
+	uint32_t neighbor_count = 0;
+	const float agent_neighbor_distance = neighbor_distance[p_index];
+	float range_sq = agent_neighbor_distance * agent_neighbor_distance;
+
+	const float x = position_x[p_index];
+	const float z = position_z[p_index];
+	const Vector2i min_cell = _get_cell(x - agent_neighbor_distance, z - agent_neighbor_distance);
+	const Vector2i max_cell = _get_cell(x + agent_neighbor_distance, z + agent_neighbor_distance);
+
+	const int64_t range_cell_count = int64_t(max_cell.x - min_cell.x + 1) * int64_t(max_cell.y - min_cell.y + 1);
+	if (range_cell_count > (int64_t)cells.size()) {
+		// Cheaper to visit every occupied cell than every cell in range.
+		for (const KeyValue<Vector2i, LocalVector<uint32_t>> &E : cells) {
+			_add_cell_neighbors(p_index, E.value, neighbor_count, range_sq);
+		}
+		return neighbor_count;
+	}
+
+	// The own cell first, so the range shrinks early once the neighbor list is full.
+	const Vector2i agent_cell = agent_cells[p_index];
+	const LocalVector<uint32_t> *agent_cell_agents = cells.getptr(agent_cell);
+	ERR_FAIL_NULL_V(agent_cell_agents, 0);
+	_add_cell_neighbors(p_index, *agent_cell_agents, neighbor_count, range_sq);
+
+	for (int cell_z = min_cell.y; cell_z <= max_cell.y; cell_z++) {
+		const float cell_distance_z = MAX(MAX(cell_z * cell_size - z, z - (cell_z + 1) * cell_size), 0.0f);
+		for (int cell_x = min_cell.x; cell_x <= max_cell.x; cell_x++) {
+			const float cell_distance_x = MAX(MAX(cell_x * cell_size - x, x - (cell_x + 1) * cell_size), 0.0f);
+			if (cell_distance_x * cell_distance_x + cell_distance_z * cell_distance_z >= range_sq) {
+				// No agent in this cell is closer than the current range.
+				continue;
+			}
+			if (cell_x == agent_cell.x && cell_z == agent_cell.y) {
+				continue;
+			}
+			const LocalVector<uint32_t> *cell_agents = cells.getptr(Vector2i(cell_x, cell_z));
+			if (cell_agents) {
+				_add_cell_neighbors(p_index, *cell_agents, neighbor_count, range_sq);
+			}
+		}
+	}
+	return neighbor_count;
+}
+
+void NavAvoidanceBatch::_add_agent_lines(uint32_t p_index, uint32_t p_neighbor_count, LocalVector<OrcaLine> &r_lines) const {
+	const uint32_t *neighbors = neighbor_indices.ptr() + neighbor_offsets[p_index];
+	const float *positions_x = position_x.ptr();
+	const float *positions_z = position_z.ptr();
+	const float *velocities_x = velocity_x.ptr();
+	const float *velocities_z = velocity_z.ptr();
+	const float *radii = radius.ptr();
+
+	const float x = positions_x[p_index];
+	const float z = positions_z[p_index];
+	const float vx = velocities_x[p_index];
+	const float vz = velocities_z[p_index];
+	const float agent_radius = radii[p_index];
+	const float inv_time_horizon = 1.0f / time_horizon[p_index];
+	const float inv_time_step = 1.0f / time_step;
+
+	const uint32_t line_offset = r_lines.size();
+	r_lines.resize(line_offset + p_neighbor_count);
+	OrcaLine *lines = r_lines.ptr() + line_offset;
+
+	// Every case of the velocity obstacle is computed and the right one selected, without branches,
+	// so the loop over the neighbors can be vectorized.
+	for (uint32_t i = 0; i < p_neighbor_count; i++) {
+		const uint32_t other = neighbors[i];
+		const float relative_position_x = positions_x[other] - x;
+		const float relative_position_z = positions_z[other] - z;
+		const float relative_velocity_x = vx - velocities_x[other];
+		const float relative_velocity_z = vz - velocities_z[other];
+		const float distance_sq = relative_position_x * relative_position_x + relative_position_z * relative_position_z;
+		const float combined_radius = agent_radius + radii[other];
+		const float combined_radius_sq = combined_radius * combined_radius;
+
+		// Vector from the cut-off center to the relative velocity. When the agents already
+		// collide, the cut-off circle is the one of the time step.
+		const bool collision = distance_sq <= combined_radius_sq;
+		const float inv_time = collision ? inv_time_step : inv_time_horizon;
+		const float w_x = relative_velocity_x - inv_time * relative_position_x;
+		const float w_z = relative_velocity_z - inv_time * relative_position_z;
+		const float w_length_sq = w_x * w_x + w_z * w_z;
+		const float w_dot = w_x * relative_position_x + w_z * relative_position_z;
+		const bool cut_off = collision || (w_dot < 0.0f && w_dot * w_dot > combined_radius_sq * w_length_sq);
+
+		// Projection on the cut-off circle.
+		const float w_length = Math::sqrt(w_length_sq);
+		const float inv_w_length = w_length > 0.0f ? 1.0f / w_length : 0.0f;
+		const float unit_w_x = w_x * inv_w_length;
+		const float unit_w_z = w_z * inv_w_length;
+		const float cut_off_u = combined_radius * inv_time - w_length;
+
+		// Projection on the closest leg of the cone.
+		const float leg = Math::sqrt(MAX(distance_sq - combined_radius_sq, 0.0f));
+		const float inv_distance_sq = distance_sq > 0.0f ? 1.0f / distance_sq : 0.0f;
+		const bool left_leg = relative_position_x * w_z - relative_position_z * w_x > 0.0f;
+		const float leg_direction_x = left_leg ? (relative_position_x * leg - relative_position_z * combined_radius) * inv_distance_sq : -(relative_position_x * leg + relative_position_z * combined_radius) * inv_distance_sq;
+		const float leg_direction_z = left_leg ? (relative_position_x * combined_radius + relative_position_z * leg) * inv_distance_sq : -(-relative_position_x * combined_radius + relative_position_z * leg) * inv_distance_sq;
+		const float leg_dot = relative_velocity_x * leg_direction_x + relative_velocity_z * leg_direction_z;
+
+		const float direction_x = cut_off ? unit_w_z : leg_direction_x;
+		const float direction_z = cut_off ? -unit_w_x : leg_direction_z;
+		const float u_x = cut_off ? cut_off_u * unit_w_x : leg_dot * leg_direction_x - relative_velocity_x;
+		const float u_z = cut_off ? cut_off_u * unit_w_z : leg_dot * leg_direction_z - relative_velocity_z;
+
+		// Both agents take half of the responsibility to avoid each other.
+		lines[i].point = Vector2(vx + 0.5f * u_x, vz + 0.5f * u_z);
+		lines[i].direction = Vector2(direction_x, direction_z);
+	}
+}
+
+void NavAvoidanceBatch::_add_agent_planes(uint32_t p_index, uint32_t p_neighbor_count, LocalVector<OrcaPlane> &r_planes) const {
+	const uint32_t *neighbors = neighbor_indices.ptr() + neighbor_offsets[p_index];
+	const float *positions_x = position_x.ptr();
+	const float *positions_y = position_y.ptr();
+	const float *positions_z = position_z.ptr();
+	const float *velocities_x = velocity_x.ptr();
+	const float *velocities_y = velocity_y.ptr();
+	const float *velocities_z = velocity_z.ptr();
+	const float *radii = radius.ptr();
+
+	const float x = positions_x[p_index];
+	const float y = positions_y[p_index];
+	const float z = positions_z[p_index];
+	const float vx = velocities_x[p_index];
+	const float vy = velocities_y[p_index];
+	const float vz = velocities_z[p_index];
+	const float agent_radius = radii[p_index];
+	const float inv_time_horizon = 1.0f / time_horizon[p_index];
+	const float inv_time_step = 1.0f / time_step;
+
+	const uint32_t plane_offset = r_planes.size();
+	r_planes.resize(plane_offset + p_neighbor_count);
+	OrcaPlane *planes = r_planes.ptr() + plane_offset;
+
+	// Every case of the velocity obstacle is computed and the right one selected, without branches,
+	// so the loop over the neighbors can be vectorized. All cases project the relative velocity
+	// away from a point `t` times the relative position, only `t` differs.
+	for (uint32_t i = 0; i < p_neighbor_count; i++) {
+		const uint32_t other = neighbors[i];
+		const float relative_position_x = positions_x[other] - x;
+		const float relative_position_y = positions_y[other] - y;
+		const float relative_position_z = positions_z[other] - z;
+		const float relative_velocity_x = vx - velocities_x[other];
+		const float relative_velocity_y = vy - velocities_y[other];
+		const float relative_velocity_z = vz - velocities_z[other];
+		const float distance_sq = relative_position_x * relative_position_x + relative_position_y * relative_position_y + relative_position_z * relative_position_z;
+		const float combined_radius = agent_radius + radii[other];
+		const float combined_radius_sq = combined_radius * combined_radius;
+		const bool collision = distance_sq <= combined_radius_sq;
+
+		// Projection on the cut-off sphere.
+		const float cut_off_w_x = relative_velocity_x - inv_time_horizon * relative_position_x;
+		const float cut_off_w_y = relative_velocity_y - inv_time_horizon * relative_position_y;
+		const float cut_off_w_z = relative_velocity_z - inv_time_horizon * relative_position_z;
+		const float cut_off_w_length_sq = cut_off_w_x * cut_off_w_x + cut_off_w_y * cut_off_w_y + cut_off_w_z * cut_off_w_z;
+		const float cut_off_w_dot = cut_off_w_x * relative_position_x + cut_off_w_y * relative_position_y + cut_off_w_z * relative_position_z;
+		const bool cut_off = cut_off_w_dot < 0.0f && cut_off_w_dot * cut_off_w_dot > combined_radius_sq * cut_off_w_length_sq;
+
+		// Projection on the cone.
+		const float cross_x = relative_position_y * relative_velocity_z - relative_position_z * relative_velocity_y;
+		const float cross_y = relative_position_z * relative_velocity_x - relative_position_x * relative_velocity_z;
+		const float cross_z = relative_position_x * relative_velocity_y - relative_position_y * relative_velocity_x;
+		const float cross_length_sq = cross_x * cross_x + cross_y * cross_y + cross_z * cross_z;
+		const float relative_velocity_length_sq = relative_velocity_x * relative_velocity_x + relative_velocity_y * relative_velocity_y + relative_velocity_z * relative_velocity_z;
+		const float a = distance_sq;
+		const float b = relative_position_x * relative_velocity_x + relative_position_y * relative_velocity_y + relative_position_z * relative_velocity_z;
+		const float c = relative_velocity_length_sq - cross_length_sq / (collision ? 1.0f : distance_sq - combined_radius_sq);
+		const float cone_t = (b + Math::sqrt(MAX(b * b - a * c, 0.0f))) / (a > 0.0f ? a : 1.0f);
+
+		const float t = collision ? inv_time_step : (cut_off ? inv_time_horizon : cone_t);
+		const float w_x = relative_velocity_x - t * relative_position_x;
+		const float w_y = relative_velocity_y - t * relative_position_y;
+		const float w_z = relative_velocity_z - t * relative_position_z;
+		const float w_length = Math::sqrt(w_x * w_x + w_y * w_y + w_z * w_z);
+		const float inv_w_length = w_length > 0.0f ? 1.0f / w_length : 0.0f;
+		const float unit_w_x = w_x * inv_w_length;
+		const float unit_w_y = w_y * inv_w_length;
+		const float unit_w_z = w_z * inv_w_length;
+		const float u = combined_radius * t - w_length;
+
+		// Both agents take half of the responsibility to avoid each other.
+		planes[i].point = Vector3(vx + 0.5f * u * unit_w_x, vy + 0.5f * u * unit_w_y, vz + 0.5f * u * unit_w_z);
+		planes[i].normal = Vector3(unit_w_x, unit_w_y, unit_w_z);
+	}
+}
+
+void NavAvoidanceBatch::compute_agent_velocity(uint32_t p_index) {
+	const uint32_t neighbor_count = _compute_agent_neighbors(p_index);
+
+	if (use_3d_avoidance) {
+		RVO3D::Agent3D *rvo_agent = agents[p_index]->get_rvo_agent_3d();
+		orca_planes.clear();
+		_add_agent_planes(p_index, neighbor_count, orca_planes);
+
+		const Vector3 preferred_velocity(rvo_agent->prefVelocity_.x(), rvo_agent->prefVelocity_.y(), rvo_agent->prefVelocity_.z());
+		const Vector3 new_velocity = solve_planes(orca_planes, rvo_agent->maxSpeed_, preferred_velocity);
+		rvo_agent->newVelocity_ = RVO3D::Vector3(new_velocity.x, new_velocity.y, new_velocity.z);
+	} else {
+		// Static obstacles are few and irregular, their lines still come from the RVO2 agent.
+		RVO2D::Agent2D *rvo_agent = agents[p_index]->get_rvo_agent_2d();
+		rvo_agent->computeObstacleOrcaLines();
+		orca_lines.resize(rvo_agent->orcaLines_.size());
+		for (uint32_t i = 0; i < orca_lines.size(); i++) {
+			const RVO2D::Line &obstacle_line = rvo_agent->orcaLines_[i];
+			orca_lines[i].point = Vector2(obstacle_line.point.x(), obstacle_line.point.y());
+			orca_lines[i].direction = Vector2(obstacle_line.direction.x(), obstacle_line.direction.y());
+		}
+		const uint32_t obstacle_line_count = orca_lines.size();
+		_add_agent_lines(p_index, neighbor_count, orca_lines);
+
+		const Vector2 preferred_velocity(rvo_agent->prefVelocity_.x(), rvo_agent->prefVelocity_.y());
+		const Vector2 new_velocity = solve_lines(orca_lines, obstacle_line_count, rvo_agent->maxSpeed_, preferred_velocity);
+		rvo_agent->newVelocity_ = RVO2D::Vector2(new_velocity.x, new_velocity.y);
+	}
+}
+
+// Normalizes with a reciprocal like the RVO2 library, so both avoidance paths round the same way.
+template <typename T>
+static _FORCE_INLINE_ T _orca_normalize(const T &p_vector) {
+	return p_vector * (1.0f / p_vector.length());
+}
+
+// Linear programs of the ORCA solver, as in "Reciprocal n-body Collision Avoidance" (van den Berg et al.).
+// Each one finds the velocity inside the max speed circle or sphere that is closest to the preferred velocity,
+// or furthest in its direction, subject to the constraints before the one it is solved on.
+
+static bool _orca_line_program_1d(const LocalVector<NavAvoidanceBatch::OrcaLine> &p_lines, uint32_t p_line, float p_radius, const Vector2 &p_optimal_velocity, bool p_optimize_direction, Vector2 &r_result) {
+	const NavAvoidanceBatch::OrcaLine &line = p_lines[p_line];
+	const real_t dot_product = line.point.dot(line.direction);
+	const real_t discriminant = dot_product * dot_product + p_radius * p_radius - line.point.length_squared();
+	if (discriminant < 0.0f) {
+		// The max speed circle fully invalidates the line.
+		return false;
+	}
+
+	const real_t sqrt_discriminant = Math::sqrt(discriminant);
+	real_t t_left = -dot_product - sqrt_discriminant;
+	real_t t_right = -dot_product + sqrt_discriminant;
+
+	for (uint32_t i = 0; i < p_line; i++) {
+		const real_t denominator = line.direction.cross(p_lines[i].direction);
+		const real_t numerator = p_lines[i].direction.cross(line.point - p_lines[i].point);
+
+		if (Math::abs(denominator) <= ORCA_EPSILON) {
+			// The lines are (almost) parallel.
+			if (numerator < 0.0f) {
+				return false;
+			}
+			continue;
+		}
+
+		const real_t t = numerator / denominator;
+		if (denominator >= 0.0f) {
+			t_right = MIN(t_right, t);
+		} else {
+			t_left = MAX(t_left, t);
+		}
+
+		if (t_left > t_right) {
+			return false;
+		}
+	}
+
+	if (p_optimize_direction) {
+		r_result = line.point + (p_optimal_velocity.dot(line.direction) > 0.0f ? t_right : t_left) * line.direction;
+	} else {
+		const real_t t = CLAMP(line.direction.dot(p_optimal_velocity - line.point), t_left, t_right);
+		r_result = line.point + t * line.direction;
+	}
+	return true;
+}
+
+static uint32_t _orca_line_program_2d(const LocalVector<NavAvoidanceBatch::OrcaLine> &p_lines, float p_radius, const Vector2 &p_optimal_velocity, bool p_optimize_direction, Vector2 &r_result) {
+	if (p_optimize_direction) {
+		// The optimal velocity is of unit length in this case.
+		r_result = p_optimal_velocity * p_radius;
+	} else if (p_optimal_velocity.length_squared() > p_radius * p_radius) {
+		r_result = _orca_normalize(p_optimal_velocity) * p_radius;
+	} else {
+		r_result = p_optimal_velocity;
+	}
+
+	for (uint32_t i = 0; i < p_lines.size(); i++) {
+		if (p_lines[i].direction.cross(p_lines[i].point - r_result) > 0.0f) {
+			// The result does not satisfy this constraint, compute a new optimal result.
+			const Vector2 previous_result = r_result;
+			if (!_orca_line_program_1d(p_lines, i, p_radius, p_optimal_velocity, p_optimize_direction, r_result)) {
+				r_result = previous_result;
+				return i;
+			}
+		}
+	}
+	return p_lines.size();
+}
+
+static void _orca_line_program_3d(const LocalVector<NavAvoidanceBatch::OrcaLine> &p_lines, uint32_t p_obstacle_line_count, uint32_t p_begin_line, float p_radius, Vector2 &r_result) {
+	// The constraints are infeasible, minimize the largest violation of the agent lines instead.
+	LocalVector<NavAvoidanceBatch::OrcaLine> &projected_lines = orca_projected_lines;
+	real_t distance = 0.0f;
+
+	for (uint32_t i = p_begin_line; i < p_lines.size(); i++) {
+		if (p_lines[i].direction.cross(p_lines[i].point - r_result) <= distance) {
+			continue;
+		}
+
+		// The result does not satisfy the constraint of this line.
+		projected_lines.resize(p_obstacle_line_count);
+		for (uint32_t j = 0; j < p_obstacle_line_count; j++) {
+			projected_lines[j] = p_lines[j];
+		}
+
+		for (uint32_t j = p_obstacle_line_count; j < i; j++) {
+			NavAvoidanceBatch::OrcaLine line;
+			const real_t determinant = p_lines[i].direction.cross(p_lines[j].direction);
+
+			if (Math::abs(determinant) <= ORCA_EPSILON) {
+				// The lines are parallel.
+				if (p_lines[i].direction.dot(p_lines[j].direction) > 0.0f) {
+					continue;
+				}
+				line.point = 0.5f * (p_lines[i].point + p_lines[j].point);
+			} else {
+				line.point = p_lines[i].point + (p_lines[j].direction.cross(p_lines[i].point - p_lines[j].point) / determinant) * p_lines[i].direction;
+			}
+
+			line.direction = _orca_normalize(p_lines[j].direction - p_lines[i].direction);
+			projected_lines.push_back(line);
+		}
+
+		const Vector2 previous_result = r_result;
+		if (_orca_line_program_2d(projected_lines, p_radius, Vector2(-p_lines[i].direction.y, p_lines[i].direction.x), true, r_result) < projected_lines.size()) {
+			// The result is already in the feasible region of this program by definition,
+			// this only fails because of floating point errors, keep the current result.
+			r_result = previous_result;
+		}
+
+		distance = p_lines[i].direction.cross(p_lines[i].point - r_result);
+	}
+}
+
+Vector2 NavAvoidanceBatch::solve_lines(const LocalVector<OrcaLine> &p_lines, uint32_t p_obstacle_line_count, float p_max_speed, const Vector2 &p_preferred_velocity) {
+	Vector2 result;
+	const uint32_t line_fail = _orca_line_program_2d(p_lines, p_max_speed, p_preferred_velocity, false, result);
+	if (line_fail < p_lines.size()) {
+		_orca_line_program_3d(p_lines, p_obstacle_line_count, line_fail, p_max_speed, result);
+	}
+	return result;
+}
+
+static bool _orca_plane_program_1d(const LocalVector<NavAvoidanceBatch::OrcaPlane> &p_planes, uint32_t p_plane, const Vector3 &p_line_point, const Vector3 &p_line_direction, float p_radius, const Vector3 &p_optimal_velocity, bool p_optimize_direction, Vector3 &r_result) {
+	const real_t dot_product = p_line_point.dot(p_line_direction);
+	const real_t discriminant = dot_product * dot_product + p_radius * p_radius - p_line_point.length_squared();
+	if (discriminant < 0.0f) {
+		// The max speed sphere fully invalidates the line.
+		return false;
+	}
+
+	const real_t sqrt_discriminant = Math::sqrt(discriminant);
+	real_t t_left = -dot_product - sqrt_discriminant;
+	real_t t_right = -dot_product + sqrt_discriminant;
+
+	for (uint32_t i = 0; i < p_plane; i++) {
+		const real_t numerator = (p_planes[i].point - p_line_point).dot(p_planes[i].normal);
+		const real_t denominator = p_line_direction.dot(p_planes[i].normal);
+
+		if (denominator * denominator <= ORCA_EPSILON) {
+			// The line is (almost) parallel to the plane.
+			if (numerator > 0.0f) {
+				return false;
+			}
+			continue;
+		}
+
+		const real_t t = numerator / denominator;
+		if (denominator >= 0.0f) {
+			t_left = MAX(t_left, t);
+		} else {
+			t_right = MIN(t_right, t);
+		}
+
+		if (t_left > t_right) {
+			return false;
+		}
+	}
+
+	if (p_optimize_direction) {
+		r_result = p_line_point + (p_optimal_velocity.dot(p_line_direction) > 0.0f ? t_right : t_left) * p_line_direction;
+	} else {
+		const real_t t = CLAMP(p_line_direction.dot(p_optimal_velocity - p_line_point), t_left, t_right);
+		r_result = p_line_point + t * p_line_direction;
+	}
+	return true;
+}
+
+static bool _orca_plane_program_2d(const LocalVector<NavAvoidanceBatch::OrcaPlane> &p_planes, uint32_t p_plane, float p_radius, const Vector3 &p_optimal_velocity, bool p_optimize_direction, Vector3 &r_result) {
+	const NavAvoidanceBatch::OrcaPlane &plane = p_planes[p_plane];
+	const real_t plane_distance = plane.point.dot(plane.normal);
+	const real_t plane_distance_sq = plane_distance * plane_distance;
+	const real_t radius_sq = p_radius * p_radius;
+	if (plane_distance_sq > radius_sq) {
+		// The max speed sphere fully invalidates the plane.
+		return false;
+	}
+
+	const real_t plane_radius_sq = radius_sq - plane_distance_sq;
+	const Vector3 plane_center = plane_distance * plane.normal;
+
+	if (p_optimize_direction) {
+		// Project the direction on the plane.
+		const Vector3 plane_optimal_velocity = p_optimal_velocity - p_optimal_velocity.dot(plane.normal) * plane.normal;
+		const real_t plane_optimal_velocity_length_sq = plane_optimal_velocity.length_squared();
+		if (plane_optimal_velocity_length_sq <= ORCA_EPSILON) {
+			r_result = plane_center;
+		} else {
+			r_result = plane_center + Math::sqrt(plane_radius_sq / plane_optimal_velocity_length_sq) * plane_optimal_velocity;
+		}
+	} else {
+		// Project the point on the plane, and on the circle the plane cuts from the max speed sphere.
+		r_result = p_optimal_velocity + (plane.point - p_optimal_velocity).dot(plane.normal) * plane.normal;
+		if (r_result.length_squared() > radius_sq) {
+			const Vector3 plane_result = r_result - plane_center;
+			r_result = plane_center + Math::sqrt(plane_radius_sq / plane_result.length_squared()) * plane_result;
+		}
+	}
+
+	for (uint32_t i = 0; i < p_plane; i++) {
+		if (p_planes[i].normal.dot(p_planes[i].point - r_result) > 0.0f) {
+			// The result does not satisfy this constraint, solve on the intersection of both planes.
+			const Vector3 cross_product = p_planes[i].normal.cross(plane.normal);
+			if (cross_product.length_squared() <= ORCA_EPSILON) {
+				// The planes are (almost) parallel, and this plane fully invalidates the other.
+				return false;
+			}
+
+			const Vector3 line_direction = _orca_normalize(cross_product);
+			const Vector3 line_normal = line_direction.cross(plane.normal);
+			const Vector3 line_point = plane.point + ((p_planes[i].point - plane.point).dot(p_planes[i].normal) / line_normal.dot(p_planes[i].normal)) * line_normal;
+
+			if (!_orca_plane_program_1d(p_planes, i, line_point, line_direction, p_radius, p_optimal_velocity, p_optimize_direction, r_result)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static uint32_t _orca_plane_program_3d(const LocalVector<NavAvoidanceBatch::OrcaPlane> &p_planes, float p_radius, const Vector3 &p_optimal_velocity, bool p_optimize_direction, Vector3 &r_result) {
+	if (p_optimize_direction) {
+		// The optimal velocity is of unit length in this case.
+		r_result = p_optimal_velocity * p_radius;
+	} else if (p_optimal_velocity.length_squared() > p_radius * p_radius) {
+		r_result = _orca_normalize(p_optimal_velocity) * p_radius;
+	} else {
+		r_result = p_optimal_velocity;
+	}
+
+	for (uint32_t i = 0; i < p_planes.size(); i++) {
+		if (p_planes[i].normal.dot(p_planes[i].point - r_result) > 0.0f) {
+			// The result does not satisfy this constraint, compute a new optimal result.
+			const Vector3 previous_result = r_result;
+			if (!_orca_plane_program_2d(p_planes, i, p_radius, p_optimal_velocity, p_optimize_direction, r_result)) {
+				r_result = previous_result;
+				return i;
+			}
+		}
+	}
+	return p_planes.size();
+}
+
+static void _orca_plane_program_4d(const LocalVector<NavAvoidanceBatch::OrcaPlane> &p_planes, uint32_t p_begin_plane, float p_radius, Vector3 &r_result) {
+	// The constraints are infeasible, minimize the largest violation instead.
+	LocalVector<NavAvoidanceBatch::OrcaPlane> &projected_planes = orca_projected_planes;
+	real_t distance = 0.0f;
+
+	for (uint32_t i = p_begin_plane; i < p_planes.size(); i++) {
+		if (p_planes[i].normal.dot(p_planes[i].point - r_result) <= distance) {
+			continue;
+		}
+
+		// The result does not satisfy the constraint of this plane.
+		projected_planes.clear();
+		for (uint32_t j = 0; j < i; j++) {
+			NavAvoidanceBatch::OrcaPlane plane;
+			const Vector3 cross_product = p_planes[j].normal.cross(p_planes[i].normal);
+
+			if (cross_product.length_squared() <= ORCA_EPSILON) {
+				// The planes are (almost) parallel.
+				if (p_planes[i].normal.dot(p_planes[j].normal) > 0.0f) {
+					continue;
+				}
+				plane.point = 0.5f * (p_planes[i].point + p_planes[j].point);
+			} else {
+				// A point on the intersection line of both planes.
+				const Vector3 line_normal = cross_product.cross(p_planes[i].normal);
+				plane.point = p_planes[i].point + ((p_planes[j].point - p_planes[i].point).dot(p_planes[j].normal) / line_normal.dot(p_planes[j].normal)) * line_normal;
+			}
+
+			plane.normal = _orca_normalize(p_planes[j].normal - p_planes[i].normal);
+			projected_planes.push_back(plane);
+		}
+
+		const Vector3 previous_result = r_result;
+		if (_orca_plane_program_3d(projected_planes, p_radius, p_planes[i].normal, true, r_result) < projected_planes.size()) {
+			// The result is already in the feasible region of this program by definition,
+			// this only fails because of floating point errors, keep the current result.
+			r_result = previous_result;
+		}
+
+		distance = p_planes[i].normal.dot(p_planes[i].point - r_result);
+	}
+}
+
+Vector3 NavAvoidanceBatch::solve_planes(const LocalVector<OrcaPlane> &p_planes, float p_max_speed, const Vector3 &p_preferred_velocity) {
+	Vector3 result;
+	const uint32_t plane_fail = _orca_plane_program_3d(p_planes, p_max_speed, p_preferred_velocity, false, result);
+	if (plane_fail < p_planes.size()) {
+		_orca_plane_program_4d(p_planes, plane_fail, p_max_speed, result);
+	}
+	return result;
+}
+
+void NavAvoidanceBatch::clear() {
+	agents.clear();
+	position_x.clear();
+	position_y.clear();
+	position_z.clear();
+	velocity_x.clear();
+	velocity_y.clear();
+	velocity_z.clear();
+	radius.clear();
+	height.clear();
+	time_horizon.clear();
+	neighbor_distance.clear();
+	max_neighbors.clear();
+	avoidance_layers.clear();
+	avoidance_mask.clear();
+	avoidance_priority.clear();
+	neighbor_offsets.clear();
+	neighbor_indices.clear();
+	neighbor_distances_sq.clear();
+	cells.clear();
+	agent_cells.clear();
+}
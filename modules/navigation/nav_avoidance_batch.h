@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  nav_avoidance_batch.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_AVOIDANCE_BATCH_H
+#define NAV_AVOIDANCE_BATCH_H
+
+#include "core/math/vector2.h"
+#include "core/math/vector2i.h"
+#include "core/math/vector3.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+class NavAgent;
+
+/// Batched avoidance for the agents of a map.
+/// The agent state is copied into flat arrays once per step, and the agents are bucketed into a uniform grid
+/// on the XZ plane that is updated incrementally as agents move between cells, instead of rebuilding a KD-tree
+/// every step. The ORCA constraints of all neighbors of an agent are then built in a single pass over those
+/// arrays, and solved for the new velocity of the agent.
+class NavAvoidanceBatch {
+public:
+	/// Constraint of the 2D avoidance, the permitted velocities are on the left of the directed line.
+	struct OrcaLine {
+		Vector2 point;
+		Vector2 direction;
+	};
+
+	/// Constraint of the 3D avoidance, the permitted velocities are on the side the normal points to.
+	struct OrcaPlane {
+		Vector3 point;
+		Vector3 normal;
+	};
+
+private:
+	bool use_3d_avoidance = false;
+	float time_step = 0.0;
+
+	LocalVector<NavAgent *> agents;
+
+	/// Structure-of-arrays copy of the avoidance agent state.
+	LocalVector<float> position_x;
+	LocalVector<float> position_y;
+	LocalVector<float> position_z;
+	LocalVector<float> velocity_x;
+	LocalVector<float> velocity_y;
+	LocalVector<float> velocity_z;
+	LocalVector<float> radius;
+	LocalVector<float> height;
+	LocalVector<float> time_horizon;
+	LocalVector<float> neighbor_distance;
+	LocalVector<uint32_t> max_neighbors;
+	LocalVector<uint32_t> avoidance_layers;
+	LocalVector<uint32_t> avoidance_mask;
+	LocalVector<float> avoidance_priority;
+
+	/// Agent neighbors sorted by distance, each agent owns `max_neighbors` slots starting at its offset.
+	LocalVector<uint32_t> neighbor_offsets;
+	LocalVector<uint32_t> neighbor_indices;
+	LocalVector<float> neighbor_distances_sq;
+
+	float cell_size = 1.0;
+	float inv_cell_size = 1.0;
+	HashMap<Vector2i, LocalVector<uint32_t>> cells;
+	LocalVector<Vector2i> agent_cells;
+
+	_FORCE_INLINE_ Vector2i _get_cell(float p_x, float p_z) const {
+		return Vector2i((int)Math::floor(p_x * inv_cell_size), (int)Math::floor(p_z * inv_cell_size));
+	}
+
+	void _rebuild_grid();
+	void _update_grid();
+	void _remove_from_cell(uint32_t p_index, const Vector2i &p_cell);
+
+	_FORCE_INLINE_ void _add_cell_neighbors(uint32_t p_index, const LocalVector<uint32_t> &p_cell_agents, uint32_t &r_neighbor_count, float &r_range_sq);
+	uint32_t _compute_agent_neighbors(uint32_t p_index);
+
+	void _add_agent_lines(uint32_t p_index, uint32_t p_neighbor_count, LocalVector<OrcaLine> &r_lines) const;
+	void _add_agent_planes(uint32_t p_index, uint32_t p_neighbor_count, LocalVector<OrcaPlane> &r_planes) const;
+
+public:
+	void set_use_3d_avoidance(bool p_enabled) { use_3d_avoidance = p_enabled; }
+	bool get_use_3d_avoidance() const { return use_3d_avoidance; }
+
+	uint32_t size() const { return agents.size(); }
+	float get_cell_size() const { return cell_size; }
+	uint32_t get_cell_count() const { return cells.size(); }
+
+	/// Copies the agent state and moves agents between grid cells.
+	/// The grid is only rebuilt from scratch when the set or order of agents changed.
+	void update(const LocalVector<NavAgent *> &p_agents, float p_time_step);
+
+	/// Finds the neighbors of an agent and solves its new RVO velocity, the agent does not move yet.
+	/// Safe to call for different agents in parallel. The static obstacle neighbors of 2D agents
+	/// have to be computed before.
+	void compute_agent_velocity(uint32_t p_index);
+
+	/// Solves the velocity closest to `p_preferred_velocity` within `p_max_speed` that satisfies the lines.
+	/// The first `p_obstacle_line_count` lines are never relaxed when the lines can't all be satisfied.
+	static Vector2 solve_lines(const LocalVector<OrcaLine> &p_lines, uint32_t p_obstacle_line_count, float p_max_speed, const Vector2 &p_preferred_velocity);
+	/// Solves the velocity closest to `p_preferred_velocity` within `p_max_speed` that satisfies the planes.
+	static Vector3 solve_planes(const LocalVector<OrcaPlane> &p_planes, float p_max_speed, const Vector3 &p_preferred_velocity);
+
+	void clear();
+};
+
+#endif // NAV_AVOIDANCE_BATCH_H
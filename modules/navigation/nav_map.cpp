@@ -93,6 +93,9 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 		return;
 	}
 	use_edge_connections = p_enabled;
+	for (NavRegion *region : regions) {
+		connectivity_dirty_regions.insert(region);
+	}
 	regenerate_links = true;
 }
 
@@ -101,6 +104,9 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 		return;
 	}
 	edge_connection_margin = p_edge_connection_margin;
+	for (NavRegion *region : regions) {
+		connectivity_dirty_regions.insert(region);
+	}
 	regenerate_links = true;
 }
 
@@ -109,6 +115,7 @@ void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
 		return;
 	}
 	link_connection_radius = p_link_connection_radius;
+	link_endpoints.clear();
 	regenerate_links = true;
 }
 
@@ -125,7 +132,7 @@ gd::PointKey NavMap::get_point_key(const Vector3 &p_pos) const {
 	return p;
 }
 
-Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
+Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, gd::PathSearchArena *r_arena) const {
 	RWLockRead read_lock(map_rwlock);
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -134,7 +141,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 	return NavMeshQueries3D::polygons_get_path(
 			polygons, p_origin, p_destination, p_optimize, p_navigation_layers,
-			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size());
+			r_path_types, r_path_rids, r_path_owners, up, link_polygons.size(),
+			clusters.is_empty() ? nullptr : &clusters, r_arena);
 }
 
 Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
@@ -192,6 +200,7 @@ void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
 		regions.remove_at_unordered(region_index);
+		_remove_region_connectivity(p_region);
 		regenerate_links = true;
 	}
 }
@@ -205,6 +214,7 @@ void NavMap::remove_link(NavLink *p_link) {
 	int64_t link_index = links.find(p_link);
 	if (link_index >= 0) {
 		links.remove_at_unordered(link_index);
+		link_endpoints.erase(p_link);
 		regenerate_links = true;
 	}
 }
@@ -379,12 +389,14 @@ void NavMap::sync() {
 
 	for (NavRegion *region : regions) {
 		if (region->sync()) {
+			connectivity_dirty_regions.insert(region);
 			regenerate_links = true;
 		}
 	}
 
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
+			link_endpoints.erase(link);
 			regenerate_links = true;
 		}
 	}
@@ -396,6 +408,12 @@ void NavMap::sync() {
 		_new_pm_edge_connection_count = 0;
 		_new_pm_edge_free_count = 0;
 
+		// Only the connections of regions that changed, and of their neighbors, are recomputed.
+		HashSet<NavRegion *> changed_regions = connectivity_dirty_regions;
+		connectivity_dirty_regions.clear();
+		_update_region_connectivity(changed_regions);
+		_update_link_endpoints(changed_regions);
+
 		// Remove regions connections.
 		region_external_connections.clear();
 		for (NavRegion *region : regions) {
@@ -404,265 +422,173 @@ void NavMap::sync() {
 
 		// Resize the polygon count.
 		int polygon_count = 0;
-		for (const NavRegion *region : regions) {
+		HashMap<NavRegion *, uint32_t> region_polygon_offsets;
+		for (NavRegion *region : regions) {
 			if (!region->get_enabled()) {
 				continue;
 			}
+			region_polygon_offsets[region] = polygon_count;
 			polygon_count += region->get_polygons().size();
 		}
 		polygons.resize(polygon_count);
 
-		// Copy all region polygons in the map.
+		// Copy all region polygons in the map, pointing their connections to the copies.
 		polygon_count = 0;
+		uint32_t cluster_count = 0;
 		for (const NavRegion *region : regions) {
 			if (!region->get_enabled()) {
 				continue;
 			}
 			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
+			const uint32_t region_offset = polygon_count;
 			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[polygon_count] = polygons_source[n];
-				polygons[polygon_count].id = polygon_count;
-				polygon_count++;
-			}
-		}
-
-		_new_pm_polygon_count = polygon_count;
-
-		// Group all edges per key.
-		connection_pairs_map.clear();
-		connection_pairs_map.reserve(polygons.size());
-		int free_edges_count = 0; // How many ConnectionPairs have only one Connection.
-
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				const int next_point = (p + 1) % poly.points.size();
-				const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey>::Iterator pair_it = connection_pairs_map.find(ek);
-				if (!pair_it) {
-					pair_it = connection_pairs_map.insert(ek, ConnectionPair());
-					_new_pm_edge_count += 1;
-					++free_edges_count;
+				gd::Polygon &poly = polygons[polygon_count];
+				poly = polygons_source[n];
+				poly.id = polygon_count;
+				if (poly.cluster != UINT32_MAX) {
+					poly.cluster += cluster_count;
 				}
-				ConnectionPair &pair = pair_it->value;
-				if (pair.size < 2) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-
-					pair.connections[pair.size] = new_connection;
-					++pair.size;
-					if (pair.size == 2) {
-						--free_edges_count;
+				for (gd::Edge &edge : poly.edges) {
+					for (gd::Edge::Connection &connection : edge.connections) {
+						connection.polygon = &polygons[region_offset + (connection.polygon - polygons_source.ptr())];
 					}
-
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
 				}
+				polygon_count++;
 			}
+			cluster_count += region->get_clusters().size();
+			_new_pm_edge_count += region->get_edge_count();
+			_new_pm_edge_merge_count += region->get_edge_merge_count();
 		}
 
-		free_edges.clear();
-		free_edges.reserve(free_edges_count);
+		_new_pm_polygon_count = polygon_count;
 
-		for (const KeyValue<gd::EdgeKey, ConnectionPair> &pair_it : connection_pairs_map) {
-			const ConnectionPair &pair = pair_it.value;
-			if (pair.size == 2) {
-				// Connect edge that are shared in different polygons.
-				const gd::Edge::Connection &c1 = pair.connections[0];
-				const gd::Edge::Connection &c2 = pair.connections[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(pair.size != 1, vformat("Number of connection != 1. Found: %d", pair.size));
-				if (use_edge_connections && pair.connections[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(pair.connections[0]);
-				}
+		// Add the connections between regions.
+		int merged_connection_count = 0;
+		for (KeyValue<NavRegion *, RegionConnectivity> &E : region_connectivity) {
+			HashMap<NavRegion *, uint32_t>::ConstIterator source_offset = region_polygon_offsets.find(E.key);
+			if (!source_offset) {
+				continue;
 			}
-		}
-
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
-
-		for (uint32_t i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (uint32_t j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
-
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+			_new_pm_edge_free_count += E.value.free_edges.size();
 
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
+			for (const RegionConnection &region_connection : E.value.connections) {
+				HashMap<NavRegion *, uint32_t>::ConstIterator target_offset = region_polygon_offsets.find(region_connection.target_region);
+				ERR_CONTINUE(!target_offset);
 
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_squared_to(self1) > edge_connection_margin_squared) {
-					continue;
-				}
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &polygons[target_offset->value + region_connection.target_polygon];
+				new_connection.edge = region_connection.target_edge;
+				new_connection.pathway_start = region_connection.pathway_start;
+				new_connection.pathway_end = region_connection.pathway_end;
+				polygons[source_offset->value + region_connection.polygon].edges[region_connection.edge].connections.push_back(new_connection);
 
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
+				if (region_connection.merged) {
+					merged_connection_count += 1;
 				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+					// Add the connection to the region_connection map.
+					region_external_connections[E.key].push_back(new_connection);
+					_new_pm_edge_connection_count += 1;
 				}
-				if (other2.distance_squared_to(self2) > edge_connection_margin_squared) {
-					continue;
-				}
-
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				region_external_connections[(NavRegion *)free_edge.polygon->owner].push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
 			}
 		}
+		// Both sides of an edge merged between regions hold a connection, and counted the edge as a border edge.
+		_new_pm_edge_count -= merged_connection_count / 2;
+		_new_pm_edge_merge_count += merged_connection_count / 2;
+
+		_update_clusters(region_polygon_offsets);
 
 		uint32_t link_poly_idx = 0;
 		link_polygons.resize(links.size());
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
+		// Connect the links to the closest polygons found within range.
+		for (NavLink *link : links) {
 			if (!link->get_enabled()) {
 				continue;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_sqr_dist = link_connection_radius * link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_sqr_dist = link_connection_radius * link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
 
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t sqr_dist = start_point.distance_squared_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_start_sqr_dist) {
-						closest_start_sqr_dist = sqr_dist;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
+			HashMap<NavLink *, LinkEndpoints>::ConstIterator endpoints = link_endpoints.find(link);
+			if (!endpoints || !endpoints->value.start.region || !endpoints->value.end.region) {
+				continue;
 			}
-
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t sqr_dist = end_point.distance_squared_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (sqr_dist < closest_end_sqr_dist) {
-						closest_end_sqr_dist = sqr_dist;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
+			HashMap<NavRegion *, uint32_t>::ConstIterator start_offset = region_polygon_offsets.find(endpoints->value.start.region);
+			HashMap<NavRegion *, uint32_t>::ConstIterator end_offset = region_polygon_offsets.find(endpoints->value.end.region);
+			ERR_CONTINUE(!start_offset || !end_offset);
+
+			gd::Polygon *closest_start_polygon = &polygons[start_offset->value + endpoints->value.start.polygon];
+			const Vector3 closest_start_point = endpoints->value.start.point;
+			gd::Polygon *closest_end_polygon = &polygons[end_offset->value + endpoints->value.end.polygon];
+			const Vector3 closest_end_point = endpoints->value.end.point;
+
+			// Create a synthetic polygon to route through.
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+			new_polygon.id = polygon_count++;
+			new_polygon.owner = link;
+			new_polygon.cluster = UINT32_MAX;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
 			}
 
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.id = polygon_count++;
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
+			// Each link is a cluster of its own, between the clusters of the polygons it connects.
+			if (use_hierarchical_pathfinding) {
+				new_polygon.cluster = clusters.size();
+				gd::Cluster link_cluster;
+				link_cluster.owner = link;
+				link_cluster.center = (closest_start_point + closest_end_point) * 0.5;
+				clusters.push_back(link_cluster);
 
-				// If the link is bi-directional, create connections from the end to the start.
+				_add_cluster_portal(closest_start_polygon->cluster, new_polygon.cluster, closest_start_point);
+				_add_cluster_portal(new_polygon.cluster, closest_end_polygon->cluster, closest_end_point);
 				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
+					_add_cluster_portal(closest_end_polygon->cluster, new_polygon.cluster, closest_end_point);
+					_add_cluster_portal(new_polygon.cluster, closest_start_polygon->cluster, closest_start_point);
 				}
 			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
+			}
 		}
 
+		link_polygons.resize(link_poly_idx);
+
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
@@ -804,7 +730,7 @@ void NavMap::_update_rvo_simulation() {
 	if (obstacles_dirty) {
 		_update_rvo_obstacles_tree_2d();
 	}
-	if (agents_dirty) {
+	if (agents_dirty && !use_batched_avoidance) {
 		_update_rvo_agents_tree_2d();
 		_update_rvo_agents_tree_3d();
 	}
@@ -824,6 +750,15 @@ void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent)
 	(*(agent + index))->update();
 }
 
+void NavMap::compute_single_batched_avoidance_step_2d(uint32_t index, NavAgent **agent) {
+	(*(agent + index))->get_rvo_agent_2d()->computeObstacleNeighbors(&rvo_simulation_2d);
+	avoidance_batch_2d.compute_agent_velocity(index);
+}
+
+void NavMap::compute_single_batched_avoidance_step_3d(uint32_t index, NavAgent **agent) {
+	avoidance_batch_3d.compute_agent_velocity(index);
+}
+
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
 
@@ -831,7 +766,22 @@ void NavMap::step(real_t p_deltatime) {
 	rvo_simulation_3d.setTimeStep(float(deltatime));
 
 	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
+		if (use_batched_avoidance) {
+			// All new velocities are computed before any agent moves, so every agent sees the same positions.
+			avoidance_batch_2d.update(active_2d_avoidance_agents, float(deltatime));
+			if (use_threads && avoidance_use_multiple_threads) {
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_batched_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOBatchedAvoidanceAgents2D"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			} else {
+				for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+					compute_single_batched_avoidance_step_2d(i, active_2d_avoidance_agents.ptr());
+				}
+			}
+			for (NavAgent *agent : active_2d_avoidance_agents) {
+				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+				agent->update();
+			}
+		} else if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
@@ -845,7 +795,21 @@ void NavMap::step(real_t p_deltatime) {
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
+		if (use_batched_avoidance) {
+			avoidance_batch_3d.update(active_3d_avoidance_agents, float(deltatime));
+			if (use_threads && avoidance_use_multiple_threads) {
+				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_batched_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOBatchedAvoidanceAgents3D"));
+				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			} else {
+				for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+					compute_single_batched_avoidance_step_3d(i, active_3d_avoidance_agents.ptr());
+				}
+			}
+			for (NavAgent *agent : active_3d_avoidance_agents) {
+				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+				agent->update();
+			}
+		} else if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
@@ -874,6 +838,416 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 	merge_rasterizer_cell_height = cell_height * merge_rasterizer_cell_scale;
 }
 
+void NavMap::_update_clusters(const HashMap<NavRegion *, uint32_t> &p_region_polygon_offsets) {
+	clusters.clear();
+	if (!use_hierarchical_pathfinding) {
+		return;
+	}
+
+	// The regions keep their clusters and the portals between them while they
+	// don't change, only the portals from one region to another are added here.
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled()) {
+			continue;
+		}
+		const uint32_t cluster_offset = clusters.size();
+		for (const gd::Cluster &region_cluster : region->get_clusters()) {
+			clusters.push_back(region_cluster);
+			for (gd::Cluster::Portal &portal : clusters[clusters.size() - 1].portals) {
+				portal.cluster += cluster_offset;
+			}
+		}
+	}
+
+	gd::ClusterPortalBuilder portal_builder;
+	for (const KeyValue<NavRegion *, RegionConnectivity> &E : region_connectivity) {
+		HashMap<NavRegion *, uint32_t>::ConstIterator source_offset = p_region_polygon_offsets.find(E.key);
+		if (!source_offset) {
+			continue;
+		}
+
+		for (const RegionConnection &region_connection : E.value.connections) {
+			HashMap<NavRegion *, uint32_t>::ConstIterator target_offset = p_region_polygon_offsets.find(region_connection.target_region);
+			if (!target_offset) {
+				continue;
+			}
+
+			const uint32_t source_cluster = polygons[source_offset->value + region_connection.polygon].cluster;
+			const uint32_t target_cluster = polygons[target_offset->value + region_connection.target_polygon].cluster;
+			if (source_cluster != UINT32_MAX && target_cluster != UINT32_MAX) {
+				portal_builder.add_connection(source_cluster, target_cluster, (region_connection.pathway_start + region_connection.pathway_end) * 0.5);
+			}
+		}
+	}
+	portal_builder.add_portals(clusters);
+}
+
+void NavMap::_add_cluster_portal(uint32_t p_from_cluster, uint32_t p_to_cluster, const Vector3 &p_position) {
+	if (p_from_cluster == UINT32_MAX || p_to_cluster == UINT32_MAX) {
+		return;
+	}
+
+	gd::Cluster::Portal portal;
+	portal.cluster = p_to_cluster;
+	portal.position = p_position;
+	clusters[p_from_cluster].portals.push_back(portal);
+}
+
+void NavMap::_update_region_connectivity(const HashSet<NavRegion *> &p_changed_regions) {
+	if (p_changed_regions.is_empty()) {
+		return;
+	}
+
+	// Regions that get their connections recomputed: the changed ones, and
+	// every region they were connected to or now share a border edge with.
+	HashSet<NavRegion *> affected_regions;
+
+	for (NavRegion *region : p_changed_regions) {
+		affected_regions.insert(region);
+
+		RegionConnectivity &connectivity = region_connectivity[region];
+		for (NavRegion *other_region : connectivity.connected_regions) {
+			affected_regions.insert(other_region);
+		}
+		_unregister_border_edges(region, connectivity);
+
+		if (!region->get_enabled()) {
+			continue;
+		}
+
+		const LocalVector<gd::Edge::Connection> &border_edges = region->get_border_edges();
+		connectivity.border_keys.resize(border_edges.size());
+		for (uint32_t i = 0; i < border_edges.size(); i++) {
+			const gd::Polygon *poly = border_edges[i].polygon;
+			const int edge = border_edges[i].edge;
+			const gd::EdgeKey ek(poly->points[edge].key, poly->points[(edge + 1) % poly->points.size()].key);
+			connectivity.border_keys[i] = ek;
+
+			LocalVector<BorderEdge> &shared_edges = border_edges_map[ek];
+			for (const BorderEdge &shared_edge : shared_edges) {
+				affected_regions.insert(shared_edge.region);
+			}
+			shared_edges.push_back({ region, i });
+		}
+	}
+
+	// Drop the previous connections of the affected regions, in both directions.
+	for (NavRegion *region : affected_regions) {
+		RegionConnectivity *connectivity = region_connectivity.getptr(region);
+		if (!connectivity) {
+			continue;
+		}
+
+		for (NavRegion *other_region : connectivity->connected_regions) {
+			if (affected_regions.has(other_region)) {
+				continue;
+			}
+			RegionConnectivity *other_connectivity = region_connectivity.getptr(other_region);
+			if (!other_connectivity) {
+				continue;
+			}
+			for (uint32_t i = 0; i < other_connectivity->connections.size();) {
+				if (other_connectivity->connections[i].target_region == region) {
+					other_connectivity->connections.remove_at_unordered(i);
+				} else {
+					i++;
+				}
+			}
+			other_connectivity->connected_regions.erase(region);
+		}
+
+		connectivity->connections.clear();
+		connectivity->connected_regions.clear();
+		connectivity->free_edges.clear();
+	}
+
+	// Merge the border edges shared by two regions.
+	for (NavRegion *region : affected_regions) {
+		RegionConnectivity *connectivity = region_connectivity.getptr(region);
+		if (!connectivity || !region->get_enabled()) {
+			continue;
+		}
+
+		const LocalVector<gd::Edge::Connection> &border_edges = region->get_border_edges();
+		const bool region_use_edge_connections = use_edge_connections && region->get_use_edge_connections();
+
+		for (uint32_t i = 0; i < connectivity->border_keys.size(); i++) {
+			const LocalVector<BorderEdge> &shared_edges = border_edges_map[connectivity->border_keys[i]];
+			if (shared_edges.size() == 1) {
+				if (region_use_edge_connections) {
+					connectivity->free_edges.push_back(i);
+				}
+				continue;
+			}
+			if (shared_edges.size() > 2) {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+				continue;
+			}
+
+			const BorderEdge &other_border_edge = shared_edges[0].region == region ? shared_edges[1] : shared_edges[0];
+			NavRegion *other_region = other_border_edge.region;
+			if (affected_regions.has(other_region) && other_region < region) {
+				// Both directions are added while going over the other region.
+				continue;
+			}
+
+			const gd::Edge::Connection &edge = border_edges[i];
+			const gd::Edge::Connection &other_edge = other_region->get_border_edges()[other_border_edge.border_edge];
+
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			RegionConnection connection;
+			connection.polygon = edge.polygon - region->get_polygons().ptr();
+			connection.edge = edge.edge;
+			connection.target_region = other_region;
+			connection.target_polygon = other_edge.polygon - other_region->get_polygons().ptr();
+			connection.target_edge = other_edge.edge;
+			connection.pathway_start = other_edge.pathway_start;
+			connection.pathway_end = other_edge.pathway_end;
+			connection.merged = true;
+			_add_region_connection(region, *connectivity, connection);
+
+			RegionConnection other_connection;
+			other_connection.polygon = connection.target_polygon;
+			other_connection.edge = connection.target_edge;
+			other_connection.target_region = region;
+			other_connection.target_polygon = connection.polygon;
+			other_connection.target_edge = connection.edge;
+			other_connection.pathway_start = edge.pathway_start;
+			other_connection.pathway_end = edge.pathway_end;
+			other_connection.merged = true;
+			_add_region_connection(other_region, region_connectivity[other_region], other_connection);
+		}
+	}
+
+	if (!use_edge_connections) {
+		return;
+	}
+
+	// Connect the free edges of the affected regions to the close enough free edges of other regions.
+	const real_t edge_connection_margin_squared = edge_connection_margin * edge_connection_margin;
+
+	for (NavRegion *region : affected_regions) {
+		RegionConnectivity *connectivity = region_connectivity.getptr(region);
+		if (!connectivity || connectivity->free_edges.is_empty()) {
+			continue;
+		}
+		const LocalVector<gd::Edge::Connection> &border_edges = region->get_border_edges();
+
+		for (KeyValue<NavRegion *, RegionConnectivity> &E : region_connectivity) {
+			NavRegion *other_region = E.key;
+			RegionConnectivity &other_connectivity = E.value;
+			if (other_region == region || other_connectivity.free_edges.is_empty()) {
+				continue;
+			}
+			// Connections starting from an affected region are added while going over that region.
+			const bool other_affected = affected_regions.has(other_region);
+			const LocalVector<gd::Edge::Connection> &other_border_edges = other_region->get_border_edges();
+
+			for (uint32_t free_edge_index : connectivity->free_edges) {
+				const gd::Edge::Connection &free_edge = border_edges[free_edge_index];
+
+				for (uint32_t other_edge_index : other_connectivity.free_edges) {
+					const gd::Edge::Connection &other_edge = other_border_edges[other_edge_index];
+
+					RegionConnection connection;
+					if (_edges_get_connection_pathway(free_edge, other_edge, edge_connection_margin_squared, connection.pathway_start, connection.pathway_end)) {
+						connection.polygon = free_edge.polygon - region->get_polygons().ptr();
+						connection.edge = free_edge.edge;
+						connection.target_region = other_region;
+						connection.target_polygon = other_edge.polygon - other_region->get_polygons().ptr();
+						connection.target_edge = other_edge.edge;
+						_add_region_connection(region, *connectivity, connection);
+					}
+
+					RegionConnection other_connection;
+					if (!other_affected && _edges_get_connection_pathway(other_edge, free_edge, edge_connection_margin_squared, other_connection.pathway_start, other_connection.pathway_end)) {
+						other_connection.polygon = other_edge.polygon - other_region->get_polygons().ptr();
+						other_connection.edge = other_edge.edge;
+						other_connection.target_region = region;
+						other_connection.target_polygon = free_edge.polygon - region->get_polygons().ptr();
+						other_connection.target_edge = free_edge.edge;
+						_add_region_connection(other_region, other_connectivity, other_connection);
+					}
+				}
+			}
+		}
+	}
+}
+
+void NavMap::_unregister_border_edges(NavRegion *p_region, RegionConnectivity &r_connectivity) {
+	for (const gd::EdgeKey &ek : r_connectivity.border_keys) {
+		HashMap<gd::EdgeKey, LocalVector<BorderEdge>, gd::EdgeKey>::Iterator E = border_edges_map.find(ek);
+		if (!E) {
+			continue;
+		}
+		for (uint32_t i = 0; i < E->value.size(); i++) {
+			if (E->value[i].region == p_region) {
+				E->value.remove_at_unordered(i);
+				break;
+			}
+		}
+		if (E->value.is_empty()) {
+			border_edges_map.remove(E);
+		}
+	}
+	r_connectivity.border_keys.clear();
+}
+
+void NavMap::_remove_region_connectivity(NavRegion *p_region) {
+	connectivity_dirty_regions.erase(p_region);
+
+	HashMap<NavRegion *, RegionConnectivity>::Iterator E = region_connectivity.find(p_region);
+	if (E) {
+		// The neighbors lose their connections to this region, and may have free edges again.
+		for (NavRegion *other_region : E->value.connected_regions) {
+			connectivity_dirty_regions.insert(other_region);
+			RegionConnectivity *other_connectivity = region_connectivity.getptr(other_region);
+			if (other_connectivity) {
+				other_connectivity->connected_regions.erase(p_region);
+			}
+		}
+		// So do the regions that shared a border edge with it without being connected.
+		for (const gd::EdgeKey &ek : E->value.border_keys) {
+			const LocalVector<BorderEdge> *shared_edges = border_edges_map.getptr(ek);
+			if (shared_edges) {
+				for (const BorderEdge &shared_edge : *shared_edges) {
+					if (shared_edge.region != p_region) {
+						connectivity_dirty_regions.insert(shared_edge.region);
+					}
+				}
+			}
+		}
+		_unregister_border_edges(p_region, E->value);
+		region_connectivity.remove(E);
+	}
+
+	// Links that ended on this region have to search for other polygons.
+	LocalVector<NavLink *> invalid_links;
+	for (const KeyValue<NavLink *, LinkEndpoints> &L : link_endpoints) {
+		if (L.value.start.region == p_region || L.value.end.region == p_region) {
+			invalid_links.push_back(L.key);
+		}
+	}
+	for (NavLink *link : invalid_links) {
+		link_endpoints.erase(link);
+	}
+}
+
+void NavMap::_add_region_connection(NavRegion *p_region, RegionConnectivity &r_connectivity, const RegionConnection &p_connection) {
+	r_connectivity.connections.push_back(p_connection);
+	r_connectivity.connected_regions.insert(p_connection.target_region);
+
+	RegionConnectivity *target_connectivity = region_connectivity.getptr(p_connection.target_region);
+	if (target_connectivity) {
+		target_connectivity->connected_regions.insert(p_region);
+	}
+}
+
+bool NavMap::_edges_get_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, real_t p_margin_squared, Vector3 &r_pathway_start, Vector3 &r_pathway_end) {
+	const gd::Polygon *poly = p_edge.polygon;
+	const gd::Polygon *other_poly = p_other_edge.polygon;
+	Vector3 edge_p1 = poly->points[p_edge.edge].pos;
+	Vector3 edge_p2 = poly->points[(p_edge.edge + 1) % poly->points.size()].pos;
+	Vector3 other_edge_p1 = other_poly->points[p_other_edge.edge].pos;
+	Vector3 other_edge_p2 = other_poly->points[(p_other_edge.edge + 1) % other_poly->points.size()].pos;
+
+	// Compute the projection of the opposite edge on the current one
+	Vector3 edge_vector = edge_p2 - edge_p1;
+	real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+	real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+	if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+		return false;
+	}
+
+	// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+	Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other1;
+	if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+		other1 = other_edge_p1;
+	} else {
+		other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other1.distance_squared_to(self1) > p_margin_squared) {
+		return false;
+	}
+
+	Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+	Vector3 other2;
+	if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+		other2 = other_edge_p2;
+	} else {
+		other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+	}
+	if (other2.distance_squared_to(self2) > p_margin_squared) {
+		return false;
+	}
+
+	// The edges can now be connected.
+	r_pathway_start = (self1 + other1) / 2.0;
+	r_pathway_end = (self2 + other2) / 2.0;
+	return true;
+}
+
+void NavMap::_update_link_endpoints(const HashSet<NavRegion *> &p_changed_regions) {
+	const real_t link_connection_radius_squared = link_connection_radius * link_connection_radius;
+
+	for (NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+
+		HashMap<NavLink *, LinkEndpoints>::Iterator E = link_endpoints.find(link);
+		bool search_all_regions = !E || p_changed_regions.has(E->value.start.region) || p_changed_regions.has(E->value.end.region);
+		if (!E) {
+			E = link_endpoints.insert(link, LinkEndpoints());
+		}
+		LinkEndpoints &endpoints = E->value;
+
+		if (search_all_regions) {
+			endpoints = LinkEndpoints();
+			endpoints.start.distance_squared = link_connection_radius_squared;
+			endpoints.end.distance_squared = link_connection_radius_squared;
+			for (NavRegion *region : regions) {
+				_link_search_endpoint(link->get_start_position(), region, endpoints.start);
+				_link_search_endpoint(link->get_end_position(), region, endpoints.end);
+			}
+		} else {
+			// Only the changed regions can hold a polygon closer than the ones already found.
+			for (NavRegion *region : p_changed_regions) {
+				_link_search_endpoint(link->get_start_position(), region, endpoints.start);
+				_link_search_endpoint(link->get_end_position(), region, endpoints.end);
+			}
+		}
+	}
+}
+
+void NavMap::_link_search_endpoint(const Vector3 &p_position, NavRegion *p_region, LinkEndpoint &r_endpoint) const {
+	if (!p_region->get_enabled()) {
+		return;
+	}
+
+	const LocalVector<gd::Polygon> &region_polygons = p_region->get_polygons();
+	for (uint32_t polygon_index = 0; polygon_index < region_polygons.size(); polygon_index++) {
+		const gd::Polygon &poly = region_polygons[polygon_index];
+
+		// For each face check the distance to the link position.
+		for (uint32_t point_id = 2; point_id < poly.points.size(); point_id += 1) {
+			const Face3 face(poly.points[0].pos, poly.points[point_id - 1].pos, poly.points[point_id].pos);
+			const Vector3 point = face.get_closest_point_to(p_position);
+			const real_t sqr_dist = point.distance_squared_to(p_position);
+
+			// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+			if (sqr_dist < r_endpoint.distance_squared) {
+				r_endpoint.distance_squared = sqr_dist;
+				r_endpoint.point = point;
+				r_endpoint.region = p_region;
+				r_endpoint.polygon = polygon_index;
+			}
+		}
+	}
+}
+
 int NavMap::get_region_connections_count(NavRegion *p_region) const {
 	ERR_FAIL_NULL_V(p_region, 0);
 
@@ -911,6 +1285,10 @@ Vector3 NavMap::get_region_connection_pathway_end(NavRegion *p_region, int p_con
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	use_batched_avoidance = GLOBAL_GET("navigation/avoidance/use_batched_avoidance");
+	avoidance_batch_3d.set_use_3d_avoidance(true);
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
+	hierarchical_cluster_size = MAX(real_t(GLOBAL_GET("navigation/pathfinding/hierarchical_cluster_size")), real_t(CMP_EPSILON));
 }
 
 NavMap::~NavMap() {
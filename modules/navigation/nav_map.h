@@ -33,11 +33,13 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_avoidance_batch.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
 #include "servers/navigation/navigation_globals.h"
 
 #include <KdTree2d.h>
@@ -87,6 +89,11 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Hierarchical pathfinding graph over groups of neighboring polygons.
+	bool use_hierarchical_pathfinding = false;
+	real_t hierarchical_cluster_size = 32.0;
+	LocalVector<gd::Cluster> clusters;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -98,6 +105,11 @@ class NavMap : public NavRid {
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
+	/// Batched neighbor search on a uniform grid that replaces the RVO agent KD-trees.
+	bool use_batched_avoidance = false;
+	NavAvoidanceBatch avoidance_batch_2d;
+	NavAvoidanceBatch avoidance_batch_3d;
+
 	/// All the Agents (even the controlled one)
 	LocalVector<NavAgent *> agents;
 
@@ -130,13 +142,53 @@ class NavMap : public NavRid {
 
 	HashMap<NavRegion *, LocalVector<gd::Edge::Connection>> region_external_connections;
 
-	struct ConnectionPair {
-		gd::Edge::Connection connections[2];
-		int size = 0;
+	/// A connection from a border edge of a region to a polygon of another region.
+	struct RegionConnection {
+		uint32_t polygon = 0;
+		int edge = -1;
+		NavRegion *target_region = nullptr;
+		uint32_t target_polygon = 0;
+		int target_edge = -1;
+		Vector3 pathway_start;
+		Vector3 pathway_end;
+		/// Whether both edges have the same points, otherwise they are connected across the edge connection margin.
+		bool merged = false;
+	};
+
+	/// Connections between regions, kept between syncs for regions that did not change.
+	struct RegionConnectivity {
+		LocalVector<RegionConnection> connections;
+		HashSet<NavRegion *> connected_regions;
+		/// Keys of the region border edges, in the order of `NavRegion::get_border_edges()`.
+		LocalVector<gd::EdgeKey> border_keys;
+		/// Border edges that are not shared with another region, as indices in the border edges.
+		LocalVector<uint32_t> free_edges;
+	};
+
+	struct BorderEdge {
+		NavRegion *region = nullptr;
+		uint32_t border_edge = 0;
+	};
+
+	/// Closest polygon found for one end of a link.
+	struct LinkEndpoint {
+		NavRegion *region = nullptr;
+		uint32_t polygon = 0;
+		Vector3 point;
+		real_t distance_squared = 0.0;
+	};
+
+	struct LinkEndpoints {
+		LinkEndpoint start;
+		LinkEndpoint end;
 	};
 
-	HashMap<gd::EdgeKey, ConnectionPair, gd::EdgeKey> connection_pairs_map;
-	LocalVector<gd::Edge::Connection> free_edges;
+	HashMap<NavRegion *, RegionConnectivity> region_connectivity;
+	HashMap<gd::EdgeKey, LocalVector<BorderEdge>, gd::EdgeKey> border_edges_map;
+	/// Regions whose connections must be recomputed on the next sync.
+	HashSet<NavRegion *> connectivity_dirty_regions;
+	/// Links whose endpoints are still valid, and only need to be checked against changed regions.
+	HashMap<NavLink *, LinkEndpoints> link_endpoints;
 
 public:
 	NavMap();
@@ -177,9 +229,16 @@ public:
 		return link_connection_radius;
 	}
 
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+	real_t get_hierarchical_cluster_size() const {
+		return hierarchical_cluster_size;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
-	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners, gd::PathSearchArena *r_arena = nullptr) const;
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
@@ -242,12 +301,25 @@ private:
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
 
+	void compute_single_batched_avoidance_step_2d(uint32_t index, NavAgent **agent);
+	void compute_single_batched_avoidance_step_3d(uint32_t index, NavAgent **agent);
+
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+	void _update_clusters(const HashMap<NavRegion *, uint32_t> &p_region_polygon_offsets);
+	void _add_cluster_portal(uint32_t p_from_cluster, uint32_t p_to_cluster, const Vector3 &p_position);
+
+	void _update_region_connectivity(const HashSet<NavRegion *> &p_changed_regions);
+	void _unregister_border_edges(NavRegion *p_region, RegionConnectivity &r_connectivity);
+	void _remove_region_connectivity(NavRegion *p_region);
+	void _add_region_connection(NavRegion *p_region, RegionConnectivity &r_connectivity, const RegionConnection &p_connection);
+	void _update_link_endpoints(const HashSet<NavRegion *> &p_changed_regions);
+	void _link_search_endpoint(const Vector3 &p_position, NavRegion *p_region, LinkEndpoint &r_endpoint) const;
+	static bool _edges_get_connection_pathway(const gd::Edge::Connection &p_edge, const gd::Edge::Connection &p_other_edge, real_t p_margin_squared, Vector3 &r_pathway_start, Vector3 &r_pathway_end);
 };
 
 #endif // NAV_MAP_H
@@ -145,7 +145,11 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	border_edges.clear();
 	surface_area = 0.0;
+	clusters.clear();
+	edge_count = 0;
+	edge_merge_count = 0;
 	polygons_dirty = false;
 
 	if (map == nullptr) {
@@ -221,4 +225,136 @@ void NavRegion::update_polygons() {
 	}
 
 	surface_area = _new_region_surface_area;
+
+	update_connections();
+	update_clusters();
+}
+
+void NavRegion::update_connections() {
+	// Connect the edges shared by polygons of this region here, so the map
+	// only has to connect the border edges when other regions change.
+	HashMap<gd::EdgeKey, gd::ConnectionPair, gd::EdgeKey> connection_pairs_map;
+	connection_pairs_map.reserve(polygons.size());
+
+	for (gd::Polygon &poly : polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			const int next_point = (p + 1) % poly.points.size();
+			const gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			HashMap<gd::EdgeKey, gd::ConnectionPair, gd::EdgeKey>::Iterator pair_it = connection_pairs_map.find(ek);
+			if (!pair_it) {
+				pair_it = connection_pairs_map.insert(ek, gd::ConnectionPair());
+				edge_count += 1;
+			}
+			gd::ConnectionPair &pair = pair_it->value;
+			if (pair.size < 2) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+
+				pair.connections[pair.size] = new_connection;
+				++pair.size;
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			}
+		}
+	}
+
+	for (const KeyValue<gd::EdgeKey, gd::ConnectionPair> &pair_it : connection_pairs_map) {
+		const gd::ConnectionPair &pair = pair_it.value;
+		if (pair.size == 2) {
+			// Connect edge that are shared in different polygons.
+			const gd::Edge::Connection &c1 = pair.connections[0];
+			const gd::Edge::Connection &c2 = pair.connections[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			edge_merge_count += 1;
+		} else {
+			CRASH_COND_MSG(pair.size != 1, vformat("Number of connection != 1. Found: %d", pair.size));
+			border_edges.push_back(pair.connections[0]);
+		}
+	}
+}
+
+void NavRegion::update_clusters() {
+	if (!map->get_use_hierarchical_pathfinding()) {
+		return;
+	}
+
+	// Group the polygons by the grid cell their center falls in, so a change to
+	// this region only regroups its own polygons. Polygons of a cell that are
+	// only connected through other cells get separate clusters, a route entering
+	// a cluster can then always reach any of its portals without leaving it.
+	const real_t cluster_size = map->get_hierarchical_cluster_size();
+	LocalVector<Vector3> polygon_centers;
+	LocalVector<Vector3i> polygon_cells;
+	polygon_centers.resize(polygons.size());
+	polygon_cells.resize(polygons.size());
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		const gd::Polygon &polygon = polygons[i];
+		if (polygon.points.is_empty()) {
+			continue;
+		}
+
+		Vector3 center;
+		for (const gd::Point &point : polygon.points) {
+			center += point.pos;
+		}
+		center /= polygon.points.size();
+
+		polygon_centers[i] = center;
+		polygon_cells[i] = (center / cluster_size).floor();
+	}
+
+	// Flood fill the connected polygons of each cell.
+	LocalVector<uint32_t> polygon_stack;
+	for (uint32_t i = 0; i < polygons.size(); i++) {
+		if (polygons[i].points.is_empty() || polygons[i].cluster != UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t cluster_id = clusters.size();
+		clusters.push_back(gd::Cluster());
+		gd::Cluster &cluster = clusters[cluster_id];
+		cluster.owner = this;
+		uint32_t cluster_polygon_count = 0;
+
+		polygons[i].cluster = cluster_id;
+		polygon_stack.push_back(i);
+		while (!polygon_stack.is_empty()) {
+			const uint32_t polygon_id = polygon_stack[polygon_stack.size() - 1];
+			polygon_stack.resize(polygon_stack.size() - 1);
+			cluster.center += polygon_centers[polygon_id];
+			cluster_polygon_count++;
+
+			for (const gd::Edge &edge : polygons[polygon_id].edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					const uint32_t neighbor_id = connection.polygon - polygons.ptr();
+					if (connection.polygon->cluster == UINT32_MAX && polygon_cells[neighbor_id] == polygon_cells[polygon_id]) {
+						connection.polygon->cluster = cluster_id;
+						polygon_stack.push_back(neighbor_id);
+					}
+				}
+			}
+		}
+		cluster.center /= cluster_polygon_count;
+	}
+
+	// The portals between clusters of this region, the map only adds the ones to other regions.
+	gd::ClusterPortalBuilder portal_builder;
+	for (const gd::Polygon &polygon : polygons) {
+		for (const gd::Edge &edge : polygon.edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if (connection.polygon->cluster != polygon.cluster) {
+					portal_builder.add_connection(polygon.cluster, connection.polygon->cluster, (connection.pathway_start + connection.pathway_end) * 0.5);
+				}
+			}
+		}
+	}
+	portal_builder.add_portals(clusters);
 }
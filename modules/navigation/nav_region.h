@@ -55,6 +55,14 @@ class NavRegion : public NavBase {
 
 	real_t surface_area = 0.0;
 
+	/// Hierarchical pathfinding clusters the polygons are grouped in, with the portals between them.
+	LocalVector<gd::Cluster> clusters;
+
+	/// Edges that are not shared by two polygons of this region, the map connects them to other regions.
+	LocalVector<gd::Edge::Connection> border_edges;
+	int edge_count = 0;
+	int edge_merge_count = 0;
+
 	RWLock navmesh_rwlock;
 	Vector<Vector3> pending_navmesh_vertices;
 	Vector<Vector<int>> pending_navmesh_polygons;
@@ -98,10 +106,22 @@ public:
 
 	real_t get_surface_area() const { return surface_area; }
 
+	const LocalVector<gd::Cluster> &get_clusters() const {
+		return clusters;
+	}
+
+	const LocalVector<gd::Edge::Connection> &get_border_edges() const {
+		return border_edges;
+	}
+	int get_edge_count() const { return edge_count; }
+	int get_edge_merge_count() const { return edge_merge_count; }
+
 	bool sync();
 
 private:
 	void update_polygons();
+	void update_connections();
+	void update_clusters();
 };
 
 #endif // NAV_REGION_H
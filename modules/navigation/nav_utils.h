@@ -99,6 +99,12 @@ struct Edge {
 	LocalVector<Connection> connections;
 };
 
+/// The polygon edges found for the same `EdgeKey`, at most two of them can be merged.
+struct ConnectionPair {
+	Edge::Connection connections[2];
+	int size = 0;
+};
+
 struct Polygon {
 	/// Id of the polygon in the map.
 	uint32_t id = UINT32_MAX;
@@ -113,6 +119,53 @@ struct Polygon {
 	LocalVector<Edge> edges;
 
 	real_t surface_area = 0.0;
+
+	/// Cluster of the hierarchical pathfinding graph this polygon belongs to.
+	/// Local to the owner region until the map merges all polygons.
+	uint32_t cluster = UINT32_MAX;
+};
+
+struct Cluster {
+	/// A connection to a neighboring cluster.
+	struct Portal {
+		/// Cluster that this portal leads to.
+		uint32_t cluster = UINT32_MAX;
+
+		/// Average position of the polygon connections crossing between the two clusters.
+		Vector3 position;
+	};
+
+	/// Navigation region or link that contains the polygons of this cluster.
+	const NavBase *owner = nullptr;
+
+	/// Average position of the polygon centers in this cluster.
+	Vector3 center;
+
+	LocalVector<Portal> portals;
+};
+
+/// Averages the polygon connections crossing from one cluster to another into portals.
+struct ClusterPortalBuilder {
+	struct PortalSum {
+		Vector3 position;
+		uint32_t count = 0;
+	};
+	HashMap<uint64_t, PortalSum> portal_sums;
+
+	void add_connection(uint32_t p_from_cluster, uint32_t p_to_cluster, const Vector3 &p_position) {
+		PortalSum &portal_sum = portal_sums[((uint64_t)p_from_cluster << 32) | p_to_cluster];
+		portal_sum.position += p_position;
+		portal_sum.count++;
+	}
+
+	void add_portals(LocalVector<Cluster> &r_clusters) const {
+		for (const KeyValue<uint64_t, PortalSum> &E : portal_sums) {
+			Cluster::Portal portal;
+			portal.cluster = E.key & UINT32_MAX;
+			portal.position = E.value.position / E.value.count;
+			r_clusters[E.key >> 32].portals.push_back(portal);
+		}
+	}
 };
 
 struct NavigationPoly {
@@ -171,6 +224,41 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+struct NavigationCluster {
+	/// This cluster.
+	const Cluster *cluster = nullptr;
+
+	/// Index in the heap of traversable clusters.
+	uint32_t traversable_cluster_index = UINT32_MAX;
+
+	/// Cluster this one was entered from, used to travel the corridor backwards.
+	uint32_t back_cluster = UINT32_MAX;
+
+	/// Whether the polygon search may enter this cluster.
+	bool in_corridor = false;
+
+	/// The entry position of this cluster.
+	Vector3 entry;
+	real_t traveled_distance = 0.0;
+	real_t distance_to_destination = 0.0;
+
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+};
+
+struct NavClusterTravelCostGreaterThan {
+	bool operator()(const NavigationCluster *p_cluster_a, const NavigationCluster *p_cluster_b) const {
+		return p_cluster_a->total_travel_cost() > p_cluster_b->total_travel_cost();
+	}
+};
+
+struct NavClusterHeapIndexer {
+	void operator()(NavigationCluster *p_cluster, uint32_t p_heap_index) const {
+		p_cluster->traversable_cluster_index = p_heap_index;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -300,6 +388,43 @@ private:
 		}
 	}
 };
+
+/**
+ * Search state kept between path queries run on the same thread, so
+ * consecutive searches don't reallocate it and only reset what they touched.
+ */
+struct PathSearchArena {
+	LocalVector<NavigationPoly> navigation_polys;
+	LocalVector<uint32_t> touched_polys;
+	Heap<NavigationPoly *, NavPolyTravelCostGreaterThan, NavPolyHeapIndexer> traversable_polys;
+
+	LocalVector<NavigationCluster> navigation_clusters;
+	LocalVector<uint32_t> touched_clusters;
+	Heap<NavigationCluster *, NavClusterTravelCostGreaterThan, NavClusterHeapIndexer> traversable_clusters;
+
+	void begin(uint32_t p_poly_count) {
+		for (uint32_t id : touched_polys) {
+			if (id < navigation_polys.size()) {
+				navigation_polys[id] = NavigationPoly();
+			}
+		}
+		touched_polys.clear();
+		traversable_polys.clear();
+		navigation_polys.resize(p_poly_count);
+	}
+
+	void begin_clusters(uint32_t p_cluster_count) {
+		for (uint32_t id : touched_clusters) {
+			if (id < navigation_clusters.size()) {
+				navigation_clusters[id] = NavigationCluster();
+			}
+		}
+		touched_clusters.clear();
+		traversable_clusters.clear();
+		navigation_clusters.resize(p_cluster_count);
+	}
+};
+
 } // namespace gd
 
 #endif // NAV_UTILS_H
@@ -176,6 +176,15 @@ void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
 				}
 			}
 			print_gpu_profile_task_time.clear();
+
+			if (create_thread) {
+				const CommandQueueMT::Stats stats = command_queue.get_stats();
+				const double frames = print_frame_profile_frame_count;
+				print_line(vformat("COMMAND QUEUE (%s): %.1f commands, %.1f KiB, %.3fms sync stalls per frame, max depth %.1f KiB.",
+						command_queue.is_lock_free() ? "lock-free" : "locked", stats.commands / frames, stats.bytes / 1024.0 / frames, stats.sync_stall_usec / 1000.0 / frames, stats.max_pending_bytes / 1024.0));
+				command_queue.reset_stats();
+			}
+
 			print_frame_profile_ticks_from = OS::get_singleton()->get_ticks_usec();
 			print_frame_profile_frame_count = 0;
 		}
@@ -110,6 +110,34 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
 
+TEST_CASE("[FileAccess] Mapped read") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	// Plain files are only mapped when the caller asks for it.
+	f->seek(6);
+	CHECK(f->get_mapped_buffer(8) == nullptr);
+	CHECK(f->get_position() == 6);
+
+	f->set_memory_mapping_enabled(true);
+	const uint8_t *view = f->get_mapped_buffer(8);
+	if (!view) {
+		return; // File mapping is not available on this platform.
+	}
+	CHECK(memcmp(view, "darkness", 8) == 0);
+	CHECK(f->get_position() == 14);
+	CHECK(f->get_8() == '\n');
+
+	// Views past the end of the file are refused without moving the cursor.
+	CHECK(f->get_mapped_buffer(f->get_length()) == nullptr);
+	CHECK(f->get_position() == 15);
+
+	// The view stays readable while regular reads keep going.
+	f->seek(0);
+	CHECK(f->get_buffer(5) == Vector<uint8_t>({ 'H', 'e', 'l', 'l', 'o' }));
+	CHECK(memcmp(view, "darkness", 8) == 0);
+}
+
 TEST_CASE("[FileAccess] Get/Store floating point values") {
 	// BigEndian Hex: 0x40490E56
 	// LittleEndian Hex: 0x560E4940
@@ -119,6 +119,46 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Read a packed file through the mapped pack") {
+	const String source_path = TestUtils::get_temp_path("mapped_pack_source.txt");
+	const CharString contents = String("Hello mapped pack").utf8();
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer((const uint8_t *)contents.get_data(), contents.length());
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_mapped.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("test_mapped_pack/hello.txt", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, false, 0) == OK);
+	Ref<FileAccess> f = PackedData::get_singleton()->try_open_path("res://test_mapped_pack/hello.txt");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)contents.length());
+
+	f->seek(6);
+	const uint8_t *view = f->get_mapped_buffer(6);
+	if (!view) {
+		return; // File mapping is not available on this platform.
+	}
+	CHECK(memcmp(view, "mapped", 6) == 0);
+	CHECK(f->get_position() == 12);
+
+	// Views past the end of the packed file are refused, even though the pack continues.
+	CHECK(f->get_mapped_buffer(f->get_length()) == nullptr);
+	CHECK(f->get_position() == 12);
+
+	// Regular reads are served from the same mapping.
+	CHECK(f->get_buffer(5) == Vector<uint8_t>({ ' ', 'p', 'a', 'c', 'k' }));
+	CHECK(f->get_buffer(1).is_empty());
+	CHECK(f->eof_reached());
+	f->seek(0);
+	CHECK(f->get_as_utf8_string() == "Hello mapped pack");
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
@@ -33,7 +33,11 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/config/project_settings.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/marshalls.h"
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
@@ -114,6 +118,128 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Loading many sub-resources from a binary file") {
+	// Large enough for the sub-resources of mapped files to be decoded on worker threads.
+	Ref<Resource> resource = memnew(Resource);
+	Array children;
+	Ref<Resource> previous;
+	for (int i = 0; i < 16; i++) {
+		Ref<Resource> child = memnew(Resource);
+		child->set_name(vformat("Child %d", i));
+		PackedFloat32Array data;
+		data.resize(8192);
+		for (int j = 0; j < data.size(); j++) {
+			data.set(j, i * 8192 + j);
+		}
+		child->set_meta("data", data);
+		if (previous.is_valid()) {
+			child->set_meta("previous", previous);
+		}
+		children.push_back(child);
+		previous = child;
+	}
+	resource->set_meta("children", children);
+
+	const String save_path_binary = TestUtils::get_temp_path("resource.res");
+	ResourceSaver::save(resource, save_path_binary);
+
+	Ref<Resource> loaded_resource;
+	SUBCASE("From a compressed file") {
+		// Compressed files are read through FileAccessCompressed, which can't be mapped,
+		// so these are decoded one by one.
+		const String save_path_compressed = TestUtils::get_temp_path("resource_compressed.res");
+		ResourceSaver::save(resource, save_path_compressed, ResourceSaver::FLAG_COMPRESS);
+		loaded_resource = ResourceLoader::load(save_path_compressed, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	}
+	SUBCASE("From a memory-backed file") {
+		// Memory and pack files are mapped, which lets worker threads decode the sub-resources.
+		const Vector<uint8_t> bytes = FileAccess::get_file_as_bytes(save_path_binary);
+		Ref<FileAccessMemory> file;
+		file.instantiate();
+		REQUIRE(file->open_custom(bytes.ptr(), bytes.size()) == OK);
+		ResourceLoaderBinary loader;
+		loader.open(file);
+		REQUIRE(loader.load() == OK);
+		loaded_resource = loader.get_resource();
+	}
+	REQUIRE(loaded_resource.is_valid());
+	const Array loaded_children = loaded_resource->get_meta("children");
+	REQUIRE(loaded_children.size() == 16);
+	for (int i = 0; i < 16; i++) {
+		const Ref<Resource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		const PackedFloat32Array data = child->get_meta("data");
+		REQUIRE(data.size() == 8192);
+		CHECK(data[0] == i * 8192);
+		CHECK(data[8191] == i * 8192 + 8191);
+		if (i > 0) {
+			CHECK_MESSAGE(
+					Ref<Resource>(child->get_meta("previous")) == loaded_children[i - 1],
+					"References between sub-resources should point to the loaded instances.");
+		}
+	}
+}
+
+TEST_CASE("[Resource] Saving and loading packed arrays") {
+	PackedByteArray bytes;
+	PackedInt32Array ints;
+	PackedFloat32Array floats;
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	for (int i = 0; i < 4096; i++) {
+		bytes.push_back(i % 7);
+		ints.push_back(i * 3 - 500);
+		floats.push_back(i * 0.5f);
+		vectors.push_back(Vector3(i, -i, i % 13));
+		colors.push_back(Color(i % 2, 0.25, 0.5, 1.0));
+	}
+	bytes.push_back(42); // Not a multiple of 4, exercises the padding.
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	Array nested_arrays;
+	nested_arrays.push_back(ints);
+	nested_arrays.push_back(floats);
+	resource->set_meta("nested", nested_arrays);
+	resource->set_meta("vectors", vectors);
+	resource->set_meta("colors", colors);
+	resource->set_meta("small", PackedInt32Array({ 1, 2, 3 }));
+
+	const String save_path_binary = TestUtils::get_temp_path("resource.res");
+	// The format version follows the "RSRC" magic, endianness, 64-bit flag and engine version.
+	const auto get_format_version = [&]() {
+		const Vector<uint8_t> file = FileAccess::get_file_as_bytes(save_path_binary);
+		REQUIRE(file.size() > 24);
+		return decode_uint32(&file[20]);
+	};
+	const bool compress = GLOBAL_GET("compression/binary_resources/compress_packed_arrays");
+	for (int i = 0; i < 2; i++) {
+		ProjectSettings::get_singleton()->set_setting("compression/binary_resources/compress_packed_arrays", i == 1);
+		ResourceSaver::save(resource, save_path_binary);
+		// Files are only marked with the newer version when an array was compressed.
+		CHECK(get_format_version() == (i == 1 ? 7u : 6u));
+
+		const Ref<Resource> &loaded_resource = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(loaded_resource.is_valid());
+		CHECK(PackedByteArray(loaded_resource->get_meta("bytes")) == bytes);
+		const Array nested = loaded_resource->get_meta("nested");
+		REQUIRE(nested.size() == 2);
+		CHECK(PackedInt32Array(nested[0]) == ints);
+		CHECK(PackedFloat32Array(nested[1]) == floats);
+		CHECK(PackedVector3Array(loaded_resource->get_meta("vectors")) == vectors);
+		CHECK(PackedColorArray(loaded_resource->get_meta("colors")) == colors);
+		CHECK(PackedInt32Array(loaded_resource->get_meta("small")) == PackedInt32Array({ 1, 2, 3 }));
+	}
+
+	// Arrays too small to be worth compressing keep the file readable by older versions.
+	Ref<Resource> small_resource = memnew(Resource);
+	small_resource->set_meta("small", PackedInt32Array({ 1, 2, 3 }));
+	ResourceSaver::save(small_resource, save_path_binary);
+	CHECK(get_format_version() == 6u);
+	ProjectSettings::get_singleton()->set_setting("compression/binary_resources/compress_packed_arrays", compress);
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
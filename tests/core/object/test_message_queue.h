@@ -0,0 +1,215 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class Recorder : public Object {
+public:
+	Mutex mutex;
+	LocalVector<int> values;
+	int notifications = 0;
+
+	void record(int p_value) {
+		MutexLock lock(mutex);
+		values.push_back(p_value);
+	}
+
+	void record_none() {
+		record(-1);
+	}
+
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_POSTINITIALIZE) {
+			return;
+		}
+		notifications++;
+	}
+};
+
+struct PushThreadData {
+	Recorder *recorder = nullptr;
+	int first = 0;
+	int count = 0;
+	SafeFlag done;
+};
+
+static void push_values(void *p_userdata) {
+	PushThreadData *data = (PushThreadData *)p_userdata;
+	for (int i = 0; i < data->count; i++) {
+		MessageQueue::get_singleton()->push_callable(callable_mp(data->recorder, &Recorder::record), data->first + i);
+	}
+	data->done.set();
+}
+
+TEST_CASE("[MessageQueue] Typed calls are run in order") {
+	Recorder *recorder = memnew(Recorder);
+
+	MessageQueue::get_singleton()->push_callable(callable_mp(recorder, &Recorder::record_none));
+	MessageQueue::get_singleton()->push_callable(callable_mp(recorder, &Recorder::record), 1);
+	MessageQueue::get_singleton()->push_callable(callable_mp(recorder, &Recorder::record), Variant(2));
+	CHECK(MessageQueue::get_singleton()->has_messages());
+
+	MessageQueue::get_singleton()->flush();
+	CHECK_FALSE(MessageQueue::get_singleton()->has_messages());
+
+	REQUIRE(recorder->values.size() == 3);
+	CHECK(recorder->values[0] == -1);
+	CHECK(recorder->values[1] == 1);
+	CHECK(recorder->values[2] == 2);
+
+	memdelete(recorder);
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from threads keep their per-thread order") {
+	const int thread_count = 4;
+	const int push_count = 2000;
+	Recorder *recorder = memnew(Recorder);
+
+	PushThreadData data[thread_count];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].recorder = recorder;
+		data[i].first = i * push_count;
+		data[i].count = push_count;
+		threads[i].start(push_values, &data[i]);
+	}
+
+	// Flush concurrently with the producers, like the main loop would.
+	bool running = true;
+	while (running) {
+		running = false;
+		for (int i = 0; i < thread_count; i++) {
+			running = running || !data[i].done.is_set();
+		}
+		MessageQueue::get_singleton()->flush();
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	MessageQueue::get_singleton()->flush();
+	CHECK_FALSE(MessageQueue::get_singleton()->has_messages());
+
+	REQUIRE(recorder->values.size() == uint32_t(thread_count * push_count));
+	int last[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		last[i] = -1;
+	}
+	bool ordered = true;
+	for (int value : recorder->values) {
+		const int thread = value / push_count;
+		ordered = ordered && value > last[thread];
+		last[thread] = value;
+	}
+	CHECK_MESSAGE(ordered, "Calls pushed by the same thread should run in the order they were pushed.");
+
+	memdelete(recorder);
+}
+
+struct AlternatingPushData {
+	Recorder *recorder = nullptr;
+	int count = 0;
+	Semaphore worker_turn;
+	Semaphore main_turn;
+};
+
+static void push_even_values(void *p_userdata) {
+	AlternatingPushData *data = (AlternatingPushData *)p_userdata;
+	for (int i = 0; i < data->count; i += 2) {
+		data->worker_turn.wait();
+		MessageQueue::get_singleton()->push_callable(callable_mp(data->recorder, &Recorder::record), i);
+		data->main_turn.post();
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from the main thread and other threads run in push order") {
+	Recorder *recorder = memnew(Recorder);
+
+	AlternatingPushData data;
+	data.recorder = recorder;
+	data.count = 200;
+	Thread thread;
+	thread.start(push_even_values, &data);
+
+	// The worker pushes even values and the main thread odd ones, taking turns.
+	for (int i = 1; i < data.count; i += 2) {
+		data.worker_turn.post();
+		data.main_turn.wait();
+		MessageQueue::get_singleton()->push_callable(callable_mp(recorder, &Recorder::record), i);
+		if (i == data.count / 2 + 1) {
+			MessageQueue::get_singleton()->flush(); // Part of them are spliced by an earlier flush.
+		}
+	}
+	thread.wait_to_finish();
+	MessageQueue::get_singleton()->flush();
+	CHECK_FALSE(MessageQueue::get_singleton()->has_messages());
+
+	REQUIRE(recorder->values.size() == uint32_t(data.count));
+	bool ordered = true;
+	for (int i = 0; i < data.count; i++) {
+		ordered = ordered && recorder->values[i] == i;
+	}
+	CHECK_MESSAGE(ordered, "Calls should run in the order they were pushed, regardless of the pushing thread.");
+
+	memdelete(recorder);
+}
+
+TEST_CASE("[MessageQueue] Staged calls can be cleared") {
+	Recorder *recorder = memnew(Recorder);
+
+	PushThreadData data;
+	data.recorder = recorder;
+	data.count = 10;
+	Thread thread;
+	thread.start(push_values, &data);
+	thread.wait_to_finish();
+
+	CHECK(MessageQueue::get_singleton()->has_messages());
+	MessageQueue::get_singleton()->clear();
+	CHECK_FALSE(MessageQueue::get_singleton()->has_messages());
+	MessageQueue::get_singleton()->flush();
+	CHECK(recorder->values.is_empty());
+
+	memdelete(recorder);
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/memory.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+static bool check_fill(const uint8_t *p_data, size_t p_size, uint8_t p_value) {
+	for (size_t i = 0; i < p_size; i++) {
+		if (p_data[i] != p_value) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[Memory] Reallocation keeps contents across block sizes") {
+	// Sizes cross every size class boundary of the thread cache allocator, and go past it.
+	const size_t sizes[] = { 1, 16, 17, 100, 128, 129, 250, 500, 1000, 1100, 4096, 300, 8, 0 };
+
+	uint8_t *data = (uint8_t *)Memory::alloc_static(1);
+	data[0] = 1;
+	size_t prev_size = 1;
+	bool kept = true;
+	for (size_t size : sizes) {
+		data = (uint8_t *)Memory::realloc_static(data, size);
+		if (size == 0) {
+			CHECK(data == nullptr);
+			break;
+		}
+		kept &= check_fill(data, MIN(prev_size, size), (uint8_t)prev_size);
+		memset(data, (uint8_t)size, size);
+		prev_size = size;
+	}
+	CHECK(kept);
+}
+
+#ifdef DEBUG_ENABLED
+static void alloc_on_thread(void *p_userdata) {
+	LocalVector<void *> &blocks = *(LocalVector<void *> *)p_userdata;
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		blocks[i] = Memory::alloc_static(8 + i * 7);
+	}
+}
+
+TEST_CASE("[Memory] Usage is tracked for blocks freed on a different thread") {
+	LocalVector<void *> blocks;
+	blocks.resize(200);
+
+	uint64_t block_bytes = 0;
+	for (uint32_t i = 0; i < blocks.size(); i++) {
+		block_bytes += 8 + i * 7;
+	}
+
+	Thread thread;
+	thread.start(alloc_on_thread, &blocks);
+	thread.wait_to_finish();
+
+	const uint64_t usage_with_blocks = Memory::get_mem_usage();
+	CHECK(Memory::get_mem_max_usage() >= usage_with_blocks);
+
+	for (void *block : blocks) {
+		Memory::free_static(block);
+	}
+	CHECK(usage_with_blocks - Memory::get_mem_usage() == block_bytes);
+}
+#endif
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = StringName("test_string_name_interning");
+	const StringName b = StringName(String("test_string_name_interning"));
+	const StringName c = _scs_create("test_string_name_interning");
+
+	CHECK(a == b);
+	CHECK(a == c);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a == "test_string_name_interning");
+	CHECK(StringName::search("test_string_name_interning") == a);
+	CHECK(StringName::search(U"test_string_name_interning") == a);
+	CHECK(StringName::search(String("test_string_name_interning")) == a);
+
+	CHECK(StringName("").is_empty());
+	CHECK(StringName() == StringName(String()));
+}
+
+TEST_CASE("[StringName] Released names can be created again") {
+	{
+		StringName temporary = StringName("test_string_name_released");
+		CHECK(StringName::search("test_string_name_released") == temporary);
+	}
+	CHECK(StringName::search("test_string_name_released") == StringName());
+
+	const StringName again = StringName("test_string_name_released");
+	CHECK(again == "test_string_name_released");
+	CHECK(StringName::search("test_string_name_released") == again);
+}
+
+struct StringNameThreadState {
+	const LocalVector<String> *shared_names = nullptr;
+	const LocalVector<StringName> *expected = nullptr;
+	int thread_index = 0;
+	int iterations = 0;
+	uint64_t mismatches = 0;
+};
+
+static void string_name_thread_func(void *p_userdata) {
+	StringNameThreadState *state = static_cast<StringNameThreadState *>(p_userdata);
+	const LocalVector<String> &names = *state->shared_names;
+	const String prefix = "test_string_name_thread_" + itos(state->thread_index) + "_";
+
+	for (int i = 0; i < state->iterations; i++) {
+		// Names alive for the whole test, only looked up.
+		const uint32_t index = (i * 7919u + state->thread_index * 104729u) % names.size();
+		if (StringName(names[index]) != (*state->expected)[index]) {
+			state->mismatches++;
+		}
+
+		// Names created and released by this thread only, which inserts and removes entries.
+		const String unique = prefix + itos(i & 63);
+		StringName created = StringName(unique);
+		if (created != unique) {
+			state->mismatches++;
+		}
+
+		// Names created and released by all threads at once.
+		StringName contended = StringName(names[i % 16] + "_contended");
+		if (contended.data_unique_pointer() != StringName(names[i % 16] + "_contended").data_unique_pointer()) {
+			state->mismatches++;
+		}
+	}
+}
+
+TEST_CASE("[StringName] Multithreaded creation and release") {
+	LocalVector<String> names;
+	LocalVector<StringName> expected;
+	for (int i = 0; i < 4096; i++) {
+		names.push_back("test_string_name_shared_" + itos(i));
+		expected.push_back(StringName(names[i]));
+	}
+
+	const int iterations = 20000;
+	const int max_threads = CLAMP<int>(OS::get_singleton()->get_processor_count(), 2, 16);
+	uint64_t single_thread_usec = 0;
+	for (int threads = 1; threads <= max_threads; threads = threads < max_threads ? MIN(threads * 2, max_threads) : threads + 1) {
+		LocalVector<StringNameThreadState> states;
+		states.resize(threads);
+		LocalVector<Thread> thread_pool;
+		thread_pool.resize(threads);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < threads; i++) {
+			states[i].shared_names = &names;
+			states[i].expected = &expected;
+			states[i].thread_index = i;
+			states[i].iterations = iterations;
+			thread_pool[i].start(string_name_thread_func, &states[i]);
+		}
+		uint64_t mismatches = 0;
+		for (int i = 0; i < threads; i++) {
+			thread_pool[i].wait_to_finish();
+			mismatches += states[i].mismatches;
+		}
+		const uint64_t usec = MAX<uint64_t>(OS::get_singleton()->get_ticks_usec() - begin, 1);
+
+		if (threads == 1) {
+			single_thread_usec = usec;
+		}
+		// Each thread does the same amount of work, so perfect scaling keeps the time constant.
+		MESSAGE(vformat("%d thread(s): %d usec, %.2f M StringName constructions per second, throughput %.2fx.", threads, usec, threads * iterations * 4.0 / usec, (double)single_thread_usec * threads / usec));
+		CHECK(mismatches == 0);
+	}
+
+	for (int i = 0; i < 64; i++) {
+		CHECK(StringName::search("test_string_name_thread_0_" + itos(i)) == StringName());
+	}
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -448,6 +448,128 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+class MultiProducerState {
+public:
+	static const int PRODUCERS = 4;
+	static const int COMMANDS_PER_PRODUCER = 20000;
+
+	CommandQueueMT command_queue;
+	SafeFlag producers_done;
+	int last_sequence[PRODUCERS];
+	int out_of_order = 0;
+	int received = 0;
+
+	MultiProducerState() {
+		for (int i = 0; i < PRODUCERS; i++) {
+			last_sequence[i] = -1;
+		}
+	}
+
+	void record(int p_producer, int p_sequence, Transform3D p_padding) {
+		if (p_sequence != last_sequence[p_producer] + 1) {
+			out_of_order++;
+		}
+		last_sequence[p_producer] = p_sequence;
+		received++;
+	}
+	int record_and_ret(int p_producer, int p_sequence) {
+		record(p_producer, p_sequence, Transform3D());
+		return p_sequence;
+	}
+
+	struct Producer {
+		MultiProducerState *state = nullptr;
+		int index = 0;
+		int wrong_returns = 0;
+	};
+
+	static void producer_loop(void *p_userdata) {
+		Producer *producer = static_cast<Producer *>(p_userdata);
+		MultiProducerState *state = producer->state;
+		for (int i = 0; i < COMMANDS_PER_PRODUCER; i++) {
+			if (i % 1000 == 999) {
+				int ret = -1;
+				state->command_queue.push_and_ret(state, &MultiProducerState::record_and_ret, producer->index, i, &ret);
+				if (ret != i) {
+					producer->wrong_returns++;
+				}
+			} else {
+				state->command_queue.push(state, &MultiProducerState::record, producer->index, i, Transform3D());
+			}
+		}
+	}
+
+	static void consumer_loop(void *p_userdata) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_userdata);
+		while (!state->producers_done.is_set()) {
+			state->command_queue.flush_if_pending();
+		}
+		state->command_queue.flush_all();
+	}
+};
+
+static void test_command_queue_multiple_producers(int p_ring_size_kb) {
+	const char *RING_SIZE_SETTING = "memory/limits/command_queue/lock_free_ring_size_kb";
+	ProjectSettings::get_singleton()->set_setting(RING_SIZE_SETTING, p_ring_size_kb);
+
+	MultiProducerState state;
+	CHECK(state.command_queue.is_lock_free() == (p_ring_size_kb > 0));
+
+	MultiProducerState::Producer producers[MultiProducerState::PRODUCERS];
+	Thread producer_threads[MultiProducerState::PRODUCERS];
+	Thread consumer_thread;
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	consumer_thread.start(&MultiProducerState::consumer_loop, &state);
+	for (int i = 0; i < MultiProducerState::PRODUCERS; i++) {
+		producers[i].state = &state;
+		producers[i].index = i;
+		producer_threads[i].start(&MultiProducerState::producer_loop, &producers[i]);
+	}
+	int wrong_returns = 0;
+	for (int i = 0; i < MultiProducerState::PRODUCERS; i++) {
+		producer_threads[i].wait_to_finish();
+		wrong_returns += producers[i].wrong_returns;
+	}
+	state.producers_done.set();
+	consumer_thread.wait_to_finish();
+	const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const int total = MultiProducerState::PRODUCERS * MultiProducerState::COMMANDS_PER_PRODUCER;
+	CHECK_MESSAGE(state.received == total, "All commands should run exactly once.");
+	CHECK_MESSAGE(state.out_of_order == 0, "Commands from the same thread should run in the order they were pushed.");
+	CHECK(wrong_returns == 0);
+
+	const CommandQueueMT::Stats stats = state.command_queue.get_stats();
+	CHECK(stats.commands == (uint64_t)total);
+	CHECK(stats.sync_count == (uint64_t)(MultiProducerState::PRODUCERS * (MultiProducerState::COMMANDS_PER_PRODUCER / 1000)));
+	CHECK(stats.bytes > 0);
+	if (p_ring_size_kb == 0) {
+		CHECK(stats.locked_commands == (uint64_t)total);
+	}
+	MESSAGE(vformat("Ring of %d KiB: %d usec, %d of %d commands locked, max depth %d bytes, sync stalls %d usec.", p_ring_size_kb, usec, stats.locked_commands, total, stats.max_pending_bytes, stats.sync_stall_usec));
+
+	state.command_queue.reset_stats();
+	CHECK(state.command_queue.get_stats().commands == 0);
+	CHECK(state.command_queue.get_stats().bytes == 0);
+
+	ProjectSettings::get_singleton()->set_setting(RING_SIZE_SETTING,
+			ProjectSettings::get_singleton()->property_get_revert(RING_SIZE_SETTING));
+}
+
+TEST_CASE("[CommandQueue] Multiple producers with the locked queue") {
+	test_command_queue_multiple_producers(0);
+}
+
+TEST_CASE("[CommandQueue] Multiple producers with the lock-free ring") {
+	test_command_queue_multiple_producers(256);
+}
+
+TEST_CASE("[CommandQueue] Multiple producers overflowing a small lock-free ring") {
+	// Small enough to fill up and fall back to the locked queue now and then.
+	test_command_queue_multiple_producers(1);
+}
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
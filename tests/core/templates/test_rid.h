@@ -33,7 +33,11 @@
 #ifndef TEST_RID_H
 #define TEST_RID_H
 
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
+#include "core/templates/rid_owner.h"
 
 #include "tests/test_macros.h"
 
@@ -98,6 +102,132 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'295).get_local_index() == 4'294'967'295);
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
+
+TEST_CASE("[RID_Owner] Allocation, lookup and release") {
+	RID_Owner<int, true> owner(sizeof(int) * 4);
+
+	LocalVector<RID> rids;
+	for (int i = 0; i < 64; i++) {
+		rids.push_back(owner.make_rid(i));
+	}
+	CHECK(owner.get_rid_count() == 64);
+
+	bool all_found = true;
+	for (int i = 0; i < 64; i++) {
+		int *value = owner.get_or_null(rids[i]);
+		all_found = all_found && value && *value == i && owner.owns(rids[i]);
+	}
+	CHECK(all_found);
+
+	owner.free(rids[10]);
+	CHECK(owner.get_or_null(rids[10]) == nullptr);
+	CHECK_FALSE(owner.owns(rids[10]));
+
+	// The freed slot is reused with a new validator.
+	RID reused = owner.make_rid(100);
+	CHECK(reused.get_local_index() == rids[10].get_local_index());
+	CHECK(owner.get_or_null(rids[10]) == nullptr);
+	CHECK(*owner.get_or_null(reused) == 100);
+
+	RID uninitialized = owner.allocate_rid();
+	CHECK_FALSE(owner.owns(RID()));
+	owner.initialize_rid(uninitialized, 200);
+	CHECK(*owner.get_or_null(uninitialized) == 200);
+
+	owner.free(reused);
+	owner.free(uninitialized);
+	for (int i = 0; i < 64; i++) {
+		if (i != 10) {
+			owner.free(rids[i]);
+		}
+	}
+	CHECK(owner.get_rid_count() == 0);
+}
+
+struct RIDOwnerThreadState {
+	RID_Owner<uint64_t, true> *owner = nullptr;
+	const LocalVector<RID> *shared = nullptr;
+	Mutex *mutex = nullptr; // Baseline that locks around every lookup.
+	int iterations = 0;
+	uint64_t mismatches = 0;
+};
+
+static void rid_owner_thread_func(void *p_userdata) {
+	RIDOwnerThreadState *state = (RIDOwnerThreadState *)p_userdata;
+	const LocalVector<RID> &shared = *state->shared;
+	for (int i = 0; i < state->iterations; i++) {
+		const RID rid = shared[i % shared.size()];
+		uint64_t *value;
+		if (state->mutex) {
+			MutexLock lock(*state->mutex);
+			value = state->owner->get_or_null(rid);
+		} else {
+			value = state->owner->get_or_null(rid);
+		}
+		if (!value || *value != rid.get_id()) {
+			state->mismatches++;
+		}
+
+		// Keep allocating while other threads look up, so chunks get published concurrently.
+		if ((i & 63) == 0) {
+			RID own = state->owner->make_rid(0);
+			*state->owner->get_or_null(own) = own.get_id();
+			if (*state->owner->get_or_null(own) != own.get_id()) {
+				state->mismatches++;
+			}
+			state->owner->free(own);
+		}
+	}
+}
+
+TEST_CASE("[RID_Owner] Contended lookups from several threads") {
+	RID_Owner<uint64_t, true> owner(1024);
+	LocalVector<RID> shared;
+	for (int i = 0; i < 1024; i++) {
+		RID rid = owner.make_rid();
+		*owner.get_or_null(rid) = rid.get_id();
+		shared.push_back(rid);
+	}
+
+	const int iterations = 200000;
+	const int max_threads = CLAMP<int>(OS::get_singleton()->get_processor_count(), 2, 16);
+	Mutex mutex;
+	for (int locked = 1; locked >= 0; locked--) {
+		uint64_t single_thread_usec = 0;
+		for (int threads = 1; threads <= max_threads; threads = threads < max_threads ? MIN(threads * 2, max_threads) : threads + 1) {
+			LocalVector<RIDOwnerThreadState> states;
+			states.resize(threads);
+			LocalVector<Thread> thread_pool;
+			thread_pool.resize(threads);
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < threads; i++) {
+				states[i].owner = &owner;
+				states[i].shared = &shared;
+				states[i].mutex = locked ? &mutex : nullptr;
+				states[i].iterations = iterations;
+				thread_pool[i].start(rid_owner_thread_func, &states[i]);
+			}
+			uint64_t mismatches = 0;
+			for (int i = 0; i < threads; i++) {
+				thread_pool[i].wait_to_finish();
+				mismatches += states[i].mismatches;
+			}
+			const uint64_t usec = MAX<uint64_t>(OS::get_singleton()->get_ticks_usec() - begin, 1);
+
+			if (threads == 1) {
+				single_thread_usec = usec;
+			}
+			MESSAGE(vformat("%s lookups, %d thread(s): %d usec, throughput %.2fx.", locked ? "Locked" : "Lock-free", threads, usec, (double)single_thread_usec * threads / usec));
+			CHECK(mismatches == 0);
+		}
+	}
+
+	CHECK(owner.get_rid_count() == shared.size());
+	for (const RID &rid : shared) {
+		owner.free(rid);
+	}
+}
 } // namespace TestRID
 
 #endif // TEST_RID_H
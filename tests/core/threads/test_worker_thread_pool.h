@@ -109,6 +109,158 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_nested_leaf(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+static int nested_elements = 0;
+static LocalVector<WorkerThreadPool::GroupID> nested_groups;
+
+static void static_nested_root(void *p_arg) {
+	// Posted from a pool thread, so these go to its own work queue and get stolen by the others.
+	nested_groups[(uintptr_t)p_arg] = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_leaf, nullptr, nested_elements, -1, true);
+
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	for (int i = 0; i < 8; i++) {
+		tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)(uintptr_t)(nested_elements + i), true));
+	}
+	for (WorkerThreadPool::TaskID task : tasks) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Process tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int roots = Math::pow(2.0f, Math::random(0.0f, 3.0f));
+		nested_elements = Math::pow(2.0f, Math::random(0.0f, 8.0f));
+
+		counter.clear();
+		counter.resize(nested_elements + 8);
+		nested_groups.clear();
+		nested_groups.resize(roots);
+
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		for (int i = 0; i < roots; i++) {
+			tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_nested_root, (void *)(uintptr_t)i, true));
+		}
+		for (WorkerThreadPool::TaskID task : tasks) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+		}
+		for (WorkerThreadPool::GroupID group : nested_groups) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		}
+
+		bool all_run = true;
+		for (int i = 1; i < nested_elements + 8; i++) {
+			all_run &= counter[i].get() == roots;
+		}
+		CHECK(all_run);
+		// Element 0 is also incremented by the non-group tasks, adding 2 each.
+		CHECK(counter[0].get() == roots * (1 + 8 * 2));
+	}
+}
+
+static void static_scaling_work(void *p_arg, uint32_t p_index) {
+	// Enough busy work per element for the scheduling overhead not to dominate.
+	uint64_t *results = (uint64_t *)p_arg;
+	uint64_t value = p_index;
+	for (int i = 0; i < 2000; i++) {
+		value = value * 6364136223846793005ULL + 1442695040888963407ULL;
+	}
+	results[p_index] = value;
+}
+
+TEST_CASE("[WorkerThreadPool] Group task scaling from 1 to N tasks") {
+	// The pool keeps its thread count, so parallelism is varied through the number of
+	// tasks the group is split into, up to one per pool thread.
+	const int elements = 20000;
+	LocalVector<uint64_t> reference;
+	reference.resize(elements);
+	static_scaling_work(nullptr, 0); // Warm up.
+	for (int i = 0; i < elements; i++) {
+		static_scaling_work(reference.ptr(), i);
+	}
+
+	LocalVector<uint64_t> results;
+	results.resize(elements);
+
+	const int max_tasks = WorkerThreadPool::get_singleton()->get_thread_count();
+	uint64_t single_task_usec = 0;
+	for (int tasks = 1; tasks <= max_tasks; tasks = tasks < max_tasks ? MIN(tasks * 2, max_tasks) : tasks + 1) {
+		memset(results.ptr(), 0, sizeof(uint64_t) * elements);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_scaling_work, results.ptr(), elements, tasks, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		const uint64_t usec = MAX<uint64_t>(OS::get_singleton()->get_ticks_usec() - begin, 1);
+
+		if (tasks == 1) {
+			single_task_usec = usec;
+		}
+		MESSAGE(vformat("%d task(s): %d usec, speedup %.2fx.", tasks, usec, (double)single_task_usec / usec));
+
+		bool all_correct = true;
+		for (int i = 0; i < elements; i++) {
+			all_correct &= results[i] == reference[i];
+		}
+		CHECK(all_correct);
+	}
+}
+
+static SafeNumeric<uint32_t> dependency_clock;
+static uint32_t dependency_stamps[20];
+
+static void static_dependency_task(void *p_arg) {
+	OS::get_singleton()->delay_usec(1000); // Give dependents a chance to run too early, if they could.
+	dependency_stamps[(uint64_t)p_arg] = dependency_clock.increment();
+}
+
+static void static_dependency_group(void *p_arg, uint32_t p_index) {
+	dependency_stamps[(uint64_t)p_arg + p_index] = dependency_clock.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Run tasks and groups after their dependencies") {
+	// Diamond-shaped graph: root -> (group, side) -> join.
+	// The group takes slots 1 to 16, the other tasks 0, 17 and 18.
+	const uint32_t group_elements = 16;
+	for (int iteration = 0; iteration < 10; iteration++) {
+		dependency_clock.set(0);
+		memset(dependency_stamps, 0, sizeof(dependency_stamps));
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		WorkerThreadPool::TaskID root = pool->add_native_task(static_dependency_task, (void *)0);
+		WorkerThreadPool::GroupID group = pool->add_dependent_native_group_task(static_dependency_group, (void *)1, group_elements, { root });
+		WorkerThreadPool::TaskID side = pool->add_dependent_native_task(static_dependency_task, (void *)17, { root }, true);
+		WorkerThreadPool::GroupID empty = pool->add_dependent_native_group_task(static_dependency_group, nullptr, 0, { side });
+		WorkerThreadPool::TaskID join = pool->add_dependent_native_task(static_dependency_task, (void *)18, { group, empty });
+
+		pool->wait_for_task_completion(join);
+		pool->wait_for_task_completion(side);
+		pool->wait_for_task_completion(root);
+		pool->wait_for_group_task_completion(group);
+		pool->wait_for_group_task_completion(empty);
+
+		bool group_after_root = true;
+		bool join_after_group = true;
+		for (uint32_t i = 1; i <= group_elements; i++) {
+			group_after_root &= dependency_stamps[i] > dependency_stamps[0];
+			join_after_group &= dependency_stamps[18] > dependency_stamps[i];
+		}
+		CHECK(dependency_stamps[0] == 1);
+		CHECK(group_after_root);
+		CHECK(dependency_stamps[17] > dependency_stamps[0]);
+		CHECK(join_after_group);
+		CHECK(dependency_stamps[18] > dependency_stamps[17]);
+		CHECK(dependency_clock.get() == group_elements + 3);
+	}
+
+	// Dependencies already completed and waited for don't hold tasks back.
+	WorkerThreadPool::TaskID done = WorkerThreadPool::get_singleton()->add_native_task(static_dependency_task, (void *)0);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(done);
+	WorkerThreadPool::TaskID after_done = WorkerThreadPool::get_singleton()->add_dependent_native_task(static_dependency_task, (void *)18, { done });
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(after_done) == OK);
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
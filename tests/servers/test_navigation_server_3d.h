@@ -33,6 +33,8 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
+#include "modules/navigation/nav_avoidance_batch.h"
 #include "modules/navigation/nav_utils.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
@@ -64,6 +66,14 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+static inline real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
 struct GreaterThan {
 	bool operator()(int p_a, int p_b) const { return p_a > p_b; }
 };
@@ -456,6 +466,94 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should make agents avoid each other with batched avoidance") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_avoidance", true);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/use_batched_avoidance", false);
+		RID agent_1 = navigation_server->agent_create();
+		RID agent_2 = navigation_server->agent_create();
+		RID agent_3 = navigation_server->agent_create();
+
+		navigation_server->map_set_active(map, true);
+
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_position(agent_1, Vector3(0, 0, 0));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_velocity(agent_1, Vector3(1, 0, 0));
+		CallableMock agent_1_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_1, callable_mp(&agent_1_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_position(agent_2, Vector3(2.5, 0, 0.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_velocity(agent_2, Vector3(-1, 0, 0));
+		CallableMock agent_2_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_2, callable_mp(&agent_2_avoidance_callback_mock, &CallableMock::function1));
+
+		// Far outside of the neighbor distance of the other agents.
+		navigation_server->agent_set_map(agent_3, map);
+		navigation_server->agent_set_avoidance_enabled(agent_3, true);
+		navigation_server->agent_set_position(agent_3, Vector3(500, 0, 500));
+		navigation_server->agent_set_radius(agent_3, 1);
+		navigation_server->agent_set_velocity(agent_3, Vector3(1, 0, 0));
+		CallableMock agent_3_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_3, callable_mp(&agent_3_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(agent_1_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_2_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_3_avoidance_callback_mock.function1_calls, 1);
+		Vector3 agent_1_safe_velocity = agent_1_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_2_safe_velocity = agent_2_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_3_safe_velocity = agent_3_avoidance_callback_mock.function1_latest_arg0;
+		CHECK_MESSAGE(agent_1_safe_velocity.x > 0, "agent 1 should move a bit along desired velocity (+X)");
+		CHECK_MESSAGE(agent_2_safe_velocity.x < 0, "agent 2 should move a bit along desired velocity (-X)");
+		CHECK_MESSAGE(agent_1_safe_velocity.z < 0, "agent 1 should move a bit to the side so that it avoids agent 2");
+		CHECK_MESSAGE(agent_2_safe_velocity.z > 0, "agent 2 should move a bit to the side so that it avoids agent 1");
+		CHECK_MESSAGE(agent_3_safe_velocity.is_equal_approx(Vector3(1, 0, 0)), "agent 3 has no neighbors and should keep its desired velocity");
+
+		navigation_server->free(agent_3);
+		navigation_server->free(agent_2);
+		navigation_server->free(agent_1);
+		navigation_server->free(map);
+	}
+
+	TEST_CASE("[NavigationServer3D] Batched avoidance should solve ORCA constraints") {
+		LocalVector<NavAvoidanceBatch::OrcaLine> lines;
+		CHECK(NavAvoidanceBatch::solve_lines(lines, 0, 2.0, Vector2(1, 1)).is_equal_approx(Vector2(1, 1)));
+		CHECK(NavAvoidanceBatch::solve_lines(lines, 0, 2.0, Vector2(4, 0)).is_equal_approx(Vector2(2, 0)));
+
+		// Only velocities with y >= 0 are permitted.
+		lines.push_back({ Vector2(0, 0), Vector2(1, 0) });
+		CHECK(NavAvoidanceBatch::solve_lines(lines, 0, 2.0, Vector2(1, -1)).is_equal_approx(Vector2(1, 0)));
+
+		// Only velocities with y <= -1 are permitted, which contradicts the first line.
+		lines[0].point = Vector2(0, 1);
+		lines.push_back({ Vector2(0, -1), Vector2(-1, 0) });
+		Vector2 velocity = NavAvoidanceBatch::solve_lines(lines, 0, 2.0, Vector2(1, 0.5));
+		CHECK_MESSAGE(Math::is_zero_approx(velocity.y), "the violation of both lines should be minimized");
+		CHECK(velocity.length() <= 2.0 + CMP_EPSILON);
+		velocity = NavAvoidanceBatch::solve_lines(lines, 1, 2.0, Vector2(1, 0.5));
+		CHECK_MESSAGE(Math::is_equal_approx(velocity.y, 1), "obstacle lines should never be relaxed");
+
+		LocalVector<NavAvoidanceBatch::OrcaPlane> planes;
+		CHECK(NavAvoidanceBatch::solve_planes(planes, 2.0, Vector3(0, 4, 0)).is_equal_approx(Vector3(0, 2, 0)));
+
+		// Only velocities with y >= 0 are permitted.
+		planes.push_back({ Vector3(0, 0, 0), Vector3(0, 1, 0) });
+		CHECK(NavAvoidanceBatch::solve_planes(planes, 2.0, Vector3(1, -1, 0)).is_equal_approx(Vector3(1, 0, 0)));
+
+		// Only velocities with y <= -1 are permitted, which contradicts the first plane.
+		planes[0].point = Vector3(0, 1, 0);
+		planes.push_back({ Vector3(0, -1, 0), Vector3(0, -1, 0) });
+		const Vector3 velocity_3d = NavAvoidanceBatch::solve_planes(planes, 2.0, Vector3(1, 0.5, 0));
+		CHECK_MESSAGE(Math::is_zero_approx(velocity_3d.y), "the violation of both planes should be minimized");
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -792,6 +890,244 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should match individual queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 8; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(i, 0, 0));
+				query_parameters->set_target_position(Vector3(10 - i, 0, 10));
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			navigation_server->query_paths(batch_parameters, batch_results);
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(batch_parameters[i], query_result);
+				Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_owner_ids(), query_result->get_path_owner_ids());
+			}
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should update region connections when regions change") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_vertices({ Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(1, 0, 1), Vector3(0, 0, 1) });
+		navigation_mesh->add_polygon({ 0, 1, 2, 3 });
+
+		RID map = navigation_server->map_create();
+		RID region_a = navigation_server->region_create();
+		RID region_b = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(1.1, 0, 0)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// The facing edges are within the default edge connection margin.
+		CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+		CHECK_EQ(navigation_server->region_get_connections_count(region_b), 1);
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(1.6, 0, 0.5), true);
+		REQUIRE_NE(path.size(), 0);
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(1.6, 0, 0.5)));
+
+		SUBCASE("Moving a region away should disconnect it") {
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(5, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_b), 0);
+			path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(5.5, 0, 0.5), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK_FALSE(path[path.size() - 1].is_equal_approx(Vector3(5.5, 0, 0.5)));
+
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(1.1, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+			CHECK_EQ(navigation_server->region_get_connections_count(region_b), 1);
+		}
+
+		SUBCASE("Removing a region should disconnect its neighbors") {
+			navigation_server->region_set_map(region_b, RID());
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 1);
+		}
+
+		SUBCASE("Disabling a region should disconnect its neighbors") {
+			navigation_server->region_set_enabled(region_b, false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 0);
+
+			navigation_server->region_set_enabled(region_b, true);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->region_get_connections_count(region_a), 1);
+		}
+
+		navigation_server->free(region_a);
+		navigation_server->free(region_b);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should find paths on maps with a hierarchical graph") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(40.0, 0.001, 40.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID flat_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 4.0);
+		RID hierarchical_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 32.0);
+
+		RID flat_region = navigation_server->region_create();
+		RID hierarchical_region = navigation_server->region_create();
+		navigation_server->map_set_active(flat_map, true);
+		navigation_server->map_set_active(hierarchical_map, true);
+		navigation_server->region_set_map(flat_region, flat_map);
+		navigation_server->region_set_map(hierarchical_region, hierarchical_map);
+		navigation_server->region_set_navigation_mesh(flat_region, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(hierarchical_region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths across clusters should reach the same target as without clusters") {
+			const Vector<Vector3> flat_path = navigation_server->map_get_path(flat_map, Vector3(-18, 0, -18), Vector3(18, 0, 18), true);
+			const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, Vector3(-18, 0, -18), Vector3(18, 0, 18), true);
+			REQUIRE_NE(flat_path.size(), 0);
+			REQUIRE_NE(hierarchical_path.size(), 0);
+			CHECK(hierarchical_path[0].is_equal_approx(flat_path[0]));
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(flat_path[flat_path.size() - 1]));
+			// The widened corridor still holds the shortest path found by the flat search.
+			CHECK(get_path_length(hierarchical_path) == doctest::Approx(get_path_length(flat_path)));
+		}
+
+		SUBCASE("Paths to a point outside the map should end at the closest reachable point") {
+			const Vector<Vector3> flat_path = navigation_server->map_get_path(flat_map, Vector3(-18, 0, -18), Vector3(60, 0, 60), true);
+			const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, Vector3(-18, 0, -18), Vector3(60, 0, 60), true);
+			REQUIRE_NE(flat_path.size(), 0);
+			REQUIRE_NE(hierarchical_path.size(), 0);
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(flat_path[flat_path.size() - 1]));
+		}
+
+		navigation_server->free(flat_region);
+		navigation_server->free(hierarchical_region);
+		navigation_server->free(flat_map);
+		navigation_server->free(hierarchical_map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should not cluster disconnected polygons together") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// Two parallel corridors, close enough to share cluster cells, only joined at their far end.
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= 21; z++) {
+			for (int x = 0; x <= 3; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		const auto add_quad = [&](int p_x, int p_z) {
+			const int index = p_z * 4 + p_x;
+			navigation_mesh->add_polygon({ index, index + 1, index + 5, index + 4 });
+		};
+		for (int z = 0; z < 20; z++) {
+			add_quad(0, z);
+			add_quad(2, z);
+		}
+		for (int x = 0; x < 3; x++) {
+			add_quad(x, 20);
+		}
+
+		RID flat_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", true);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 4.0);
+		RID hierarchical_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", false);
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 32.0);
+
+		RID flat_region = navigation_server->region_create();
+		RID hierarchical_region = navigation_server->region_create();
+		navigation_server->map_set_active(flat_map, true);
+		navigation_server->map_set_active(hierarchical_map, true);
+		navigation_server->region_set_map(flat_region, flat_map);
+		navigation_server->region_set_map(hierarchical_region, hierarchical_map);
+		navigation_server->region_set_navigation_mesh(flat_region, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(hierarchical_region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Both corridors cross the same cells, the path has to go around through the far end.
+		const Vector3 start = Vector3(0.5, 0, 6.5);
+		const Vector3 end = Vector3(2.5, 0, 1.5);
+		const Vector<Vector3> flat_path = navigation_server->map_get_path(flat_map, start, end, true);
+		const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, start, end, true);
+		REQUIRE_NE(flat_path.size(), 0);
+		REQUIRE_NE(hierarchical_path.size(), 0);
+		CHECK(flat_path[flat_path.size() - 1].is_equal_approx(end));
+		CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(end));
+		CHECK(get_path_length(flat_path) > 30.0);
+		CHECK(get_path_length(hierarchical_path) == doctest::Approx(get_path_length(flat_path)));
+
+		navigation_server->free(flat_region);
+		navigation_server->free(hierarchical_region);
+		navigation_server->free(flat_map);
+		navigation_server->free(hierarchical_map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should be able to bake tiled navigation meshes") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(8.0);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(40.0, 0.001, 40.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths should cross tile edges") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-18, 0, -18), Vector3(18, 0, 18), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].distance_to(Vector3(18, 0, 18)) < 1.0);
+		}
+
+		SUBCASE("Rebaking unchanged source geometry should give the same result") {
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(navigation_mesh->get_vertices(), vertices);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
 		navigation_server->free(region);
 		navigation_server->free(map);
 		navigation_server->process(0.0); // Give server some cycles to commit.
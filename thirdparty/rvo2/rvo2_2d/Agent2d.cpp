@@ -40,20 +40,24 @@ namespace RVO2D {
 
 	void Agent2D::computeNeighbors(RVOSimulator2D *sim_)
 	{
-		obstacleNeighbors_.clear();
-		float rangeSq = sqr(timeHorizonObst_ * maxSpeed_ + radius_);
-		sim_->kdTree_->computeObstacleNeighbors(this, rangeSq);
+		computeObstacleNeighbors(sim_);
 
 		agentNeighbors_.clear();
 
 		if (maxNeighbors_ > 0) {
-			rangeSq = sqr(neighborDist_);
+			float rangeSq = sqr(neighborDist_);
 			sim_->kdTree_->computeAgentNeighbors(this, rangeSq);
 		}
 	}
 
-	/* Search for the best new velocity. */
-	void Agent2D::computeNewVelocity(RVOSimulator2D *sim_)
+	void Agent2D::computeObstacleNeighbors(RVOSimulator2D *sim_)
+	{
+		obstacleNeighbors_.clear();
+		float rangeSq = sqr(timeHorizonObst_ * maxSpeed_ + radius_);
+		sim_->kdTree_->computeObstacleNeighbors(this, rangeSq);
+	}
+
+	void Agent2D::computeObstacleOrcaLines()
 	{
 		orcaLines_.clear();
 
@@ -280,6 +284,12 @@ namespace RVO2D {
 				continue;
 			}
 		}
+	}
+
+	/* Search for the best new velocity. */
+	void Agent2D::computeNewVelocity(RVOSimulator2D *sim_)
+	{
+		computeObstacleOrcaLines();
 
 		const size_t numObstLines = orcaLines_.size();
 
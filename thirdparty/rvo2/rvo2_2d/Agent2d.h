@@ -58,6 +58,17 @@ namespace RVO2D {
 		 */
 		void computeNeighbors(RVOSimulator2D *sim_);
 
+		/**
+		 * \brief      Computes the static obstacle neighbors of this agent.
+		 */
+		void computeObstacleNeighbors(RVOSimulator2D *sim_);
+
+		/**
+		 * \brief      Replaces the ORCA lines of this agent with the lines of
+		 *             its static obstacle neighbors.
+		 */
+		void computeObstacleOrcaLines();
+
 		/**
 		 * \brief      Computes the new velocity of this agent.
 		 */